@@ -35,39 +35,533 @@
  */
 
 #include "driver_em4095_basic.h"
+#if (EM4095_BASIC_OS != 0)
+#include "driver_em4095_os.h"
+#endif
 
 static em4095_handle_t gs_handle;                                                                 /**< em4095 handle */
-static volatile uint8_t gs_flag;                                                                  /**< flag */
+#if (EM4095_BASIC_OS != 0)
+static em4095_os_sem_t gs_sem;                                                                    /**< sense and measure semaphore */
+static em4095_os_mutex_t gs_mutex;                                                                /**< submit mutex */
+#else
+static volatile uint8_t gs_flag;                                                                  /**< sense and measure flag */
+#endif
 static void (*gs_callback)(em4095_mode_t mode, em4095_decode_t *buf, uint16_t len) = NULL;        /**< callback */
 
+/**
+ * @brief em4095 basic request structure definition
+ */
+typedef struct em4095_basic_request_s
+{
+    em4095_mode_t mode;                                                        /**< read or write */
+    uint8_t *buf;                                                              /**< data buffer */
+    uint16_t len;                                                              /**< data length */
+    uint32_t timeout_ms;                                                       /**< timeout from the submit */
+    em4095_time_t start;                                                       /**< submit time */
+    uint32_t seq;                                                              /**< submit sequence */
+    volatile uint8_t status;                                                   /**< request status */
+    void (*callback)(uint32_t token, em4095_basic_status_t status);            /**< completion callback */
+} em4095_basic_request_t;
+
+#define EM4095_BASIC_NO_REQUEST    0xFF        /**< no running request */
+
+static em4095_basic_request_t gs_request[EM4095_BASIC_ASYNC_DEPTH];            /**< request slots */
+static volatile uint8_t gs_running = EM4095_BASIC_NO_REQUEST;                  /**< running request */
+static uint32_t gs_seq;                                                        /**< last sequence */
+#if (EM4095_BASIC_OS != 0)
+static em4095_os_sem_t gs_done[EM4095_BASIC_ASYNC_DEPTH];                      /**< completion semaphores */
+#endif
+
+/**
+ * @brief     finish a request
+ * @param[in] index request index
+ * @param[in] status final status
+ * @note      none
+ */
+static void a_async_finish(uint8_t index, em4095_basic_status_t status)
+{
+    em4095_basic_request_t *r = &gs_request[index];
+
+    r->status = (uint8_t)status;
+    if (r->callback != NULL)
+    {
+        r->callback((r->seq << 8) | index, status);
+    }
+#if (EM4095_BASIC_OS != 0)
+    (void)em4095_os_sem_give(gs_done[index]);
+#endif
+}
+
+/**
+ * @brief  start the oldest pending request
+ * @note   it runs from the irq when a request completes, so a queue drains without a poll
+ */
+static void a_async_start(void)
+{
+    uint8_t i;
+    uint8_t next;
+    uint8_t res;
+    em4095_basic_request_t *r;
+
+    while (gs_running == EM4095_BASIC_NO_REQUEST)
+    {
+        /* find the oldest pending request */
+        next = EM4095_BASIC_NO_REQUEST;
+        for (i = 0; i < EM4095_BASIC_ASYNC_DEPTH; i++)
+        {
+            if ((gs_request[i].status == EM4095_BASIC_STATUS_PENDING) &&
+                ((next == EM4095_BASIC_NO_REQUEST) || ((int32_t)(gs_request[i].seq - gs_request[next].seq) < 0)))
+            {
+                next = i;
+            }
+        }
+        if (next == EM4095_BASIC_NO_REQUEST)
+        {
+            return;
+        }
+
+        /* start it */
+        r = &gs_request[next];
+        r->status = EM4095_BASIC_STATUS_RUNNING;
+        gs_running = next;
+        if (r->mode == EM4095_MODE_READ)
+        {
+            res = em4095_read(&gs_handle, r->len);
+        }
+        else
+        {
+            res = em4095_write(&gs_handle, r->buf, r->len);
+        }
+        if (res == 0)
+        {
+            res = em4095_power_on(&gs_handle);
+        }
+        if (res != 0)
+        {
+            (void)em4095_abort(&gs_handle);
+            gs_running = EM4095_BASIC_NO_REQUEST;
+            a_async_finish(next, EM4095_BASIC_STATUS_FAILED);
+        }
+    }
+}
+
+/**
+ * @brief     complete the running request
+ * @param[in] mode running mode
+ * @note      runs in the irq
+ */
+static void a_async_complete(em4095_mode_t mode)
+{
+    uint8_t index;
+    uint16_t l;
+    em4095_basic_status_t status;
+
+    index = gs_running;
+    if ((index == EM4095_BASIC_NO_REQUEST) || (gs_request[index].mode != mode))
+    {
+        return;
+    }
+    status = EM4095_BASIC_STATUS_DONE;
+    if (mode == EM4095_MODE_READ)
+    {
+        /* copy the levels before the next read reuses the decode buffer */
+        if ((em4095_copy_decode_buffer(&gs_handle, gs_request[index].buf, &l) != 0) ||
+            (l != gs_request[index].len))
+        {
+            status = EM4095_BASIC_STATUS_FAILED;
+        }
+    }
+    gs_running = EM4095_BASIC_NO_REQUEST;
+    a_async_finish(index, status);
+    a_async_start();
+}
+
+/**
+ * @brief  check the request timeouts
+ * @note   none
+ */
+static void a_async_timeout(void)
+{
+    uint8_t i;
+    uint8_t index;
+    int64_t diff;
+    em4095_time_t t;
+
+    if (em4095_interface_timestamp_read(&t) != 0)
+    {
+        return;
+    }
+    for (i = 0; i < EM4095_BASIC_ASYNC_DEPTH; i++)
+    {
+        if ((gs_request[i].status != EM4095_BASIC_STATUS_PENDING) &&
+            (gs_request[i].status != EM4095_BASIC_STATUS_RUNNING))
+        {
+            continue;
+        }
+        diff = (int64_t)(t.s - gs_request[i].start.s) * 1000000 +
+               ((int64_t)t.us - (int64_t)gs_request[i].start.us);
+        if (diff < (int64_t)gs_request[i].timeout_ms * 1000)
+        {
+            continue;
+        }
+        if (gs_request[i].status == EM4095_BASIC_STATUS_RUNNING)
+        {
+            /* after the abort the irq can't complete anything */
+            (void)em4095_abort(&gs_handle);
+            index = gs_running;
+            if ((index != i) && (index != EM4095_BASIC_NO_REQUEST))
+            {
+                /* it completed just before the abort and the next one was aborted, run it again */
+                gs_request[index].status = EM4095_BASIC_STATUS_PENDING;
+            }
+            gs_running = EM4095_BASIC_NO_REQUEST;
+            if (gs_request[i].status != EM4095_BASIC_STATUS_RUNNING)
+            {
+                continue;
+            }
+        }
+        a_async_finish(i, EM4095_BASIC_STATUS_TIMEOUT);
+    }
+    a_async_start();
+}
+
+/**
+ * @brief      submit a request
+ * @param[in]  mode read or write
+ * @param[in]  *buf pointer to a data buffer
+ * @param[in]  len data length
+ * @param[in]  timeout_ms timeout from now
+ * @param[in]  *callback pointer to a completion callback
+ * @param[out] *token pointer to a token buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 submit failed
+ * @note       with the os layer the mutex keeps two threads off the same slot
+ */
+static uint8_t a_async_submit(em4095_mode_t mode, uint8_t *buf, uint16_t len, uint32_t timeout_ms,
+                              void (*callback)(uint32_t token, em4095_basic_status_t status), uint32_t *token)
+{
+    uint8_t i;
+    em4095_basic_request_t *r;
+
+    if ((buf == NULL) || (token == NULL) || (len == 0) || (len > EM4095_MAX_LENGTH))
+    {
+        return 1;
+    }
+#if (EM4095_BASIC_OS != 0)
+    if (em4095_os_mutex_lock(gs_mutex) != 0)
+    {
+        return 1;
+    }
+#endif
+
+    /* find a slot without a live request */
+    for (i = 0; i < EM4095_BASIC_ASYNC_DEPTH; i++)
+    {
+        if ((gs_request[i].status != EM4095_BASIC_STATUS_PENDING) &&
+            (gs_request[i].status != EM4095_BASIC_STATUS_RUNNING))
+        {
+            break;
+        }
+    }
+    if (i == EM4095_BASIC_ASYNC_DEPTH)
+    {
+#if (EM4095_BASIC_OS != 0)
+        (void)em4095_os_mutex_unlock(gs_mutex);
+#endif
+
+        return 1;
+    }
+    r = &gs_request[i];
+    if (em4095_interface_timestamp_read(&r->start) != 0)
+    {
+#if (EM4095_BASIC_OS != 0)
+        (void)em4095_os_mutex_unlock(gs_mutex);
+#endif
+
+        return 1;
+    }
+    gs_seq = ((gs_seq + 1) & 0x00FFFFFFU);
+    if (gs_seq == 0)
+    {
+        gs_seq = 1;
+    }
+    r->mode = mode;
+    r->buf = buf;
+    r->len = len;
+    r->timeout_ms = timeout_ms;
+    r->seq = gs_seq;
+    r->callback = callback;
+    *token = (r->seq << 8) | i;
+
+#if (EM4095_BASIC_OS != 0)
+    /* drop a completion left by the last request of the slot */
+    (void)em4095_os_sem_take(gs_done[i], 0);
+#endif
+
+    /* the irq starts it if a request is running, else start it here */
+    r->status = EM4095_BASIC_STATUS_PENDING;
+    if (gs_running == EM4095_BASIC_NO_REQUEST)
+    {
+        a_async_start();
+    }
+#if (EM4095_BASIC_OS != 0)
+    (void)em4095_os_mutex_unlock(gs_mutex);
+#endif
+
+    return 0;
+}
+
+/**
+ * @brief      find a request by the token
+ * @param[in]  token request token
+ * @param[out] *index pointer to an index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 token is invalid
+ * @note       none
+ */
+static uint8_t a_async_find(uint32_t token, uint8_t *index)
+{
+    uint8_t i;
+
+    i = (uint8_t)(token & 0xFF);
+    if ((i >= EM4095_BASIC_ASYNC_DEPTH) || (gs_request[i].seq != (token >> 8)) ||
+        (gs_request[i].status == EM4095_BASIC_STATUS_FREE))
+    {
+        return 1;
+    }
+    *index = i;
+
+    return 0;
+}
+
+#if (EM4095_BASIC_OS != 0)
+/**
+ * @brief     wait for a request
+ * @param[in] token request token
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 request failed
+ * @note      it sleeps on the completion semaphore instead of polling
+ */
+static uint8_t a_async_wait(uint32_t token, uint32_t timeout_ms)
+{
+    em4095_basic_status_t status;
+
+    /* the semaphore is given by the irq or a timeout check */
+    (void)em4095_os_sem_take(gs_done[token & 0xFF], timeout_ms);
+    if (em4095_basic_poll(token, &status) != 0)
+    {
+        return 1;
+    }
+    if ((status == EM4095_BASIC_STATUS_PENDING) || (status == EM4095_BASIC_STATUS_RUNNING))
+    {
+        /* the wait is over, don't leave it behind */
+        (void)em4095_basic_cancel(token);
+
+        return 1;
+    }
+
+    return (status == EM4095_BASIC_STATUS_DONE) ? 0 : 1;
+}
+#else
+/**
+ * @brief     wait for a request
+ * @param[in] token request token
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 request failed
+ * @note      it polls every 1ms, the poll times the request out
+ */
+static uint8_t a_async_wait(uint32_t token, uint32_t timeout_ms)
+{
+    em4095_basic_status_t status;
+
+    (void)timeout_ms;
+    while (1)
+    {
+        if (em4095_basic_poll(token, &status) != 0)
+        {
+            return 1;
+        }
+        if ((status != EM4095_BASIC_STATUS_PENDING) && (status != EM4095_BASIC_STATUS_RUNNING))
+        {
+            break;
+        }
+
+        /* delay 1ms */
+        em4095_interface_delay_ms(1);
+    }
+
+    return (status == EM4095_BASIC_STATUS_DONE) ? 0 : 1;
+}
+#endif
+
+#if (EM4095_BASIC_OS != 0)
+/**
+ * @brief  delete the os objects
+ * @note   none
+ */
+static void a_os_delete(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < EM4095_BASIC_ASYNC_DEPTH; i++)
+    {
+        if (gs_done[i] != NULL)
+        {
+            (void)em4095_os_sem_delete(gs_done[i]);
+            gs_done[i] = NULL;
+        }
+    }
+    if (gs_sem != NULL)
+    {
+        (void)em4095_os_sem_delete(gs_sem);
+        gs_sem = NULL;
+    }
+    if (gs_mutex != NULL)
+    {
+        (void)em4095_os_mutex_delete(gs_mutex);
+        gs_mutex = NULL;
+    }
+}
+
+/**
+ * @brief  create the os objects
+ * @return status code
+ *         - 0 success
+ *         - 1 create failed
+ * @note   none
+ */
+static uint8_t a_os_create(void)
+{
+    uint8_t i;
+
+    a_os_delete();
+    for (i = 0; i < EM4095_BASIC_ASYNC_DEPTH; i++)
+    {
+        if (em4095_os_sem_create(&gs_done[i]) != 0)
+        {
+            a_os_delete();
+
+            return 1;
+        }
+    }
+    if ((em4095_os_sem_create(&gs_sem) != 0) || (em4095_os_mutex_create(&gs_mutex) != 0))
+    {
+        a_os_delete();
+
+        return 1;
+    }
+
+    return 0;
+}
+#endif
+
+/**
+ * @brief  clear the sense and measure completion
+ * @note   none
+ */
+static void a_done_clear(void)
+{
+#if (EM4095_BASIC_OS != 0)
+    (void)em4095_os_sem_take(gs_sem, 0);
+#else
+    gs_flag = 0;
+#endif
+}
+
+/**
+ * @brief  give the sense and measure completion
+ * @note   runs in the irq
+ */
+static void a_done_give(void)
+{
+#if (EM4095_BASIC_OS != 0)
+    (void)em4095_os_sem_give(gs_sem);
+#else
+    gs_flag = 1;
+#endif
+}
+
+/**
+ * @brief     wait for the sense and measure completion
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout
+ * @note      none
+ */
+static uint8_t a_done_wait(uint32_t timeout_ms)
+{
+#if (EM4095_BASIC_OS != 0)
+    return em4095_os_sem_take(gs_sem, timeout_ms);
+#else
+    /* check timeout */
+    while (timeout_ms != 0)
+    {
+        /* check the flag */
+        if (gs_flag != 0)
+        {
+            return 0;
+        }
+
+        /* timeout -- */
+        timeout_ms--;
+
+        /* delay 1ms */
+        em4095_interface_delay_ms(1);
+    }
+
+    return 1;
+#endif
+}
+
 /**
  * @brief     interface receive callback
+ * @param[in] *ctx pointer to the interface context
  * @param[in] mode running mode
  * @param[in] *buf pointer to a decode buffer
  * @param[in] len data length
  * @note      none
  */
-static void a_receive_callback(em4095_mode_t mode, em4095_decode_t *buf, uint16_t len)
+static void a_receive_callback(void *ctx, em4095_mode_t mode, em4095_decode_t *buf, uint16_t len)
 {
+    (void)ctx;
+
     switch (mode)
     {
         case EM4095_MODE_READ :
         {
-            gs_flag = 1;
             if (gs_callback != NULL)
             {
                 gs_callback(mode, buf, len);
             }
+            a_async_complete(mode);
 
             break;
         }
         case EM4095_MODE_WRITE :
         {
-            gs_flag = 1;
             if (gs_callback != NULL)
             {
                 gs_callback(mode, buf, len);
             }
+            a_async_complete(mode);
+
+            break;
+        }
+        case EM4095_MODE_SENSE :
+        case EM4095_MODE_MEASURE :
+        {
+            if (gs_callback != NULL)
+            {
+                gs_callback(mode, buf, len);
+            }
+            a_done_give();
 
             break;
         }
@@ -125,12 +619,28 @@ uint8_t em4095_basic_init(void (*callback)(em4095_mode_t mode, em4095_decode_t *
     DRIVER_EM4095_LINK_DEBUG_PRINT(&gs_handle, em4095_interface_debug_print);
     DRIVER_EM4095_LINK_RECEIVE_CALLBACK(&gs_handle, a_receive_callback);
     gs_callback = callback;
+    memset(gs_request, 0, sizeof(gs_request));
+    gs_running = EM4095_BASIC_NO_REQUEST;
+
+#if (EM4095_BASIC_OS != 0)
+    /* create the os objects */
+    res = a_os_create();
+    if (res != 0)
+    {
+        em4095_interface_debug_print("em4095: create os objects failed.\n");
+
+        return 1;
+    }
+#endif
 
     /* init */
     res = em4095_init(&gs_handle);
     if (res != 0)
     {
         em4095_interface_debug_print("em4095: init failed.\n");
+#if (EM4095_BASIC_OS != 0)
+        a_os_delete();
+#endif
 
         return 1;
     }
@@ -141,6 +651,9 @@ uint8_t em4095_basic_init(void (*callback)(em4095_mode_t mode, em4095_decode_t *
     {
         em4095_interface_debug_print("em4095: set div failed.\n");
         (void)em4095_deinit(&gs_handle);
+#if (EM4095_BASIC_OS != 0)
+        a_os_delete();
+#endif
 
         return 1;
     }
@@ -151,6 +664,9 @@ uint8_t em4095_basic_init(void (*callback)(em4095_mode_t mode, em4095_decode_t *
     {
         em4095_interface_debug_print("em4095: power down failed.\n");
         (void)em4095_deinit(&gs_handle);
+#if (EM4095_BASIC_OS != 0)
+        a_os_delete();
+#endif
 
         return 1;
     }
@@ -181,76 +697,158 @@ uint8_t em4095_basic_set_div(uint32_t clock_div)
 }
 
 /**
- * @brief      basic example read
- * @param[out] *buf pointer to a data buffer
- * @param[in]  len read length
- * @return     status code
- *             - 0 success
- *             - 1 read failed
- * @note       none
+ * @brief     basic example set the read oversampling
+ * @param[in] times odd reads per sample, 1 disables it
+ * @return    status code
+ *            - 0 success
+ *            - 1 set oversample failed
+ * @note      none
  */
-uint8_t em4095_basic_read(uint8_t *buf, uint16_t len)
+uint8_t em4095_basic_set_oversample(uint8_t times)
 {
     uint8_t res;
-    uint16_t l;
-    uint32_t timeout;
-
-    /* init 0 */
-    gs_flag = 0;
-
-    /* read */
-    res = em4095_read(&gs_handle, len);
+    
+    /* set oversample */
+    res = em4095_set_oversample(&gs_handle, times);
     if (res != 0)
     {
         return 1;
     }
+    
+    return 0;
+}
 
-    /* power on */
-    res = em4095_power_on(&gs_handle);
+/**
+ * @brief     basic example set the glitch filter
+ * @param[in] width min pulse width in clock irqs, 0 disables it
+ * @return    status code
+ *            - 0 success
+ *            - 1 set glitch filter failed
+ * @note      none
+ */
+uint8_t em4095_basic_set_glitch_filter(uint8_t width)
+{
+    uint8_t res;
+    
+    /* set glitch filter */
+    res = em4095_set_glitch_filter(&gs_handle, width);
     if (res != 0)
     {
         return 1;
     }
+    
+    return 0;
+}
 
-    /* set timeout 5s */
-    timeout = 500;
-
-    /* check timeout */
-    while (timeout != 0)
+/**
+ * @brief     basic example set the read gap
+ * @param[in] periods gap in sample periods, 0 uses the fixed timeout
+ * @return    status code
+ *            - 0 success
+ *            - 1 set gap failed
+ * @note      none
+ */
+uint8_t em4095_basic_set_gap(uint16_t periods)
+{
+    uint8_t res;
+    
+    /* set gap */
+    res = em4095_set_gap(&gs_handle, periods);
+    if (res != 0)
     {
-        /* check the flag */
-        if (gs_flag != 0)
-        {
-            break;
-        }
-
-        /* timeout -- */
-        timeout--;
+        return 1;
+    }
+    
+    return 0;
+}
 
-        /* delay 10ms */
-        em4095_interface_delay_ms(10);
+/**
+ * @brief     basic example set the timebase
+ * @param[in] timebase read and write timebase
+ * @return    status code
+ *            - 0 success
+ *            - 1 set timebase failed
+ * @note      the carrier timebase gives the diffs in clock irqs
+ */
+uint8_t em4095_basic_set_timebase(em4095_timebase_t timebase)
+{
+    uint8_t res;
+    
+    /* set timebase */
+    res = em4095_set_timebase(&gs_handle, timebase);
+    if (res != 0)
+    {
+        return 1;
     }
+    
+    return 0;
+}
 
-    /* check the timeout */
-    if (timeout == 0)
+/**
+ * @brief     basic example set the sampling phase loop
+ * @param[in] shift loop gain is 1 / 2^shift, 0 disables the loop
+ * @return    status code
+ *            - 0 success
+ *            - 1 set pll failed
+ * @note      none
+ */
+uint8_t em4095_basic_set_pll(uint8_t shift)
+{
+    uint8_t res;
+    
+    /* set pll */
+    res = em4095_set_pll(&gs_handle, shift);
+    if (res != 0)
     {
         return 1;
     }
+    
+    return 0;
+}
 
-    /* copy to buffer */
-    res = em4095_copy_decode_buffer(&gs_handle, buf, &l);
+/**
+ * @brief      basic example get the corrected samples of the last read
+ * @param[out] *corrected pointer to a corrected sample number buffer
+ * @param[out] *glitches pointer to a filtered glitch number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get corrected samples failed
+ * @note       none
+ */
+uint8_t em4095_basic_get_corrected_samples(uint16_t *corrected, uint16_t *glitches)
+{
+    uint8_t res;
+    
+    /* get corrected samples */
+    res = em4095_get_corrected_samples(&gs_handle, corrected, glitches);
     if (res != 0)
     {
         return 1;
     }
+    
+    return 0;
+}
+
+/**
+ * @brief      basic example read
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len read length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t em4095_basic_read(uint8_t *buf, uint16_t len)
+{
+    uint32_t token;
 
-    /* check length */
-    if (l != len)
+    /* read with timeout 5s */
+    if (em4095_basic_read_async(buf, len, 5000, NULL, &token) != 0)
     {
         return 1;
     }
 
-    return 0;
+    return a_async_wait(token, 5000);
 }
 
 /**
@@ -263,52 +861,278 @@ uint8_t em4095_basic_read(uint8_t *buf, uint16_t len)
  * @note      none
  */
 uint8_t em4095_basic_write(uint8_t *buf, uint16_t len)
+{
+    uint32_t token;
+
+    /* write with timeout 5s */
+    if (em4095_basic_write_async(buf, len, 5000, NULL, &token) != 0)
+    {
+        return 1;
+    }
+
+    return a_async_wait(token, 5000);
+}
+
+#if (EM4095_BASIC_OS != 0)
+/**
+ * @brief      basic example read and sleep until it is done
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len read length
+ * @param[in]  timeout_ms timeout in ms
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the caller sleeps on a semaphore given by the irq, a timed out read is canceled
+ */
+uint8_t em4095_basic_read_blocking(uint8_t *buf, uint16_t len, uint32_t timeout_ms)
+{
+    uint32_t token;
+
+    if (em4095_basic_read_async(buf, len, timeout_ms, NULL, &token) != 0)
+    {
+        return 1;
+    }
+
+    return a_async_wait(token, timeout_ms);
+}
+
+/**
+ * @brief     basic example write and sleep until it is done
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len written length
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the caller sleeps on a semaphore given by the irq, a timed out write is canceled
+ */
+uint8_t em4095_basic_write_blocking(uint8_t *buf, uint16_t len, uint32_t timeout_ms)
+{
+    uint32_t token;
+
+    if (em4095_basic_write_async(buf, len, timeout_ms, NULL, &token) != 0)
+    {
+        return 1;
+    }
+
+    return a_async_wait(token, timeout_ms);
+}
+#endif
+
+/**
+ * @brief      basic example start an asynchronous read
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len read length
+ * @param[in]  timeout_ms timeout from now
+ * @param[in]  *callback pointer to a completion callback, NULL means polling only
+ * @param[out] *token pointer to a token buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       buf is filled before the completion, the callback runs in the irq when the request is done
+ *             and in em4095_basic_poll when it times out
+ */
+uint8_t em4095_basic_read_async(uint8_t *buf, uint16_t len, uint32_t timeout_ms,
+                                void (*callback)(uint32_t token, em4095_basic_status_t status), uint32_t *token)
+{
+    return a_async_submit(EM4095_MODE_READ, buf, len, timeout_ms, callback, token);
+}
+
+/**
+ * @brief      basic example start an asynchronous write
+ * @param[in]  *buf pointer to a data buffer
+ * @param[in]  len written length
+ * @param[in]  timeout_ms timeout from now
+ * @param[in]  *callback pointer to a completion callback, NULL means polling only
+ * @param[out] *token pointer to a token buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 write failed
+ * @note       buf must be kept until the write starts
+ */
+uint8_t em4095_basic_write_async(uint8_t *buf, uint16_t len, uint32_t timeout_ms,
+                                 void (*callback)(uint32_t token, em4095_basic_status_t status), uint32_t *token)
+{
+    return a_async_submit(EM4095_MODE_WRITE, buf, len, timeout_ms, callback, token);
+}
+
+/**
+ * @brief      basic example poll an asynchronous request
+ * @param[in]  token request token
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 token is invalid
+ * @note       the timeouts of all requests are checked with the timestamp here
+ */
+uint8_t em4095_basic_poll(uint32_t token, em4095_basic_status_t *status)
+{
+    uint8_t index;
+
+    a_async_timeout();
+    if (a_async_find(token, &index) != 0)
+    {
+        return 1;
+    }
+    *status = (em4095_basic_status_t)gs_request[index].status;
+
+    return 0;
+}
+
+/**
+ * @brief     basic example cancel an asynchronous request
+ * @param[in] token request token
+ * @return    status code
+ *            - 0 success
+ *            - 1 cancel failed
+ * @note      a finished request can't be canceled
+ */
+uint8_t em4095_basic_cancel(uint32_t token)
+{
+    uint8_t index;
+
+    if (a_async_find(token, &index) != 0)
+    {
+        return 1;
+    }
+    if (gs_request[index].status == EM4095_BASIC_STATUS_RUNNING)
+    {
+        /* after the abort the irq can't complete it */
+        (void)em4095_abort(&gs_handle);
+        if (gs_running != index)
+        {
+            if (gs_running != EM4095_BASIC_NO_REQUEST)
+            {
+                /* it completed just before the abort, run the next one again */
+                gs_request[gs_running].status = EM4095_BASIC_STATUS_PENDING;
+                gs_running = EM4095_BASIC_NO_REQUEST;
+                a_async_start();
+            }
+
+            return 1;
+        }
+        gs_running = EM4095_BASIC_NO_REQUEST;
+    }
+    else if (gs_request[index].status != EM4095_BASIC_STATUS_PENDING)
+    {
+        return 1;
+    }
+    else
+    {
+        /* not started */
+    }
+    a_async_finish(index, EM4095_BASIC_STATUS_CANCELED);
+    a_async_start();
+
+    return 0;
+}
+
+/**
+ * @brief      basic example sense
+ * @param[in]  settle ignored clock irqs after the power on
+ * @param[in]  window counted clock irqs
+ * @param[out] *edges pointer to an edge number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 sense failed
+ * @note       the chip is only powered during the sense
+ */
+uint8_t em4095_basic_sense(uint16_t settle, uint16_t window, uint16_t *edges)
 {
     uint8_t res;
-    uint32_t timeout;
 
-    /* init 0 */
-    gs_flag = 0;
+    /* wait for the asynchronous requests */
+    if (gs_running != EM4095_BASIC_NO_REQUEST)
+    {
+        return 1;
+    }
 
-    /* write */
-    res = em4095_write(&gs_handle, buf, len);
+    /* drop a stale completion */
+    a_done_clear();
+
+    /* sense */
+    res = em4095_sense(&gs_handle, settle, window);
     if (res != 0)
     {
         return 1;
     }
 
-    /* power on */
-    res = em4095_power_on(&gs_handle);
+    /* wait 1s for the irq */
+    if (a_done_wait(1000) != 0)
+    {
+        (void)em4095_abort(&gs_handle);
+
+        return 1;
+    }
+
+    /* get the edges */
+    res = em4095_get_sense_edges(&gs_handle, edges);
     if (res != 0)
     {
         return 1;
     }
 
-    /* set timeout 5s */
-    timeout = 500;
+    return 0;
+}
 
-    /* check timeout */
-    while (timeout != 0)
+/**
+ * @brief      basic example measure the carrier
+ * @param[in]  window measured clock irqs
+ * @param[out] *hz pointer to a frequency buffer
+ * @param[out] *ppm pointer to a detuning buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 measure failed
+ * @note       ppm is the offset from the nearer one of 125KHz and 134.2KHz,
+ *             it fails when there is no carrier
+ */
+uint8_t em4095_basic_measure_carrier(uint32_t window, float *hz, float *ppm)
+{
+    uint8_t res;
+    float nominal;
+
+    /* wait for the asynchronous requests */
+    if (gs_running != EM4095_BASIC_NO_REQUEST)
     {
-        /* check the flag */
-        if (gs_flag != 0)
-        {
-            break;
-        }
+        return 1;
+    }
 
-        /* timeout -- */
-        timeout--;
+    /* drop a stale completion */
+    a_done_clear();
 
-        /* delay 10ms */
-        em4095_interface_delay_ms(10);
+    /* measure */
+    res = em4095_measure(&gs_handle, EM4095_BASIC_DEFAULT_SETTLE, window);
+    if (res != 0)
+    {
+        return 1;
+    }
+
+    /* wait 1s for the irq */
+    if (a_done_wait(1000) != 0)
+    {
+        (void)em4095_abort(&gs_handle);
+
+        return 1;
     }
 
-    /* check the timeout */
-    if (timeout == 0)
+    /* get the frequency */
+    res = em4095_get_carrier_frequency(&gs_handle, EM4095_BASIC_DEFAULT_IRQS_PER_CYCLE, hz);
+    if (res != 0)
     {
         return 1;
     }
 
+    /* detuning from the nearer nominal carrier */
+    if (*hz < (EM4095_CARRIER_125K_HZ + EM4095_CARRIER_134K_HZ) / 2.0f)
+    {
+        nominal = EM4095_CARRIER_125K_HZ;
+    }
+    else
+    {
+        nominal = EM4095_CARRIER_134K_HZ;
+    }
+    *ppm = (*hz - nominal) / nominal * 1000000.0f;
+
     return 0;
 }
 
@@ -321,10 +1145,15 @@ uint8_t em4095_basic_write(uint8_t *buf, uint16_t len)
  */
 uint8_t em4095_basic_deinit(void)
 {
+    (void)em4095_abort(&gs_handle);
+    gs_running = EM4095_BASIC_NO_REQUEST;
     if (em4095_deinit(&gs_handle) != 0)
     {
         return 1;
     }
+#if (EM4095_BASIC_OS != 0)
+    a_os_delete();
+#endif
     gs_callback = NULL;
 
     return 0;
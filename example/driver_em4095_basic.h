@@ -53,7 +53,39 @@ extern "C"{
 /**
  * @brief em4095 basic example default definition
  */
-#define EM4095_BASIC_DEFAULT_DIV     64       /**< div 64 */
+#define EM4095_BASIC_DEFAULT_DIV               64        /**< div 64 */
+#define EM4095_BASIC_DEFAULT_IRQS_PER_CYCLE    2         /**< both clk edges */
+#define EM4095_BASIC_DEFAULT_SETTLE            512       /**< 512 clock irqs */
+
+/**
+ * @brief em4095 basic example async depth definition
+ */
+#ifndef EM4095_BASIC_ASYNC_DEPTH
+    #define EM4095_BASIC_ASYNC_DEPTH    4        /**< 4 requests */
+#endif
+
+/**
+ * @brief em4095 basic example os layer definition
+ * @note  0 waits with em4095_interface_delay_ms, 1 sleeps on the semaphores and the mutex of driver_em4095_os.h
+ *        and adds the blocking helpers, it follows EM4095_OS of the driver
+ */
+#ifndef EM4095_BASIC_OS
+    #define EM4095_BASIC_OS    EM4095_OS        /**< os layer of the driver */
+#endif
+
+/**
+ * @brief em4095 basic status enumeration definition
+ */
+typedef enum
+{
+    EM4095_BASIC_STATUS_FREE     = 0x00,        /**< no request */
+    EM4095_BASIC_STATUS_PENDING  = 0x01,        /**< queued */
+    EM4095_BASIC_STATUS_RUNNING  = 0x02,        /**< running */
+    EM4095_BASIC_STATUS_DONE     = 0x03,        /**< done */
+    EM4095_BASIC_STATUS_TIMEOUT  = 0x04,        /**< timeout */
+    EM4095_BASIC_STATUS_FAILED   = 0x05,        /**< failed */
+    EM4095_BASIC_STATUS_CANCELED = 0x06,        /**< canceled */
+} em4095_basic_status_t;
 
 /**
  * @brief  basic irq
@@ -105,6 +137,84 @@ uint8_t em4095_basic_read(uint8_t *buf, uint16_t len);
  */
 uint8_t em4095_basic_write(uint8_t *buf, uint16_t len);
 
+#if (EM4095_BASIC_OS != 0)
+/**
+ * @brief      basic example read and sleep until it is done
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len read length
+ * @param[in]  timeout_ms timeout in ms
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the caller sleeps on a semaphore given by the irq, a timed out read is canceled
+ */
+uint8_t em4095_basic_read_blocking(uint8_t *buf, uint16_t len, uint32_t timeout_ms);
+
+/**
+ * @brief     basic example write and sleep until it is done
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len written length
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the caller sleeps on a semaphore given by the irq, a timed out write is canceled
+ */
+uint8_t em4095_basic_write_blocking(uint8_t *buf, uint16_t len, uint32_t timeout_ms);
+#endif
+
+/**
+ * @brief      basic example start an asynchronous read
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len read length
+ * @param[in]  timeout_ms timeout from now
+ * @param[in]  *callback pointer to a completion callback, NULL means polling only
+ * @param[out] *token pointer to a token buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       buf is filled before the completion, the callback runs in the irq when the request is done
+ *             and in em4095_basic_poll when it times out
+ */
+uint8_t em4095_basic_read_async(uint8_t *buf, uint16_t len, uint32_t timeout_ms,
+                                void (*callback)(uint32_t token, em4095_basic_status_t status), uint32_t *token);
+
+/**
+ * @brief      basic example start an asynchronous write
+ * @param[in]  *buf pointer to a data buffer
+ * @param[in]  len written length
+ * @param[in]  timeout_ms timeout from now
+ * @param[in]  *callback pointer to a completion callback, NULL means polling only
+ * @param[out] *token pointer to a token buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 write failed
+ * @note       buf must be kept until the write starts
+ */
+uint8_t em4095_basic_write_async(uint8_t *buf, uint16_t len, uint32_t timeout_ms,
+                                 void (*callback)(uint32_t token, em4095_basic_status_t status), uint32_t *token);
+
+/**
+ * @brief      basic example poll an asynchronous request
+ * @param[in]  token request token
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 token is invalid
+ * @note       the timeouts of all requests are checked with the timestamp here
+ */
+uint8_t em4095_basic_poll(uint32_t token, em4095_basic_status_t *status);
+
+/**
+ * @brief     basic example cancel an asynchronous request
+ * @param[in] token request token
+ * @return    status code
+ *            - 0 success
+ *            - 1 cancel failed
+ * @note      a finished request can't be canceled
+ */
+uint8_t em4095_basic_cancel(uint32_t token);
+
 /**
  * @brief     basic example set clock div
  * @param[in] clock_div clock div
@@ -115,6 +225,92 @@ uint8_t em4095_basic_write(uint8_t *buf, uint16_t len);
  */
 uint8_t em4095_basic_set_div(uint32_t clock_div);
 
+/**
+ * @brief      basic example sense
+ * @param[in]  settle ignored clock irqs after the power on
+ * @param[in]  window counted clock irqs
+ * @param[out] *edges pointer to an edge number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 sense failed
+ * @note       the chip is only powered during the sense
+ */
+uint8_t em4095_basic_sense(uint16_t settle, uint16_t window, uint16_t *edges);
+
+/**
+ * @brief      basic example measure the carrier
+ * @param[in]  window measured clock irqs
+ * @param[out] *hz pointer to a frequency buffer
+ * @param[out] *ppm pointer to a detuning buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 measure failed
+ * @note       ppm is the offset from the nearer one of 125KHz and 134.2KHz,
+ *             it fails when there is no carrier
+ */
+uint8_t em4095_basic_measure_carrier(uint32_t window, float *hz, float *ppm);
+
+/**
+ * @brief     basic example set the read oversampling
+ * @param[in] times odd reads per sample, 1 disables it
+ * @return    status code
+ *            - 0 success
+ *            - 1 set oversample failed
+ * @note      none
+ */
+uint8_t em4095_basic_set_oversample(uint8_t times);
+
+/**
+ * @brief     basic example set the glitch filter
+ * @param[in] width min pulse width in clock irqs, 0 disables it
+ * @return    status code
+ *            - 0 success
+ *            - 1 set glitch filter failed
+ * @note      none
+ */
+uint8_t em4095_basic_set_glitch_filter(uint8_t width);
+
+/**
+ * @brief     basic example set the read gap
+ * @param[in] periods gap in sample periods, 0 uses the fixed timeout
+ * @return    status code
+ *            - 0 success
+ *            - 1 set gap failed
+ * @note      none
+ */
+uint8_t em4095_basic_set_gap(uint16_t periods);
+
+/**
+ * @brief     basic example set the timebase
+ * @param[in] timebase read and write timebase
+ * @return    status code
+ *            - 0 success
+ *            - 1 set timebase failed
+ * @note      the carrier timebase gives the diffs in clock irqs
+ */
+uint8_t em4095_basic_set_timebase(em4095_timebase_t timebase);
+
+/**
+ * @brief     basic example set the sampling phase loop
+ * @param[in] shift loop gain is 1 / 2^shift, 0 disables the loop
+ * @return    status code
+ *            - 0 success
+ *            - 1 set pll failed
+ * @note      none
+ */
+uint8_t em4095_basic_set_pll(uint8_t shift);
+
+/**
+ * @brief      basic example get the corrected samples of the last read
+ * @param[out] *corrected pointer to a corrected sample number buffer
+ * @param[out] *glitches pointer to a filtered glitch number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get corrected samples failed
+ * @note       none
+ */
+uint8_t em4095_basic_get_corrected_samples(uint16_t *corrected, uint16_t *glitches);
+
 /**
  * @}
  */
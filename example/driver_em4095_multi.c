@@ -0,0 +1,351 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_multi.c
+ * @brief     driver em4095 multi source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_em4095_multi.h"
+#include "driver_em4095_os.h"
+
+/**
+ * @brief em4095 multi reader structure definition
+ */
+typedef struct em4095_multi_reader_s
+{
+    em4095_handle_t handle;         /**< em4095 handle */
+    uint8_t *buf;                   /**< data buffer of the running read */
+    uint16_t len;                   /**< data length of the running read */
+    volatile uint8_t running;       /**< running flag */
+    volatile uint8_t done;          /**< done flag */
+} em4095_multi_reader_t;
+
+static em4095_multi_reader_t gs_reader[EM4095_MULTI_MAX_READERS];        /**< readers */
+static uint8_t gs_num;                                                   /**< reader number */
+static em4095_os_sem_t gs_sem;                                           /**< completion semaphore */
+static void (*gs_callback)(uint8_t reader, em4095_mode_t mode,
+                           em4095_decode_t *buf, uint16_t len);          /**< callback */
+
+/**
+ * @brief     interface receive callback
+ * @param[in] *ctx pointer to the interface context
+ * @param[in] mode running mode
+ * @param[in] *buf pointer to a decode buffer
+ * @param[in] len data length
+ * @note      the reader is found by its interface context
+ */
+static void a_receive_callback(void *ctx, em4095_mode_t mode, em4095_decode_t *buf, uint16_t len)
+{
+    uint8_t i;
+    uint16_t l;
+    em4095_multi_reader_t *r;
+
+    for (i = 0; i < gs_num; i++)
+    {
+        if (gs_reader[i].handle.ctx == ctx)
+        {
+            break;
+        }
+    }
+    if (i == gs_num)
+    {
+        return;
+    }
+    r = &gs_reader[i];
+    if (gs_callback != NULL)
+    {
+        gs_callback(i, mode, buf, len);
+    }
+    if ((mode == EM4095_MODE_READ) && (r->running != 0))
+    {
+        /* copy the levels and power down, the others keep reading */
+        if ((em4095_copy_decode_buffer(&r->handle, r->buf, &l) == 0) && (l == r->len))
+        {
+            r->done = 1;
+        }
+        r->running = 0;
+        (void)em4095_os_sem_give(gs_sem);
+    }
+}
+
+/**
+ * @brief     multi example irq
+ * @param[in] reader reader index
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      every reader clock line calls it with its own index,
+ *            the clock irqs of all readers must have the same priority
+ */
+uint8_t em4095_multi_irq_handler(uint8_t reader)
+{
+    if (reader >= gs_num)
+    {
+        return 1;
+    }
+    if (em4095_irq_handler(&gs_reader[reader].handle) != 0)
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     multi example init
+ * @param[in] num reader number
+ * @param[in] **ctx pointer to the interface contexts of the readers
+ * @param[in] *callback pointer to an irq callback address, it can be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      each reader is a handle and a few bytes, the decode buffer dominates,
+ *            so set EM4095_MAX_LENGTH to the longest read to fit more readers,
+ *            every reader needs its own context and a second init fails until em4095_multi_deinit
+ */
+uint8_t em4095_multi_init(uint8_t num, void *const ctx[],
+                          void (*callback)(uint8_t reader, em4095_mode_t mode, em4095_decode_t *buf, uint16_t len))
+{
+    uint8_t i;
+    uint8_t j;
+    em4095_handle_t *handle;
+
+    if ((num == 0) || (num > EM4095_MULTI_MAX_READERS) || (ctx == NULL))
+    {
+        em4095_interface_debug_print("em4095: reader number is invalid.\n");
+
+        return 1;
+    }
+    for (i = 0; i < num; i++)
+    {
+        for (j = 0; j < i; j++)
+        {
+            if (ctx[j] == ctx[i])
+            {
+                em4095_interface_debug_print("em4095: reader %d shares the context of reader %d.\n", i, j);
+
+                return 1;
+            }
+        }
+    }
+    if (gs_sem != NULL)
+    {
+        em4095_interface_debug_print("em4095: multi is already inited.\n");
+
+        return 1;
+    }
+    if (em4095_os_sem_create(&gs_sem) != 0)
+    {
+        em4095_interface_debug_print("em4095: create semaphore failed.\n");
+
+        return 1;
+    }
+    gs_num = 0;
+    gs_callback = callback;
+    for (i = 0; i < num; i++)
+    {
+        /* link interface function with the context of the reader */
+        handle = &gs_reader[i].handle;
+        DRIVER_EM4095_LINK_INIT(handle, em4095_handle_t);
+        DRIVER_EM4095_LINK_CONTEXT(handle, ctx[i]);
+        DRIVER_EM4095_LINK_SHD_GPIO_INIT(handle, em4095_interface_shd_gpio_init);
+        DRIVER_EM4095_LINK_SHD_GPIO_DEINIT(handle, em4095_interface_shd_gpio_deinit);
+        DRIVER_EM4095_LINK_SHD_GPIO_WRITE(handle, em4095_interface_shd_gpio_write);
+        DRIVER_EM4095_LINK_MOD_GPIO_INIT(handle, em4095_interface_mod_gpio_init);
+        DRIVER_EM4095_LINK_MOD_GPIO_DEINIT(handle, em4095_interface_mod_gpio_deinit);
+        DRIVER_EM4095_LINK_MOD_GPIO_WRITE(handle, em4095_interface_mod_gpio_write);
+        DRIVER_EM4095_LINK_DEMOD_GPIO_INIT(handle, em4095_interface_demod_gpio_init);
+        DRIVER_EM4095_LINK_DEMOD_GPIO_DEINIT(handle, em4095_interface_demod_gpio_deinit);
+        DRIVER_EM4095_LINK_DEMOD_GPIO_READ(handle, em4095_interface_demod_gpio_read);
+        DRIVER_EM4095_LINK_TIMESTAMP_READ(handle, em4095_interface_timestamp_read);
+        DRIVER_EM4095_LINK_DELAY_MS(handle, em4095_interface_delay_ms);
+        DRIVER_EM4095_LINK_DEBUG_PRINT(handle, em4095_interface_debug_print);
+        DRIVER_EM4095_LINK_RECEIVE_CALLBACK(handle, a_receive_callback);
+        gs_reader[i].running = 0;
+        gs_reader[i].done = 0;
+
+        /* init */
+        if (em4095_init(handle) != 0)
+        {
+            em4095_interface_debug_print("em4095: init reader %d failed.\n", i);
+            (void)em4095_multi_deinit();
+
+            return 1;
+        }
+        gs_num = i + 1;
+
+        /* set default div */
+        if (em4095_set_div(handle, EM4095_MULTI_DEFAULT_DIV) != 0)
+        {
+            em4095_interface_debug_print("em4095: set reader %d div failed.\n", i);
+            (void)em4095_multi_deinit();
+
+            return 1;
+        }
+
+        /* power down */
+        if (em4095_power_down(handle) != 0)
+        {
+            em4095_interface_debug_print("em4095: power down reader %d failed.\n", i);
+            (void)em4095_multi_deinit();
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief  multi example deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t em4095_multi_deinit(void)
+{
+    uint8_t i;
+    uint8_t res = 0;
+    uint8_t num = gs_num;
+
+    /* stop the irq routing first */
+    gs_num = 0;
+    for (i = 0; i < num; i++)
+    {
+        (void)em4095_abort(&gs_reader[i].handle);
+        if (em4095_deinit(&gs_reader[i].handle) != 0)
+        {
+            res = 1;
+        }
+    }
+    if (gs_sem != NULL)
+    {
+        (void)em4095_os_sem_delete(gs_sem);
+        gs_sem = NULL;
+    }
+    gs_callback = NULL;
+
+    return res;
+}
+
+/**
+ * @brief      multi example read all readers at once
+ * @param[out] **buf pointer to the data buffers of the readers
+ * @param[in]  len read length
+ * @param[in]  timeout_ms timeout in ms
+ * @param[out] *done pointer to a done mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       bit n of done is set when reader n filled its buffer,
+ *             the readers still running at the timeout are powered down
+ */
+uint8_t em4095_multi_read(uint8_t *const buf[], uint16_t len, uint32_t timeout_ms, uint32_t *done)
+{
+    uint8_t i;
+    uint8_t running;
+    uint64_t start;
+    uint64_t now;
+    uint64_t elapsed_ms;
+    em4095_multi_reader_t *r;
+
+    if ((gs_num == 0) || (buf == NULL) || (done == NULL) || (len == 0) || (len > EM4095_MAX_LENGTH))
+    {
+        return 1;
+    }
+    if (em4095_os_monotonic_us(&start) != 0)
+    {
+        return 1;
+    }
+
+    /* drop a stale completion */
+    (void)em4095_os_sem_take(gs_sem, 0);
+
+    /* start every reader */
+    for (i = 0; i < gs_num; i++)
+    {
+        r = &gs_reader[i];
+        r->buf = buf[i];
+        r->len = len;
+        r->done = 0;
+        r->running = 1;
+        if ((em4095_read(&r->handle, len) != 0) || (em4095_power_on(&r->handle) != 0))
+        {
+            em4095_interface_debug_print("em4095: start reader %d failed.\n", i);
+            (void)em4095_abort(&r->handle);
+            r->running = 0;
+        }
+    }
+
+    /* sleep until every reader is done or the time is up */
+    while (1)
+    {
+        running = 0;
+        for (i = 0; i < gs_num; i++)
+        {
+            running += gs_reader[i].running;
+        }
+        if (running == 0)
+        {
+            break;
+        }
+        if (em4095_os_monotonic_us(&now) != 0)
+        {
+            break;
+        }
+        elapsed_ms = (now - start) / 1000;
+        if (elapsed_ms >= timeout_ms)
+        {
+            break;
+        }
+        (void)em4095_os_sem_take(gs_sem, timeout_ms - (uint32_t)elapsed_ms);
+    }
+
+    /* power down the late readers */
+    *done = 0;
+    for (i = 0; i < gs_num; i++)
+    {
+        r = &gs_reader[i];
+        if (r->running != 0)
+        {
+            (void)em4095_abort(&r->handle);
+            r->running = 0;
+        }
+        if (r->done != 0)
+        {
+            *done |= (1UL << i);
+        }
+    }
+
+    return 0;
+}
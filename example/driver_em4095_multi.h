@@ -0,0 +1,120 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_multi.h
+ * @brief     driver em4095 multi header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_EM4095_MULTI_H
+#define DRIVER_EM4095_MULTI_H
+
+#include "driver_em4095_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup em4095_example_driver
+ * @{
+ */
+
+/**
+ * @brief em4095 multi example default definition
+ */
+#define EM4095_MULTI_DEFAULT_DIV    64        /**< div 64 */
+
+/**
+ * @brief em4095 multi example max readers definition
+ */
+#ifndef EM4095_MULTI_MAX_READERS
+    #define EM4095_MULTI_MAX_READERS    4        /**< 4 readers */
+#endif
+
+/**
+ * @brief     multi example irq
+ * @param[in] reader reader index
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      every reader clock line calls it with its own index,
+ *            the clock irqs of all readers must have the same priority
+ */
+uint8_t em4095_multi_irq_handler(uint8_t reader);
+
+/**
+ * @brief     multi example init
+ * @param[in] num reader number
+ * @param[in] **ctx pointer to the interface contexts of the readers
+ * @param[in] *callback pointer to an irq callback address, it can be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      each reader is a handle and a few bytes, the decode buffer dominates,
+ *            so set EM4095_MAX_LENGTH to the longest read to fit more readers,
+ *            every reader needs its own context and a second init fails until em4095_multi_deinit
+ */
+uint8_t em4095_multi_init(uint8_t num, void *const ctx[],
+                          void (*callback)(uint8_t reader, em4095_mode_t mode, em4095_decode_t *buf, uint16_t len));
+
+/**
+ * @brief  multi example deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t em4095_multi_deinit(void);
+
+/**
+ * @brief      multi example read all readers at once
+ * @param[out] **buf pointer to the data buffers of the readers
+ * @param[in]  len read length
+ * @param[in]  timeout_ms timeout in ms
+ * @param[out] *done pointer to a done mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       bit n of done is set when reader n filled its buffer,
+ *             the readers still running at the timeout are powered down
+ */
+uint8_t em4095_multi_read(uint8_t *const buf[], uint16_t len, uint32_t timeout_ms, uint32_t *done);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,231 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_presence.c
+ * @brief     driver em4095 presence source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_em4095_presence.h"
+
+static em4095_presence_config_t gs_config;        /**< presence config */
+static uint32_t gs_baseline;                      /**< baseline edges in q4 */
+static uint32_t gs_deviation;                     /**< mean deviation in q4 */
+static uint8_t gs_calibrated;                     /**< calibrated flag */
+
+/**
+ * @brief     presence update the baseline
+ * @param[in] edges sensed edges
+ * @note      1/8 exponential moving average of the edges and of their deviation
+ */
+static void a_presence_update(uint16_t edges)
+{
+    uint32_t e;
+    uint32_t d;
+
+    e = (uint32_t)edges << 4;
+    if (gs_calibrated == 0)
+    {
+        gs_baseline = e;
+        gs_deviation = 0;
+        gs_calibrated = 1;
+
+        return;
+    }
+    d = (e > gs_baseline) ? (e - gs_baseline) : (gs_baseline - e);
+    gs_baseline = gs_baseline - (gs_baseline >> 3) + (e >> 3);
+    gs_deviation = gs_deviation - (gs_deviation >> 3) + (d >> 3);
+}
+
+/**
+ * @brief     presence example init
+ * @param[in] *config pointer to a presence config structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      em4095_basic_init must be called before, NULL uses the default config
+ */
+uint8_t em4095_presence_init(const em4095_presence_config_t *config)
+{
+    if (config != NULL)
+    {
+        if (config->window == 0)
+        {
+            return 1;
+        }
+        gs_config = *config;
+    }
+    else
+    {
+        gs_config.settle = EM4095_PRESENCE_DEFAULT_SETTLE;
+        gs_config.window = EM4095_PRESENCE_DEFAULT_WINDOW;
+        gs_config.period_ms = EM4095_PRESENCE_DEFAULT_PERIOD_MS;
+        gs_config.margin = EM4095_PRESENCE_DEFAULT_MARGIN;
+    }
+    gs_baseline = 0;
+    gs_deviation = 0;
+    gs_calibrated = 0;
+
+    return 0;
+}
+
+/**
+ * @brief     presence example calibrate the baseline
+ * @param[in] times sense times
+ * @return    status code
+ *            - 0 success
+ *            - 1 calibrate failed
+ * @note      no tag should be in the field
+ */
+uint8_t em4095_presence_calibrate(uint16_t times)
+{
+    uint16_t i;
+    uint16_t edges;
+
+    /* restart the baseline */
+    gs_calibrated = 0;
+    for (i = 0; i < times; i++)
+    {
+        if (em4095_basic_sense(gs_config.settle, gs_config.window, &edges) != 0)
+        {
+            return 1;
+        }
+        a_presence_update(edges);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      presence example check the field once
+ * @param[out] *present pointer to a present flag buffer
+ * @param[out] *edges pointer to an edge number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 check failed
+ * @note       the baseline follows the windows without a tag
+ */
+uint8_t em4095_presence_check(uint8_t *present, uint16_t *edges)
+{
+    uint32_t margin;
+    uint32_t threshold;
+
+    /* sense the field */
+    if (em4095_basic_sense(gs_config.settle, gs_config.window, edges) != 0)
+    {
+        return 1;
+    }
+    if (gs_calibrated == 0)
+    {
+        /* the first window is the baseline */
+        a_presence_update(*edges);
+        *present = 0;
+
+        return 0;
+    }
+
+    /* over the noise by the larger of 4 deviations and the margin */
+    margin = (uint32_t)gs_config.margin << 4;
+    threshold = gs_baseline + ((gs_deviation * 4 > margin) ? (gs_deviation * 4) : margin);
+    if (((uint32_t)*edges << 4) > threshold)
+    {
+        *present = 1;
+    }
+    else
+    {
+        *present = 0;
+        a_presence_update(*edges);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      presence example get the baseline
+ * @param[out] *baseline pointer to a baseline edge buffer
+ * @param[out] *deviation pointer to a deviation edge buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get baseline failed
+ * @note       none
+ */
+uint8_t em4095_presence_get_baseline(uint16_t *baseline, uint16_t *deviation)
+{
+    if (gs_calibrated == 0)
+    {
+        return 1;
+    }
+    *baseline = (uint16_t)((gs_baseline + 8) >> 4);
+    *deviation = (uint16_t)((gs_deviation + 8) >> 4);
+
+    return 0;
+}
+
+/**
+ * @brief      presence example wait for a tag and read it
+ * @param[in]  polls max sense times
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len read length
+ * @param[out] *found pointer to a found flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the field is sensed once a period and a full read only starts when a tag is likely present
+ */
+uint8_t em4095_presence_read(uint32_t polls, uint8_t *buf, uint16_t len, uint8_t *found)
+{
+    uint32_t i;
+    uint8_t present;
+    uint16_t edges;
+
+    *found = 0;
+    for (i = 0; i < polls; i++)
+    {
+        /* sense the field */
+        if (em4095_presence_check(&present, &edges) != 0)
+        {
+            return 1;
+        }
+
+        /* a false trigger only costs one read */
+        if ((present != 0) && (em4095_basic_read(buf, len) == 0))
+        {
+            *found = 1;
+
+            return 0;
+        }
+
+        /* sleep with the field off */
+        em4095_interface_delay_ms(gs_config.period_ms);
+    }
+
+    return 0;
+}
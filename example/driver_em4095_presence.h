@@ -0,0 +1,133 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_presence.h
+ * @brief     driver em4095 presence header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_EM4095_PRESENCE_H
+#define DRIVER_EM4095_PRESENCE_H
+
+#include "driver_em4095_basic.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup em4095_example_driver
+ * @{
+ */
+
+/**
+ * @brief em4095 presence example default definition
+ */
+#define EM4095_PRESENCE_DEFAULT_SETTLE        512        /**< 512 clock irqs */
+#define EM4095_PRESENCE_DEFAULT_WINDOW        2048       /**< 2048 clock irqs */
+#define EM4095_PRESENCE_DEFAULT_PERIOD_MS     200        /**< 200ms */
+#define EM4095_PRESENCE_DEFAULT_MARGIN        4          /**< 4 edges */
+
+/**
+ * @brief em4095 presence config structure definition
+ */
+typedef struct em4095_presence_config_s
+{
+    uint16_t settle;           /**< ignored clock irqs after the power on */
+    uint16_t window;           /**< counted clock irqs */
+    uint32_t period_ms;        /**< sense period */
+    uint16_t margin;           /**< min edges over the baseline */
+} em4095_presence_config_t;
+
+/**
+ * @brief     presence example init
+ * @param[in] *config pointer to a presence config structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      em4095_basic_init must be called before, NULL uses the default config
+ */
+uint8_t em4095_presence_init(const em4095_presence_config_t *config);
+
+/**
+ * @brief     presence example calibrate the baseline
+ * @param[in] times sense times
+ * @return    status code
+ *            - 0 success
+ *            - 1 calibrate failed
+ * @note      no tag should be in the field
+ */
+uint8_t em4095_presence_calibrate(uint16_t times);
+
+/**
+ * @brief      presence example check the field once
+ * @param[out] *present pointer to a present flag buffer
+ * @param[out] *edges pointer to an edge number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 check failed
+ * @note       the baseline follows the windows without a tag
+ */
+uint8_t em4095_presence_check(uint8_t *present, uint16_t *edges);
+
+/**
+ * @brief      presence example get the baseline
+ * @param[out] *baseline pointer to a baseline edge buffer
+ * @param[out] *deviation pointer to a deviation edge buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get baseline failed
+ * @note       none
+ */
+uint8_t em4095_presence_get_baseline(uint16_t *baseline, uint16_t *deviation);
+
+/**
+ * @brief      presence example wait for a tag and read it
+ * @param[in]  polls max sense times
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len read length
+ * @param[out] *found pointer to a found flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the field is sensed once a period and a full read only starts when a tag is likely present
+ */
+uint8_t em4095_presence_read(uint32_t polls, uint8_t *buf, uint16_t len, uint8_t *found);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
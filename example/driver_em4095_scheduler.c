@@ -0,0 +1,456 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_scheduler.c
+ * @brief     driver em4095 scheduler source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_em4095_scheduler.h"
+#include "driver_em4095_slicer.h"
+#include "driver_em4095_os.h"
+
+/**
+ * @brief scheduler activity definition
+ */
+#define EM4095_SCHEDULER_ACTIVITY_HIT    255        /**< activity after a decoded id */
+
+static em4095_handle_t gs_handle;                                                       /**< em4095 handle */
+static em4095_scheduler_config_t gs_config;                                             /**< scheduler config */
+static em4095_scheduler_stats_t gs_stats[EM4095_SCHEDULER_MAX_ANTENNAS];                /**< antenna statistics */
+static void (*gs_callback)(uint8_t antenna, const em4095_em4100_id_t *id) = NULL;       /**< id callback */
+static em4095_os_sem_t gs_sem;                                                          /**< visit done semaphore */
+static em4095_slicer_t gs_slicer;                                                       /**< bit slicer */
+static em4095_em4100_t gs_em4100;                                                       /**< em4100 decoder */
+static em4095_em4100_id_t gs_id;                                                        /**< decoded id */
+static volatile uint8_t gs_decoded;                                                     /**< decoded flag */
+static volatile uint8_t gs_visiting;                                                    /**< visit running flag */
+static uint8_t gs_first;                                                                /**< first sample of the visit */
+static uint32_t gs_dwell_us;                                                            /**< dwell of the visit */
+static volatile uint32_t gs_elapsed_us;                                                 /**< elapsed time of the visit */
+
+/**
+ * @brief  finish the visit in the irq
+ * @note   none
+ */
+static void a_visit_finish(void)
+{
+    (void)em4095_abort(&gs_handle);
+    gs_visiting = 0;
+    (void)em4095_os_sem_give(gs_sem);
+}
+
+/**
+ * @brief     scheduler sample callback
+ * @param[in] *ctx pointer to the interface context
+ * @param[in] index sample index
+ * @param[in] level sampled level
+ * @param[in] diff_us time from the previous sample
+ * @note      the samples of the settling time are dropped, the visit ends at the first id
+ */
+static void a_sample_callback(void *ctx, uint16_t index, uint8_t level, uint32_t diff_us)
+{
+    uint8_t i;
+    uint8_t count;
+    em4095_slicer_bit_t bit[EM4095_SLICER_MAX_BITS];
+
+    (void)ctx;
+    (void)index;
+
+    if (gs_visiting == 0)
+    {
+        return;
+    }
+
+    /* the first diff is from the last visit */
+    if (gs_first != 0)
+    {
+        gs_first = 0;
+        diff_us = 0;
+    }
+    gs_elapsed_us += diff_us;
+    if (gs_elapsed_us < gs_config.settle_us)
+    {
+        return;
+    }
+    (void)em4095_slicer_push_sample(&gs_slicer, level, diff_us, bit, &count);
+    for (i = 0; i < count; i++)
+    {
+        if (em4095_em4100_push_bit(&gs_em4100, bit[i].bit, &gs_id) == 0)
+        {
+            gs_decoded = 1;
+            a_visit_finish();
+
+            return;
+        }
+    }
+    if (gs_elapsed_us >= gs_config.settle_us + gs_dwell_us)
+    {
+        a_visit_finish();
+    }
+}
+
+/**
+ * @brief     scheduler event callback
+ * @param[in] *ctx pointer to the interface context
+ * @param[in] event frame boundary event
+ * @param[in] *buf pointer to the samples before the boundary
+ * @param[in] len data length
+ * @note      a gap restarts the decoders, an overflow keeps them
+ */
+static void a_event_callback(void *ctx, em4095_event_t event, em4095_decode_t *buf, uint16_t len)
+{
+    (void)ctx;
+    (void)buf;
+    (void)len;
+
+    if (event == EM4095_EVENT_GAP)
+    {
+        (void)em4095_slicer_reset(&gs_slicer);
+        (void)em4095_em4100_init(&gs_em4100);
+    }
+}
+
+/**
+ * @brief     scheduler receive callback
+ * @param[in] *ctx pointer to the interface context
+ * @param[in] mode running mode
+ * @param[in] *buf pointer to a decode buffer
+ * @param[in] len data length
+ * @note      the streaming read never completes, the visit is ended by the sample callback
+ */
+static void a_receive_callback(void *ctx, em4095_mode_t mode, em4095_decode_t *buf, uint16_t len)
+{
+    (void)ctx;
+    (void)mode;
+    (void)buf;
+    (void)len;
+}
+
+/**
+ * @brief     get the dwell of an antenna
+ * @param[in] antenna antenna index
+ * @return    dwell in us
+ * @note      an idle antenna only probes for a new tag, an active one gets the time of a sure read
+ */
+static uint32_t a_dwell(uint8_t antenna)
+{
+    uint32_t span;
+
+    span = gs_config.max_dwell_us - gs_config.min_dwell_us;
+
+    return gs_config.min_dwell_us + (uint32_t)(((uint64_t)span * gs_stats[antenna].activity) / 255);
+}
+
+/**
+ * @brief     visit one antenna
+ * @param[in] antenna antenna index
+ * @return    status code
+ *            - 0 success
+ *            - 1 visit failed
+ * @note      none
+ */
+static uint8_t a_visit(uint8_t antenna)
+{
+    uint32_t timeout_ms;
+    em4095_scheduler_stats_t *s = &gs_stats[antenna];
+
+    /* switch the coil with the field off */
+    if (em4095_power_down(&gs_handle) != 0)
+    {
+        return 1;
+    }
+    if (em4095_interface_antenna_select(gs_handle.ctx, antenna) != 0)
+    {
+        em4095_interface_debug_print("em4095: select antenna %d failed.\n", antenna);
+
+        return 1;
+    }
+
+    /* restart the decoders */
+    (void)em4095_slicer_reset(&gs_slicer);
+    (void)em4095_em4100_init(&gs_em4100);
+    (void)em4095_os_sem_take(gs_sem, 0);
+    gs_decoded = 0;
+    gs_first = 1;
+    gs_elapsed_us = 0;
+    gs_dwell_us = a_dwell(antenna);
+    gs_visiting = 1;
+
+    /* stream until the sample callback ends the visit */
+    if ((em4095_read(&gs_handle, EM4095_MAX_LENGTH) != 0) || (em4095_power_on(&gs_handle) != 0))
+    {
+        (void)em4095_abort(&gs_handle);
+        gs_visiting = 0;
+
+        return 1;
+    }
+    timeout_ms = (gs_config.settle_us + gs_dwell_us) / 1000 + 100;
+    if (em4095_os_sem_take(gs_sem, timeout_ms) != 0)
+    {
+        /* no clock, the field is probably dead */
+        (void)em4095_abort(&gs_handle);
+        gs_visiting = 0;
+    }
+
+    /* adapt the dwell to the recent activity */
+    s->dwells++;
+    s->busy_us += gs_elapsed_us;
+    if (gs_decoded != 0)
+    {
+        s->reads++;
+        s->activity = EM4095_SCHEDULER_ACTIVITY_HIT;
+        if (gs_callback != NULL)
+        {
+            gs_callback(antenna, &gs_id);
+        }
+    }
+    else
+    {
+        s->activity = (uint8_t)(s->activity / 2);
+    }
+    s->dwell_us = a_dwell(antenna);
+
+    return 0;
+}
+
+/**
+ * @brief  scheduler example irq
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   none
+ */
+uint8_t em4095_scheduler_irq_handler(void)
+{
+    if (em4095_irq_handler(&gs_handle) != 0)
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     scheduler example init
+ * @param[in] *ctx pointer to the interface context of the em4095
+ * @param[in] *config pointer to a scheduler config structure
+ * @param[in] *callback pointer to an id callback, it can be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      NULL config uses the default config with 2 antennas, the callback runs in the caller
+ *            of em4095_scheduler_run
+ */
+uint8_t em4095_scheduler_init(void *ctx, const em4095_scheduler_config_t *config,
+                              void (*callback)(uint8_t antenna, const em4095_em4100_id_t *id))
+{
+    uint8_t i;
+
+    /* check the config */
+    if (config != NULL)
+    {
+        if ((config->antennas == 0) || (config->antennas > EM4095_SCHEDULER_MAX_ANTENNAS) ||
+            (config->min_dwell_us == 0) || (config->max_dwell_us < config->min_dwell_us) ||
+            (config->half_us == 0))
+        {
+            em4095_interface_debug_print("em4095: scheduler config is invalid.\n");
+
+            return 1;
+        }
+        gs_config = *config;
+    }
+    else
+    {
+        gs_config.antennas = 2;
+        gs_config.settle_us = EM4095_SCHEDULER_DEFAULT_SETTLE_US;
+        gs_config.min_dwell_us = EM4095_SCHEDULER_DEFAULT_MIN_DWELL_US;
+        gs_config.max_dwell_us = EM4095_SCHEDULER_DEFAULT_MAX_DWELL_US;
+        gs_config.half_us = EM4095_SCHEDULER_DEFAULT_HALF_US;
+    }
+    for (i = 0; i < EM4095_SCHEDULER_MAX_ANTENNAS; i++)
+    {
+        gs_stats[i].dwells = 0;
+        gs_stats[i].reads = 0;
+        gs_stats[i].busy_us = 0;
+        gs_stats[i].activity = 0;
+        gs_stats[i].dwell_us = gs_config.min_dwell_us;
+    }
+    gs_callback = callback;
+    gs_visiting = 0;
+
+    /* link interface function */
+    DRIVER_EM4095_LINK_INIT(&gs_handle, em4095_handle_t);
+    DRIVER_EM4095_LINK_CONTEXT(&gs_handle, ctx);
+    DRIVER_EM4095_LINK_SHD_GPIO_INIT(&gs_handle, em4095_interface_shd_gpio_init);
+    DRIVER_EM4095_LINK_SHD_GPIO_DEINIT(&gs_handle, em4095_interface_shd_gpio_deinit);
+    DRIVER_EM4095_LINK_SHD_GPIO_WRITE(&gs_handle, em4095_interface_shd_gpio_write);
+    DRIVER_EM4095_LINK_MOD_GPIO_INIT(&gs_handle, em4095_interface_mod_gpio_init);
+    DRIVER_EM4095_LINK_MOD_GPIO_DEINIT(&gs_handle, em4095_interface_mod_gpio_deinit);
+    DRIVER_EM4095_LINK_MOD_GPIO_WRITE(&gs_handle, em4095_interface_mod_gpio_write);
+    DRIVER_EM4095_LINK_DEMOD_GPIO_INIT(&gs_handle, em4095_interface_demod_gpio_init);
+    DRIVER_EM4095_LINK_DEMOD_GPIO_DEINIT(&gs_handle, em4095_interface_demod_gpio_deinit);
+    DRIVER_EM4095_LINK_DEMOD_GPIO_READ(&gs_handle, em4095_interface_demod_gpio_read);
+    DRIVER_EM4095_LINK_TIMESTAMP_READ(&gs_handle, em4095_interface_timestamp_read);
+    DRIVER_EM4095_LINK_DELAY_MS(&gs_handle, em4095_interface_delay_ms);
+    DRIVER_EM4095_LINK_DEBUG_PRINT(&gs_handle, em4095_interface_debug_print);
+    DRIVER_EM4095_LINK_RECEIVE_CALLBACK(&gs_handle, a_receive_callback);
+    DRIVER_EM4095_LINK_SAMPLE_CALLBACK(&gs_handle, a_sample_callback);
+    DRIVER_EM4095_LINK_EVENT_CALLBACK(&gs_handle, a_event_callback);
+
+    /* decoders */
+    if ((em4095_slicer_init(&gs_slicer, EM4095_SLICER_CODING_MANCHESTER, gs_config.half_us) != 0) ||
+        (em4095_em4100_init(&gs_em4100) != 0))
+    {
+        em4095_interface_debug_print("em4095: decoder init failed.\n");
+
+        return 1;
+    }
+    if (em4095_os_sem_create(&gs_sem) != 0)
+    {
+        em4095_interface_debug_print("em4095: create semaphore failed.\n");
+
+        return 1;
+    }
+
+    /* init */
+    if (em4095_init(&gs_handle) != 0)
+    {
+        em4095_interface_debug_print("em4095: init failed.\n");
+        (void)em4095_os_sem_delete(gs_sem);
+        gs_sem = NULL;
+
+        return 1;
+    }
+
+    /* set default div */
+    if (em4095_set_div(&gs_handle, EM4095_SCHEDULER_DEFAULT_DIV) != 0)
+    {
+        em4095_interface_debug_print("em4095: set div failed.\n");
+        (void)em4095_scheduler_deinit();
+
+        return 1;
+    }
+
+    /* power down */
+    if (em4095_power_down(&gs_handle) != 0)
+    {
+        em4095_interface_debug_print("em4095: power down failed.\n");
+        (void)em4095_scheduler_deinit();
+
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief  scheduler example deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t em4095_scheduler_deinit(void)
+{
+    uint8_t res = 0;
+
+    (void)em4095_abort(&gs_handle);
+    gs_visiting = 0;
+    if (em4095_deinit(&gs_handle) != 0)
+    {
+        res = 1;
+    }
+    if (gs_sem != NULL)
+    {
+        (void)em4095_os_sem_delete(gs_sem);
+        gs_sem = NULL;
+    }
+    gs_callback = NULL;
+
+    return res;
+}
+
+/**
+ * @brief     scheduler example run
+ * @param[in] cycles round robin cycles
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      every cycle visits each antenna once, so none of them starves. a visit ends at the
+ *            first decoded id or after the dwell, which grows with the recent tag activity
+ */
+uint8_t em4095_scheduler_run(uint32_t cycles)
+{
+    uint8_t i;
+    uint32_t c;
+
+    for (c = 0; c < cycles; c++)
+    {
+        for (i = 0; i < gs_config.antennas; i++)
+        {
+            if (a_visit(i) != 0)
+            {
+                (void)em4095_power_down(&gs_handle);
+
+                return 1;
+            }
+        }
+    }
+
+    /* leave the field off */
+    if (em4095_power_down(&gs_handle) != 0)
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      scheduler example get the antenna statistics
+ * @param[in]  antenna antenna index
+ * @param[out] *stats pointer to a statistics buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       none
+ */
+uint8_t em4095_scheduler_get_stats(uint8_t antenna, em4095_scheduler_stats_t *stats)
+{
+    if ((antenna >= gs_config.antennas) || (stats == NULL))
+    {
+        return 1;
+    }
+    *stats = gs_stats[antenna];
+
+    return 0;
+}
@@ -0,0 +1,155 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_scheduler.h
+ * @brief     driver em4095 scheduler header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_EM4095_SCHEDULER_H
+#define DRIVER_EM4095_SCHEDULER_H
+
+#include "driver_em4095_interface.h"
+#include "driver_em4095_em4100.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup em4095_example_driver
+ * @{
+ */
+
+/**
+ * @brief em4095 scheduler example default definition
+ */
+#define EM4095_SCHEDULER_DEFAULT_DIV             16           /**< div 16, 8 samples per rf/64 bit */
+#define EM4095_SCHEDULER_DEFAULT_HALF_US         256          /**< rf/64 half bit */
+#define EM4095_SCHEDULER_DEFAULT_SETTLE_US       3000         /**< 3ms field settling */
+#define EM4095_SCHEDULER_DEFAULT_FRAME_US       32768        /**< one em4100 frame, 64 bits of 512us */
+#define EM4095_SCHEDULER_DEFAULT_MIN_DWELL_US    49152        /**< 1.5 frames, half of the frame phases fit */
+#define EM4095_SCHEDULER_DEFAULT_MAX_DWELL_US    73728        /**< 2.25 frames, a full frame always fits after the lock */
+
+/**
+ * @brief em4095 scheduler example max antennas definition
+ */
+#ifndef EM4095_SCHEDULER_MAX_ANTENNAS
+    #define EM4095_SCHEDULER_MAX_ANTENNAS    4        /**< 4 antennas */
+#endif
+
+/**
+ * @brief em4095 scheduler config structure definition
+ */
+typedef struct em4095_scheduler_config_s
+{
+    uint8_t antennas;             /**< antenna number */
+    uint32_t settle_us;           /**< ignored time after the field is switched on */
+    uint32_t min_dwell_us;        /**< decode time of an idle antenna */
+    uint32_t max_dwell_us;        /**< decode time of an active antenna */
+    uint32_t half_us;             /**< nominal half bit period */
+} em4095_scheduler_config_t;
+
+/**
+ * @brief em4095 scheduler antenna statistics structure definition
+ */
+typedef struct em4095_scheduler_stats_s
+{
+    uint32_t dwells;              /**< visits */
+    uint32_t reads;               /**< decoded ids */
+    uint32_t busy_us;             /**< total decode time */
+    uint8_t activity;             /**< recent tag activity, 255 is a tag in the last visit */
+    uint32_t dwell_us;            /**< dwell of the next visit */
+} em4095_scheduler_stats_t;
+
+/**
+ * @brief  scheduler example irq
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   none
+ */
+uint8_t em4095_scheduler_irq_handler(void);
+
+/**
+ * @brief     scheduler example init
+ * @param[in] *ctx pointer to the interface context of the em4095
+ * @param[in] *config pointer to a scheduler config structure
+ * @param[in] *callback pointer to an id callback, it can be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      NULL config uses the default config with 2 antennas, the callback runs in the caller
+ *            of em4095_scheduler_run
+ */
+uint8_t em4095_scheduler_init(void *ctx, const em4095_scheduler_config_t *config,
+                              void (*callback)(uint8_t antenna, const em4095_em4100_id_t *id));
+
+/**
+ * @brief  scheduler example deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t em4095_scheduler_deinit(void);
+
+/**
+ * @brief     scheduler example run
+ * @param[in] cycles round robin cycles
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      every cycle visits each antenna once, so none of them starves. a visit ends at the
+ *            first decoded id or after the dwell, which grows with the recent tag activity
+ */
+uint8_t em4095_scheduler_run(uint32_t cycles);
+
+/**
+ * @brief      scheduler example get the antenna statistics
+ * @param[in]  antenna antenna index
+ * @param[out] *stats pointer to a statistics buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       none
+ */
+uint8_t em4095_scheduler_get_stats(uint8_t antenna, em4095_scheduler_stats_t *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -37,112 +37,135 @@
 #include "driver_em4095_interface.h"
 
 /**
- * @brief  interface shd gpio init
- * @return status code
- *         - 0 success
- *         - 1 init failed
- * @note   none
+ * @brief     interface shd gpio init
+ * @param[in] *ctx pointer to the interface context
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
  */
-uint8_t em4095_interface_shd_gpio_init(void)
+uint8_t em4095_interface_shd_gpio_init(void *ctx)
 {
     return 0;
 }
 
 /**
- * @brief  interface shd gpio deinit
- * @return status code
- *         - 0 success
- *         - 1 deinit failed
- * @note   none
+ * @brief     interface shd gpio deinit
+ * @param[in] *ctx pointer to the interface context
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
  */
-uint8_t em4095_interface_shd_gpio_deinit(void)
+uint8_t em4095_interface_shd_gpio_deinit(void *ctx)
 {
     return 0;
 }
 
 /**
  * @brief     interface shd gpio write
+ * @param[in] *ctx pointer to the interface context
  * @param[in] data set level
  * @return    status code
  *            - 0 success
  *            - 1 write failed
  * @note      none
  */
-uint8_t em4095_interface_shd_gpio_write(uint8_t data)
+uint8_t em4095_interface_shd_gpio_write(void *ctx, uint8_t data)
 {
     return 0;
 }
 
 /**
- * @brief  interface mod gpio init
- * @return status code
- *         - 0 success
- *         - 1 init failed
- * @note   none
+ * @brief     interface mod gpio init
+ * @param[in] *ctx pointer to the interface context
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
  */
-uint8_t em4095_interface_mod_gpio_init(void)
+uint8_t em4095_interface_mod_gpio_init(void *ctx)
 {
     return 0;
 }
 
 /**
- * @brief  interface mod gpio deinit
- * @return status code
- *         - 0 success
- *         - 1 deinit failed
- * @note   none
+ * @brief     interface mod gpio deinit
+ * @param[in] *ctx pointer to the interface context
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
  */
-uint8_t em4095_interface_mod_gpio_deinit(void)
+uint8_t em4095_interface_mod_gpio_deinit(void *ctx)
 {
     return 0;
 }
 
 /**
  * @brief     interface mod gpio write
+ * @param[in] *ctx pointer to the interface context
  * @param[in] data set level
  * @return    status code
  *            - 0 success
  *            - 1 write failed
  * @note      none
  */
-uint8_t em4095_interface_mod_gpio_write(uint8_t data)
+uint8_t em4095_interface_mod_gpio_write(void *ctx, uint8_t data)
 {
     return 0;
 }
 
 /**
- * @brief  interface demod gpio init
- * @return status code
- *         - 0 success
- *         - 1 init failed
- * @note   none
+ * @brief     interface demod gpio init
+ * @param[in] *ctx pointer to the interface context
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
  */
-uint8_t em4095_interface_demod_gpio_init(void)
+uint8_t em4095_interface_demod_gpio_init(void *ctx)
 {
     return 0;
 }
 
 /**
- * @brief  interface demod gpio deinit
- * @return status code
- *         - 0 success
- *         - 1 deinit failed
- * @note   none
+ * @brief     interface demod gpio deinit
+ * @param[in] *ctx pointer to the interface context
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
  */
-uint8_t em4095_interface_demod_gpio_deinit(void)
+uint8_t em4095_interface_demod_gpio_deinit(void *ctx)
 {
     return 0;
 }
 
 /**
  * @brief      interface demod gpio read
+ * @param[in]  *ctx pointer to the interface context
  * @param[out] *data pointer to a data level buffer
  * @return     status code
  *             - 0 success
  *             - 1 read failed
  * @note       none
  */
-uint8_t em4095_interface_demod_gpio_read(uint8_t *data)
+uint8_t em4095_interface_demod_gpio_read(void *ctx, uint8_t *data)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface antenna select
+ * @param[in] *ctx pointer to the interface context
+ * @param[in] antenna antenna index
+ * @return    status code
+ *            - 0 success
+ *            - 1 select failed
+ * @note      it drives the analog mux between the coils of one em4095, only the scheduler example uses it
+ */
+uint8_t em4095_interface_antenna_select(void *ctx, uint8_t antenna)
 {
     return 0;
 }
@@ -182,12 +205,13 @@ void em4095_interface_debug_print(const char *const fmt, ...)
 
 /**
  * @brief     interface receive callback
+ * @param[in] *ctx pointer to the interface context
  * @param[in] mode running mode
  * @param[in] *buf pointer to a decode buffer
  * @param[in] len data length
  * @note      none
  */
-void em4095_interface_receive_callback(em4095_mode_t mode, em4095_decode_t *buf, uint16_t len)
+void em4095_interface_receive_callback(void *ctx, em4095_mode_t mode, em4095_decode_t *buf, uint16_t len)
 {
     switch (mode)
     {
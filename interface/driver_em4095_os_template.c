@@ -0,0 +1,212 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_os_template.c
+ * @brief     driver em4095 os template source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_em4095_os.h"
+
+/**
+ * @brief      os create a binary semaphore
+ * @param[out] *sem pointer to a semaphore buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 create failed
+ * @note       it is created empty
+ */
+uint8_t em4095_os_sem_create(em4095_os_sem_t *sem)
+{
+    return 0;
+}
+
+/**
+ * @brief     os delete a binary semaphore
+ * @param[in] sem semaphore
+ * @return    status code
+ *            - 0 success
+ *            - 1 delete failed
+ * @note      none
+ */
+uint8_t em4095_os_sem_delete(em4095_os_sem_t sem)
+{
+    return 0;
+}
+
+/**
+ * @brief     os give a binary semaphore
+ * @param[in] sem semaphore
+ * @return    status code
+ *            - 0 success
+ *            - 1 give failed
+ * @note      it can be called in the irq
+ */
+uint8_t em4095_os_sem_give(em4095_os_sem_t sem)
+{
+    return 0;
+}
+
+/**
+ * @brief     os take a binary semaphore
+ * @param[in] sem semaphore
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout
+ * @note      EM4095_OS_WAIT_FOREVER waits without a timeout
+ */
+uint8_t em4095_os_sem_take(em4095_os_sem_t sem, uint32_t timeout_ms)
+{
+    return 0;
+}
+
+/**
+ * @brief      os create a mutex
+ * @param[out] *mutex pointer to a mutex buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 create failed
+ * @note       none
+ */
+uint8_t em4095_os_mutex_create(em4095_os_mutex_t *mutex)
+{
+    return 0;
+}
+
+/**
+ * @brief     os delete a mutex
+ * @param[in] mutex mutex
+ * @return    status code
+ *            - 0 success
+ *            - 1 delete failed
+ * @note      none
+ */
+uint8_t em4095_os_mutex_delete(em4095_os_mutex_t mutex)
+{
+    return 0;
+}
+
+/**
+ * @brief     os lock a mutex
+ * @param[in] mutex mutex
+ * @return    status code
+ *            - 0 success
+ *            - 1 lock failed
+ * @note      it can't be called in the irq
+ */
+uint8_t em4095_os_mutex_lock(em4095_os_mutex_t mutex)
+{
+    return 0;
+}
+
+/**
+ * @brief     os unlock a mutex
+ * @param[in] mutex mutex
+ * @return    status code
+ *            - 0 success
+ *            - 1 unlock failed
+ * @note      none
+ */
+uint8_t em4095_os_mutex_unlock(em4095_os_mutex_t mutex)
+{
+    return 0;
+}
+
+/**
+ * @brief      os create a message queue
+ * @param[out] *queue pointer to a queue buffer
+ * @param[in]  item_size item size in bytes
+ * @param[in]  depth max items
+ * @return     status code
+ *             - 0 success
+ *             - 1 create failed
+ * @note       none
+ */
+uint8_t em4095_os_queue_create(em4095_os_queue_t *queue, uint16_t item_size, uint16_t depth)
+{
+    return 0;
+}
+
+/**
+ * @brief     os delete a message queue
+ * @param[in] queue queue
+ * @return    status code
+ *            - 0 success
+ *            - 1 delete failed
+ * @note      none
+ */
+uint8_t em4095_os_queue_delete(em4095_os_queue_t queue)
+{
+    return 0;
+}
+
+/**
+ * @brief     os send an item to a message queue
+ * @param[in] queue queue
+ * @param[in] *item pointer to an item
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ * @note      it never blocks and can be called in the irq
+ */
+uint8_t em4095_os_queue_send(em4095_os_queue_t queue, const void *item)
+{
+    return 0;
+}
+
+/**
+ * @brief      os receive an item from a message queue
+ * @param[in]  queue queue
+ * @param[out] *item pointer to an item buffer
+ * @param[in]  timeout_ms timeout in ms
+ * @return     status code
+ *             - 0 success
+ *             - 1 timeout
+ * @note       EM4095_OS_WAIT_FOREVER waits without a timeout
+ */
+uint8_t em4095_os_queue_receive(em4095_os_queue_t queue, void *item, uint32_t timeout_ms)
+{
+    return 0;
+}
+
+/**
+ * @brief      os read the monotonic clock
+ * @param[out] *us pointer to a time buffer in us
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       it never goes back
+ */
+uint8_t em4095_os_monotonic_us(uint64_t *us)
+{
+    return 0;
+}
@@ -0,0 +1,269 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      linux_driver_em4095_interface.c
+ * @brief     linux driver em4095 interface source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_em4095_interface.h"
+#include "trace.h"
+#include <stdarg.h>
+#include <unistd.h>
+
+/**
+ * @brief     interface shd gpio init
+ * @param[in] *ctx pointer to the interface context
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+uint8_t em4095_interface_shd_gpio_init(void *ctx)
+{
+    (void)ctx;
+
+    return 0;
+}
+
+/**
+ * @brief     interface shd gpio deinit
+ * @param[in] *ctx pointer to the interface context
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
+ */
+uint8_t em4095_interface_shd_gpio_deinit(void *ctx)
+{
+    (void)ctx;
+
+    return 0;
+}
+
+/**
+ * @brief     interface shd gpio write
+ * @param[in] *ctx pointer to the interface context
+ * @param[in] data set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t em4095_interface_shd_gpio_write(void *ctx, uint8_t data)
+{
+    (void)ctx;
+
+    return trace_shd_write(data);
+}
+
+/**
+ * @brief     interface mod gpio init
+ * @param[in] *ctx pointer to the interface context
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+uint8_t em4095_interface_mod_gpio_init(void *ctx)
+{
+    (void)ctx;
+
+    return 0;
+}
+
+/**
+ * @brief     interface mod gpio deinit
+ * @param[in] *ctx pointer to the interface context
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
+ */
+uint8_t em4095_interface_mod_gpio_deinit(void *ctx)
+{
+    (void)ctx;
+
+    return 0;
+}
+
+/**
+ * @brief     interface mod gpio write
+ * @param[in] *ctx pointer to the interface context
+ * @param[in] data set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t em4095_interface_mod_gpio_write(void *ctx, uint8_t data)
+{
+    (void)ctx;
+
+    return trace_mod_write(data);
+}
+
+/**
+ * @brief     interface demod gpio init
+ * @param[in] *ctx pointer to the interface context
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+uint8_t em4095_interface_demod_gpio_init(void *ctx)
+{
+    (void)ctx;
+
+    return 0;
+}
+
+/**
+ * @brief     interface demod gpio deinit
+ * @param[in] *ctx pointer to the interface context
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
+ */
+uint8_t em4095_interface_demod_gpio_deinit(void *ctx)
+{
+    (void)ctx;
+
+    return 0;
+}
+
+/**
+ * @brief      interface demod gpio read
+ * @param[in]  *ctx pointer to the interface context
+ * @param[out] *data pointer to a data level buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t em4095_interface_demod_gpio_read(void *ctx, uint8_t *data)
+{
+    (void)ctx;
+
+    return trace_read(data);
+}
+
+/**
+ * @brief     interface antenna select
+ * @param[in] *ctx pointer to the interface context
+ * @param[in] antenna antenna index
+ * @return    status code
+ *            - 0 success
+ *            - 1 select failed
+ * @note      it drives the analog mux between the coils of one em4095, only the scheduler example uses it
+ */
+uint8_t em4095_interface_antenna_select(void *ctx, uint8_t antenna)
+{
+    (void)ctx;
+    (void)antenna;
+
+    return 0;
+}
+
+/**
+ * @brief     interface timestamp read
+ * @param[in] *t pointer to an em4095_time structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ * @note      none
+ */
+uint8_t em4095_interface_timestamp_read(em4095_time_t *t)
+{
+    return trace_timestamp(t);
+}
+
+/**
+ * @brief     interface delay ms
+ * @param[in] ms time
+ * @note      none
+ */
+void em4095_interface_delay_ms(uint32_t ms)
+{
+    usleep(1000 * ms);
+}
+
+/**
+ * @brief     interface print format data
+ * @param[in] fmt format data
+ * @note      none
+ */
+void em4095_interface_debug_print(const char *const fmt, ...)
+{
+    va_list args;
+
+    va_start(args, fmt);
+    (void)vprintf(fmt, args);
+    va_end(args);
+}
+
+/**
+ * @brief     interface receive callback
+ * @param[in] *ctx pointer to the interface context
+ * @param[in] mode running mode
+ * @param[in] *buf pointer to a decode buffer
+ * @param[in] len data length
+ * @note      none
+ */
+void em4095_interface_receive_callback(void *ctx, em4095_mode_t mode, em4095_decode_t *buf, uint16_t len)
+{
+    (void)ctx;
+    (void)buf;
+    (void)len;
+
+    switch (mode)
+    {
+        case EM4095_MODE_READ :
+        {
+            em4095_interface_debug_print("em4095: irq read done.\n");
+
+            break;
+        }
+        case EM4095_MODE_WRITE :
+        {
+            em4095_interface_debug_print("em4095: irq write done.\n");
+
+            break;
+        }
+        default :
+        {
+            em4095_interface_debug_print("em4095: irq unknown mode.\n");
+
+            break;
+        }
+    }
+}
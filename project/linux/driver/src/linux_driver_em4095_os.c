@@ -0,0 +1,503 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      linux_driver_em4095_os.c
+ * @brief     linux driver em4095 os source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_em4095_os.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief linux os semaphore structure definition
+ */
+typedef struct linux_os_sem_s
+{
+    pthread_mutex_t mutex;        /**< state mutex */
+    pthread_cond_t cond;          /**< given condition */
+    uint8_t given;                /**< given flag */
+} linux_os_sem_t;
+
+/**
+ * @brief linux os queue structure definition
+ */
+typedef struct linux_os_queue_s
+{
+    pthread_mutex_t mutex;        /**< state mutex */
+    pthread_cond_t cond;          /**< not empty condition */
+    uint16_t item_size;           /**< item size */
+    uint16_t depth;               /**< max items */
+    uint16_t head;                /**< first item */
+    uint16_t count;               /**< item number */
+    uint8_t *buf;                 /**< item buffer */
+} linux_os_queue_t;
+
+/**
+ * @brief      init a condition on the monotonic clock
+ * @param[out] *cond pointer to a condition
+ * @return     status code
+ *             - 0 success
+ *             - 1 init failed
+ * @note       none
+ */
+static uint8_t a_os_cond_init(pthread_cond_t *cond)
+{
+    pthread_condattr_t attr;
+
+    if (pthread_condattr_init(&attr) != 0)
+    {
+        return 1;
+    }
+    (void)pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    if (pthread_cond_init(cond, &attr) != 0)
+    {
+        (void)pthread_condattr_destroy(&attr);
+
+        return 1;
+    }
+    (void)pthread_condattr_destroy(&attr);
+
+    return 0;
+}
+
+/**
+ * @brief      get the deadline of a timeout
+ * @param[in]  timeout_ms timeout in ms
+ * @param[out] *ts pointer to a deadline
+ * @note       none
+ */
+static void a_os_deadline(uint32_t timeout_ms, struct timespec *ts)
+{
+    (void)clock_gettime(CLOCK_MONOTONIC, ts);
+    ts->tv_sec += timeout_ms / 1000;
+    ts->tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (ts->tv_nsec >= 1000000000L)
+    {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000L;
+    }
+}
+
+/**
+ * @brief     wait for a condition
+ * @param[in] *cond pointer to a condition
+ * @param[in] *mutex pointer to the locked mutex
+ * @param[in] *ts pointer to a deadline, NULL waits forever
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout
+ * @note      none
+ */
+static uint8_t a_os_wait(pthread_cond_t *cond, pthread_mutex_t *mutex, const struct timespec *ts)
+{
+    if (ts == NULL)
+    {
+        (void)pthread_cond_wait(cond, mutex);
+
+        return 0;
+    }
+
+    return (pthread_cond_timedwait(cond, mutex, ts) == 0) ? 0 : 1;
+}
+
+/**
+ * @brief      os create a binary semaphore
+ * @param[out] *sem pointer to a semaphore buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 create failed
+ * @note       it is created empty
+ */
+uint8_t em4095_os_sem_create(em4095_os_sem_t *sem)
+{
+    linux_os_sem_t *s;
+
+    s = (linux_os_sem_t *)calloc(1, sizeof(linux_os_sem_t));
+    if (s == NULL)
+    {
+        return 1;
+    }
+    if (pthread_mutex_init(&s->mutex, NULL) != 0)
+    {
+        free(s);
+
+        return 1;
+    }
+    if (a_os_cond_init(&s->cond) != 0)
+    {
+        (void)pthread_mutex_destroy(&s->mutex);
+        free(s);
+
+        return 1;
+    }
+    *sem = s;
+
+    return 0;
+}
+
+/**
+ * @brief     os delete a binary semaphore
+ * @param[in] sem semaphore
+ * @return    status code
+ *            - 0 success
+ *            - 1 delete failed
+ * @note      none
+ */
+uint8_t em4095_os_sem_delete(em4095_os_sem_t sem)
+{
+    linux_os_sem_t *s = (linux_os_sem_t *)sem;
+
+    if (s == NULL)
+    {
+        return 1;
+    }
+    (void)pthread_cond_destroy(&s->cond);
+    (void)pthread_mutex_destroy(&s->mutex);
+    free(s);
+
+    return 0;
+}
+
+/**
+ * @brief     os give a binary semaphore
+ * @param[in] sem semaphore
+ * @return    status code
+ *            - 0 success
+ *            - 1 give failed
+ * @note      it can be called in the irq
+ */
+uint8_t em4095_os_sem_give(em4095_os_sem_t sem)
+{
+    linux_os_sem_t *s = (linux_os_sem_t *)sem;
+
+    if (s == NULL)
+    {
+        return 1;
+    }
+    (void)pthread_mutex_lock(&s->mutex);
+    s->given = 1;
+    (void)pthread_cond_signal(&s->cond);
+    (void)pthread_mutex_unlock(&s->mutex);
+
+    return 0;
+}
+
+/**
+ * @brief     os take a binary semaphore
+ * @param[in] sem semaphore
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout
+ * @note      EM4095_OS_WAIT_FOREVER waits without a timeout
+ */
+uint8_t em4095_os_sem_take(em4095_os_sem_t sem, uint32_t timeout_ms)
+{
+    uint8_t res = 0;
+    struct timespec ts;
+    linux_os_sem_t *s = (linux_os_sem_t *)sem;
+
+    if (s == NULL)
+    {
+        return 1;
+    }
+    a_os_deadline(timeout_ms, &ts);
+    (void)pthread_mutex_lock(&s->mutex);
+    while ((s->given == 0) && (res == 0))
+    {
+        res = a_os_wait(&s->cond, &s->mutex, (timeout_ms == EM4095_OS_WAIT_FOREVER) ? NULL : &ts);
+    }
+    if (s->given != 0)
+    {
+        s->given = 0;
+        res = 0;
+    }
+    (void)pthread_mutex_unlock(&s->mutex);
+
+    return res;
+}
+
+/**
+ * @brief      os create a mutex
+ * @param[out] *mutex pointer to a mutex buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 create failed
+ * @note       none
+ */
+uint8_t em4095_os_mutex_create(em4095_os_mutex_t *mutex)
+{
+    pthread_mutex_t *m;
+
+    m = (pthread_mutex_t *)malloc(sizeof(pthread_mutex_t));
+    if (m == NULL)
+    {
+        return 1;
+    }
+    if (pthread_mutex_init(m, NULL) != 0)
+    {
+        free(m);
+
+        return 1;
+    }
+    *mutex = m;
+
+    return 0;
+}
+
+/**
+ * @brief     os delete a mutex
+ * @param[in] mutex mutex
+ * @return    status code
+ *            - 0 success
+ *            - 1 delete failed
+ * @note      none
+ */
+uint8_t em4095_os_mutex_delete(em4095_os_mutex_t mutex)
+{
+    if (mutex == NULL)
+    {
+        return 1;
+    }
+    (void)pthread_mutex_destroy((pthread_mutex_t *)mutex);
+    free(mutex);
+
+    return 0;
+}
+
+/**
+ * @brief     os lock a mutex
+ * @param[in] mutex mutex
+ * @return    status code
+ *            - 0 success
+ *            - 1 lock failed
+ * @note      it can't be called in the irq
+ */
+uint8_t em4095_os_mutex_lock(em4095_os_mutex_t mutex)
+{
+    if ((mutex == NULL) || (pthread_mutex_lock((pthread_mutex_t *)mutex) != 0))
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     os unlock a mutex
+ * @param[in] mutex mutex
+ * @return    status code
+ *            - 0 success
+ *            - 1 unlock failed
+ * @note      none
+ */
+uint8_t em4095_os_mutex_unlock(em4095_os_mutex_t mutex)
+{
+    if ((mutex == NULL) || (pthread_mutex_unlock((pthread_mutex_t *)mutex) != 0))
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      os create a message queue
+ * @param[out] *queue pointer to a queue buffer
+ * @param[in]  item_size item size in bytes
+ * @param[in]  depth max items
+ * @return     status code
+ *             - 0 success
+ *             - 1 create failed
+ * @note       none
+ */
+uint8_t em4095_os_queue_create(em4095_os_queue_t *queue, uint16_t item_size, uint16_t depth)
+{
+    linux_os_queue_t *q;
+
+    if ((item_size == 0) || (depth == 0))
+    {
+        return 1;
+    }
+    q = (linux_os_queue_t *)calloc(1, sizeof(linux_os_queue_t));
+    if (q == NULL)
+    {
+        return 1;
+    }
+    q->buf = (uint8_t *)malloc((size_t)item_size * depth);
+    if (q->buf == NULL)
+    {
+        free(q);
+
+        return 1;
+    }
+    if (pthread_mutex_init(&q->mutex, NULL) != 0)
+    {
+        free(q->buf);
+        free(q);
+
+        return 1;
+    }
+    if (a_os_cond_init(&q->cond) != 0)
+    {
+        (void)pthread_mutex_destroy(&q->mutex);
+        free(q->buf);
+        free(q);
+
+        return 1;
+    }
+    q->item_size = item_size;
+    q->depth = depth;
+    *queue = q;
+
+    return 0;
+}
+
+/**
+ * @brief     os delete a message queue
+ * @param[in] queue queue
+ * @return    status code
+ *            - 0 success
+ *            - 1 delete failed
+ * @note      none
+ */
+uint8_t em4095_os_queue_delete(em4095_os_queue_t queue)
+{
+    linux_os_queue_t *q = (linux_os_queue_t *)queue;
+
+    if (q == NULL)
+    {
+        return 1;
+    }
+    (void)pthread_cond_destroy(&q->cond);
+    (void)pthread_mutex_destroy(&q->mutex);
+    free(q->buf);
+    free(q);
+
+    return 0;
+}
+
+/**
+ * @brief     os send an item to a message queue
+ * @param[in] queue queue
+ * @param[in] *item pointer to an item
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ * @note      it never blocks and can be called in the irq
+ */
+uint8_t em4095_os_queue_send(em4095_os_queue_t queue, const void *item)
+{
+    uint16_t tail;
+    linux_os_queue_t *q = (linux_os_queue_t *)queue;
+
+    if (q == NULL)
+    {
+        return 1;
+    }
+    (void)pthread_mutex_lock(&q->mutex);
+    if (q->count == q->depth)
+    {
+        (void)pthread_mutex_unlock(&q->mutex);
+
+        return 1;
+    }
+    tail = (uint16_t)((q->head + q->count) % q->depth);
+    memcpy(q->buf + (size_t)tail * q->item_size, item, q->item_size);
+    q->count++;
+    (void)pthread_cond_signal(&q->cond);
+    (void)pthread_mutex_unlock(&q->mutex);
+
+    return 0;
+}
+
+/**
+ * @brief      os receive an item from a message queue
+ * @param[in]  queue queue
+ * @param[out] *item pointer to an item buffer
+ * @param[in]  timeout_ms timeout in ms
+ * @return     status code
+ *             - 0 success
+ *             - 1 timeout
+ * @note       EM4095_OS_WAIT_FOREVER waits without a timeout
+ */
+uint8_t em4095_os_queue_receive(em4095_os_queue_t queue, void *item, uint32_t timeout_ms)
+{
+    uint8_t res = 0;
+    struct timespec ts;
+    linux_os_queue_t *q = (linux_os_queue_t *)queue;
+
+    if (q == NULL)
+    {
+        return 1;
+    }
+    a_os_deadline(timeout_ms, &ts);
+    (void)pthread_mutex_lock(&q->mutex);
+    while ((q->count == 0) && (res == 0))
+    {
+        res = a_os_wait(&q->cond, &q->mutex, (timeout_ms == EM4095_OS_WAIT_FOREVER) ? NULL : &ts);
+    }
+    if (q->count != 0)
+    {
+        memcpy(item, q->buf + (size_t)q->head * q->item_size, q->item_size);
+        q->head = (uint16_t)((q->head + 1) % q->depth);
+        q->count--;
+        res = 0;
+    }
+    (void)pthread_mutex_unlock(&q->mutex);
+
+    return res;
+}
+
+/**
+ * @brief      os read the monotonic clock
+ * @param[out] *us pointer to a time buffer in us
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       it never goes back
+ */
+uint8_t em4095_os_monotonic_us(uint64_t *us)
+{
+    struct timespec ts;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+    {
+        return 1;
+    }
+    *us = (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      analyze.h
+ * @brief     analyze header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef ANALYZE_H
+#define ANALYZE_H
+
+#include "replay.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup analyze analyze function
+ * @brief    analyze function modules
+ * @details  the capture files of a directory tree are replayed by a pool of worker threads. every
+ *           worker owns a bounded deque, pops its own files from the bottom and steals from the top
+ *           of the others when it runs dry. the directory walk blocks when all deques are full and
+ *           every file result is streamed out once it is merged, so the memory doesn't grow with
+ *           the corpus size.
+ * @{
+ */
+
+/**
+ * @brief analyze definition
+ */
+#define ANALYZE_MAX_THREADS        256        /**< max worker threads */
+#define ANALYZE_QUEUE_DEPTH        64         /**< files per worker deque */
+
+/**
+ * @brief analyze config structure definition
+ */
+typedef struct analyze_config_s
+{
+    replay_config_t replay;                                                         /**< replay config */
+    uint32_t threads;                                                               /**< worker threads, 0 means all cores */
+    void (*file_callback)(const char *path, const replay_result_t *result);         /**< called after every file */
+    void (*reader_callback)(uint32_t reader_id, const replay_result_t *result);     /**< called for every reader at the end */
+} analyze_config_t;
+
+/**
+ * @brief      analyze all capture files of a directory tree
+ * @param[in]  *path pointer to a directory path
+ * @param[in]  *config pointer to an analyze config structure
+ * @param[out] *total pointer to a replay result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 analyze failed
+ * @note       the callbacks are serialized, the readers are reported in the reader id order
+ */
+uint8_t analyze_run(const char *path, const analyze_config_t *config, replay_result_t *total);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
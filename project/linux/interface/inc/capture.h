@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      capture.h
+ * @brief     capture header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include "driver_em4095_capture.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup capture capture function
+ * @brief    capture function modules
+ * @{
+ */
+
+/**
+ * @brief capture file structure definition
+ */
+typedef struct capture_file_s
+{
+    int fd;                                /**< file descriptor */
+    const uint8_t *map;                    /**< mapped file */
+    size_t size;                           /**< file size */
+    size_t offset;                         /**< read offset */
+    uint32_t frame;                        /**< read frame count */
+    uint32_t corrupt;                      /**< skipped corrupt blocks */
+    em4095_capture_header_t header;        /**< file header */
+} capture_file_t;
+
+/**
+ * @brief      open a capture file
+ * @param[out] *file pointer to a capture file structure
+ * @param[in]  *path pointer to a file path
+ * @return     status code
+ *             - 0 success
+ *             - 1 open failed
+ *             - 2 header is invalid
+ * @note       the file is memory mapped read only, so the file size is not limited by the ram
+ */
+uint8_t capture_open(capture_file_t *file, const char *path);
+
+/**
+ * @brief      read the next frame
+ * @param[in]  *file pointer to a capture file structure
+ * @param[out] *frame pointer to a capture frame structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 end of file
+ * @note       the frame payload points into the mapped file and is valid until capture_close,
+ *             blocks failing their crc are skipped and counted in file->corrupt
+ */
+uint8_t capture_read_frame(capture_file_t *file, em4095_capture_frame_t *frame);
+
+/**
+ * @brief     rewind to the first frame
+ * @param[in] *file pointer to a capture file structure
+ * @note      none
+ */
+void capture_rewind(capture_file_t *file);
+
+/**
+ * @brief     close a capture file
+ * @param[in] *file pointer to a capture file structure
+ * @note      none
+ */
+void capture_close(capture_file_t *file);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
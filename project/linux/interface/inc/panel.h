@@ -0,0 +1,121 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      panel.h
+ * @brief     panel header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#ifndef PANEL_H
+#define PANEL_H
+
+#include "driver_em4095_osdp.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup panel panel function
+ * @brief    panel function modules
+ * @details  the host stand-in of an osdp access panel. it polls a pd on a serial device, or on a
+ *           pseudo terminal pair whose other side is served by a pd on the host, so the whole osdp
+ *           path of the driver, the secure channel included, runs without a board and an rs485
+ *           adapter.
+ * @{
+ */
+
+/**
+ * @brief      open the panel
+ * @param[in]  *device pointer to a serial device path, NULL opens a pseudo terminal pair
+ * @param[in]  baud baud rate
+ * @param[out] *pd_fd pointer to a pd side fd buffer, -1 with a serial device
+ * @return     status code
+ *             - 0 success
+ *             - 1 open failed
+ * @note       both sides are raw 8n1
+ */
+uint8_t panel_open(const char *device, uint32_t baud, int *pd_fd);
+
+/**
+ * @brief  close the panel
+ * @return status code
+ *         - 0 success
+ * @note   the pd side fd is closed as well
+ */
+uint8_t panel_close(void);
+
+/**
+ * @brief      send a command and wait the reply
+ * @param[in]  address pd address
+ * @param[in]  code command code
+ * @param[in]  *data pointer to a data buffer
+ * @param[in]  len data length
+ * @param[in]  repeat 1 sends the last command again with its sequence number
+ * @param[out] *reply pointer to a reply packet
+ * @param[in]  timeout_ms reply timeout in ms
+ * @return     status code
+ *             - 0 success
+ *             - 1 send failed
+ *             - 2 reply timeout
+ *             - 3 reply mac is wrong
+ * @note       the reply data points into the panel receive buffer or the secure channel until
+ *             the next command, the sequence number runs 1, 2, 3, 1 like a panel after the first
+ *             poll, in a session the command is secured and a plain reply ends the session
+ */
+uint8_t panel_command(uint8_t address, uint8_t code, const uint8_t *data, uint16_t len, uint8_t repeat,
+                      em4095_osdp_packet_t *reply, uint32_t timeout_ms);
+
+/**
+ * @brief     start a secure channel session
+ * @param[in] address pd address
+ * @param[in] *scbk pointer to a 16 bytes base key, NULL for the default key scbk-d
+ * @param[in] timeout_ms reply timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 send failed
+ *            - 2 reply timeout
+ *            - 3 pd refused the session or its cryptogram is wrong
+ * @note      osdp_CHLNG gets osdp_CCRYPT, the client cryptogram proves the pd key, then
+ *            osdp_SCRYPT gets osdp_RMAC_I which seeds the mac chain of the session
+ */
+uint8_t panel_secure(uint8_t address, const uint8_t *scbk, uint32_t timeout_ms);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,179 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      replay.h
+ * @brief     replay header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "driver_em4095_capture.h"
+#include "driver_em4095_em4100.h"
+#include "driver_em4095_slicer.h"
+#include "driver_em4095_allow.h"
+#include "driver_em4095_format.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup replay replay function
+ * @brief    replay function modules
+ * @details  captures are played through em4095_irq_handler as fast as the cpu allows, the clock
+ *           ticks and timestamps are simulated so the result doesn't depend on the wall time. every
+ *           thread replays with its own handle and decoder state. the samples are sliced to bits and
+ *           decoded as em4100 while they are captured, optionally through the frame combiner.
+ *           a gap event restarts the decoders, frames longer than the decode buffer are streamed
+ *           through the overflow event. with the formats flag the bits go through the table driven
+ *           format engine instead, the built in table order matches the protocol enumeration.
+ * @{
+ */
+
+/**
+ * @brief replay default definition
+ */
+#define REPLAY_DEFAULT_RATE          64            /**< rf/64 */
+#define REPLAY_DEFAULT_CARRIER       125000        /**< 125KHz */
+
+/**
+ * @brief replay failure enumeration definition
+ */
+typedef enum
+{
+    REPLAY_FAILURE_NO_SYNC   = 0x00,        /**< no em4100 header found */
+    REPLAY_FAILURE_CHECK     = 0x01,        /**< header found, parity or stop bit error */
+    REPLAY_FAILURE_TRUNCATED = 0x02,        /**< trace ended before the read was done */
+    REPLAY_FAILURE_CORRUPT   = 0x03,        /**< frame block is invalid */
+    REPLAY_FAILURE_MAX       = 0x04,        /**< failure class number */
+} replay_failure_t;
+
+/**
+ * @brief replay protocol enumeration definition
+ */
+typedef enum
+{
+    REPLAY_PROTOCOL_EM4100  = 0x00,        /**< em4100 */
+    REPLAY_PROTOCOL_VIKING  = 0x01,        /**< viking, only decoded by the format table */
+    REPLAY_PROTOCOL_UNKNOWN = 0x02,        /**< no protocol decoded */
+    REPLAY_PROTOCOL_MAX     = 0x03,        /**< protocol number */
+} replay_protocol_t;
+
+/**
+ * @brief replay config structure definition
+ */
+typedef struct replay_config_s
+{
+    uint32_t rate;                      /**< data rate in carrier cycles per bit */
+    uint32_t carrier_hz;                /**< carrier frequency */
+    uint8_t verbose;                    /**< print every frame */
+    uint8_t oversample;                 /**< reads per sample, 1 disables it */
+    uint8_t glitch;                     /**< glitch filter width in clock irqs, 0 disables it */
+    uint8_t pll;                        /**< sample phase loop gain shift, 0 disables it */
+    uint32_t noise_ppm;                 /**< injected glitches per million clock irqs */
+    uint32_t noise_width;               /**< injected glitch width in clock irqs */
+    int32_t clock_ppm;                  /**< simulated tag clock offset in ppm */
+    uint32_t jitter;                    /**< simulated edge jitter in clock irqs */
+    uint8_t vote;                       /**< max frames voted by the em4100 combiner, 0 disables it */
+    uint16_t gap;                       /**< gap in sample periods, 0 uses the fixed timeout */
+    const em4095_allow_t *allow;        /**< allow list checked at every id, NULL disables it */
+    uint8_t formats;                    /**< decode with the built in format table instead of the em4100 decoder */
+} replay_config_t;
+
+/**
+ * @brief replay result structure definition
+ */
+typedef struct replay_result_s
+{
+    uint32_t files;                                /**< replayed files */
+    uint32_t bad_files;                            /**< invalid files */
+    uint64_t frames;                               /**< replayed frames */
+    uint64_t bad_frames;                           /**< invalid or truncated frames */
+    uint64_t decoded;                              /**< decoded frames */
+    uint64_t allowed;                              /**< ids in the allow list */
+    uint64_t denied;                               /**< ids not in the allow list */
+    uint64_t protocol[REPLAY_PROTOCOL_MAX];        /**< frames per protocol */
+    uint64_t failure[REPLAY_FAILURE_MAX];          /**< frames without an id per failure class */
+    uint64_t latency;                              /**< decode latency sum in samples */
+    uint64_t combined;                             /**< ids voted from more than one frame */
+    uint64_t corrected;                            /**< samples corrected by the majority vote */
+    uint64_t glitches;                             /**< glitches removed by the filter */
+    uint64_t gaps;                                 /**< gap events */
+    uint64_t overflows;                            /**< decode buffer overflow events */
+    uint64_t ticks;                                /**< replayed clock ticks */
+    double signal_seconds;                         /**< replayed signal time */
+    double seconds;                                /**< elapsed time */
+    uint32_t reader_id;                            /**< reader id of the last replayed file */
+} replay_result_t;
+
+/**
+ * @brief      replay a capture file
+ * @param[in]  *path pointer to a file path
+ * @param[in]  *config pointer to a replay config structure
+ * @param[out] *result pointer to a replay result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 replay failed
+ * @note       the result is accumulated, clear it before the first call
+ */
+uint8_t replay_file(const char *path, const replay_config_t *config, replay_result_t *result);
+
+/**
+ * @brief      merge a replay result to another one
+ * @param[out] *dst pointer to a destination replay result structure
+ * @param[in]  *src pointer to a source replay result structure
+ * @note       the reader id isn't merged
+ */
+void replay_result_merge(replay_result_t *dst, const replay_result_t *src);
+
+/**
+ * @brief      replay all capture files of a directory
+ * @param[in]  *path pointer to a directory path
+ * @param[in]  *config pointer to a replay config structure
+ * @param[out] *result pointer to a replay result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 replay failed
+ * @note       files which are not captures are counted as bad files
+ */
+uint8_t replay_dir(const char *path, const replay_config_t *config, replay_result_t *result);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
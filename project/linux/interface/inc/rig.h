@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      rig.h
+ * @brief     rig header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#ifndef RIG_H
+#define RIG_H
+
+#include "driver_em4095_host.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup rig rig function
+ * @brief    rig function modules
+ * @details  the host test rig side of the binary host protocol. requests are written as they are
+ *           sent and the responses are parsed from the byte stream, so many requests may be in
+ *           flight. it runs on a serial device, or on a pseudo terminal pair whose other side is
+ *           served on the host, so the protocol path runs without a board.
+ * @{
+ */
+
+/**
+ * @brief      open the rig
+ * @param[in]  *device pointer to a serial device path, NULL opens a pseudo terminal pair
+ * @param[in]  baud baud rate
+ * @param[out] *board_fd pointer to a board side fd buffer, -1 with a serial device
+ * @return     status code
+ *             - 0 success
+ *             - 1 open failed
+ * @note       both sides are raw 8n1, 9600 to 4000000 baud
+ */
+uint8_t rig_open(const char *device, uint32_t baud, int *board_fd);
+
+/**
+ * @brief  close the rig
+ * @return status code
+ *         - 0 success
+ * @note   the board side fd is closed as well
+ */
+uint8_t rig_close(void);
+
+/**
+ * @brief     send a request
+ * @param[in] seq sequence number
+ * @param[in] code request code
+ * @param[in] *data pointer to a payload buffer
+ * @param[in] len payload length
+ * @return    status code
+ *            - 0 success
+ *            - 1 send failed
+ * @note      it doesn't wait the response
+ */
+uint8_t rig_send(uint8_t seq, uint8_t code, const uint8_t *data, uint16_t len);
+
+/**
+ * @brief      receive the next response
+ * @param[out] *frame pointer to a frame structure
+ * @param[in]  timeout_ms response timeout in ms
+ * @return     status code
+ *             - 0 success
+ *             - 1 receive failed
+ *             - 2 response timeout
+ * @note       the frame payload points into the rig receive buffer until the next receive
+ */
+uint8_t rig_receive(em4095_host_frame_t *frame, uint32_t timeout_ms);
+
+/**
+ * @brief  get the skipped bytes
+ * @return skipped byte number
+ * @note   bytes dropped before a sof and bad frames
+ */
+uint32_t rig_get_skipped(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,147 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      trace.h
+ * @brief     trace header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "driver_em4095_capture.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup trace trace function
+ * @brief    trace function modules
+ * @details  the trace plays a recorded frame on a simulated DEMOD_OUT line, one clock irq per tick,
+ *           so the driver sees the same levels and timestamps as on the board. the trace state is
+ *           thread local, every thread plays its own trace.
+ * @{
+ */
+
+/**
+ * @brief     set the trace noise
+ * @param[in] ppm glitches per million ticks
+ * @param[in] width glitch width in ticks
+ * @param[in] seed random seed
+ * @note      a glitch inverts DEMOD_OUT, 0 ppm disables the noise
+ */
+void trace_set_noise(uint32_t ppm, uint32_t width, uint32_t seed);
+
+/**
+ * @brief     set the tag clock of the trace
+ * @param[in] ppm tag clock offset in ppm, a positive offset stretches the recorded runs
+ * @param[in] jitter max edge jitter in ticks
+ * @param[in] seed random seed
+ * @note      every edge moves by a random -jitter to +jitter ticks on its own, so the jitter never
+ *            accumulates, while the offset walks the edges away from the recorded phase
+ */
+void trace_set_clock(int32_t ppm, uint32_t jitter, uint32_t seed);
+
+/**
+ * @brief     load a frame to the trace
+ * @param[in] *header pointer to a capture header structure
+ * @param[in] *frame pointer to a capture frame structure
+ * @param[out] *samples pointer to a sample number buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 frame is invalid
+ * @note      a lead in of div ticks with the opposite level is added, it ends on the first
+ *            recorded edge, so the driver syncs on it with the same phase as on the board
+ */
+uint8_t trace_load(const em4095_capture_header_t *header, const em4095_capture_frame_t *frame, uint16_t *samples);
+
+/**
+ * @brief  run one clock tick
+ * @return status code
+ *         - 0 success
+ *         - 1 end of the trace
+ * @note   none
+ */
+uint8_t trace_tick(void);
+
+/**
+ * @brief  get the played ticks
+ * @return played ticks
+ * @note   none
+ */
+uint64_t trace_get_ticks(void);
+
+/**
+ * @brief      trace read the DEMOD_OUT level
+ * @param[out] *level pointer to a level buffer
+ * @return     status code
+ *             - 0 success
+ * @note       the level is inverted while a noise glitch lasts
+ */
+uint8_t trace_read(uint8_t *level);
+
+/**
+ * @brief      trace read the timestamp
+ * @param[out] *t pointer to an em4095_time structure
+ * @return     status code
+ *             - 0 success
+ * @note       the timestamp is derived from the ticks and the clock rate
+ */
+uint8_t trace_timestamp(em4095_time_t *t);
+
+/**
+ * @brief     trace write the SHD level
+ * @param[in] level set level
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t trace_shd_write(uint8_t level);
+
+/**
+ * @brief     trace write the MOD level
+ * @param[in] level set level
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t trace_mod_write(uint8_t level);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,160 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      wiegand.h
+ * @brief     wiegand header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#ifndef WIEGAND_H
+#define WIEGAND_H
+
+#include "driver_em4095_wiegand.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup wiegand wiegand function
+ * @brief    wiegand function modules
+ * @details  the host stand-in of the stm32f407 wiegand output. the same transmitter is clocked by a
+ *           simulated slot timer instead of the timer dma, and every line change is recorded, so the
+ *           emitted pulse trains can be checked without a board.
+ * @{
+ */
+
+/**
+ * @brief wiegand trace definition
+ */
+#define WIEGAND_TRACE_MAX        2048        /**< max recorded edges */
+
+/**
+ * @brief wiegand edge structure definition
+ */
+typedef struct wiegand_edge_s
+{
+    uint32_t t_us;         /**< edge time in us */
+    uint8_t line;          /**< 0 is d0 or data, 1 is d1 or clock */
+    uint8_t level;         /**< line level after the edge */
+} wiegand_edge_t;
+
+/**
+ * @brief     wiegand output init
+ * @param[in] pulse_us pulse width in us
+ * @param[in] interval_us bit interval in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 pulse_us or interval_us is invalid
+ * @note      the trace is cleared and both lines idle high
+ */
+uint8_t wiegand_init(uint32_t pulse_us, uint32_t interval_us);
+
+/**
+ * @brief  wiegand output deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t wiegand_deinit(void);
+
+/**
+ * @brief     queue a wiegand payload
+ * @param[in] payload right aligned payload, the first bit is the msb
+ * @param[in] bits payload bits
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ *            - 2 bits is invalid
+ * @note      none
+ */
+uint8_t wiegand_send(uint64_t payload, uint8_t bits);
+
+/**
+ * @brief     queue an aba track 2 frame
+ * @param[in] *digits pointer to a decimal digit string
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ *            - 2 digits is invalid
+ * @note      none
+ */
+uint8_t wiegand_send_aba(const char *digits);
+
+/**
+ * @brief  get the wiegand output busy status
+ * @return 1 while a frame is queued or sent
+ * @note   none
+ */
+uint8_t wiegand_busy(void);
+
+/**
+ * @brief     run the slot timer
+ * @param[in] us run time in us
+ * @note      one slot is clocked every pulse_us, the line changes are recorded
+ */
+void wiegand_run(uint32_t us);
+
+/**
+ * @brief      get the recorded edges
+ * @param[out] **edges pointer to an edge table pointer
+ * @param[out] *count pointer to an edge number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 trace overflowed
+ * @note       none
+ */
+uint8_t wiegand_get_trace(const wiegand_edge_t **edges, uint32_t *count);
+
+/**
+ * @brief      decode the recorded edges back to bits
+ * @param[in]  mode tx mode
+ * @param[out] *buf pointer to a bit buffer, the first bit is the msb of buf[0]
+ * @param[in]  len buffer length
+ * @param[out] *bits pointer to a bit number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is too small
+ * @note       a wiegand bit is a falling edge of d0 or d1, an aba bit is the inverted data level
+ *             at a falling edge of the clock
+ */
+uint8_t wiegand_decode(em4095_wiegand_tx_mode_t mode, uint8_t *buf, uint16_t len, uint16_t *bits);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
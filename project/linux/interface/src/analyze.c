@@ -0,0 +1,496 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      analyze.c
+ * @brief     analyze source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#define _XOPEN_SOURCE 700
+#include "analyze.h"
+#include <ftw.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief analyze deque structure definition
+ */
+typedef struct analyze_deque_s
+{
+    pthread_mutex_t mutex;                    /**< deque mutex */
+    char *path[ANALYZE_QUEUE_DEPTH];          /**< file paths */
+    uint32_t top;                             /**< steal end */
+    uint32_t bottom;                          /**< owner end */
+} analyze_deque_t;
+
+/**
+ * @brief analyze reader structure definition
+ */
+typedef struct analyze_reader_s
+{
+    uint32_t reader_id;                      /**< reader id */
+    replay_result_t result;                  /**< reader result */
+} analyze_reader_t;
+
+/**
+ * @brief analyze pool structure definition
+ */
+typedef struct analyze_pool_s
+{
+    const analyze_config_t *config;          /**< analyze config */
+    uint32_t threads;                        /**< worker threads */
+    uint32_t next;                           /**< next deque to push */
+    analyze_deque_t *deque;                  /**< worker deques */
+    pthread_mutex_t mutex;                   /**< pool mutex */
+    pthread_cond_t work;                     /**< work condition */
+    pthread_cond_t space;                    /**< space condition */
+    int64_t queued;                          /**< queued files */
+    uint8_t done;                            /**< walk done flag */
+    uint8_t go;                              /**< start gate flag */
+    pthread_mutex_t result_mutex;            /**< result mutex */
+    replay_result_t *total;                  /**< total result */
+    analyze_reader_t *reader;                /**< readers sorted by id */
+    uint32_t reader_count;                   /**< reader number */
+    uint32_t reader_size;                    /**< reader capacity */
+} analyze_pool_t;
+
+/**
+ * @brief analyze worker structure definition
+ */
+typedef struct analyze_worker_s
+{
+    analyze_pool_t *pool;                    /**< pool */
+    uint32_t index;                          /**< worker index */
+} analyze_worker_t;
+
+/**
+ * @brief analyze var definition
+ */
+static analyze_pool_t *gs_pool;              /**< pool used by the directory walk */
+
+/**
+ * @brief  analyze get the monotonic time
+ * @return time in seconds
+ * @note   none
+ */
+static double a_analyze_now(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/**
+ * @brief     analyze pop a file from the owner end
+ * @param[in] *deque pointer to a deque structure
+ * @return    file path or NULL
+ * @note      none
+ */
+static char *a_analyze_pop(analyze_deque_t *deque)
+{
+    char *path = NULL;
+
+    pthread_mutex_lock(&deque->mutex);
+    if (deque->bottom != deque->top)
+    {
+        deque->bottom--;
+        path = deque->path[deque->bottom % ANALYZE_QUEUE_DEPTH];
+    }
+    pthread_mutex_unlock(&deque->mutex);
+
+    return path;
+}
+
+/**
+ * @brief     analyze steal a file from the other end
+ * @param[in] *deque pointer to a deque structure
+ * @return    file path or NULL
+ * @note      none
+ */
+static char *a_analyze_steal(analyze_deque_t *deque)
+{
+    char *path = NULL;
+
+    pthread_mutex_lock(&deque->mutex);
+    if (deque->bottom != deque->top)
+    {
+        path = deque->path[deque->top % ANALYZE_QUEUE_DEPTH];
+        deque->top++;
+    }
+    pthread_mutex_unlock(&deque->mutex);
+
+    return path;
+}
+
+/**
+ * @brief     analyze push a file to the owner end
+ * @param[in] *deque pointer to a deque structure
+ * @param[in] *path pointer to a file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 deque is full
+ * @note      none
+ */
+static uint8_t a_analyze_push(analyze_deque_t *deque, char *path)
+{
+    uint8_t res = 1;
+
+    pthread_mutex_lock(&deque->mutex);
+    if (deque->bottom - deque->top < ANALYZE_QUEUE_DEPTH)
+    {
+        deque->path[deque->bottom % ANALYZE_QUEUE_DEPTH] = path;
+        deque->bottom++;
+        res = 0;
+    }
+    pthread_mutex_unlock(&deque->mutex);
+
+    return res;
+}
+
+/**
+ * @brief     analyze get a reader entry
+ * @param[in] *pool pointer to a pool structure
+ * @param[in] reader_id reader id
+ * @return    reader entry or NULL
+ * @note      the result mutex must be held
+ */
+static analyze_reader_t *a_analyze_reader(analyze_pool_t *pool, uint32_t reader_id)
+{
+    uint32_t lo = 0;
+    uint32_t hi = pool->reader_count;
+
+    /* binary search */
+    while (lo < hi)
+    {
+        uint32_t mid = lo + (hi - lo) / 2;
+
+        if (pool->reader[mid].reader_id < reader_id)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    if ((lo < pool->reader_count) && (pool->reader[lo].reader_id == reader_id))
+    {
+        return &pool->reader[lo];
+    }
+
+    /* insert a new reader */
+    if (pool->reader_count == pool->reader_size)
+    {
+        uint32_t size = (pool->reader_size == 0) ? 64 : pool->reader_size * 2;
+        analyze_reader_t *reader = realloc(pool->reader, sizeof(analyze_reader_t) * size);
+
+        if (reader == NULL)
+        {
+            return NULL;
+        }
+        pool->reader = reader;
+        pool->reader_size = size;
+    }
+    memmove(&pool->reader[lo + 1], &pool->reader[lo], sizeof(analyze_reader_t) * (pool->reader_count - lo));
+    memset(&pool->reader[lo], 0, sizeof(analyze_reader_t));
+    pool->reader[lo].reader_id = reader_id;
+    pool->reader_count++;
+
+    return &pool->reader[lo];
+}
+
+/**
+ * @brief     analyze worker thread
+ * @param[in] *arg pointer to a worker structure
+ * @return    NULL
+ * @note      none
+ */
+static void *a_analyze_worker(void *arg)
+{
+    analyze_worker_t *worker = (analyze_worker_t *)arg;
+    analyze_pool_t *pool = worker->pool;
+
+    /* wait until the thread count is final */
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->go == 0)
+    {
+        pthread_cond_wait(&pool->work, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+
+    while (1)
+    {
+        char *path;
+        uint32_t i;
+        replay_result_t result;
+
+        /* own deque first, then steal */
+        path = a_analyze_pop(&pool->deque[worker->index]);
+        for (i = 1; (path == NULL) && (i < pool->threads); i++)
+        {
+            path = a_analyze_steal(&pool->deque[(worker->index + i) % pool->threads]);
+        }
+        if (path == NULL)
+        {
+            /* wait for more work */
+            pthread_mutex_lock(&pool->mutex);
+            while ((pool->queued <= 0) && (pool->done == 0))
+            {
+                pthread_cond_wait(&pool->work, &pool->mutex);
+            }
+            if ((pool->queued <= 0) && (pool->done != 0))
+            {
+                pthread_mutex_unlock(&pool->mutex);
+
+                break;
+            }
+            pthread_mutex_unlock(&pool->mutex);
+
+            continue;
+        }
+        pthread_mutex_lock(&pool->mutex);
+        pool->queued--;
+        pthread_cond_signal(&pool->space);
+        pthread_mutex_unlock(&pool->mutex);
+
+        /* replay with the thread local handle */
+        memset(&result, 0, sizeof(replay_result_t));
+        (void)replay_file(path, &pool->config->replay, &result);
+
+        /* merge and stream the result */
+        pthread_mutex_lock(&pool->result_mutex);
+        replay_result_merge(pool->total, &result);
+        if (result.files != 0)
+        {
+            analyze_reader_t *reader = a_analyze_reader(pool, result.reader_id);
+
+            if (reader != NULL)
+            {
+                replay_result_merge(&reader->result, &result);
+            }
+        }
+        if (pool->config->file_callback != NULL)
+        {
+            pool->config->file_callback(path, &result);
+        }
+        pthread_mutex_unlock(&pool->result_mutex);
+        free(path);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief     analyze directory walk callback
+ * @param[in] *fpath pointer to a file path
+ * @param[in] *sb pointer to a stat structure
+ * @param[in] typeflag file type
+ * @param[in] *ftwbuf pointer to a ftw structure
+ * @return    0 to go on
+ * @note      none
+ */
+static int a_analyze_walk(const char *fpath, const struct stat *sb, int typeflag, struct FTW *ftwbuf)
+{
+    analyze_pool_t *pool = gs_pool;
+    char *path;
+    uint32_t i;
+
+    (void)sb;
+    if ((typeflag != FTW_F) || (fpath[ftwbuf->base] == '.'))
+    {
+        return 0;
+    }
+    path = strdup(fpath);
+    if (path == NULL)
+    {
+        return -1;
+    }
+
+    /* block while all deques are full */
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->queued >= (int64_t)pool->threads * ANALYZE_QUEUE_DEPTH)
+    {
+        pthread_cond_wait(&pool->space, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+
+    /* round robin over the deques with space */
+    for (i = 0; i < pool->threads; i++)
+    {
+        uint32_t index = (pool->next + i) % pool->threads;
+
+        if (a_analyze_push(&pool->deque[index], path) == 0)
+        {
+            pool->next = index + 1;
+
+            break;
+        }
+    }
+    if (i == pool->threads)
+    {
+        free(path);
+
+        return -1;
+    }
+    pthread_mutex_lock(&pool->mutex);
+    pool->queued++;
+    pthread_cond_signal(&pool->work);
+    pthread_mutex_unlock(&pool->mutex);
+
+    return 0;
+}
+
+/**
+ * @brief      analyze all capture files of a directory tree
+ * @param[in]  *path pointer to a directory path
+ * @param[in]  *config pointer to an analyze config structure
+ * @param[out] *total pointer to a replay result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 analyze failed
+ * @note       the callbacks are serialized, the readers are reported in the reader id order
+ */
+uint8_t analyze_run(const char *path, const analyze_config_t *config, replay_result_t *total)
+{
+    uint8_t res = 0;
+    uint32_t i;
+    uint32_t count;
+    uint32_t started;
+    double start;
+    analyze_pool_t pool;
+    pthread_t thread[ANALYZE_MAX_THREADS];
+    analyze_worker_t worker[ANALYZE_MAX_THREADS];
+
+    /* init the pool */
+    memset(&pool, 0, sizeof(analyze_pool_t));
+    pool.config = config;
+    pool.threads = config->threads;
+    if (pool.threads == 0)
+    {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+
+        pool.threads = (cores > 0) ? (uint32_t)cores : 1;
+    }
+    if (pool.threads > ANALYZE_MAX_THREADS)
+    {
+        pool.threads = ANALYZE_MAX_THREADS;
+    }
+    count = pool.threads;
+    pool.deque = calloc(count, sizeof(analyze_deque_t));
+    if (pool.deque == NULL)
+    {
+        return 1;
+    }
+    for (i = 0; i < count; i++)
+    {
+        pthread_mutex_init(&pool.deque[i].mutex, NULL);
+    }
+    pthread_mutex_init(&pool.mutex, NULL);
+    pthread_cond_init(&pool.work, NULL);
+    pthread_cond_init(&pool.space, NULL);
+    pthread_mutex_init(&pool.result_mutex, NULL);
+    memset(total, 0, sizeof(replay_result_t));
+    pool.total = total;
+
+    /* start the workers */
+    start = a_analyze_now();
+    for (started = 0; started < pool.threads; started++)
+    {
+        worker[started].pool = &pool;
+        worker[started].index = started;
+        if (pthread_create(&thread[started], NULL, a_analyze_worker, &worker[started]) != 0)
+        {
+            break;
+        }
+    }
+
+    /* only the started workers own a deque, fix the count before opening the gate */
+    pthread_mutex_lock(&pool.mutex);
+    pool.threads = started;
+    pool.go = 1;
+    pthread_cond_broadcast(&pool.work);
+    pthread_mutex_unlock(&pool.mutex);
+    if (started == 0)
+    {
+        res = 1;
+    }
+    else
+    {
+        /* walk the tree */
+        gs_pool = &pool;
+        if (nftw(path, a_analyze_walk, 16, FTW_PHYS) != 0)
+        {
+            res = 1;
+        }
+        gs_pool = NULL;
+    }
+
+    /* stop the workers */
+    pthread_mutex_lock(&pool.mutex);
+    pool.done = 1;
+    pthread_cond_broadcast(&pool.work);
+    pthread_mutex_unlock(&pool.mutex);
+    for (i = 0; i < started; i++)
+    {
+        (void)pthread_join(thread[i], NULL);
+    }
+
+    /* the elapsed time of the whole run, not the sum of the workers */
+    total->seconds = a_analyze_now() - start;
+
+    /* report the readers */
+    for (i = 0; i < pool.reader_count; i++)
+    {
+        if (config->reader_callback != NULL)
+        {
+            config->reader_callback(pool.reader[i].reader_id, &pool.reader[i].result);
+        }
+    }
+
+    /* free the pool */
+    free(pool.reader);
+    for (i = 0; i < count; i++)
+    {
+        pthread_mutex_destroy(&pool.deque[i].mutex);
+    }
+    free(pool.deque);
+    pthread_mutex_destroy(&pool.mutex);
+    pthread_cond_destroy(&pool.work);
+    pthread_cond_destroy(&pool.space);
+    pthread_mutex_destroy(&pool.result_mutex);
+
+    return res;
+}
@@ -0,0 +1,206 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      capture.c
+ * @brief     capture source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "capture.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @brief      open a capture file
+ * @param[out] *file pointer to a capture file structure
+ * @param[in]  *path pointer to a file path
+ * @return     status code
+ *             - 0 success
+ *             - 1 open failed
+ *             - 2 header is invalid
+ * @note       the file is memory mapped read only, so the file size is not limited by the ram
+ */
+uint8_t capture_open(capture_file_t *file, const char *path)
+{
+    struct stat st;
+    void *map;
+
+    /* init */
+    memset(file, 0, sizeof(capture_file_t));
+    file->fd = -1;
+
+    /* open the file */
+    file->fd = open(path, O_RDONLY);
+    if (file->fd < 0)
+    {
+        return 1;
+    }
+
+    /* get the size */
+    if ((fstat(file->fd, &st) != 0) || (st.st_size < EM4095_CAPTURE_HEADER_SIZE))
+    {
+        (void)close(file->fd);
+        file->fd = -1;
+
+        return 2;
+    }
+    file->size = (size_t)st.st_size;
+
+    /* map the whole file */
+    map = mmap(NULL, file->size, PROT_READ, MAP_PRIVATE, file->fd, 0);
+    if (map == MAP_FAILED)
+    {
+        (void)close(file->fd);
+        file->fd = -1;
+
+        return 1;
+    }
+    file->map = (const uint8_t *)map;
+
+    /* frames are read front to back */
+    (void)madvise(map, file->size, MADV_SEQUENTIAL);
+
+    /* parse the header */
+    if (em4095_capture_parse_header(file->map, EM4095_CAPTURE_HEADER_SIZE, &file->header) != 0)
+    {
+        capture_close(file);
+
+        return 2;
+    }
+    file->offset = file->map[5];
+
+    return 0;
+}
+
+/**
+ * @brief      read the next frame
+ * @param[in]  *file pointer to a capture file structure
+ * @param[out] *frame pointer to a capture frame structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 end of file
+ * @note       the frame payload points into the mapped file and is valid until capture_close,
+ *             blocks failing their crc are skipped and counted in file->corrupt
+ */
+uint8_t capture_read_frame(capture_file_t *file, em4095_capture_frame_t *frame)
+{
+    size_t left;
+    uint32_t used;
+    uint8_t res;
+    uint8_t lost;
+
+    lost = 0;
+    while (1)
+    {
+        /* check the end */
+        if (file->offset >= file->size)
+        {
+            return 2;
+        }
+
+        /* the parser takes a 32 bit length, so clamp the window */
+        left = file->size - file->offset;
+        if (left > 0xFFFFFFFFUL)
+        {
+            left = 0xFFFFFFFFUL;
+        }
+
+        /* parse in place */
+        res = em4095_capture_parse_frame(&file->map[file->offset], (uint32_t)left, frame, &used);
+        if (res == 0)
+        {
+            break;
+        }
+        else if (res == 4)
+        {
+            /* truncated tail, a recording cut in the middle of a block */
+            file->offset = file->size;
+
+            return 2;
+        }
+
+        /* a block with a good tag but a bad crc is skipped by its length field, */
+        /* anything else is resynced one byte at a time and counted once */
+        if ((file->map[file->offset] == EM4095_CAPTURE_TAG_FRAME) && (file->map[file->offset + 1] <= 1))
+        {
+            file->offset += EM4095_CAPTURE_FRAME_OVERHEAD +
+                            (((size_t)file->map[file->offset + 5] << 8) | file->map[file->offset + 4]);
+            file->corrupt++;
+            lost = 0;
+        }
+        else
+        {
+            if (lost == 0)
+            {
+                file->corrupt++;
+            }
+            file->offset++;
+            lost = 1;
+        }
+    }
+    file->offset += used;
+    file->frame++;
+
+    return 0;
+}
+
+/**
+ * @brief     rewind to the first frame
+ * @param[in] *file pointer to a capture file structure
+ * @note      none
+ */
+void capture_rewind(capture_file_t *file)
+{
+    file->offset = file->map[5];
+    file->frame = 0;
+    file->corrupt = 0;
+}
+
+/**
+ * @brief     close a capture file
+ * @param[in] *file pointer to a capture file structure
+ * @note      none
+ */
+void capture_close(capture_file_t *file)
+{
+    if (file->map != NULL)
+    {
+        (void)munmap((void *)file->map, file->size);
+        file->map = NULL;
+    }
+    if (file->fd >= 0)
+    {
+        (void)close(file->fd);
+        file->fd = -1;
+    }
+}
@@ -0,0 +1,432 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      panel.c
+ * @brief     panel source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 700
+#include "panel.h"
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/random.h>
+#include <termios.h>
+#include <unistd.h>
+
+/**
+ * @brief panel var definition
+ */
+static int gs_fd = -1;                                  /**< panel fd */
+static int gs_pd_fd = -1;                               /**< pd side fd of the pseudo terminal */
+static uint8_t gs_sqn = 0;                              /**< last sequence number */
+static uint8_t gs_buf[EM4095_OSDP_MAX_PACKET * 2];      /**< receive buffer */
+static uint16_t gs_len = 0;                             /**< received length */
+static uint8_t gs_packet[EM4095_OSDP_MAX_PACKET];       /**< last command */
+static uint16_t gs_packet_len = 0;                      /**< last command length */
+static em4095_osdp_sc_t gs_sc;                          /**< secure channel */
+
+/**
+ * @brief     set a fd to raw 8n1
+ * @param[in] fd file descriptor
+ * @param[in] baud baud rate
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      an unknown baud rate keeps the current one
+ */
+static uint8_t a_panel_raw(int fd, uint32_t baud)
+{
+    struct termios tio;
+    speed_t speed;
+
+    if (tcgetattr(fd, &tio) != 0)
+    {
+        return 1;
+    }
+    cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+    switch (baud)
+    {
+        case 9600 :
+        {
+            speed = B9600;
+
+            break;
+        }
+        case 19200 :
+        {
+            speed = B19200;
+
+            break;
+        }
+        case 38400 :
+        {
+            speed = B38400;
+
+            break;
+        }
+        case 57600 :
+        {
+            speed = B57600;
+
+            break;
+        }
+        case 230400 :
+        {
+            speed = B230400;
+
+            break;
+        }
+        default :
+        {
+            speed = B115200;
+
+            break;
+        }
+    }
+    (void)cfsetispeed(&tio, speed);
+    (void)cfsetospeed(&tio, speed);
+    if (tcsetattr(fd, TCSANOW, &tio) != 0)
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      open the panel
+ * @param[in]  *device pointer to a serial device path, NULL opens a pseudo terminal pair
+ * @param[in]  baud baud rate
+ * @param[out] *pd_fd pointer to a pd side fd buffer, -1 with a serial device
+ * @return     status code
+ *             - 0 success
+ *             - 1 open failed
+ * @note       both sides are raw 8n1
+ */
+uint8_t panel_open(const char *device, uint32_t baud, int *pd_fd)
+{
+    char *name;
+
+    gs_sqn = 0;
+    gs_len = 0;
+    gs_packet_len = 0;
+    gs_pd_fd = -1;
+    (void)em4095_osdp_sc_init(&gs_sc, NULL);
+    if (device != NULL)
+    {
+        gs_fd = open(device, O_RDWR | O_NOCTTY);
+        if (gs_fd < 0)
+        {
+            return 1;
+        }
+    }
+    else
+    {
+        gs_fd = posix_openpt(O_RDWR | O_NOCTTY);
+        if (gs_fd < 0)
+        {
+            return 1;
+        }
+        name = ((grantpt(gs_fd) == 0) && (unlockpt(gs_fd) == 0)) ? ptsname(gs_fd) : NULL;
+        gs_pd_fd = (name != NULL) ? open(name, O_RDWR | O_NOCTTY) : -1;
+        if ((gs_pd_fd < 0) || (a_panel_raw(gs_pd_fd, baud) != 0))
+        {
+            (void)panel_close();
+
+            return 1;
+        }
+    }
+    if (a_panel_raw(gs_fd, baud) != 0)
+    {
+        (void)panel_close();
+
+        return 1;
+    }
+    *pd_fd = gs_pd_fd;
+
+    return 0;
+}
+
+/**
+ * @brief  close the panel
+ * @return status code
+ *         - 0 success
+ * @note   the pd side fd is closed as well
+ */
+uint8_t panel_close(void)
+{
+    if (gs_pd_fd >= 0)
+    {
+        (void)close(gs_pd_fd);
+        gs_pd_fd = -1;
+    }
+    if (gs_fd >= 0)
+    {
+        (void)close(gs_fd);
+        gs_fd = -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      send the last command and wait the reply
+ * @param[in]  address pd address
+ * @param[out] *reply pointer to a reply packet
+ * @param[in]  timeout_ms reply timeout in ms
+ * @return     status code
+ *             - 0 success
+ *             - 1 send failed
+ *             - 2 reply timeout
+ * @note       none
+ */
+static uint8_t a_panel_exchange(uint8_t address, em4095_osdp_packet_t *reply, uint32_t timeout_ms)
+{
+    uint8_t res;
+    uint16_t used;
+    ssize_t l;
+    struct pollfd p;
+
+    /* send the command */
+    gs_len = 0;
+    if (write(gs_fd, gs_packet, gs_packet_len) != (ssize_t)gs_packet_len)
+    {
+        return 1;
+    }
+
+    /* wait the reply */
+    p.fd = gs_fd;
+    p.events = POLLIN;
+    while (1)
+    {
+        if (poll(&p, 1, (int)timeout_ms) <= 0)
+        {
+            return 2;
+        }
+        l = read(gs_fd, &gs_buf[gs_len], sizeof(gs_buf) - gs_len);
+        if (l <= 0)
+        {
+            return 2;
+        }
+        gs_len = (uint16_t)(gs_len + l);
+        while (1)
+        {
+            res = em4095_osdp_parse(gs_buf, gs_len, reply, &used);
+            if ((res == 0) && (reply->address == (uint8_t)(address | EM4095_OSDP_REPLY_FLAG)) &&
+                (reply->sqn == gs_sqn))
+            {
+                return 0;
+            }
+            if (used == 0)
+            {
+                break;
+            }
+            memmove(gs_buf, &gs_buf[used], gs_len - used);
+            gs_len = (uint16_t)(gs_len - used);
+            if (res == 1)
+            {
+                break;
+            }
+        }
+        if (gs_len == sizeof(gs_buf))
+        {
+            gs_len = 0;
+        }
+    }
+}
+
+/**
+ * @brief      send a command and wait the reply
+ * @param[in]  address pd address
+ * @param[in]  code command code
+ * @param[in]  *data pointer to a data buffer
+ * @param[in]  len data length
+ * @param[in]  repeat 1 sends the last command again with its sequence number
+ * @param[out] *reply pointer to a reply packet
+ * @param[in]  timeout_ms reply timeout in ms
+ * @return     status code
+ *             - 0 success
+ *             - 1 send failed
+ *             - 2 reply timeout
+ *             - 3 reply mac is wrong
+ * @note       the reply data points into the panel receive buffer or the secure channel until
+ *             the next command, the sequence number runs 1, 2, 3, 1 like a panel after the first
+ *             poll, in a session the command is secured and a plain reply ends the session
+ */
+uint8_t panel_command(uint8_t address, uint8_t code, const uint8_t *data, uint16_t len, uint8_t repeat,
+                      em4095_osdp_packet_t *reply, uint32_t timeout_ms)
+{
+    uint8_t res;
+
+    /* build the command, a repeat sends the same bytes so the mac chain stays */
+    if ((repeat == 0) || (gs_sqn == 0) || (gs_packet_len == 0))
+    {
+        gs_sqn = (uint8_t)((gs_sqn % 3) + 1);
+        if (gs_sc.state == EM4095_OSDP_SC_ACTIVE)
+        {
+            res = em4095_osdp_sc_build(&gs_sc, address, gs_sqn, code, data, len,
+                                       gs_packet, sizeof(gs_packet), &gs_packet_len);
+        }
+        else
+        {
+            res = em4095_osdp_build(address, gs_sqn, 1, code, data, len,
+                                    gs_packet, sizeof(gs_packet), &gs_packet_len);
+        }
+        if (res != 0)
+        {
+            gs_packet_len = 0;
+
+            return 1;
+        }
+    }
+
+    /* send it and check the reply */
+    res = a_panel_exchange(address, reply, timeout_ms);
+    if (res != 0)
+    {
+        return res;
+    }
+    if (gs_sc.state == EM4095_OSDP_SC_ACTIVE)
+    {
+        if (reply->scb == 0)
+        {
+            gs_sc.state = EM4095_OSDP_SC_NONE;
+        }
+        else if (em4095_osdp_sc_unwrap(&gs_sc, reply) != 0)
+        {
+            gs_sc.state = EM4095_OSDP_SC_NONE;
+
+            return 3;
+        }
+        else
+        {
+            /* clear reply */
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     start a secure channel session
+ * @param[in] address pd address
+ * @param[in] *scbk pointer to a 16 bytes base key, NULL for the default key scbk-d
+ * @param[in] timeout_ms reply timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 send failed
+ *            - 2 reply timeout
+ *            - 3 pd refused the session or its cryptogram is wrong
+ * @note      osdp_CHLNG gets osdp_CCRYPT, the client cryptogram proves the pd key, then
+ *            osdp_SCRYPT gets osdp_RMAC_I which seeds the mac chain of the session
+ */
+uint8_t panel_secure(uint8_t address, const uint8_t *scbk, uint32_t timeout_ms)
+{
+    uint8_t res;
+    uint8_t sec[3];
+    uint8_t rnd_a[EM4095_OSDP_RND_LEN];
+    uint8_t client[EM4095_AES_BLOCK];
+    uint8_t server[EM4095_AES_BLOCK];
+    uint8_t rmac_i[EM4095_AES_BLOCK];
+    em4095_osdp_packet_t reply;
+
+    /* challenge with a new random */
+    (void)em4095_osdp_sc_init(&gs_sc, scbk);
+    if (getrandom(rnd_a, sizeof(rnd_a), 0) != (ssize_t)sizeof(rnd_a))
+    {
+        return 1;
+    }
+    sec[0] = 3;
+    sec[1] = EM4095_OSDP_SCS_11;
+    sec[2] = gs_sc.key;
+    gs_sqn = (uint8_t)((gs_sqn % 3) + 1);
+    if (em4095_osdp_build_block(address, gs_sqn, sec, EM4095_OSDP_CMD_CHLNG, rnd_a, sizeof(rnd_a),
+                                gs_packet, sizeof(gs_packet), &gs_packet_len) != 0)
+    {
+        return 1;
+    }
+    res = a_panel_exchange(address, &reply, timeout_ms);
+    if (res != 0)
+    {
+        return res;
+    }
+
+    /* client uid, pd random and the client cryptogram */
+    if ((reply.code != EM4095_OSDP_REPLY_CCRYPT) || (reply.sec == NULL) ||
+        (reply.sec[1] != EM4095_OSDP_SCS_12) || (reply.len != 2 * EM4095_OSDP_RND_LEN + EM4095_AES_BLOCK))
+    {
+        return 3;
+    }
+    (void)em4095_osdp_sc_session(&gs_sc, rnd_a, &reply.data[EM4095_OSDP_RND_LEN], client);
+    if (memcmp(client, &reply.data[2 * EM4095_OSDP_RND_LEN], sizeof(client)) != 0)
+    {
+        gs_sc.state = EM4095_OSDP_SC_NONE;
+
+        return 3;
+    }
+
+    /* server cryptogram */
+    (void)em4095_osdp_sc_server(&gs_sc, server, rmac_i);
+    sec[1] = EM4095_OSDP_SCS_13;
+    gs_sqn = (uint8_t)((gs_sqn % 3) + 1);
+    if (em4095_osdp_build_block(address, gs_sqn, sec, EM4095_OSDP_CMD_SCRYPT, server, sizeof(server),
+                                gs_packet, sizeof(gs_packet), &gs_packet_len) != 0)
+    {
+        gs_sc.state = EM4095_OSDP_SC_NONE;
+
+        return 1;
+    }
+    res = a_panel_exchange(address, &reply, timeout_ms);
+    if (res != 0)
+    {
+        gs_sc.state = EM4095_OSDP_SC_NONE;
+
+        return res;
+    }
+    if ((reply.code != EM4095_OSDP_REPLY_RMAC_I) || (reply.sec == NULL) ||
+        (reply.sec[1] != EM4095_OSDP_SCS_14) || (reply.sec[0] != 3) || (reply.sec[2] != 0x01) ||
+        (reply.len != sizeof(rmac_i)) || (memcmp(rmac_i, reply.data, sizeof(rmac_i)) != 0))
+    {
+        gs_sc.state = EM4095_OSDP_SC_NONE;
+
+        return 3;
+    }
+
+    return 0;
+}
@@ -0,0 +1,635 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      replay.c
+ * @brief     replay source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "replay.h"
+#include "capture.h"
+#include "trace.h"
+#include "driver_em4095_interface.h"
+#include <dirent.h>
+#include <sys/stat.h>
+#include <time.h>
+
+/**
+ * @brief replay var definition
+ */
+static __thread em4095_handle_t gs_handle;                /**< em4095 handle */
+static __thread volatile uint8_t gs_flag;                 /**< done flag */
+static __thread uint8_t gs_samples_per_bit;               /**< samples per bit */
+static __thread uint8_t gs_decoded;                       /**< decoded flag */
+static __thread uint32_t gs_index;                        /**< decoded sample index */
+static __thread em4095_em4100_id_t gs_id;                 /**< decoded id */
+static __thread replay_failure_t gs_failure;              /**< failure class */
+static __thread em4095_slicer_t gs_slicer;                /**< bit slicer */
+static __thread em4095_em4100_t gs_em4100;                /**< em4100 decoder */
+static __thread em4095_em4100_combiner_t gs_combiner;     /**< em4100 frame combiner */
+static __thread uint8_t gs_vote;                          /**< voted frames, 0 disables the combiner */
+static __thread uint8_t gs_used;                          /**< frames used by the id */
+static __thread uint32_t gs_base;                         /**< samples before the decode buffer */
+static __thread uint8_t gs_header;                        /**< header found before an overflow */
+static __thread uint32_t gs_gaps;                         /**< gap events of the frame */
+static __thread uint32_t gs_overflows;                    /**< overflow events of the frame */
+static __thread const em4095_allow_t *gs_allow;           /**< allow list, NULL disables the check */
+static __thread uint8_t gs_allowed;                       /**< id is allowed */
+static __thread uint8_t gs_formats;                       /**< use the format engine */
+static __thread em4095_format_engine_t gs_format;         /**< format engine */
+static __thread replay_protocol_t gs_protocol;            /**< decoded protocol */
+
+/**
+ * @brief     replay check if an em4100 header is in the samples
+ * @param[in] *buf pointer to a decode buffer
+ * @param[in] len data length
+ * @return    1 if found else 0
+ * @note      a stop bit followed by 9 header ones is searched in both polarities and all phases
+ */
+static uint8_t a_replay_header_found(const em4095_decode_t *buf, uint16_t len)
+{
+    uint8_t phase;
+    uint16_t i;
+    uint16_t window;
+
+    for (phase = 0; phase < gs_samples_per_bit; phase++)
+    {
+        window = 0;
+        for (i = phase; i < len; i += gs_samples_per_bit)
+        {
+            window = (uint16_t)(((window << 1) | buf[i].level) & 0x3FF);
+            if ((window == 0x1FF) || (window == 0x200))
+            {
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief replay restart the streaming decoders
+ * @note  none
+ */
+static void a_replay_restart(void)
+{
+    (void)em4095_slicer_reset(&gs_slicer);
+    (void)em4095_em4100_init(&gs_em4100);
+    if (gs_formats != 0)
+    {
+        (void)em4095_format_reset(&gs_format);
+    }
+    if (gs_vote != 0)
+    {
+        (void)em4095_em4100_combiner_init(&gs_combiner, gs_vote);
+    }
+}
+
+/**
+ * @brief     replay sample callback
+ * @param[in] *ctx pointer to the interface context
+ * @param[in] index sample index
+ * @param[in] level sampled level
+ * @param[in] diff_us time from the previous sample
+ * @note      the frame is decoded while it is captured, the decoders keep their state when the
+ *            decode buffer restarts after an overflow
+ */
+static void a_replay_sample_callback(void *ctx, uint16_t index, uint8_t level, uint32_t diff_us)
+{
+    uint8_t i;
+    uint8_t count;
+    em4095_slicer_bit_t bit[EM4095_SLICER_MAX_BITS];
+    em4095_format_result_t format;
+
+    (void)ctx;
+
+    if (gs_decoded != 0)
+    {
+        return;
+    }
+    (void)em4095_slicer_push_sample(&gs_slicer, level, diff_us, bit, &count);
+    for (i = 0; (i < count) && (gs_decoded == 0); i++)
+    {
+        if (gs_formats != 0)
+        {
+            if (em4095_format_push_bit(&gs_format, bit[i].bit, &format) == 0)
+            {
+                /* the built in table order is the protocol order */
+                gs_protocol = (format.format == gs_format.table[0]) ? REPLAY_PROTOCOL_EM4100 : REPLAY_PROTOCOL_VIKING;
+                gs_id.version = (gs_protocol == REPLAY_PROTOCOL_EM4100) ? (uint8_t)format.field[0] : 0;
+                gs_id.id = (uint32_t)format.field[(gs_protocol == REPLAY_PROTOCOL_EM4100) ? 1 : 0];
+                gs_id.inverted = format.inverted;
+                gs_id.raw = format.raw[1];
+                gs_decoded = 1;
+                gs_index = gs_base + index;
+                gs_used = 1;
+            }
+        }
+        else if (gs_vote != 0)
+        {
+            if (em4095_em4100_combiner_push_bit(&gs_combiner, bit[i].bit, bit[i].confidence, &gs_id) == 0)
+            {
+                gs_decoded = 1;
+                gs_index = gs_base + index;
+                gs_used = gs_combiner.used;
+            }
+        }
+        else if (em4095_em4100_push_bit(&gs_em4100, bit[i].bit, &gs_id) == 0)
+        {
+            gs_decoded = 1;
+            gs_index = gs_base + index;
+            gs_used = 1;
+        }
+        else
+        {
+            /* no frame */
+        }
+    }
+
+    /* gate the id in the completion path */
+    if ((gs_decoded != 0) && (gs_allow != NULL))
+    {
+        (void)em4095_allow_check(gs_allow, EM4095_ALLOW_KEY(gs_id.version, gs_id.id), &gs_allowed);
+    }
+}
+
+/**
+ * @brief     replay event callback
+ * @param[in] *ctx pointer to the interface context
+ * @param[in] event frame boundary event
+ * @param[in] *buf pointer to the samples before the boundary
+ * @param[in] len data length
+ * @note      a gap restarts the decoders at once, an overflow only moves the sample base
+ */
+static void a_replay_event_callback(void *ctx, em4095_event_t event, em4095_decode_t *buf, uint16_t len)
+{
+    (void)ctx;
+
+    if ((gs_decoded == 0) && (a_replay_header_found(buf, len) != 0))
+    {
+        gs_header = 1;
+    }
+    gs_base += len;
+    if (event == EM4095_EVENT_GAP)
+    {
+        gs_gaps++;
+        a_replay_restart();
+    }
+    else
+    {
+        gs_overflows++;
+    }
+}
+
+/**
+ * @brief     replay receive callback
+ * @param[in] *ctx pointer to the interface context
+ * @param[in] mode running mode
+ * @param[in] *buf pointer to a decode buffer
+ * @param[in] len data length
+ * @note      none
+ */
+static void a_replay_receive_callback(void *ctx, em4095_mode_t mode, em4095_decode_t *buf, uint16_t len)
+{
+    (void)ctx;
+
+    if (mode == EM4095_MODE_READ)
+    {
+        if (gs_decoded == 0)
+        {
+            gs_failure = ((gs_header != 0) || (a_replay_header_found(buf, len) != 0)) ?
+                         REPLAY_FAILURE_CHECK : REPLAY_FAILURE_NO_SYNC;
+        }
+        gs_flag = 1;
+    }
+}
+
+/**
+ * @brief  replay get the monotonic time
+ * @return time in seconds
+ * @note   none
+ */
+static double a_replay_now(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/**
+ * @brief     replay init the handle
+ * @param[in] *header pointer to a capture header structure
+ * @param[in] *config pointer to a replay config structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+static uint8_t a_replay_init(const em4095_capture_header_t *header, const replay_config_t *config)
+{
+    uint64_t spb;
+    uint64_t half_us;
+
+    /* link interface function */
+    DRIVER_EM4095_LINK_INIT(&gs_handle, em4095_handle_t);
+    DRIVER_EM4095_LINK_SHD_GPIO_INIT(&gs_handle, em4095_interface_shd_gpio_init);
+    DRIVER_EM4095_LINK_SHD_GPIO_DEINIT(&gs_handle, em4095_interface_shd_gpio_deinit);
+    DRIVER_EM4095_LINK_SHD_GPIO_WRITE(&gs_handle, em4095_interface_shd_gpio_write);
+    DRIVER_EM4095_LINK_MOD_GPIO_INIT(&gs_handle, em4095_interface_mod_gpio_init);
+    DRIVER_EM4095_LINK_MOD_GPIO_DEINIT(&gs_handle, em4095_interface_mod_gpio_deinit);
+    DRIVER_EM4095_LINK_MOD_GPIO_WRITE(&gs_handle, em4095_interface_mod_gpio_write);
+    DRIVER_EM4095_LINK_DEMOD_GPIO_INIT(&gs_handle, em4095_interface_demod_gpio_init);
+    DRIVER_EM4095_LINK_DEMOD_GPIO_DEINIT(&gs_handle, em4095_interface_demod_gpio_deinit);
+    DRIVER_EM4095_LINK_DEMOD_GPIO_READ(&gs_handle, em4095_interface_demod_gpio_read);
+    DRIVER_EM4095_LINK_TIMESTAMP_READ(&gs_handle, em4095_interface_timestamp_read);
+    DRIVER_EM4095_LINK_DELAY_MS(&gs_handle, em4095_interface_delay_ms);
+    DRIVER_EM4095_LINK_DEBUG_PRINT(&gs_handle, em4095_interface_debug_print);
+    DRIVER_EM4095_LINK_RECEIVE_CALLBACK(&gs_handle, a_replay_receive_callback);
+    DRIVER_EM4095_LINK_SAMPLE_CALLBACK(&gs_handle, a_replay_sample_callback);
+    DRIVER_EM4095_LINK_EVENT_CALLBACK(&gs_handle, a_replay_event_callback);
+
+    /* init */
+    if (em4095_init(&gs_handle) != 0)
+    {
+        return 1;
+    }
+
+    /* use the recorded div */
+    if (em4095_set_div(&gs_handle, header->div) != 0)
+    {
+        (void)em4095_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* allow list */
+    gs_allow = config->allow;
+
+    /* format table */
+    gs_formats = config->formats;
+    if (gs_formats != 0)
+    {
+        const em4095_format_t *const *table;
+        uint8_t count;
+
+        (void)em4095_format_get_builtin(&table, &count);
+        if (em4095_format_init(&gs_format, table, count, EM4095_SLICER_CODING_MANCHESTER) != 0)
+        {
+            (void)em4095_deinit(&gs_handle);
+
+            return 1;
+        }
+    }
+
+    /* frame combiner */
+    gs_vote = config->vote;
+    if (gs_vote == 1)
+    {
+        (void)em4095_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* filters */
+    if ((em4095_set_oversample(&gs_handle, config->oversample) != 0) ||
+        (em4095_set_glitch_filter(&gs_handle, config->glitch) != 0) ||
+        (em4095_set_pll(&gs_handle, config->pll) != 0) ||
+        (em4095_set_gap(&gs_handle, config->gap) != 0))
+    {
+        (void)em4095_deinit(&gs_handle);
+
+        return 1;
+    }
+    trace_set_noise(config->noise_ppm, config->noise_width, header->reader_id);
+    trace_set_clock(config->clock_ppm, config->jitter, ~header->reader_id);
+
+    /* levels sampled per data bit */
+    spb = ((uint64_t)config->rate * header->clock_hz / config->carrier_hz) / header->div;
+    gs_samples_per_bit = (spb == 0) ? 1 : ((spb > 255) ? 255 : (uint8_t)spb);
+
+    /* half bit period of the tag */
+    half_us = (uint64_t)config->rate * 1000000 / config->carrier_hz / 2;
+    if (em4095_slicer_init(&gs_slicer, EM4095_SLICER_CODING_MANCHESTER, (half_us == 0) ? 1 : (uint32_t)half_us) != 0)
+    {
+        (void)em4095_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      replay one frame
+ * @param[in]  *header pointer to a capture header structure
+ * @param[in]  *frame pointer to a capture frame structure
+ * @param[out] *result pointer to a replay result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 frame is invalid
+ * @note       a frame without an id is a success, the failure class is saved to the result.
+ *             a frame longer than the decode buffer is streamed through the overflow event
+ */
+static uint8_t a_replay_frame(const em4095_capture_header_t *header, const em4095_capture_frame_t *frame,
+                              replay_result_t *result)
+{
+    uint8_t stream;
+    uint16_t samples;
+    uint16_t corrected;
+    uint16_t glitches;
+
+    /* load the trace */
+    gs_flag = 0;
+    gs_decoded = 0;
+    gs_allowed = 0;
+    gs_protocol = REPLAY_PROTOCOL_EM4100;
+    gs_failure = REPLAY_FAILURE_CORRUPT;
+    gs_base = 0;
+    gs_header = 0;
+    gs_gaps = 0;
+    gs_overflows = 0;
+    a_replay_restart();
+    if (trace_load(header, frame, &samples) != 0)
+    {
+        goto failed;
+    }
+    if (samples == 0)
+    {
+        goto failed;
+    }
+    stream = 0;
+    if (samples > EM4095_MAX_LENGTH - 1)
+    {
+        /* never ends by length, the trace end finishes it */
+        stream = 1;
+        samples = EM4095_MAX_LENGTH;
+    }
+
+    /* start reading */
+    if (em4095_read(&gs_handle, samples) != 0)
+    {
+        goto failed;
+    }
+    if (em4095_power_on(&gs_handle) != 0)
+    {
+        goto failed;
+    }
+
+    /* one irq per clock tick until the frame is done */
+    while (gs_flag == 0)
+    {
+        if (trace_tick() != 0)
+        {
+            break;
+        }
+        if (em4095_irq_handler(&gs_handle) != 0)
+        {
+            break;
+        }
+    }
+    result->ticks += trace_get_ticks();
+    result->signal_seconds += (double)trace_get_ticks() / (double)header->clock_hz;
+    result->gaps += gs_gaps;
+    result->overflows += gs_overflows;
+    (void)em4095_power_down(&gs_handle);
+    if ((gs_flag == 0) && (stream != 0))
+    {
+        /* the stream ends with the trace */
+        a_replay_receive_callback(gs_handle.ctx, EM4095_MODE_READ, gs_handle.decode, gs_handle.decode_len);
+    }
+    if (gs_flag == 0)
+    {
+        gs_failure = REPLAY_FAILURE_TRUNCATED;
+
+        goto failed;
+    }
+
+    /* save the result */
+    if (em4095_get_corrected_samples(&gs_handle, &corrected, &glitches) == 0)
+    {
+        result->corrected += corrected;
+        result->glitches += glitches;
+    }
+    if (gs_decoded != 0)
+    {
+        result->decoded++;
+        result->latency += (uint64_t)gs_index + 1;
+        if (gs_used > 1)
+        {
+            result->combined++;
+        }
+        result->protocol[gs_protocol]++;
+        if (gs_allow != NULL)
+        {
+            if (gs_allowed != 0)
+            {
+                result->allowed++;
+            }
+            else
+            {
+                result->denied++;
+            }
+        }
+    }
+    else
+    {
+        result->protocol[REPLAY_PROTOCOL_UNKNOWN]++;
+        result->failure[gs_failure]++;
+    }
+
+    return 0;
+
+    failed:
+    result->bad_frames++;
+    result->protocol[REPLAY_PROTOCOL_UNKNOWN]++;
+    result->failure[gs_failure]++;
+
+    return 1;
+}
+
+/**
+ * @brief      replay a capture file
+ * @param[in]  *path pointer to a file path
+ * @param[in]  *config pointer to a replay config structure
+ * @param[out] *result pointer to a replay result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 replay failed
+ * @note       the result is accumulated, clear it before the first call
+ */
+uint8_t replay_file(const char *path, const replay_config_t *config, replay_result_t *result)
+{
+    uint8_t res;
+    double start;
+    capture_file_t file;
+    em4095_capture_frame_t frame;
+
+    /* open the capture */
+    start = a_replay_now();
+    if (capture_open(&file, path) != 0)
+    {
+        result->bad_files++;
+
+        return 1;
+    }
+    if (a_replay_init(&file.header, config) != 0)
+    {
+        capture_close(&file);
+        result->bad_files++;
+
+        return 1;
+    }
+    result->files++;
+    result->reader_id = file.header.reader_id;
+
+    /* replay all frames */
+    while ((res = capture_read_frame(&file, &frame)) == 0)
+    {
+        result->frames++;
+        if (a_replay_frame(&file.header, &frame, result) != 0)
+        {
+            if (config->verbose != 0)
+            {
+                printf("%s: frame %u is invalid.\n", path, file.frame - 1);
+            }
+        }
+        else if (config->verbose != 0)
+        {
+            if ((gs_decoded != 0) && (gs_allow != NULL))
+            {
+                printf("%s: frame %u id 0x%02X%08X at sample %u, %s.\n", path, file.frame - 1,
+                       gs_id.version, gs_id.id, gs_index, (gs_allowed != 0) ? "allowed" : "denied");
+            }
+            else if (gs_decoded != 0)
+            {
+                printf("%s: frame %u id 0x%02X%08X at sample %u.\n", path, file.frame - 1,
+                       gs_id.version, gs_id.id, gs_index);
+            }
+            else
+            {
+                printf("%s: frame %u no id.\n", path, file.frame - 1);
+            }
+        }
+    }
+
+    /* blocks skipped for a bad crc */
+    result->frames += file.corrupt;
+    result->bad_frames += file.corrupt;
+    result->protocol[REPLAY_PROTOCOL_UNKNOWN] += file.corrupt;
+    result->failure[REPLAY_FAILURE_CORRUPT] += file.corrupt;
+    (void)em4095_deinit(&gs_handle);
+    capture_close(&file);
+    result->seconds += a_replay_now() - start;
+
+    return 0;
+}
+
+/**
+ * @brief      merge a replay result to another one
+ * @param[out] *dst pointer to a destination replay result structure
+ * @param[in]  *src pointer to a source replay result structure
+ * @note       the reader id isn't merged
+ */
+void replay_result_merge(replay_result_t *dst, const replay_result_t *src)
+{
+    uint8_t i;
+
+    dst->files += src->files;
+    dst->bad_files += src->bad_files;
+    dst->frames += src->frames;
+    dst->bad_frames += src->bad_frames;
+    dst->decoded += src->decoded;
+    dst->allowed += src->allowed;
+    dst->denied += src->denied;
+    for (i = 0; i < REPLAY_PROTOCOL_MAX; i++)
+    {
+        dst->protocol[i] += src->protocol[i];
+    }
+    for (i = 0; i < REPLAY_FAILURE_MAX; i++)
+    {
+        dst->failure[i] += src->failure[i];
+    }
+    dst->latency += src->latency;
+    dst->combined += src->combined;
+    dst->corrected += src->corrected;
+    dst->glitches += src->glitches;
+    dst->gaps += src->gaps;
+    dst->overflows += src->overflows;
+    dst->ticks += src->ticks;
+    dst->signal_seconds += src->signal_seconds;
+    dst->seconds += src->seconds;
+}
+
+/**
+ * @brief      replay all capture files of a directory
+ * @param[in]  *path pointer to a directory path
+ * @param[in]  *config pointer to a replay config structure
+ * @param[out] *result pointer to a replay result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 replay failed
+ * @note       files which are not captures are counted as bad files
+ */
+uint8_t replay_dir(const char *path, const replay_config_t *config, replay_result_t *result)
+{
+    DIR *dir;
+    struct dirent *entry;
+    char name[4096];
+    struct stat st;
+
+    /* open the directory */
+    dir = opendir(path);
+    if (dir == NULL)
+    {
+        return 1;
+    }
+
+    /* replay all regular files */
+    while ((entry = readdir(dir)) != NULL)
+    {
+        if (entry->d_name[0] == '.')
+        {
+            continue;
+        }
+        (void)snprintf(name, sizeof(name), "%s/%s", path, entry->d_name);
+        if ((stat(name, &st) != 0) || (S_ISREG(st.st_mode) == 0))
+        {
+            continue;
+        }
+        (void)replay_file(name, config, result);
+    }
+    (void)closedir(dir);
+
+    return 0;
+}
@@ -0,0 +1,298 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      rig.c
+ * @brief     rig source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 700
+#include "rig.h"
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+/**
+ * @brief rig var definition
+ */
+static int gs_fd = -1;                                                           /**< rig fd */
+static int gs_board_fd = -1;                                                     /**< board side fd of the pseudo terminal */
+static uint8_t gs_buf[(EM4095_HOST_MAX_PAYLOAD + EM4095_HOST_OVERHEAD) * 2];     /**< receive buffer */
+static uint16_t gs_len = 0;                                                      /**< received length */
+static uint16_t gs_drop = 0;                                                     /**< length of the last response */
+static uint32_t gs_skipped = 0;                                                  /**< skipped bytes */
+
+/**
+ * @brief rig baud rate table definition
+ */
+static const struct
+{
+    uint32_t baud;
+    speed_t speed;
+} gs_rig_speed[] =
+{
+    {9600, B9600}, {19200, B19200}, {38400, B38400}, {57600, B57600},
+    {115200, B115200}, {230400, B230400}, {460800, B460800}, {921600, B921600},
+    {1000000, B1000000}, {2000000, B2000000}, {3000000, B3000000}, {4000000, B4000000},
+};
+
+/**
+ * @brief     set a fd to raw 8n1
+ * @param[in] fd file descriptor
+ * @param[in] baud baud rate
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      an unknown baud rate is 115200
+ */
+static uint8_t a_rig_raw(int fd, uint32_t baud)
+{
+    struct termios tio;
+    speed_t speed;
+    size_t i;
+
+    if (tcgetattr(fd, &tio) != 0)
+    {
+        return 1;
+    }
+    cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+    speed = B115200;
+    for (i = 0; i < sizeof(gs_rig_speed) / sizeof(gs_rig_speed[0]); i++)
+    {
+        if (gs_rig_speed[i].baud == baud)
+        {
+            speed = gs_rig_speed[i].speed;
+        }
+    }
+    (void)cfsetispeed(&tio, speed);
+    (void)cfsetospeed(&tio, speed);
+    if (tcsetattr(fd, TCSANOW, &tio) != 0)
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      open the rig
+ * @param[in]  *device pointer to a serial device path, NULL opens a pseudo terminal pair
+ * @param[in]  baud baud rate
+ * @param[out] *board_fd pointer to a board side fd buffer, -1 with a serial device
+ * @return     status code
+ *             - 0 success
+ *             - 1 open failed
+ * @note       both sides are raw 8n1, 9600 to 4000000 baud
+ */
+uint8_t rig_open(const char *device, uint32_t baud, int *board_fd)
+{
+    char *name;
+
+    gs_len = 0;
+    gs_drop = 0;
+    gs_skipped = 0;
+    gs_board_fd = -1;
+    if (device != NULL)
+    {
+        gs_fd = open(device, O_RDWR | O_NOCTTY);
+        if (gs_fd < 0)
+        {
+            return 1;
+        }
+    }
+    else
+    {
+        gs_fd = posix_openpt(O_RDWR | O_NOCTTY);
+        if (gs_fd < 0)
+        {
+            return 1;
+        }
+        name = ((grantpt(gs_fd) == 0) && (unlockpt(gs_fd) == 0)) ? ptsname(gs_fd) : NULL;
+        gs_board_fd = (name != NULL) ? open(name, O_RDWR | O_NOCTTY) : -1;
+        if ((gs_board_fd < 0) || (a_rig_raw(gs_board_fd, baud) != 0))
+        {
+            (void)rig_close();
+
+            return 1;
+        }
+    }
+    if (a_rig_raw(gs_fd, baud) != 0)
+    {
+        (void)rig_close();
+
+        return 1;
+    }
+    *board_fd = gs_board_fd;
+
+    return 0;
+}
+
+/**
+ * @brief  close the rig
+ * @return status code
+ *         - 0 success
+ * @note   the board side fd is closed as well
+ */
+uint8_t rig_close(void)
+{
+    if (gs_board_fd >= 0)
+    {
+        (void)close(gs_board_fd);
+        gs_board_fd = -1;
+    }
+    if (gs_fd >= 0)
+    {
+        (void)close(gs_fd);
+        gs_fd = -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     send a request
+ * @param[in] seq sequence number
+ * @param[in] code request code
+ * @param[in] *data pointer to a payload buffer
+ * @param[in] len payload length
+ * @return    status code
+ *            - 0 success
+ *            - 1 send failed
+ * @note      it doesn't wait the response
+ */
+uint8_t rig_send(uint8_t seq, uint8_t code, const uint8_t *data, uint16_t len)
+{
+    uint8_t frame[EM4095_HOST_MAX_PAYLOAD + EM4095_HOST_OVERHEAD];
+    uint16_t n;
+    uint16_t pos;
+    ssize_t l;
+
+    /* build the request */
+    if (em4095_host_build(seq, code, data, len, frame, sizeof(frame), &n) != 0)
+    {
+        return 1;
+    }
+
+    /* write all */
+    pos = 0;
+    while (pos < n)
+    {
+        l = write(gs_fd, &frame[pos], n - pos);
+        if (l <= 0)
+        {
+            return 1;
+        }
+        pos = (uint16_t)(pos + l);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      receive the next response
+ * @param[out] *frame pointer to a frame structure
+ * @param[in]  timeout_ms response timeout in ms
+ * @return     status code
+ *             - 0 success
+ *             - 1 receive failed
+ *             - 2 response timeout
+ * @note       the frame payload points into the rig receive buffer until the next receive
+ */
+uint8_t rig_receive(em4095_host_frame_t *frame, uint32_t timeout_ms)
+{
+    uint8_t res;
+    uint16_t used;
+    ssize_t l;
+    struct pollfd p;
+
+    /* drop the last response */
+    memmove(gs_buf, &gs_buf[gs_drop], gs_len - gs_drop);
+    gs_len = (uint16_t)(gs_len - gs_drop);
+    gs_drop = 0;
+
+    p.fd = gs_fd;
+    p.events = POLLIN;
+    while (1)
+    {
+        /* parse the received bytes */
+        while (1)
+        {
+            res = em4095_host_parse(gs_buf, gs_len, frame, &used);
+            if (res == 0)
+            {
+                gs_drop = used;
+
+                return 0;
+            }
+            if (used == 0)
+            {
+                break;
+            }
+            gs_skipped += used;
+            memmove(gs_buf, &gs_buf[used], gs_len - used);
+            gs_len = (uint16_t)(gs_len - used);
+            if (res == 1)
+            {
+                break;
+            }
+        }
+
+        /* receive more */
+        if (poll(&p, 1, (int)timeout_ms) <= 0)
+        {
+            return 2;
+        }
+        l = read(gs_fd, &gs_buf[gs_len], sizeof(gs_buf) - gs_len);
+        if (l <= 0)
+        {
+            return 1;
+        }
+        gs_len = (uint16_t)(gs_len + l);
+    }
+}
+
+/**
+ * @brief  get the skipped bytes
+ * @return skipped byte number
+ * @note   bytes dropped before a sof and bad frames
+ */
+uint32_t rig_get_skipped(void)
+{
+    return gs_skipped;
+}
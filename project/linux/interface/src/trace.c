@@ -0,0 +1,333 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      trace.c
+ * @brief     trace source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "trace.h"
+
+/**
+ * @brief trace var definition
+ */
+static __thread em4095_capture_header_t gs_header;        /**< capture header */
+static __thread em4095_capture_frame_t gs_frame;          /**< capture frame */
+static __thread uint16_t gs_offset;                       /**< payload offset */
+static __thread uint64_t gs_ticks;                        /**< played ticks */
+static __thread uint64_t gs_edge;                         /**< next edge tick */
+static __thread uint64_t gs_base;                         /**< first run start tick */
+static __thread uint64_t gs_sum;                          /**< recorded ticks sum */
+static __thread uint8_t gs_level;                         /**< DEMOD_OUT level */
+static __thread uint8_t gs_lead;                          /**< lead in flag */
+static __thread uint8_t gs_end;                           /**< last run loaded */
+static __thread uint8_t gs_shd;                           /**< SHD level */
+static __thread uint8_t gs_mod;                           /**< MOD level */
+static __thread uint32_t gs_noise_ppm;                    /**< glitch rate per tick */
+static __thread uint32_t gs_noise_width;                  /**< glitch width in ticks */
+static __thread uint32_t gs_noise_left;                   /**< ticks left of the glitch */
+static __thread uint32_t gs_noise_seed;                   /**< noise random state */
+static __thread int32_t gs_clock_ppm;                     /**< tag clock offset */
+static __thread uint32_t gs_clock_jitter;                 /**< edge jitter in ticks */
+static __thread uint32_t gs_clock_seed;                   /**< jitter random state */
+
+/**
+ * @brief         trace get a random number
+ * @param[in,out] *state pointer to a random state
+ * @return        random number
+ * @note          xorshift32, every thread keeps its own state
+ */
+static uint32_t a_trace_random(uint32_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+
+    return *state;
+}
+
+/**
+ * @brief     trace convert recorded ticks to clock ticks
+ * @param[in] ticks recorded ticks
+ * @return    clock ticks
+ * @note      the tag clock offset is applied
+ */
+static uint64_t a_trace_scale(uint64_t ticks)
+{
+    uint64_t num;
+    uint64_t den;
+
+    num = ticks * gs_header.clock_hz * (uint64_t)(1000000 + (int64_t)gs_clock_ppm);
+    den = (uint64_t)gs_header.tick_hz * 1000000;
+
+    return (num + den / 2) / den;
+}
+
+/**
+ * @brief  load the next edge
+ * @return status code
+ *         - 0 success
+ *         - 1 no more runs
+ * @note   the edge ticks are derived from the recorded sum, so rounding and jitter never accumulate,
+ *         a jittered edge is kept after the previous one
+ */
+static uint8_t a_trace_next_edge(void)
+{
+    uint32_t duration;
+    uint64_t last;
+    int64_t edge;
+
+    if (em4095_capture_next_run(&gs_frame, &gs_offset, &duration) != 0)
+    {
+        return 1;
+    }
+    gs_sum += duration;
+    last = gs_edge;
+    edge = (int64_t)(gs_base + a_trace_scale(gs_sum));
+    if (gs_clock_jitter != 0)
+    {
+        edge += (int64_t)(a_trace_random(&gs_clock_seed) % (2 * gs_clock_jitter + 1)) - (int64_t)gs_clock_jitter;
+    }
+    gs_edge = (edge > (int64_t)last) ? (uint64_t)edge : last + 1;
+
+    return 0;
+}
+
+/**
+ * @brief     set the trace noise
+ * @param[in] ppm glitches per million ticks
+ * @param[in] width glitch width in ticks
+ * @param[in] seed random seed
+ * @note      a glitch inverts DEMOD_OUT, 0 ppm disables the noise
+ */
+void trace_set_noise(uint32_t ppm, uint32_t width, uint32_t seed)
+{
+    gs_noise_ppm = ppm;
+    gs_noise_width = (width == 0) ? 1 : width;
+    gs_noise_left = 0;
+    gs_noise_seed = (seed == 0) ? 0x9E3779B9U : seed;
+}
+
+/**
+ * @brief     set the tag clock of the trace
+ * @param[in] ppm tag clock offset in ppm, a positive offset stretches the recorded runs
+ * @param[in] jitter max edge jitter in ticks
+ * @param[in] seed random seed
+ * @note      every edge moves by a random -jitter to +jitter ticks on its own, so the jitter never
+ *            accumulates, while the offset walks the edges away from the recorded phase
+ */
+void trace_set_clock(int32_t ppm, uint32_t jitter, uint32_t seed)
+{
+    gs_clock_ppm = (ppm <= -1000000) ? -999999 : ppm;
+    gs_clock_jitter = jitter;
+    gs_clock_seed = (seed == 0) ? 0x85EBCA6BU : seed;
+}
+
+/**
+ * @brief     load a frame to the trace
+ * @param[in] *header pointer to a capture header structure
+ * @param[in] *frame pointer to a capture frame structure
+ * @param[out] *samples pointer to a sample number buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 frame is invalid
+ * @note      a lead in of div ticks with the opposite level is added, it ends on the first
+ *            recorded edge, so the driver syncs on it with the same phase as on the board
+ */
+uint8_t trace_load(const em4095_capture_header_t *header, const em4095_capture_frame_t *frame, uint16_t *samples)
+{
+    uint16_t offset;
+    uint32_t duration;
+    uint64_t total;
+    uint64_t n;
+
+    /* count the recorded ticks */
+    offset = 0;
+    total = 0;
+    while (em4095_capture_next_run(frame, &offset, &duration) == 0)
+    {
+        total += duration;
+    }
+    if ((frame->count == 0) || (offset != frame->size))
+    {
+        return 1;
+    }
+
+    /* init the trace */
+    gs_header = *header;
+    gs_frame = *frame;
+    gs_offset = 0;
+    gs_ticks = 0;
+    gs_sum = 0;
+    gs_end = 0;
+    gs_shd = 1;
+    gs_mod = 0;
+
+    /* lead in with the opposite level, it ends on the first recorded edge */
+    gs_lead = 1;
+    gs_level = (frame->level != 0) ? 0 : 1;
+    gs_edge = header->div;
+    gs_base = header->div;
+
+    /* samples in the frame */
+    n = (a_trace_scale(total) + header->div / 2) / header->div;
+    *samples = (n > 0xFFFF) ? 0xFFFF : (uint16_t)n;
+
+    return 0;
+}
+
+/**
+ * @brief  run one clock tick
+ * @return status code
+ *         - 0 success
+ *         - 1 end of the trace
+ * @note   none
+ */
+uint8_t trace_tick(void)
+{
+    gs_ticks++;
+    while (gs_ticks >= gs_edge)
+    {
+        if (gs_end != 0)
+        {
+            return 1;
+        }
+        if (gs_lead != 0)
+        {
+            /* end of the lead in */
+            gs_lead = 0;
+            gs_level = gs_frame.level;
+        }
+        else
+        {
+            gs_level = (gs_level != 0) ? 0 : 1;
+        }
+        if (a_trace_next_edge() != 0)
+        {
+            gs_end = 1;
+
+            return 1;
+        }
+    }
+
+    /* noise */
+    if (gs_noise_left != 0)
+    {
+        gs_noise_left--;
+    }
+    else if ((gs_noise_ppm != 0) && ((a_trace_random(&gs_noise_seed) % 1000000U) < gs_noise_ppm))
+    {
+        gs_noise_left = gs_noise_width;
+    }
+    else
+    {
+        /* no glitch */
+    }
+
+    return 0;
+}
+
+/**
+ * @brief  get the played ticks
+ * @return played ticks
+ * @note   none
+ */
+uint64_t trace_get_ticks(void)
+{
+    return gs_ticks;
+}
+
+/**
+ * @brief      trace read the DEMOD_OUT level
+ * @param[out] *level pointer to a level buffer
+ * @return     status code
+ *             - 0 success
+ * @note       the level is inverted while a noise glitch lasts
+ */
+uint8_t trace_read(uint8_t *level)
+{
+    *level = (gs_noise_left != 0) ? (uint8_t)(gs_level ^ 1) : gs_level;
+
+    return 0;
+}
+
+/**
+ * @brief      trace read the timestamp
+ * @param[out] *t pointer to an em4095_time structure
+ * @return     status code
+ *             - 0 success
+ * @note       the timestamp is derived from the ticks and the clock rate
+ */
+uint8_t trace_timestamp(em4095_time_t *t)
+{
+    uint64_t us;
+
+    if (gs_header.clock_hz == 0)
+    {
+        t->s = 0;
+        t->us = 0;
+
+        return 0;
+    }
+    us = gs_ticks * 1000000ULL / gs_header.clock_hz;
+    t->s = us / 1000000ULL;
+    t->us = (uint32_t)(us % 1000000ULL);
+
+    return 0;
+}
+
+/**
+ * @brief     trace write the SHD level
+ * @param[in] level set level
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t trace_shd_write(uint8_t level)
+{
+    gs_shd = level;
+
+    return 0;
+}
+
+/**
+ * @brief     trace write the MOD level
+ * @param[in] level set level
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t trace_mod_write(uint8_t level)
+{
+    gs_mod = level;
+
+    return 0;
+}
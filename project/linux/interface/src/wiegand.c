@@ -0,0 +1,303 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      wiegand.c
+ * @brief     wiegand source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#include "wiegand.h"
+
+/**
+ * @brief wiegand definition
+ */
+#define WIEGAND_FRAME_GAP_US        20000        /**< idle time after a frame */
+
+/**
+ * @brief wiegand var definition
+ */
+static em4095_wiegand_tx_t gs_tx;                        /**< transmitter */
+static wiegand_edge_t gs_edges[WIEGAND_TRACE_MAX];       /**< recorded edges */
+static uint32_t gs_count;                                /**< recorded edge number */
+static uint8_t gs_overflow;                              /**< trace overflow flag */
+static uint32_t gs_pulse_us;                             /**< slot time */
+static uint32_t gs_now_us;                               /**< simulated time */
+static uint32_t gs_next_us;                              /**< next slot time */
+static uint8_t gs_level[2];                              /**< line levels */
+
+/**
+ * @brief     set a line level
+ * @param[in] line line index
+ * @param[in] level line level
+ * @note      only a change is recorded
+ */
+static void a_wiegand_set(uint8_t line, uint8_t level)
+{
+    if (gs_level[line] == level)
+    {
+        return;
+    }
+    gs_level[line] = level;
+    if (gs_count < WIEGAND_TRACE_MAX)
+    {
+        gs_edges[gs_count].t_us = gs_next_us;
+        gs_edges[gs_count].line = line;
+        gs_edges[gs_count].level = level;
+        gs_count++;
+    }
+    else
+    {
+        gs_overflow = 1;
+    }
+}
+
+/**
+ * @brief     wiegand output init
+ * @param[in] pulse_us pulse width in us
+ * @param[in] interval_us bit interval in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 pulse_us or interval_us is invalid
+ * @note      the trace is cleared and both lines idle high
+ */
+uint8_t wiegand_init(uint32_t pulse_us, uint32_t interval_us)
+{
+    if ((pulse_us == 0) || (interval_us / pulse_us > 65535) || (WIEGAND_FRAME_GAP_US / pulse_us == 0))
+    {
+        return 2;
+    }
+    if (em4095_wiegand_tx_init(&gs_tx, (uint16_t)(interval_us / pulse_us),
+                               (uint16_t)(WIEGAND_FRAME_GAP_US / pulse_us)) != 0)
+    {
+        return 2;
+    }
+    gs_pulse_us = pulse_us;
+    gs_now_us = 0;
+    gs_next_us = 0;
+    gs_count = 0;
+    gs_overflow = 0;
+    gs_level[0] = 1;
+    gs_level[1] = 1;
+
+    return 0;
+}
+
+/**
+ * @brief  wiegand output deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t wiegand_deinit(void)
+{
+    gs_pulse_us = 0;
+
+    return 0;
+}
+
+/**
+ * @brief     queue a wiegand payload
+ * @param[in] payload right aligned payload, the first bit is the msb
+ * @param[in] bits payload bits
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ *            - 2 bits is invalid
+ * @note      none
+ */
+uint8_t wiegand_send(uint64_t payload, uint8_t bits)
+{
+    uint8_t res;
+
+    res = em4095_wiegand_tx_push_payload(&gs_tx, payload, bits);
+    if (res != 0)
+    {
+        return (res == 1) ? 1 : 2;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     queue an aba track 2 frame
+ * @param[in] *digits pointer to a decimal digit string
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ *            - 2 digits is invalid
+ * @note      none
+ */
+uint8_t wiegand_send_aba(const char *digits)
+{
+    uint8_t res;
+    uint8_t bits;
+    uint8_t buf[EM4095_WIEGAND_TX_MAX_BITS / 8];
+
+    if (em4095_wiegand_aba_encode(digits, buf, sizeof(buf), &bits) != 0)
+    {
+        return 2;
+    }
+    res = em4095_wiegand_tx_push(&gs_tx, EM4095_WIEGAND_TX_MODE_ABA, buf, bits);
+    if (res != 0)
+    {
+        return (res == 1) ? 1 : 2;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief  get the wiegand output busy status
+ * @return 1 while a frame is queued or sent
+ * @note   none
+ */
+uint8_t wiegand_busy(void)
+{
+    return ((gs_tx.active != 0) || (gs_tx.head != gs_tx.tail)) ? 1 : 0;
+}
+
+/**
+ * @brief     run the slot timer
+ * @param[in] us run time in us
+ * @note      one slot is clocked every pulse_us, the line changes are recorded
+ */
+void wiegand_run(uint32_t us)
+{
+    uint8_t lines;
+
+    if (gs_pulse_us == 0)
+    {
+        return;
+    }
+    gs_now_us += us;
+    while ((int32_t)(gs_now_us - gs_next_us) >= 0)
+    {
+        if (em4095_wiegand_tx_next(&gs_tx, &lines) == 0)
+        {
+            if ((lines & EM4095_WIEGAND_LINE_D0_LOW) != 0)
+            {
+                a_wiegand_set(0, 0);
+            }
+            if ((lines & EM4095_WIEGAND_LINE_D0_HIGH) != 0)
+            {
+                a_wiegand_set(0, 1);
+            }
+            if ((lines & EM4095_WIEGAND_LINE_D1_LOW) != 0)
+            {
+                a_wiegand_set(1, 0);
+            }
+            if ((lines & EM4095_WIEGAND_LINE_D1_HIGH) != 0)
+            {
+                a_wiegand_set(1, 1);
+            }
+        }
+        gs_next_us += gs_pulse_us;
+    }
+}
+
+/**
+ * @brief      get the recorded edges
+ * @param[out] **edges pointer to an edge table pointer
+ * @param[out] *count pointer to an edge number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 trace overflowed
+ * @note       none
+ */
+uint8_t wiegand_get_trace(const wiegand_edge_t **edges, uint32_t *count)
+{
+    *edges = gs_edges;
+    *count = gs_count;
+
+    return gs_overflow;
+}
+
+/**
+ * @brief      decode the recorded edges back to bits
+ * @param[in]  mode tx mode
+ * @param[out] *buf pointer to a bit buffer, the first bit is the msb of buf[0]
+ * @param[in]  len buffer length
+ * @param[out] *bits pointer to a bit number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is too small
+ * @note       a wiegand bit is a falling edge of d0 or d1, an aba bit is the inverted data level
+ *             at a falling edge of the clock
+ */
+uint8_t wiegand_decode(em4095_wiegand_tx_mode_t mode, uint8_t *buf, uint16_t len, uint16_t *bits)
+{
+    uint32_t i;
+    uint8_t data;
+    uint8_t b;
+    uint16_t n;
+
+    n = 0;
+    data = 1;
+    for (i = 0; i < gs_count; i++)
+    {
+        if (mode == EM4095_WIEGAND_TX_MODE_ABA)
+        {
+            if (gs_edges[i].line == 0)
+            {
+                data = gs_edges[i].level;
+
+                continue;
+            }
+            if (gs_edges[i].level != 0)
+            {
+                continue;
+            }
+            b = (data == 0) ? 1 : 0;
+        }
+        else
+        {
+            if (gs_edges[i].level != 0)
+            {
+                continue;
+            }
+            b = gs_edges[i].line;
+        }
+        if (n >= len * 8)
+        {
+            return 1;
+        }
+        if ((n % 8) == 0)
+        {
+            buf[n / 8] = 0;
+        }
+        buf[n / 8] |= (uint8_t)(b << (7 - (n % 8)));
+        n++;
+    }
+    *bits = n;
+
+    return 0;
+}
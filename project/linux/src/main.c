@@ -0,0 +1,3047 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      main.c
+ * @brief     main source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_em4095_capture.h"
+#include "driver_em4095_allow.h"
+#include "driver_em4095_wiegand.h"
+#include "driver_em4095_osdp.h"
+#include "driver_em4095_host.h"
+#include "driver_em4095_cache.h"
+#include "driver_em4095_log.h"
+#include "driver_em4095_interface.h"
+#include "driver_em4095_os.h"
+#include "capture.h"
+#include "replay.h"
+#include "analyze.h"
+#include "wiegand.h"
+#include "panel.h"
+#include "rig.h"
+#include "trace.h"
+#include <getopt.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <sys/random.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief     dump a capture file
+ * @param[in] *path pointer to a file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_dump(const char *path)
+{
+    uint8_t res;
+    capture_file_t file;
+    em4095_capture_frame_t frame;
+
+    /* open the file */
+    res = capture_open(&file, path);
+    if (res != 0)
+    {
+        printf("em4095: open %s failed.\n", path);
+
+        return 1;
+    }
+
+    /* print the header */
+    printf("em4095: version is %d.\n", file.header.version);
+    printf("em4095: mode is %d.\n", file.header.mode);
+    printf("em4095: div is %u.\n", file.header.div);
+    printf("em4095: tick rate is %uHz.\n", file.header.tick_hz);
+    printf("em4095: clock rate is %uHz.\n", file.header.clock_hz);
+    printf("em4095: reader id is 0x%08X.\n", file.header.reader_id);
+
+    /* print all frames */
+    while ((res = capture_read_frame(&file, &frame)) == 0)
+    {
+        uint16_t offset;
+        uint32_t duration;
+        uint64_t total;
+
+        offset = 0;
+        total = 0;
+        while (em4095_capture_next_run(&frame, &offset, &duration) == 0)
+        {
+            total += duration;
+        }
+        printf("frame %u: level %d, %d runs, %llu ticks.\n", file.frame - 1, frame.level,
+               frame.count, (unsigned long long)total);
+    }
+    if (file.corrupt != 0)
+    {
+        printf("em4095: skipped %u corrupt blocks.\n", file.corrupt);
+    }
+    capture_close(&file);
+
+    return 0;
+}
+
+/**
+ * @brief      load a whole file
+ * @param[in]  *path pointer to a file path
+ * @param[out] **buf pointer to a buffer pointer, free it after use
+ * @param[out] *len pointer to a length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 load failed
+ * @note       none
+ */
+static uint8_t a_load(const char *path, uint8_t **buf, uint32_t *len)
+{
+    FILE *fp;
+    long size;
+
+    /* open the file */
+    fp = fopen(path, "rb");
+    if (fp == NULL)
+    {
+        return 1;
+    }
+
+    /* get the size */
+    if ((fseek(fp, 0, SEEK_END) != 0) || ((size = ftell(fp)) < 0) || (fseek(fp, 0, SEEK_SET) != 0))
+    {
+        fclose(fp);
+
+        return 1;
+    }
+
+    /* read all */
+    *buf = (uint8_t *)malloc((size_t)size + 1);
+    if (*buf == NULL)
+    {
+        fclose(fp);
+
+        return 1;
+    }
+    if (fread(*buf, 1, (size_t)size, fp) != (size_t)size)
+    {
+        free(*buf);
+        *buf = NULL;
+        fclose(fp);
+
+        return 1;
+    }
+    *len = (uint32_t)size;
+    fclose(fp);
+
+    return 0;
+}
+
+/**
+ * @brief     build an allow list image
+ * @param[in] *path pointer to an id list path
+ * @param[in] *output pointer to an image path
+ * @param[in] bits_per_key bloom filter bits per key, 0 disables the filter
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the list has one hex id per line, '#' starts a comment. an output path ending with
+ *            .h is written as a const c array which can be linked to the flash
+ */
+static uint8_t a_allow_build(const char *path, const char *output, uint8_t bits_per_key)
+{
+    FILE *fp;
+    char line[128];
+    char *end;
+    uint8_t bloom_log2;
+    uint8_t hashes;
+    uint8_t res;
+    uint8_t *image;
+    uint32_t count;
+    uint32_t max;
+    uint32_t size;
+    uint32_t used;
+    uint32_t i;
+    uint32_t lines;
+    uint64_t *keys;
+    uint64_t key;
+    size_t n;
+
+    /* read the ids */
+    fp = fopen(path, "r");
+    if (fp == NULL)
+    {
+        printf("em4095: open %s failed.\n", path);
+
+        return 1;
+    }
+    count = 0;
+    max = 1024;
+    lines = 0;
+    keys = (uint64_t *)malloc(sizeof(uint64_t) * max);
+    if (keys == NULL)
+    {
+        fclose(fp);
+
+        return 1;
+    }
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        char *p;
+
+        lines++;
+        p = strchr(line, '#');
+        if (p != NULL)
+        {
+            *p = 0;
+        }
+        p = line;
+        while ((*p == ' ') || (*p == '\t'))
+        {
+            p++;
+        }
+        if ((*p == '\r') || (*p == '\n') || (*p == 0))
+        {
+            continue;
+        }
+        key = strtoull(p, &end, 16);
+        while ((*end == ' ') || (*end == '\t') || (*end == '\r') || (*end == '\n'))
+        {
+            end++;
+        }
+        if ((end == p) || (*end != 0) || (key > EM4095_ALLOW_KEY_MAX))
+        {
+            printf("em4095: %s line %u is invalid.\n", path, lines);
+            free(keys);
+            fclose(fp);
+
+            return 1;
+        }
+        if (count == max)
+        {
+            uint64_t *tmp;
+
+            max *= 2;
+            tmp = (uint64_t *)realloc(keys, sizeof(uint64_t) * max);
+            if (tmp == NULL)
+            {
+                free(keys);
+                fclose(fp);
+
+                return 1;
+            }
+            keys = tmp;
+        }
+        keys[count++] = key;
+    }
+    fclose(fp);
+
+    /* size the bloom filter */
+    bloom_log2 = 0;
+    hashes = 0;
+    if (bits_per_key != 0)
+    {
+        (void)em4095_allow_bloom_size(count, bits_per_key, &bloom_log2, &hashes);
+    }
+    if (em4095_allow_image_size(count, bloom_log2, &size) != 0)
+    {
+        free(keys);
+
+        return 1;
+    }
+
+    /* build the image */
+    image = (uint8_t *)malloc(size);
+    if (image == NULL)
+    {
+        free(keys);
+
+        return 1;
+    }
+    res = em4095_allow_build(keys, count, bloom_log2, hashes, image, size, &used);
+    free(keys);
+    if (res != 0)
+    {
+        printf("em4095: build failed.\n");
+        free(image);
+
+        return 1;
+    }
+
+    /* write the image */
+    fp = fopen(output, "wb");
+    if (fp == NULL)
+    {
+        printf("em4095: open %s failed.\n", output);
+        free(image);
+
+        return 1;
+    }
+    n = strlen(output);
+    if ((n > 2) && (strcmp(output + n - 2, ".h") == 0))
+    {
+        fprintf(fp, "/* em4095 allow list image, %u bytes */\n", used);
+        fprintf(fp, "static const uint8_t gs_allow_image[%u] =\n{", used);
+        for (i = 0; i < used; i++)
+        {
+            fprintf(fp, "%s0x%02X,", ((i % 16) == 0) ? "\n    " : " ", image[i]);
+        }
+        fprintf(fp, "\n};\n");
+    }
+    else
+    {
+        (void)fwrite(image, 1, used, fp);
+    }
+    if (fclose(fp) != 0)
+    {
+        free(image);
+
+        return 1;
+    }
+    printf("em4095: %u ids, %u unique.\n", count, image[8] | (image[9] << 8) | (image[10] << 16) | ((uint32_t)image[11] << 24));
+    printf("em4095: bloom filter %u bits, %u hashes.\n", (bloom_log2 != 0) ? (1U << bloom_log2) : 0, hashes);
+    printf("em4095: image %u bytes written to %s.\n", used, output);
+    free(image);
+
+    return 0;
+}
+
+/**
+ * @brief     play the queued wiegand frames on the stand-in
+ * @param[in] mode tx mode
+ * @param[out] *buf pointer to a bit buffer
+ * @param[in] len buffer length
+ * @param[out] *bits pointer to a bit number buffer
+ * @param[in] verbose print every edge
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the slot timer runs until the transmitter is idle, then the pulse train is decoded
+ */
+static uint8_t a_wiegand_play(em4095_wiegand_tx_mode_t mode, uint8_t *buf, uint16_t len, uint16_t *bits, uint8_t verbose)
+{
+    uint32_t i;
+    uint32_t count;
+    const wiegand_edge_t *edges;
+
+    while (wiegand_busy() != 0)
+    {
+        wiegand_run(1000);
+    }
+    if (wiegand_get_trace(&edges, &count) != 0)
+    {
+        printf("em4095: wiegand trace overflowed.\n");
+
+        return 1;
+    }
+    if (verbose != 0)
+    {
+        for (i = 0; i < count; i++)
+        {
+            printf("em4095: %8uus %s %s.\n", edges[i].t_us,
+                   (mode == EM4095_WIEGAND_TX_MODE_ABA) ? ((edges[i].line == 0) ? "data " : "clock") :
+                   ((edges[i].line == 0) ? "d0" : "d1"), (edges[i].level == 0) ? "low" : "high");
+        }
+    }
+    if (wiegand_decode(mode, buf, len, bits) != 0)
+    {
+        printf("em4095: wiegand decode failed.\n");
+
+        return 1;
+    }
+    printf("em4095: %u edges, %u bits in %uus.\n", count, *bits, (count != 0) ? edges[count - 1].t_us : 0);
+
+    return 0;
+}
+
+/**
+ * @brief     parse or encode a wiegand payload
+ * @param[in] *payload pointer to a hex payload string, empty to encode
+ * @param[in] length payload bits
+ * @param[in] *name pointer to a format name
+ * @param[in] facility facility code
+ * @param[in] card card number
+ * @param[in] verbose print every output edge
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      an encoded payload is sent through the output stand-in and decoded back from the pulse train
+ */
+static uint8_t a_wiegand(const char *payload, uint8_t length, const char *name, uint32_t facility, uint32_t card,
+                         uint8_t verbose)
+{
+    uint8_t i;
+    uint8_t count;
+    uint16_t j;
+    uint8_t frame[EM4095_WIEGAND_TX_MAX_BITS / 8];
+    uint8_t ref[EM4095_WIEGAND_TX_MAX_BITS / 8];
+    uint8_t ref_bits;
+    uint16_t bits;
+    uint64_t v;
+    char *end;
+    char digits[11];
+    const em4095_wiegand_format_t *table;
+    em4095_wiegand_card_t c;
+
+    /* parse the payload */
+    if (payload[0] != 0)
+    {
+        v = strtoull(payload, &end, 16);
+        if ((end == payload) || (*end != 0) || (length == 0) || (length > EM4095_WIEGAND_MAX_BITS) ||
+            ((length < 64) && ((v >> length) != 0)))
+        {
+            printf("em4095: payload is invalid.\n");
+
+            return 1;
+        }
+        if (em4095_wiegand_parse(v, length, &c) != 0)
+        {
+            printf("em4095: no %d bits format matched.\n", length);
+
+            return 1;
+        }
+        printf("em4095: format is %s.\n", c.format->name);
+        printf("em4095: facility code is %u.\n", c.facility);
+        printf("em4095: card number is %u.\n", c.card);
+
+        return 0;
+    }
+
+    /* 50us pulses every 2ms */
+    if (wiegand_init(50, 2000) != 0)
+    {
+        return 1;
+    }
+
+    /* send the card number as aba track 2 */
+    if (strcmp(name, "aba") == 0)
+    {
+        (void)snprintf(digits, sizeof(digits), "%u", card);
+        if ((em4095_wiegand_aba_encode(digits, ref, sizeof(ref), &ref_bits) != 0) || (wiegand_send_aba(digits) != 0))
+        {
+            printf("em4095: card is invalid.\n");
+            (void)wiegand_deinit();
+
+            return 1;
+        }
+        if (a_wiegand_play(EM4095_WIEGAND_TX_MODE_ABA, frame, sizeof(frame), &bits, verbose) != 0)
+        {
+            (void)wiegand_deinit();
+
+            return 1;
+        }
+        (void)wiegand_deinit();
+        if ((bits != ref_bits) || (memcmp(frame, ref, (size_t)((bits + 7) / 8)) != 0))
+        {
+            printf("em4095: aba frame mismatched.\n");
+
+            return 1;
+        }
+        printf("em4095: aba track 2 %s sent in %u bits.\n", digits, bits);
+
+        return 0;
+    }
+
+    /* encode the payload */
+    (void)em4095_wiegand_get_formats(&table, &count);
+    for (i = 0; i < count; i++)
+    {
+        if (strcmp(table[i].name, name) == 0)
+        {
+            break;
+        }
+    }
+    if (i == count)
+    {
+        printf("em4095: format %s is unknown.\n", name);
+        (void)wiegand_deinit();
+
+        return 1;
+    }
+    if (em4095_wiegand_encode(&table[i], facility, card, &v) != 0)
+    {
+        printf("em4095: facility or card is too large.\n");
+        (void)wiegand_deinit();
+
+        return 1;
+    }
+    printf("em4095: %s payload is 0x%0*llX, %d bits.\n", table[i].name, (table[i].bits + 3) / 4,
+           (unsigned long long)v, table[i].bits);
+
+    /* send it and read it back from the pulse train */
+    if ((wiegand_send(v, table[i].bits) != 0) ||
+        (a_wiegand_play(EM4095_WIEGAND_TX_MODE_WIEGAND, frame, sizeof(frame), &bits, verbose) != 0))
+    {
+        (void)wiegand_deinit();
+
+        return 1;
+    }
+    (void)wiegand_deinit();
+    if (bits != table[i].bits)
+    {
+        printf("em4095: sent %u bits, expected %d.\n", bits, table[i].bits);
+
+        return 1;
+    }
+    v = 0;
+    for (j = 0; j < bits; j++)
+    {
+        v = (v << 1) | ((frame[j / 8] >> (7 - (j % 8))) & 0x01);
+    }
+    if (em4095_wiegand_parse(v, (uint8_t)bits, &c) != 0)
+    {
+        printf("em4095: sent frame is invalid.\n");
+
+        return 1;
+    }
+    printf("em4095: sent %s facility %u card %u.\n", c.format->name, c.facility, c.card);
+
+    return 0;
+}
+
+/**
+ * @brief osdp pd var definition
+ */
+static em4095_osdp_pd_t gs_osdp_pd;                 /**< host pd */
+static int gs_osdp_fd = -1;                         /**< pd side fd */
+static volatile int gs_osdp_stop = 0;               /**< pd thread stop flag */
+
+/**
+ * @brief     osdp pd thread
+ * @param[in] *arg pointer to an argument
+ * @return    NULL
+ * @note      the board side of the pseudo terminal, the packets are parsed in place like on the target
+ */
+static void *a_osdp_pd_thread(void *arg)
+{
+    uint8_t res;
+    uint8_t buf[EM4095_OSDP_MAX_PACKET * 2];
+    uint16_t len;
+    uint16_t pos;
+    uint16_t used;
+    uint16_t reply_len;
+    const uint8_t *reply;
+    ssize_t l;
+    struct pollfd p;
+    em4095_osdp_packet_t packet;
+
+    (void)arg;
+    len = 0;
+    p.fd = gs_osdp_fd;
+    p.events = POLLIN;
+    while (gs_osdp_stop == 0)
+    {
+        if (poll(&p, 1, 10) <= 0)
+        {
+            continue;
+        }
+        l = read(gs_osdp_fd, &buf[len], sizeof(buf) - len);
+        if (l <= 0)
+        {
+            continue;
+        }
+        len = (uint16_t)(len + l);
+        pos = 0;
+        while (pos < len)
+        {
+            res = em4095_osdp_parse(&buf[pos], (uint16_t)(len - pos), &packet, &used);
+            pos = (uint16_t)(pos + used);
+            if (res == 1)
+            {
+                break;
+            }
+            if (res != 0)
+            {
+                gs_osdp_pd.errors++;
+
+                continue;
+            }
+            if (em4095_osdp_pd_handle(&gs_osdp_pd, &packet, &reply, &reply_len) == 0)
+            {
+                if (write(gs_osdp_fd, reply, reply_len) != (ssize_t)reply_len)
+                {
+                    gs_osdp_pd.errors++;
+                }
+            }
+        }
+        if ((pos == 0) && (len == sizeof(buf)))
+        {
+            pos = len;
+        }
+        memmove(buf, &buf[pos], len - pos);
+        len = (uint16_t)(len - pos);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief      osdp pd random source
+ * @param[out] *buf pointer to a random buffer
+ * @param[in]  len random length
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       none
+ */
+static uint8_t a_osdp_random(uint8_t *buf, uint16_t len)
+{
+    return (getrandom(buf, len, 0) == (ssize_t)len) ? 0 : 1;
+}
+
+/**
+ * @brief     print an osdp reply
+ * @param[in] *reply pointer to a reply packet
+ * @note      none
+ */
+static void a_osdp_print(const em4095_osdp_packet_t *reply)
+{
+    uint16_t i;
+    uint16_t bits;
+    uint64_t v;
+    em4095_wiegand_card_t c;
+
+    if ((reply->code == EM4095_OSDP_REPLY_RAW) && (reply->len >= 4))
+    {
+        bits = (uint16_t)(reply->data[2] | (reply->data[3] << 8));
+        printf("em4095: osdp_RAW reader %d format %d, %d bits:", reply->data[0], reply->data[1], bits);
+        for (i = 0; i < reply->len - 4; i++)
+        {
+            printf(" %02X", reply->data[4 + i]);
+        }
+        printf(".\n");
+        if ((reply->data[1] == EM4095_OSDP_RAW_FORMAT_WIEGAND) && (bits <= 64) && (reply->len - 4 >= (bits + 7) / 8))
+        {
+            v = 0;
+            for (i = 0; i < bits; i++)
+            {
+                v = (v << 1) | ((reply->data[4 + i / 8] >> (7 - (i % 8))) & 0x01);
+            }
+            if (em4095_wiegand_parse(v, (uint8_t)bits, &c) == 0)
+            {
+                printf("em4095: %s facility %u card %u.\n", c.format->name, c.facility, c.card);
+            }
+        }
+    }
+    else if ((reply->code == EM4095_OSDP_REPLY_FMT) && (reply->len >= 3))
+    {
+        printf("em4095: osdp_FMT reader %d direction %d, %.*s.\n", reply->data[0], reply->data[1],
+               (int)(reply->len - 3), (const char *)&reply->data[3]);
+    }
+    else if ((reply->code == EM4095_OSDP_REPLY_NAK) && (reply->len >= 1))
+    {
+        printf("em4095: osdp_NAK error %d.\n", reply->data[0]);
+    }
+    else if (reply->code == EM4095_OSDP_REPLY_ACK)
+    {
+        printf("em4095: osdp_ACK.\n");
+    }
+    else
+    {
+        printf("em4095: osdp reply 0x%02X, %d bytes.\n", reply->code, reply->len);
+    }
+}
+
+/**
+ * @brief     osdp compare a result with a known answer
+ * @param[in] *name pointer to a result name
+ * @param[in] *buf pointer to a result buffer
+ * @param[in] *expect pointer to a known answer
+ * @param[in] len compared length
+ * @return    status code
+ *            - 0 success
+ *            - 1 result is wrong
+ * @note      none
+ */
+static uint8_t a_osdp_match(const char *name, const uint8_t *buf, const uint8_t *expect, uint16_t len)
+{
+    if (memcmp(buf, expect, len) != 0)
+    {
+        printf("em4095: %s doesn't match the known answer.\n", name);
+
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief  osdp check the secure channel with known answers
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   the answers are from an independent aes-128 model, fips-197 c.1 for the block cipher, then
+ *         scbk-d, rnd.a 01..08 and rnd.b 09..10 for the session keys, the cryptograms, rmac_i, a scs_15
+ *         poll and the scs_18 reply 11 22 33 44 55, a symmetric bug of both sides is caught here
+ */
+static uint8_t a_osdp_vectors(void)
+{
+    uint8_t i;
+    uint8_t block[EM4095_AES_BLOCK];
+    uint8_t key[EM4095_AES_KEY];
+    uint8_t rnd_a[8];
+    uint8_t rnd_b[8];
+    uint8_t client[EM4095_AES_BLOCK];
+    uint8_t server[EM4095_AES_BLOCK];
+    uint8_t rmac_i[EM4095_AES_BLOCK];
+    uint8_t buf[EM4095_OSDP_MAX_PACKET];
+    uint16_t len;
+    uint16_t used;
+    em4095_aes_t aes;
+    em4095_osdp_sc_t acu;
+    em4095_osdp_sc_t pd;
+    em4095_osdp_packet_t packet;
+    static const uint8_t data[5] = {0x11, 0x22, 0x33, 0x44, 0x55};
+    static const uint8_t fips_ct[16] = {0x69, 0xC4, 0xE0, 0xD8, 0x6A, 0x7B, 0x04, 0x30,
+                                        0xD8, 0xCD, 0xB7, 0x80, 0x70, 0xB4, 0xC5, 0x5A};
+    static const uint8_t s_enc[16] = {0x90, 0x88, 0x00, 0x62, 0x79, 0xD4, 0x1B, 0x61,
+                                      0x8A, 0xCA, 0xF4, 0x76, 0x0E, 0x9D, 0xEE, 0xC6};
+    static const uint8_t s_mac1[16] = {0x33, 0x6A, 0x2F, 0xD8, 0x40, 0xA1, 0x0E, 0xFB,
+                                       0xB5, 0xC3, 0x22, 0x39, 0x7B, 0x97, 0x59, 0xEF};
+    static const uint8_t s_mac2[16] = {0xFB, 0x27, 0x1D, 0x4A, 0x53, 0xCD, 0x63, 0x4A,
+                                       0x17, 0xCD, 0xAC, 0x9C, 0x9A, 0xDC, 0x86, 0xBD};
+    static const uint8_t client_ct[16] = {0xD0, 0xF6, 0xF7, 0xFA, 0x4E, 0x55, 0x5F, 0x0D,
+                                          0xEF, 0x42, 0xF9, 0x62, 0x5F, 0xAA, 0x10, 0xF9};
+    static const uint8_t server_ct[16] = {0xFF, 0x5A, 0x4E, 0xA7, 0xA4, 0x43, 0x21, 0x02,
+                                          0xDE, 0x63, 0xCC, 0x68, 0xF8, 0x36, 0x74, 0xF5};
+    static const uint8_t rmac_i_ct[16] = {0xAA, 0x73, 0xFF, 0x4C, 0x29, 0xB6, 0xC3, 0xE7,
+                                          0xCC, 0x26, 0x87, 0xAA, 0x2B, 0xB6, 0x1F, 0x22};
+    static const uint8_t poll[14] = {0x53, 0x01, 0x0E, 0x00, 0x0D, 0x02, 0x15, 0x60,
+                                     0xEF, 0x59, 0x5E, 0x15, 0xF9, 0x2E};
+    static const uint8_t reply[30] = {0x53, 0x81, 0x1E, 0x00, 0x0D, 0x02, 0x18, 0x50,
+                                      0x60, 0x77, 0xEF, 0x7D, 0xC2, 0x14, 0x3A, 0x38,
+                                      0xAA, 0x8A, 0x3B, 0x5B, 0x1A, 0xA4, 0x60, 0x4C,
+                                      0xC2, 0xE8, 0xD9, 0x40, 0xB8, 0xFF};
+
+    /* aes-128 block */
+    for (i = 0; i < 16; i++)
+    {
+        key[i] = i;
+        block[i] = (uint8_t)(i * 0x11);
+    }
+    (void)em4095_aes_init(&aes, key);
+    (void)em4095_aes_encrypt(&aes, block);
+    if (a_osdp_match("aes-128 block", block, fips_ct, 16) != 0)
+    {
+        return 1;
+    }
+    (void)em4095_aes_decrypt(&aes, block);
+    for (i = 0; i < 16; i++)
+    {
+        if (block[i] != (uint8_t)(i * 0x11))
+        {
+            printf("em4095: aes-128 decrypt doesn't match the known answer.\n");
+
+            return 1;
+        }
+    }
+
+    /* session keys and cryptograms of both sides */
+    for (i = 0; i < 8; i++)
+    {
+        rnd_a[i] = (uint8_t)(0x01 + i);
+        rnd_b[i] = (uint8_t)(0x09 + i);
+    }
+    (void)em4095_osdp_sc_init(&acu, NULL);
+    (void)em4095_osdp_sc_init(&pd, NULL);
+    if ((em4095_osdp_sc_session(&acu, rnd_a, rnd_b, client) != 0) ||
+        (em4095_osdp_sc_session(&pd, rnd_a, rnd_b, client) != 0))
+    {
+        return 1;
+    }
+    if ((a_osdp_match("s-enc", acu.s_enc, s_enc, 16) != 0) ||
+        (a_osdp_match("s-mac1", acu.s_mac1, s_mac1, 16) != 0) ||
+        (a_osdp_match("s-mac2", acu.s_mac2, s_mac2, 16) != 0) ||
+        (a_osdp_match("client cryptogram", client, client_ct, 16) != 0))
+    {
+        return 1;
+    }
+    if ((em4095_osdp_sc_server(&acu, server, rmac_i) != 0) ||
+        (em4095_osdp_sc_server(&pd, server, rmac_i) != 0))
+    {
+        return 1;
+    }
+    if ((a_osdp_match("server cryptogram", server, server_ct, 16) != 0) ||
+        (a_osdp_match("rmac_i", rmac_i, rmac_i_ct, 16) != 0))
+    {
+        return 1;
+    }
+
+    /* a scs_15 poll of the panel, checked by the pd */
+    if ((em4095_osdp_sc_build(&acu, 0x01, 1, EM4095_OSDP_CMD_POLL, NULL, 0, buf, sizeof(buf), &len) != 0) ||
+        (len != sizeof(poll)))
+    {
+        printf("em4095: scs_15 poll is wrong.\n");
+
+        return 1;
+    }
+    if (a_osdp_match("scs_15 poll", buf, poll, sizeof(poll)) != 0)
+    {
+        return 1;
+    }
+    if ((em4095_osdp_parse(poll, sizeof(poll), &packet, &used) != 0) || (em4095_osdp_sc_unwrap(&pd, &packet) != 0))
+    {
+        printf("em4095: pd refused the scs_15 poll.\n");
+
+        return 1;
+    }
+
+    /* a scs_18 reply of the pd, decrypted by the panel */
+    if ((em4095_osdp_sc_build(&pd, 0x81, 1, EM4095_OSDP_REPLY_RAW, data, sizeof(data), buf, sizeof(buf), &len) != 0) ||
+        (len != sizeof(reply)))
+    {
+        printf("em4095: scs_18 reply is wrong.\n");
+
+        return 1;
+    }
+    if (a_osdp_match("scs_18 reply", buf, reply, sizeof(reply)) != 0)
+    {
+        return 1;
+    }
+    if ((em4095_osdp_parse(reply, sizeof(reply), &packet, &used) != 0) || (em4095_osdp_sc_unwrap(&acu, &packet) != 0) ||
+        (packet.len != sizeof(data)) || (memcmp(packet.data, data, sizeof(data)) != 0))
+    {
+        printf("em4095: panel refused the scs_18 reply.\n");
+
+        return 1;
+    }
+    printf("em4095: aes-128, session keys, cryptograms, rmac_i and scs_15 and scs_18 packets match the known answers.\n");
+
+    return 0;
+}
+
+/**
+ * @brief     run the osdp panel
+ * @param[in] *device pointer to a serial device path, empty serves a host pd on a pseudo terminal
+ * @param[in] baud baud rate
+ * @param[in] address pd address
+ * @param[in] *name pointer to a wiegand format name, fmt reports the card number as text
+ * @param[in] facility facility code
+ * @param[in] card card number
+ * @param[in] times poll times of a serial device
+ * @param[in] *key pointer to a 16 bytes secure channel base key, NULL for the default key
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      with the host pd, a wrong key is refused, then a card read is queued and the poll replies
+ *            and a repeated poll are checked in the secure channel, a serial pd is polled in the secure
+ *            channel when its capabilities report aes-128
+ */
+static uint8_t a_osdp(const char *device, uint32_t baud, uint8_t address, const char *name, uint32_t facility,
+                      uint32_t card, uint32_t times, const uint8_t *key)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t count;
+    uint8_t secure;
+    uint8_t buf[8];
+    uint8_t wrong[EM4095_AES_KEY];
+    uint8_t first[EM4095_OSDP_MAX_PACKET];
+    uint16_t first_len;
+    uint32_t t;
+    uint64_t v;
+    char text[11];
+    pthread_t thread;
+    em4095_osdp_packet_t reply;
+    const em4095_wiegand_format_t *table;
+    static const em4095_osdp_id_t id = {{0x00, 0x00, 0x00}, 0x01, 0x01, 0x00000001, {1, 0, 0}};
+
+    /* known answers of the secure channel */
+    if (a_osdp_vectors() != 0)
+    {
+        return 1;
+    }
+
+    /* open the panel */
+    if (panel_open((device[0] != 0) ? device : NULL, baud, &gs_osdp_fd) != 0)
+    {
+        printf("em4095: open the osdp panel failed.\n");
+
+        return 1;
+    }
+    if (device[0] == 0)
+    {
+        (void)em4095_osdp_pd_init(&gs_osdp_pd, address, 0, &id);
+        (void)em4095_osdp_pd_set_secure(&gs_osdp_pd, key, a_osdp_random);
+        gs_osdp_stop = 0;
+        if (pthread_create(&thread, NULL, a_osdp_pd_thread, NULL) != 0)
+        {
+            (void)panel_close();
+
+            return 1;
+        }
+    }
+
+    /* id and capabilities */
+    res = 1;
+    if ((panel_command(address, EM4095_OSDP_CMD_ID, NULL, 0, 0, &reply, 200) != 0) ||
+        (reply.code != EM4095_OSDP_REPLY_PDID) || (reply.len < 12))
+    {
+        printf("em4095: osdp id failed.\n");
+
+        goto exit;
+    }
+    printf("em4095: pd vendor %02X%02X%02X model %d version %d serial %08X firmware %d.%d.%d.\n",
+           reply.data[0], reply.data[1], reply.data[2], reply.data[3], reply.data[4],
+           (unsigned int)(reply.data[5] | (reply.data[6] << 8) | (reply.data[7] << 16) | ((uint32_t)reply.data[8] << 24)),
+           reply.data[9], reply.data[10], reply.data[11]);
+    if ((panel_command(address, EM4095_OSDP_CMD_CAP, NULL, 0, 0, &reply, 200) != 0) ||
+        (reply.code != EM4095_OSDP_REPLY_PDCAP))
+    {
+        printf("em4095: osdp cap failed.\n");
+
+        goto exit;
+    }
+    secure = 0;
+    for (i = 0; i + 2 < reply.len; i = (uint8_t)(i + 3))
+    {
+        printf("em4095: pd capability %d compliance %d items %d.\n", reply.data[i], reply.data[i + 1], reply.data[i + 2]);
+        if ((reply.data[i] == 9) && ((reply.data[i + 1] & 0x01) != 0))
+        {
+            secure = 1;
+        }
+    }
+
+    /* a wrong key is refused */
+    if (device[0] == 0)
+    {
+        for (i = 0; i < EM4095_AES_KEY; i++)
+        {
+            wrong[i] = (key != NULL) ? key[i] : (uint8_t)(0x30 + i);
+        }
+        wrong[EM4095_AES_KEY - 1] ^= 0x01;
+        if (panel_secure(address, wrong, 200) != 3)
+        {
+            printf("em4095: osdp wrong key is not refused.\n");
+
+            goto exit;
+        }
+        printf("em4095: a wrong key is refused.\n");
+    }
+
+    /* open the secure channel */
+    if (secure != 0)
+    {
+        res = panel_secure(address, key, 200);
+        if (res != 0)
+        {
+            printf("em4095: osdp secure channel failed with %d.\n", res);
+            res = 1;
+
+            goto exit;
+        }
+        res = 1;
+        printf("em4095: secure channel is open with the %s.\n", (key != NULL) ? "scbk" : "default key scbk-d");
+    }
+
+    /* poll a serial device */
+    if (device[0] != 0)
+    {
+        for (t = 0; t < times; t++)
+        {
+            if (panel_command(address, EM4095_OSDP_CMD_POLL, NULL, 0, 0, &reply, 200) != 0)
+            {
+                printf("em4095: osdp poll timeout.\n");
+
+                goto exit;
+            }
+            if (reply.code != EM4095_OSDP_REPLY_ACK)
+            {
+                a_osdp_print(&reply);
+            }
+            (void)usleep(200000);
+        }
+        res = 0;
+
+        goto exit;
+    }
+
+    /* an idle poll is acked in the session */
+    if ((panel_command(address, EM4095_OSDP_CMD_POLL, NULL, 0, 0, &reply, 200) != 0) ||
+        (reply.code != EM4095_OSDP_REPLY_ACK) || (reply.scb == 0))
+    {
+        printf("em4095: osdp idle poll failed.\n");
+
+        goto exit;
+    }
+    a_osdp_print(&reply);
+
+    /* queue a card read */
+    if (strcmp(name, "fmt") == 0)
+    {
+        (void)snprintf(text, sizeof(text), "%u", card);
+        res = em4095_osdp_pd_push_fmt(&gs_osdp_pd, text);
+    }
+    else
+    {
+        (void)em4095_wiegand_get_formats(&table, &count);
+        for (i = 0; i < count; i++)
+        {
+            if (strcmp(table[i].name, name) == 0)
+            {
+                break;
+            }
+        }
+        if ((i == count) || (em4095_wiegand_encode(&table[i], facility, card, &v) != 0))
+        {
+            printf("em4095: format or card is invalid.\n");
+            res = 1;
+
+            goto exit;
+        }
+        v <<= 64 - table[i].bits;
+        for (count = 0; count < 8; count++)
+        {
+            buf[count] = (uint8_t)(v >> (56 - count * 8));
+        }
+        res = em4095_osdp_pd_push_raw(&gs_osdp_pd, EM4095_OSDP_RAW_FORMAT_WIEGAND, buf, table[i].bits);
+    }
+    if (res != 0)
+    {
+        printf("em4095: queue the card failed.\n");
+        res = 1;
+
+        goto exit;
+    }
+    res = 1;
+
+    /* the next poll gets the encrypted card, a repeated poll gets it again */
+    if ((panel_command(address, EM4095_OSDP_CMD_POLL, NULL, 0, 0, &reply, 200) != 0) ||
+        (reply.sec == NULL) || (reply.sec[1] != EM4095_OSDP_SCS_18))
+    {
+        printf("em4095: osdp card poll failed.\n");
+
+        goto exit;
+    }
+    a_osdp_print(&reply);
+    first_len = reply.len;
+    memcpy(first, reply.data, reply.len);
+    if ((panel_command(address, EM4095_OSDP_CMD_POLL, NULL, 0, 1, &reply, 200) != 0) ||
+        (reply.len != first_len) || (memcmp(first, reply.data, first_len) != 0))
+    {
+        printf("em4095: osdp repeated poll failed.\n");
+
+        goto exit;
+    }
+    printf("em4095: repeated poll got the same reply.\n");
+    if ((panel_command(address, EM4095_OSDP_CMD_POLL, NULL, 0, 0, &reply, 200) != 0) ||
+        (reply.code != EM4095_OSDP_REPLY_ACK))
+    {
+        printf("em4095: osdp poll after the card failed.\n");
+
+        goto exit;
+    }
+    a_osdp_print(&reply);
+    res = 0;
+
+    exit:
+    if (device[0] == 0)
+    {
+        gs_osdp_stop = 1;
+        (void)pthread_join(thread, NULL);
+        printf("em4095: pd handled %u packets with %u errors.\n", gs_osdp_pd.packets, gs_osdp_pd.errors);
+    }
+    (void)panel_close();
+
+    return res;
+}
+
+/**
+ * @brief host board var definition
+ */
+static em4095_host_t gs_host;                       /**< board side host protocol */
+static int gs_host_fd = -1;                         /**< board side fd */
+static volatile int gs_host_stop = 0;               /**< board thread stop flag */
+static uint8_t gs_host_tag[256];                    /**< simulated tag memory */
+static uint32_t gs_host_config[5] =                 /**< div, oversample, glitch, gap and pll */
+{
+    64, 1, 0, 0, 0,
+};
+
+/**
+ * @brief      host board command callback
+ * @param[in]  code request code
+ * @param[in]  *data pointer to a payload buffer
+ * @param[in]  len payload length
+ * @param[out] *out pointer to a response data buffer
+ * @param[in]  size response data buffer size
+ * @param[out] *out_len pointer to a response data length buffer
+ * @return     em4095_host_status_t
+ * @note       a write is kept in the simulated tag and read back, a capture is a manchester frame
+ */
+static uint8_t a_host_command(uint8_t code, const uint8_t *data, uint16_t len,
+                              uint8_t *out, uint16_t size, uint16_t *out_len)
+{
+    uint8_t key;
+    uint16_t n;
+    uint16_t i;
+    uint32_t value;
+    em4095_decode_t decode[128];
+
+    switch (code)
+    {
+        case EM4095_HOST_CODE_READ :
+        case EM4095_HOST_CODE_CAPTURE :
+        {
+            if (len != 2)
+            {
+                return EM4095_HOST_STATUS_LENGTH;
+            }
+            n = (uint16_t)(data[0] | (data[1] << 8));
+            if ((n == 0) || (n > sizeof(gs_host_tag)) || (n > size))
+            {
+                return EM4095_HOST_STATUS_PARAM;
+            }
+            if (code == EM4095_HOST_CODE_READ)
+            {
+                memcpy(out, gs_host_tag, n);
+                *out_len = n;
+
+                return EM4095_HOST_STATUS_OK;
+            }
+            n = (n > 128) ? 128 : n;
+            for (i = 0; i < n; i++)
+            {
+                memset(&decode[i], 0, sizeof(em4095_decode_t));
+                decode[i].level = (uint8_t)((gs_host_tag[i / 8] >> (7 - (i % 8))) & 0x01);
+                decode[i].diff_us = 256;
+            }
+            *out_len = size;
+
+            return (em4095_capture_encode_frame(decode, n, out, out_len) == 0) ?
+                    EM4095_HOST_STATUS_OK : EM4095_HOST_STATUS_FAILED;
+        }
+        case EM4095_HOST_CODE_WRITE :
+        {
+            if ((len == 0) || (len > sizeof(gs_host_tag)))
+            {
+                return EM4095_HOST_STATUS_LENGTH;
+            }
+            memcpy(gs_host_tag, data, len);
+
+            return EM4095_HOST_STATUS_OK;
+        }
+        case EM4095_HOST_CODE_CONFIG :
+        {
+            if ((len != 1) && (len != 5))
+            {
+                return EM4095_HOST_STATUS_LENGTH;
+            }
+            key = data[0];
+            if ((key < EM4095_HOST_CONFIG_DIV) || (key > EM4095_HOST_CONFIG_PLL))
+            {
+                return EM4095_HOST_STATUS_UNKNOWN;
+            }
+            if (len == 5)
+            {
+                gs_host_config[key - 1] = (uint32_t)data[1] | ((uint32_t)data[2] << 8) |
+                                          ((uint32_t)data[3] << 16) | ((uint32_t)data[4] << 24);
+            }
+            value = gs_host_config[key - 1];
+            out[0] = (uint8_t)(value & 0xFF);
+            out[1] = (uint8_t)((value >> 8) & 0xFF);
+            out[2] = (uint8_t)((value >> 16) & 0xFF);
+            out[3] = (uint8_t)((value >> 24) & 0xFF);
+            *out_len = 4;
+
+            return EM4095_HOST_STATUS_OK;
+        }
+        default :
+        {
+            return EM4095_HOST_STATUS_UNKNOWN;
+        }
+    }
+}
+
+/**
+ * @brief     host board thread
+ * @param[in] *arg pointer to an argument
+ * @return    NULL
+ * @note      the board side of the pseudo terminal, the requests are parsed in place like on the target
+ */
+static void *a_host_board_thread(void *arg)
+{
+    uint8_t res;
+    uint8_t buf[EM4095_HOST_MAX_PAYLOAD + EM4095_HOST_OVERHEAD];
+    uint16_t len;
+    uint16_t used;
+    uint16_t response_len;
+    const uint8_t *response;
+    ssize_t l;
+    struct pollfd p;
+    em4095_host_frame_t frame;
+
+    (void)arg;
+    len = 0;
+    p.fd = gs_host_fd;
+    p.events = POLLIN;
+    while (gs_host_stop == 0)
+    {
+        res = em4095_host_parse(buf, len, &frame, &used);
+        if (res == 0)
+        {
+            if (em4095_host_handle(&gs_host, &frame, &response, &response_len) == 0)
+            {
+                if (write(gs_host_fd, response, response_len) != (ssize_t)response_len)
+                {
+                    gs_host.stats.errors++;
+                }
+            }
+        }
+        else if ((res == 4) || (used != 0))
+        {
+            gs_host.stats.errors++;
+        }
+        else
+        {
+            /* wait the rest */
+        }
+        if (used != 0)
+        {
+            memmove(buf, &buf[used], len - used);
+            len = (uint16_t)(len - used);
+        }
+        if (res != 1)
+        {
+            continue;
+        }
+        if (poll(&p, 1, 10) <= 0)
+        {
+            continue;
+        }
+        l = read(gs_host_fd, &buf[len], sizeof(buf) - len);
+        if (l > 0)
+        {
+            len = (uint16_t)(len + l);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief      send a request and wait its response
+ * @param[in]  seq sequence number
+ * @param[in]  code request code
+ * @param[in]  *data pointer to a payload buffer
+ * @param[in]  len payload length
+ * @param[out] *frame pointer to a response frame
+ * @return     status code
+ *             - 0 success
+ *             - 1 request failed
+ * @note       the response must carry the sequence number and an ok status
+ */
+static uint8_t a_host_request(uint8_t seq, uint8_t code, const uint8_t *data, uint16_t len, em4095_host_frame_t *frame)
+{
+    if ((rig_send(seq, code, data, len) != 0) || (rig_receive(frame, 1000) != 0))
+    {
+        printf("em4095: request 0x%02X timeout.\n", code);
+
+        return 1;
+    }
+    if ((frame->seq != seq) || (frame->code != (code | EM4095_HOST_RESPONSE_FLAG)) ||
+        (frame->len == 0) || (frame->data[0] != EM4095_HOST_STATUS_OK))
+    {
+        printf("em4095: request 0x%02X failed with status %d.\n", code, (frame->len != 0) ? frame->data[0] : -1);
+
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     run the host test rig
+ * @param[in] *device pointer to a serial device path, empty serves a host board on a pseudo terminal
+ * @param[in] baud baud rate
+ * @param[in] times write and read cycles
+ * @param[in] window max requests in flight
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the ping goes alone, then the cycles are pipelined, with the host board the read data
+ *            is checked against the written data
+ */
+static uint8_t a_host(const char *device, uint32_t baud, uint32_t times, uint32_t window)
+{
+    uint8_t res;
+    uint8_t buf[16];
+    uint8_t last[16];
+    uint8_t expect;
+    uint16_t last_len;
+    uint16_t i;
+    uint32_t sent;
+    uint32_t done;
+    uint32_t k;
+    double s;
+    struct timespec start;
+    struct timespec stop;
+    pthread_t thread;
+    em4095_host_frame_t frame;
+
+    /* open the rig */
+    if (window == 0)
+    {
+        window = 1;
+    }
+    if (rig_open((device[0] != 0) ? device : NULL, baud, &gs_host_fd) != 0)
+    {
+        printf("em4095: open the host rig failed.\n");
+
+        return 1;
+    }
+    if (device[0] == 0)
+    {
+        (void)em4095_host_init(&gs_host, a_host_command);
+        gs_host_stop = 0;
+        if (pthread_create(&thread, NULL, a_host_board_thread, NULL) != 0)
+        {
+            (void)rig_close();
+
+            return 1;
+        }
+    }
+
+    /* ping alone, it opens the binary mode of the board */
+    res = 1;
+    if (a_host_request(0, EM4095_HOST_CODE_PING, (const uint8_t *)"em4095", 6, &frame) != 0)
+    {
+        goto exit;
+    }
+    if ((frame.len != 10) || (memcmp(&frame.data[4], "em4095", 6) != 0))
+    {
+        printf("em4095: ping echo is wrong.\n");
+
+        goto exit;
+    }
+    printf("em4095: protocol version %d, max payload %d.\n", frame.data[1], frame.data[2] | (frame.data[3] << 8));
+
+    /* set and get the oversample */
+    buf[0] = EM4095_HOST_CONFIG_OVERSAMPLE;
+    buf[1] = 3;
+    buf[2] = 0;
+    buf[3] = 0;
+    buf[4] = 0;
+    if ((a_host_request(1, EM4095_HOST_CODE_CONFIG, buf, 5, &frame) != 0) ||
+        (a_host_request(2, EM4095_HOST_CODE_CONFIG, buf, 1, &frame) != 0) ||
+        (frame.len != 5) || (frame.data[1] != 3))
+    {
+        printf("em4095: config failed.\n");
+
+        goto exit;
+    }
+    printf("em4095: oversample set to %d.\n", frame.data[1]);
+
+    /* pipelined write and read cycles */
+    (void)clock_gettime(CLOCK_MONOTONIC, &start);
+    sent = 0;
+    done = 0;
+    while (done < times * 2)
+    {
+        while ((sent < times * 2) && (sent - done < window))
+        {
+            k = sent / 2;
+            for (i = 0; i < 8; i++)
+            {
+                buf[i] = (uint8_t)(k * 8 + i);
+            }
+            buf[8] = 8;
+            buf[9] = 0;
+            if (((sent % 2) == 0) ? (rig_send((uint8_t)sent, EM4095_HOST_CODE_WRITE, buf, 8) != 0) :
+                                    (rig_send((uint8_t)sent, EM4095_HOST_CODE_READ, &buf[8], 2) != 0))
+            {
+                printf("em4095: send failed.\n");
+
+                goto exit;
+            }
+            sent++;
+        }
+        if (rig_receive(&frame, 1000) != 0)
+        {
+            printf("em4095: response %u timeout.\n", done);
+
+            goto exit;
+        }
+        expect = ((done % 2) == 0) ? EM4095_HOST_CODE_WRITE : EM4095_HOST_CODE_READ;
+        if ((frame.seq != (uint8_t)done) || (frame.code != (expect | EM4095_HOST_RESPONSE_FLAG)) ||
+            (frame.len == 0) || (frame.data[0] != EM4095_HOST_STATUS_OK))
+        {
+            printf("em4095: response %u is wrong.\n", done);
+
+            goto exit;
+        }
+        if ((expect == EM4095_HOST_CODE_READ) && (device[0] == 0))
+        {
+            k = done / 2;
+            for (i = 0; i < 8; i++)
+            {
+                if ((frame.len != 9) || (frame.data[1 + i] != (uint8_t)(k * 8 + i)))
+                {
+                    printf("em4095: read %u doesn't match the write.\n", k);
+
+                    goto exit;
+                }
+            }
+        }
+        done++;
+    }
+    (void)clock_gettime(CLOCK_MONOTONIC, &stop);
+    s = (double)(stop.tv_sec - start.tv_sec) + (double)(stop.tv_nsec - start.tv_nsec) / 1000000000.0;
+    printf("em4095: %u write and read cycles with %u requests in flight in %.3fs, %.0f cycles per minute.\n",
+           times, window, s, (s > 0.0) ? (double)times * 60.0 / s : 0.0);
+
+    /* a repeated request gets the last response without running again */
+    buf[8] = 8;
+    buf[9] = 0;
+    if (a_host_request(3, EM4095_HOST_CODE_READ, &buf[8], 2, &frame) != 0)
+    {
+        goto exit;
+    }
+    last_len = (frame.len > sizeof(last)) ? (uint16_t)sizeof(last) : frame.len;
+    memcpy(last, frame.data, last_len);
+    if ((a_host_request(3, EM4095_HOST_CODE_READ, &buf[8], 2, &frame) != 0) ||
+        (frame.len != last_len) || (memcmp(last, frame.data, last_len) != 0))
+    {
+        printf("em4095: repeated request failed.\n");
+
+        goto exit;
+    }
+    printf("em4095: repeated request got the same response.\n");
+
+    /* stats */
+    if ((a_host_request(4, EM4095_HOST_CODE_STATS, NULL, 0, &frame) != 0) || (frame.len != 21))
+    {
+        printf("em4095: stats failed.\n");
+
+        goto exit;
+    }
+    for (i = 0; i < 5; i++)
+    {
+        k = (uint32_t)frame.data[1 + i * 4] | ((uint32_t)frame.data[2 + i * 4] << 8) |
+            ((uint32_t)frame.data[3 + i * 4] << 16) | ((uint32_t)frame.data[4 + i * 4] << 24);
+        printf("em4095: %s %u.\n", (i == 0) ? "frames" : (i == 1) ? "errors" : (i == 2) ? "repeats" :
+                                    (i == 3) ? "unknown" : "failed", k);
+    }
+    printf("em4095: rig skipped %u bytes.\n", rig_get_skipped());
+    res = 0;
+
+    exit:
+    if (device[0] == 0)
+    {
+        gs_host_stop = 1;
+        (void)pthread_join(thread, NULL);
+    }
+    (void)rig_close();
+
+    return res;
+}
+
+/**
+ * @brief blocking read var definition
+ */
+static em4095_handle_t gs_blocking_handle;           /**< em4095 handle */
+static em4095_os_sem_t gs_blocking_start;            /**< given when the chip is powered on */
+static em4095_capture_header_t gs_blocking_header;   /**< capture header */
+static em4095_capture_frame_t gs_blocking_frame;     /**< replayed frame */
+static volatile uint16_t gs_blocking_len;            /**< samples of the receive callback */
+static volatile uint64_t gs_blocking_done_us;        /**< irq completion time */
+
+/**
+ * @brief     blocking read shd gpio write
+ * @param[in] *ctx pointer to the interface context
+ * @param[in] data written data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the power on starts the clock irq thread
+ */
+static uint8_t a_blocking_shd_gpio_write(void *ctx, uint8_t data)
+{
+    if (data == 0)
+    {
+        (void)em4095_os_sem_give(gs_blocking_start);
+    }
+
+    return em4095_interface_shd_gpio_write(ctx, data);
+}
+
+/**
+ * @brief     blocking read receive callback
+ * @param[in] *ctx pointer to the interface context
+ * @param[in] mode em4095 mode
+ * @param[in] *buf pointer to a decode buffer
+ * @param[in] len data length
+ * @note      it runs in the clock irq thread
+ */
+static void a_blocking_receive_callback(void *ctx, em4095_mode_t mode, em4095_decode_t *buf, uint16_t len)
+{
+    uint64_t us;
+
+    (void)ctx;
+    (void)buf;
+    if (mode == EM4095_MODE_READ)
+    {
+        gs_blocking_len = len;
+        (void)em4095_os_monotonic_us(&us);
+        gs_blocking_done_us = us;
+    }
+}
+
+/**
+ * @brief     blocking read clock irq thread
+ * @param[in] *arg pointer to an argument
+ * @return    NULL
+ * @note      the trace is thread local, so the thread loads the frame and runs the irq once per clock
+ *            tick from the power on until the read is done
+ */
+static void *a_blocking_irq_thread(void *arg)
+{
+    uint16_t samples;
+
+    (void)arg;
+    if (trace_load(&gs_blocking_header, &gs_blocking_frame, &samples) != 0)
+    {
+        return NULL;
+    }
+    if (em4095_os_sem_take(gs_blocking_start, 1000) != 0)
+    {
+        return NULL;
+    }
+    while (__atomic_load_n(&gs_blocking_handle.mode, __ATOMIC_ACQUIRE) == EM4095_MODE_READ)
+    {
+        if (trace_tick() != 0)
+        {
+            break;
+        }
+        if (em4095_irq_handler(&gs_blocking_handle) != 0)
+        {
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief     read every frame of a capture with em4095_read_blocking
+ * @param[in] *path pointer to a capture path
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the reader sleeps on the completion semaphore while another thread feeds the irq from the
+ *            trace, a read without the irq thread must time out
+ */
+static uint8_t a_blocking(const char *path)
+{
+    uint8_t res;
+    uint16_t samples;
+    uint16_t len;
+    uint32_t frames;
+    uint32_t done;
+    uint64_t us;
+    uint64_t latency;
+    uint64_t max_latency;
+    pthread_t thread;
+    capture_file_t file;
+
+    /* open the capture */
+    if (capture_open(&file, path) != 0)
+    {
+        printf("em4095: open %s failed.\n", path);
+
+        return 1;
+    }
+    if (em4095_os_sem_create(&gs_blocking_start) != 0)
+    {
+        capture_close(&file);
+
+        return 1;
+    }
+
+    /* link interface function */
+    DRIVER_EM4095_LINK_INIT(&gs_blocking_handle, em4095_handle_t);
+    DRIVER_EM4095_LINK_SHD_GPIO_INIT(&gs_blocking_handle, em4095_interface_shd_gpio_init);
+    DRIVER_EM4095_LINK_SHD_GPIO_DEINIT(&gs_blocking_handle, em4095_interface_shd_gpio_deinit);
+    DRIVER_EM4095_LINK_SHD_GPIO_WRITE(&gs_blocking_handle, a_blocking_shd_gpio_write);
+    DRIVER_EM4095_LINK_MOD_GPIO_INIT(&gs_blocking_handle, em4095_interface_mod_gpio_init);
+    DRIVER_EM4095_LINK_MOD_GPIO_DEINIT(&gs_blocking_handle, em4095_interface_mod_gpio_deinit);
+    DRIVER_EM4095_LINK_MOD_GPIO_WRITE(&gs_blocking_handle, em4095_interface_mod_gpio_write);
+    DRIVER_EM4095_LINK_DEMOD_GPIO_INIT(&gs_blocking_handle, em4095_interface_demod_gpio_init);
+    DRIVER_EM4095_LINK_DEMOD_GPIO_DEINIT(&gs_blocking_handle, em4095_interface_demod_gpio_deinit);
+    DRIVER_EM4095_LINK_DEMOD_GPIO_READ(&gs_blocking_handle, em4095_interface_demod_gpio_read);
+    DRIVER_EM4095_LINK_TIMESTAMP_READ(&gs_blocking_handle, em4095_interface_timestamp_read);
+    DRIVER_EM4095_LINK_DELAY_MS(&gs_blocking_handle, em4095_interface_delay_ms);
+    DRIVER_EM4095_LINK_DEBUG_PRINT(&gs_blocking_handle, em4095_interface_debug_print);
+    DRIVER_EM4095_LINK_RECEIVE_CALLBACK(&gs_blocking_handle, a_blocking_receive_callback);
+    res = 1;
+    if (em4095_init(&gs_blocking_handle) != 0)
+    {
+        (void)em4095_os_sem_delete(gs_blocking_start);
+        capture_close(&file);
+
+        return 1;
+    }
+    if (em4095_set_div(&gs_blocking_handle, file.header.div) != 0)
+    {
+        goto exit;
+    }
+
+    /* read half of every frame, the clock irq thread sees the same trace */
+    gs_blocking_header = file.header;
+    frames = 0;
+    done = 0;
+    max_latency = 0;
+    while (capture_read_frame(&file, &gs_blocking_frame) == 0)
+    {
+        if ((trace_load(&gs_blocking_header, &gs_blocking_frame, &samples) != 0) || (samples < 2))
+        {
+            continue;
+        }
+        len = samples / 2;
+        if (len > EM4095_MAX_LENGTH - 1)
+        {
+            len = EM4095_MAX_LENGTH - 1;
+        }
+        frames++;
+        gs_blocking_len = 0;
+        (void)em4095_os_sem_take(gs_blocking_start, 0);
+        if (pthread_create(&thread, NULL, a_blocking_irq_thread, NULL) != 0)
+        {
+            goto exit;
+        }
+        if (em4095_read_blocking(&gs_blocking_handle, len, 1000) == 0)
+        {
+            (void)em4095_os_monotonic_us(&us);
+            latency = us - gs_blocking_done_us;
+            if (latency > max_latency)
+            {
+                max_latency = latency;
+            }
+            if (gs_blocking_len == len)
+            {
+                done++;
+            }
+        }
+        (void)pthread_join(thread, NULL);
+    }
+    printf("em4095: blocking reads %u, done %u, max wake latency %uus.\n", frames, done, (uint32_t)max_latency);
+    if ((frames == 0) || (done != frames))
+    {
+        goto exit;
+    }
+
+    /* without the clock irq thread the read must time out and stop */
+    if ((em4095_read_blocking(&gs_blocking_handle, 1, 50) != 5) || (gs_blocking_handle.mode != EM4095_MODE_IDLE))
+    {
+        printf("em4095: blocking read without irq didn't time out.\n");
+
+        goto exit;
+    }
+    printf("em4095: blocking read without irq timed out after 50ms.\n");
+    res = 0;
+
+    exit:
+    (void)em4095_deinit(&gs_blocking_handle);
+    (void)em4095_os_sem_delete(gs_blocking_start);
+    capture_close(&file);
+
+    return res;
+}
+
+/**
+ * @brief cache check definition
+ */
+#define CACHE_CHECK_KEYS         40              /**< tag keys of the random reads */
+#define CACHE_CHECK_STEPS        200000          /**< random reads and expiries */
+#define CACHE_CHECK_PHASE        2000            /**< steps with the same tags in the field */
+#define CACHE_CHECK_HOLDOFF      200             /**< hold off in ms */
+#define CACHE_CHECK_EXPIRY       1000            /**< expiry in ms */
+
+/**
+ * @brief cache check var definition
+ */
+static em4095_cache_t gs_cache;                                     /**< checked cache */
+static em4095_cache_entry_t gs_cache_model[EM4095_CACHE_SIZE];      /**< reference list of the tags */
+static uint16_t gs_cache_model_count;                               /**< tags in the reference list */
+static uint32_t gs_cache_seed;                                      /**< random seed */
+
+/**
+ * @brief  cache check random number
+ * @return random number
+ * @note   xorshift32, the same seed replays the same reads
+ */
+static uint32_t a_cache_random(void)
+{
+    gs_cache_seed ^= gs_cache_seed << 13;
+    gs_cache_seed ^= gs_cache_seed >> 17;
+    gs_cache_seed ^= gs_cache_seed << 5;
+
+    return gs_cache_seed;
+}
+
+/**
+ * @brief      cache check timestamp
+ * @param[in]  us time in us
+ * @param[out] *t pointer to a timestamp buffer
+ * @note       none
+ */
+static void a_cache_time(uint64_t us, em4095_time_t *t)
+{
+    t->s = us / 1000000ULL;
+    t->us = (uint32_t)(us % 1000000ULL);
+}
+
+/**
+ * @brief     cache check push a read to the reference list
+ * @param[in] key tag key
+ * @param[in] now read time in us
+ * @return    expected event
+ * @note      a linear list with the same hold off, expiry and least recently read eviction
+ */
+static em4095_cache_event_t a_cache_model_push(uint64_t key, uint64_t now)
+{
+    uint16_t i;
+    uint16_t oldest;
+
+    for (i = 0; i < gs_cache_model_count; i++)
+    {
+        if (gs_cache_model[i].key == key)
+        {
+            gs_cache_model[i].last_us = now;
+            gs_cache_model[i].reads++;
+            if (now - gs_cache_model[i].report_us >= (uint64_t)CACHE_CHECK_HOLDOFF * 1000)
+            {
+                gs_cache_model[i].report_us = now;
+
+                return EM4095_CACHE_EVENT_PRESENT;
+            }
+
+            return EM4095_CACHE_EVENT_NONE;
+        }
+    }
+    if (gs_cache_model_count >= EM4095_CACHE_SIZE)
+    {
+        oldest = 0;
+        for (i = 1; i < gs_cache_model_count; i++)
+        {
+            if (gs_cache_model[i].last_us < gs_cache_model[oldest].last_us)
+            {
+                oldest = i;
+            }
+        }
+        gs_cache_model[oldest] = gs_cache_model[gs_cache_model_count - 1];
+        gs_cache_model_count--;
+    }
+    gs_cache_model[gs_cache_model_count].key = key;
+    gs_cache_model[gs_cache_model_count].first_us = now;
+    gs_cache_model[gs_cache_model_count].last_us = now;
+    gs_cache_model[gs_cache_model_count].report_us = now;
+    gs_cache_model[gs_cache_model_count].reads = 1;
+    gs_cache_model[gs_cache_model_count].used = 1;
+    gs_cache_model_count++;
+
+    return EM4095_CACHE_EVENT_ARRIVED;
+}
+
+/**
+ * @brief     cache check compare the cache with the reference list
+ * @param[in] *slot pointer to the slot of every tag before the step, NULL skips the shift count
+ * @param[out] *shifted pointer to a shifted entries buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 the cache is different
+ * @note      every tag of the list must be found through its probe chain
+ */
+static uint8_t a_cache_compare(const uint16_t *slot, uint32_t *shifted)
+{
+    uint16_t i;
+    uint16_t index;
+    const em4095_cache_entry_t *entry;
+
+    if (gs_cache.count != gs_cache_model_count)
+    {
+        return 1;
+    }
+    for (i = 0; i < gs_cache_model_count; i++)
+    {
+        if (em4095_cache_find(&gs_cache, gs_cache_model[i].key, &entry) != 0)
+        {
+            return 1;
+        }
+        if ((entry->reads != gs_cache_model[i].reads) || (entry->last_us != gs_cache_model[i].last_us) ||
+            (entry->report_us != gs_cache_model[i].report_us))
+        {
+            return 1;
+        }
+        index = (uint16_t)(entry - gs_cache.entry);
+        if ((slot != NULL) && (slot[gs_cache_model[i].key % CACHE_CHECK_KEYS] != EM4095_CACHE_SIZE) &&
+            (slot[gs_cache_model[i].key % CACHE_CHECK_KEYS] != index))
+        {
+            (*shifted)++;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief  check the tag cache
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   a scripted tag checks the events, then random reads of more tags than entries are compared with a
+ *         linear reference list after every step, so the eviction and the backward shift deletion of the full
+ *         table are covered and the same seed replays the same run
+ */
+static uint8_t a_cache(void)
+{
+    uint8_t res;
+    uint16_t i;
+    uint16_t j;
+    uint16_t slot[CACHE_CHECK_KEYS];
+    uint32_t step;
+    uint32_t count[4];
+    uint32_t shifted;
+    uint32_t first;
+    uint32_t width;
+    uint64_t now;
+    uint64_t key;
+    uint64_t left[EM4095_CACHE_SIZE];
+    uint16_t left_len;
+    em4095_time_t t;
+    em4095_cache_event_t event;
+    em4095_cache_event_t expect;
+    const em4095_cache_entry_t *entry;
+
+    /* one tag: arrived, a duplicate, present after the hold off and left after the expiry */
+    if (em4095_cache_init(&gs_cache, 500, 1000) != 0)
+    {
+        return 1;
+    }
+    key = 0x0102030405ULL;
+    a_cache_time(0, &t);
+    res = em4095_cache_push(&gs_cache, key, &t, &event);
+    if ((res != 0) || (event != EM4095_CACHE_EVENT_ARRIVED))
+    {
+        printf("em4095: first read is not arrived.\n");
+
+        return 1;
+    }
+    a_cache_time(100000, &t);
+    res = em4095_cache_push(&gs_cache, key, &t, &event);
+    if ((res != 0) || (event != EM4095_CACHE_EVENT_NONE))
+    {
+        printf("em4095: read in the hold off is reported.\n");
+
+        return 1;
+    }
+    a_cache_time(500000, &t);
+    res = em4095_cache_push(&gs_cache, key, &t, &event);
+    if ((res != 0) || (event != EM4095_CACHE_EVENT_PRESENT) ||
+        (em4095_cache_find(&gs_cache, key, &entry) != 0) || (entry->reads != 3))
+    {
+        printf("em4095: read after the hold off is not present.\n");
+
+        return 1;
+    }
+    a_cache_time(1499999, &t);
+    if (em4095_cache_expire(&gs_cache, &t, &key, &event) != 1)
+    {
+        printf("em4095: tag left before the expiry.\n");
+
+        return 1;
+    }
+    a_cache_time(1500000, &t);
+    if ((em4095_cache_expire(&gs_cache, &t, &key, &event) != 0) || (event != EM4095_CACHE_EVENT_LEFT) ||
+        (key != 0x0102030405ULL) || (gs_cache.count != 0))
+    {
+        printf("em4095: tag didn't leave after the expiry.\n");
+
+        return 1;
+    }
+    printf("em4095: arrived, present and left events are right.\n");
+
+    /* random reads compared with the reference list */
+    if (em4095_cache_init(&gs_cache, CACHE_CHECK_HOLDOFF, CACHE_CHECK_EXPIRY) != 0)
+    {
+        return 1;
+    }
+    gs_cache_model_count = 0;
+    gs_cache_seed = 0x12345678U;
+    memset(count, 0, sizeof(count));
+    shifted = 0;
+    first = 0;
+    width = 1;
+    now = 0;
+    for (step = 0; step < CACHE_CHECK_STEPS; step++)
+    {
+        /* slots before the step */
+        for (i = 0; i < CACHE_CHECK_KEYS; i++)
+        {
+            slot[i] = EM4095_CACHE_SIZE;
+        }
+        for (i = 0; i < gs_cache_model_count; i++)
+        {
+            (void)em4095_cache_find(&gs_cache, gs_cache_model[i].key, &entry);
+            slot[gs_cache_model[i].key % CACHE_CHECK_KEYS] = (uint16_t)(entry - gs_cache.entry);
+        }
+
+        /* the tags in the field change, more tags than entries fill the table */
+        if ((step % CACHE_CHECK_PHASE) == 0)
+        {
+            first = a_cache_random() % CACHE_CHECK_KEYS;
+            width = 1 + a_cache_random() % CACHE_CHECK_KEYS;
+        }
+
+        /* the time never repeats, so the least recently read tag is unique */
+        now += 1 + a_cache_random() % 40000;
+        a_cache_time(now, &t);
+        if ((a_cache_random() % 8) != 0)
+        {
+            /* a read of the tags in the field, the key modulo the pool is the tag index */
+            key = (uint64_t)CACHE_CHECK_KEYS * 0x1000000000ULL + (first + a_cache_random() % width) % CACHE_CHECK_KEYS;
+            expect = a_cache_model_push(key, now);
+            if ((em4095_cache_push(&gs_cache, key, &t, &event) != 0) || (event != expect))
+            {
+                printf("em4095: step %u read event is %d, expect %d.\n", step, event, expect);
+
+                return 1;
+            }
+            count[event]++;
+        }
+        else
+        {
+            /* drain the expired tags and compare them as sets */
+            left_len = 0;
+            while ((left_len < EM4095_CACHE_SIZE) && (em4095_cache_expire(&gs_cache, &t, &key, &event) == 0))
+            {
+                left[left_len++] = key;
+                count[EM4095_CACHE_EVENT_LEFT]++;
+            }
+            i = 0;
+            while (i < gs_cache_model_count)
+            {
+                if (now - gs_cache_model[i].last_us >= (uint64_t)CACHE_CHECK_EXPIRY * 1000)
+                {
+                    for (j = 0; j < left_len; j++)
+                    {
+                        if (left[j] == gs_cache_model[i].key)
+                        {
+                            break;
+                        }
+                    }
+                    if (j == left_len)
+                    {
+                        printf("em4095: step %u tag didn't leave.\n", step);
+
+                        return 1;
+                    }
+                    left[j] = left[left_len - 1];
+                    left_len--;
+                    gs_cache_model[i] = gs_cache_model[gs_cache_model_count - 1];
+                    gs_cache_model_count--;
+                }
+                else
+                {
+                    i++;
+                }
+            }
+            if (left_len != 0)
+            {
+                printf("em4095: step %u tag left too early.\n", step);
+
+                return 1;
+            }
+        }
+        if (a_cache_compare(slot, &shifted) != 0)
+        {
+            printf("em4095: step %u cache is different from the reference list.\n", step);
+
+            return 1;
+        }
+    }
+    printf("em4095: %u steps, arrived %u, present %u, duplicate %u, left %u.\n", CACHE_CHECK_STEPS,
+           count[EM4095_CACHE_EVENT_ARRIVED], count[EM4095_CACHE_EVENT_PRESENT],
+           count[EM4095_CACHE_EVENT_NONE], count[EM4095_CACHE_EVENT_LEFT]);
+    printf("em4095: evicted %u, shifted back %u entries.\n", gs_cache.evicted, shifted);
+    if ((gs_cache.evicted == 0) || (shifted == 0))
+    {
+        printf("em4095: the full table wasn't covered.\n");
+
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief log check definition
+ */
+#define LOG_CHECK_RECORDS        100000        /**< records per producer */
+#define LOG_CHECK_MAX_THREADS    64            /**< max producers */
+
+/**
+ * @brief log check var definition
+ */
+static uint32_t gs_log_dropped_records[LOG_CHECK_MAX_THREADS];        /**< full ring drops per producer */
+static uint32_t gs_log_done;                                           /**< finished producers */
+
+/**
+ * @brief     log check write a packed record
+ * @param[in] level message level
+ * @param[in] *fmt pointer to a format
+ * @return    status code
+ *            - 0 success
+ *            - 1 ring is full
+ * @note      none
+ */
+static uint8_t a_log_packed(uint8_t level, const char *fmt, ...)
+{
+    uint8_t res;
+    va_list args;
+
+    va_start(args, fmt);
+    res = em4095_log_vwrite(level, fmt, args);
+    va_end(args);
+
+    return res;
+}
+
+/**
+ * @brief     log check producer thread
+ * @param[in] *arg pointer to the producer index
+ * @return    NULL
+ * @note      raw and packed records alternate, the string of a packed record is a temporary which is
+ *            overwritten right after the write, a full ring yields to the reader
+ */
+static void *a_log_producer_thread(void *arg)
+{
+    uint32_t p;
+    uint32_t i;
+    uint8_t res;
+    char name[16];
+
+    p = (uint32_t)(uintptr_t)arg;
+    for (i = 0; i < LOG_CHECK_RECORDS; i++)
+    {
+        if ((i % 2) == 0)
+        {
+            res = EM4095_LOG_WRITE(EM4095_LOG_LEVEL_INFO, "em4095: producer %u record %u raw 0x%08X.\n", p, i, i * 2654435761U);
+        }
+        else
+        {
+            snprintf(name, sizeof(name), "name%u", p);
+            res = a_log_packed(EM4095_LOG_LEVEL_DEBUG, "em4095: producer %u record %u packed %s %llu %.3f %ld.\n",
+                               p, i, name, ((unsigned long long)p << 40) | i, (double)i / 8.0, -(long)i);
+            memset(name, 'x', sizeof(name) - 1);
+        }
+        if (res != 0)
+        {
+            gs_log_dropped_records[p]++;
+            (void)sched_yield();
+        }
+    }
+    (void)__atomic_fetch_add(&gs_log_done, 1, __ATOMIC_RELEASE);
+
+    return NULL;
+}
+
+/**
+ * @brief     check the deferred log with many producers
+ * @param[in] threads producer threads, 0 means all cores
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the main thread is the only reader, every record is formatted by em4095_log_format and
+ *            compared with snprintf of the same values, the records of one producer must come in order
+ *            and the read and the dropped records must add up to the written ones
+ */
+static uint8_t a_log(uint32_t threads)
+{
+    uint8_t res;
+    uint8_t level;
+    uint32_t i;
+    uint32_t p;
+    uint32_t seq;
+    uint32_t running;
+    uint32_t done;
+    uint32_t dropped;
+    uint64_t read;
+    uint32_t next[LOG_CHECK_MAX_THREADS];
+    char text[128];
+    char expect[128];
+    char kind[8];
+    pthread_t thread[LOG_CHECK_MAX_THREADS];
+    em4095_log_record_t record;
+
+    /* start the producers */
+    if (threads == 0)
+    {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+
+        threads = (cores < 2) ? 2 : (uint32_t)cores;
+    }
+    if (threads > LOG_CHECK_MAX_THREADS)
+    {
+        threads = LOG_CHECK_MAX_THREADS;
+    }
+    memset(next, 0, sizeof(next));
+    memset(gs_log_dropped_records, 0, sizeof(gs_log_dropped_records));
+    gs_log_done = 0;
+    running = 0;
+    res = 1;
+    for (p = 0; p < threads; p++)
+    {
+        if (pthread_create(&thread[p], NULL, a_log_producer_thread, (void *)(uintptr_t)p) != 0)
+        {
+            goto exit;
+        }
+        running++;
+    }
+
+    /* read while they write, then drain */
+    read = 0;
+    while (1)
+    {
+        done = __atomic_load_n(&gs_log_done, __ATOMIC_ACQUIRE);
+        if (em4095_log_read(&record) != 0)
+        {
+            if (done == running)
+            {
+                if (em4095_log_get_free() != EM4095_LOG_WORDS)
+                {
+                    printf("em4095: %u ring words are never committed.\n", EM4095_LOG_WORDS - em4095_log_get_free());
+
+                    goto exit;
+                }
+
+                break;
+            }
+            (void)sched_yield();
+
+            continue;
+        }
+        if (em4095_log_format(&record, text, sizeof(text)) != 0)
+        {
+            printf("em4095: record %llu can't be formatted.\n", (unsigned long long)read);
+
+            goto exit;
+        }
+        if ((sscanf(text, "em4095: producer %u record %u %7s", &p, &seq, kind) != 3) || (p >= threads) || (seq < next[p]))
+        {
+            printf("em4095: record %llu is out of order: %s", (unsigned long long)read, text);
+
+            goto exit;
+        }
+        next[p] = seq + 1;
+        level = ((seq % 2) == 0) ? EM4095_LOG_LEVEL_INFO : EM4095_LOG_LEVEL_DEBUG;
+        if ((seq % 2) == 0)
+        {
+            snprintf(expect, sizeof(expect), "em4095: producer %u record %u raw 0x%08X.\n", p, seq, seq * 2654435761U);
+        }
+        else
+        {
+            snprintf(expect, sizeof(expect), "em4095: producer %u record %u packed name%u %llu %.3f %ld.\n",
+                     p, seq, p, ((unsigned long long)p << 40) | seq, (double)seq / 8.0, -(long)seq);
+        }
+        if ((record.level != level) || (record.packed != (seq % 2)) || (strcmp(text, expect) != 0))
+        {
+            printf("em4095: record %llu is wrong: %s", (unsigned long long)read, text);
+
+            goto exit;
+        }
+        read++;
+    }
+
+    res = 0;
+
+    exit:
+    for (i = 0; i < running; i++)
+    {
+        (void)pthread_join(thread[i], NULL);
+    }
+    if (res != 0)
+    {
+        return 1;
+    }
+
+    /* every record is read or dropped */
+    dropped = 0;
+    for (p = 0; p < threads; p++)
+    {
+        dropped += gs_log_dropped_records[p];
+    }
+    printf("em4095: %u producers wrote %u records, read %llu, dropped %u.\n", threads, threads * LOG_CHECK_RECORDS,
+           (unsigned long long)read, dropped);
+    if ((read + dropped != (uint64_t)threads * LOG_CHECK_RECORDS) || (dropped != em4095_log_get_dropped()))
+    {
+        printf("em4095: read and dropped records don't add up.\n");
+
+        return 1;
+    }
+    if ((read == 0) || (dropped == 0))
+    {
+        printf("em4095: the full ring wasn't covered.\n");
+
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     print a replay result
+ * @param[in] *result pointer to a replay result structure
+ * @param[in] expect min decoded percent
+ * @return    status code
+ *            - 0 success
+ *            - 1 decoded percent is too low
+ * @note      none
+ */
+static uint8_t a_print_result(const replay_result_t *result, double expect)
+{
+    double percent;
+
+    percent = (result->frames != 0) ? (100.0 * (double)result->decoded / (double)result->frames) : 0.0;
+    printf("em4095: files %u, bad files %u.\n", result->files, result->bad_files);
+    printf("em4095: frames %llu, bad frames %llu, decoded %llu (%0.2f%%).\n",
+           (unsigned long long)result->frames, (unsigned long long)result->bad_frames,
+           (unsigned long long)result->decoded, percent);
+    printf("em4095: protocol em4100 %llu, viking %llu, unknown %llu.\n",
+           (unsigned long long)result->protocol[REPLAY_PROTOCOL_EM4100],
+           (unsigned long long)result->protocol[REPLAY_PROTOCOL_VIKING],
+           (unsigned long long)result->protocol[REPLAY_PROTOCOL_UNKNOWN]);
+    if ((result->allowed != 0) || (result->denied != 0))
+    {
+        printf("em4095: allowed %llu, denied %llu.\n",
+               (unsigned long long)result->allowed, (unsigned long long)result->denied);
+    }
+    printf("em4095: failure no sync %llu, check %llu, truncated %llu, corrupt %llu.\n",
+           (unsigned long long)result->failure[REPLAY_FAILURE_NO_SYNC],
+           (unsigned long long)result->failure[REPLAY_FAILURE_CHECK],
+           (unsigned long long)result->failure[REPLAY_FAILURE_TRUNCATED],
+           (unsigned long long)result->failure[REPLAY_FAILURE_CORRUPT]);
+    printf("em4095: combined ids %llu.\n", (unsigned long long)result->combined);
+    printf("em4095: gap events %llu, overflow events %llu.\n",
+           (unsigned long long)result->gaps, (unsigned long long)result->overflows);
+    printf("em4095: corrected samples %llu, filtered glitches %llu.\n",
+           (unsigned long long)result->corrected, (unsigned long long)result->glitches);
+    if (result->decoded != 0)
+    {
+        printf("em4095: mean decode latency is %0.1f samples.\n",
+               (double)result->latency / (double)result->decoded);
+    }
+    if (result->seconds > 0.0)
+    {
+        printf("em4095: throughput is %0.1f frames/s, %0.1fx real time.\n",
+               (double)result->frames / result->seconds, result->signal_seconds / result->seconds);
+    }
+
+    /* check the decode rate */
+    if (percent < expect)
+    {
+        printf("em4095: decoded %0.2f%% is below %0.2f%%.\n", percent, expect);
+
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     analyze file callback
+ * @param[in] *path pointer to a file path
+ * @param[in] *result pointer to a replay result structure
+ * @note      none
+ */
+static void a_analyze_file_callback(const char *path, const replay_result_t *result)
+{
+    if (result->files == 0)
+    {
+        printf("%s: invalid capture.\n", path);
+    }
+    else
+    {
+        printf("%s: reader 0x%08X, frames %llu, decoded %llu.\n", path, result->reader_id,
+               (unsigned long long)result->frames, (unsigned long long)result->decoded);
+    }
+}
+
+/**
+ * @brief     analyze reader callback
+ * @param[in] reader_id reader id
+ * @param[in] *result pointer to a replay result structure
+ * @note      none
+ */
+static void a_analyze_reader_callback(uint32_t reader_id, const replay_result_t *result)
+{
+    printf("reader 0x%08X: files %u, frames %llu, decoded %llu, no sync %llu, check %llu, truncated %llu, corrupt %llu.\n",
+           reader_id, result->files, (unsigned long long)result->frames, (unsigned long long)result->decoded,
+           (unsigned long long)result->failure[REPLAY_FAILURE_NO_SYNC],
+           (unsigned long long)result->failure[REPLAY_FAILURE_CHECK],
+           (unsigned long long)result->failure[REPLAY_FAILURE_TRUNCATED],
+           (unsigned long long)result->failure[REPLAY_FAILURE_CORRUPT]);
+}
+
+/**
+ * @brief     analyze a capture directory tree
+ * @param[in] *dir pointer to a directory path
+ * @param[in] *config pointer to an analyze config structure
+ * @param[in] expect min decoded percent
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_analyze(const char *dir, const analyze_config_t *config, double expect)
+{
+    replay_result_t result;
+
+    /* analyze */
+    if (analyze_run(dir, config, &result) != 0)
+    {
+        printf("em4095: analyze %s failed.\n", dir);
+
+        return 1;
+    }
+
+    /* print the result */
+    return a_print_result(&result, expect);
+}
+
+/**
+ * @brief     replay a capture file or directory
+ * @param[in] *file pointer to a file path
+ * @param[in] *dir pointer to a directory path
+ * @param[in] *config pointer to a replay config structure
+ * @param[in] expect min decoded percent
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_replay(const char *file, const char *dir, const replay_config_t *config, double expect)
+{
+    uint8_t res;
+    replay_result_t result;
+
+    /* replay */
+    memset(&result, 0, sizeof(replay_result_t));
+    if (dir[0] != 0)
+    {
+        res = replay_dir(dir, config, &result);
+        if (res != 0)
+        {
+            printf("em4095: open %s failed.\n", dir);
+
+            return 1;
+        }
+    }
+    else
+    {
+        res = replay_file(file, config, &result);
+        if (res != 0)
+        {
+            printf("em4095: replay %s failed.\n", file);
+
+            return 1;
+        }
+    }
+
+    /* print the result */
+    return a_print_result(&result, expect);
+}
+
+/**
+ * @brief     em4095 full function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 5 param is invalid
+ * @note      none
+ */
+uint8_t em4095(uint8_t argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    char short_options[] = "hie:";
+    struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"information", no_argument, NULL, 'i'},
+        {"example", required_argument, NULL, 'e'},
+        {"file", required_argument, NULL, 1},
+        {"dir", required_argument, NULL, 2},
+        {"rate", required_argument, NULL, 3},
+        {"expect", required_argument, NULL, 4},
+        {"verbose", no_argument, NULL, 5},
+        {"threads", required_argument, NULL, 6},
+        {"oversample", required_argument, NULL, 7},
+        {"glitch", required_argument, NULL, 8},
+        {"noise", required_argument, NULL, 9},
+        {"noise-width", required_argument, NULL, 10},
+        {"vote", required_argument, NULL, 11},
+        {"gap", required_argument, NULL, 12},
+        {"allow", required_argument, NULL, 13},
+        {"output", required_argument, NULL, 14},
+        {"bits", required_argument, NULL, 15},
+        {"formats", no_argument, NULL, 16},
+        {"payload", required_argument, NULL, 17},
+        {"length", required_argument, NULL, 18},
+        {"format", required_argument, NULL, 19},
+        {"facility", required_argument, NULL, 20},
+        {"card", required_argument, NULL, 21},
+        {"device", required_argument, NULL, 22},
+        {"baud", required_argument, NULL, 23},
+        {"address", required_argument, NULL, 24},
+        {"times", required_argument, NULL, 25},
+        {"window", required_argument, NULL, 26},
+        {"key", required_argument, NULL, 27},
+        {"pll", required_argument, NULL, 28},
+        {"ppm", required_argument, NULL, 29},
+        {"jitter", required_argument, NULL, 30},
+        {NULL, 0, NULL, 0},
+    };
+    char type[33] = "unknown";
+    char file[256] = "";
+    char dir[256] = "";
+    double expect = 0.0;
+    char allow_path[256] = "";
+    char output[256] = "";
+    replay_config_t config = {REPLAY_DEFAULT_RATE, REPLAY_DEFAULT_CARRIER, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, NULL, 0};
+    uint32_t threads = 0;
+    uint8_t bits = 10;
+    char payload[33] = "";
+    char format[33] = "h10301";
+    uint8_t length = 26;
+    uint32_t facility = 0;
+    uint32_t card = 0;
+    char device[256] = "";
+    uint32_t baud = 115200;
+    uint8_t address = 0;
+    uint32_t times = 10;
+    uint32_t window = 16;
+    uint8_t key[EM4095_AES_KEY];
+    uint8_t key_set = 0;
+    uint8_t res;
+    uint8_t *image = NULL;
+    uint32_t image_len = 0;
+    em4095_allow_t allow;
+
+    /* if no params */
+    if (argc == 1)
+    {
+        /* goto the help */
+        goto help;
+    }
+
+    /* init 0 */
+    optind = 0;
+
+    /* parse */
+    do
+    {
+        /* parse the args */
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+
+        /* judge the result */
+        switch (c)
+        {
+            /* help */
+            case 'h' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "h");
+
+                break;
+            }
+
+            /* information */
+            case 'i' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "i");
+
+                break;
+            }
+
+            /* example */
+            case 'e' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "e_%s", optarg);
+
+                break;
+            }
+
+            /* file */
+            case 1 :
+            {
+                /* set the file */
+                memset(file, 0, sizeof(char) * 256);
+                snprintf(file, 255, "%s", optarg);
+
+                break;
+            }
+
+            /* dir */
+            case 2 :
+            {
+                /* set the dir */
+                memset(dir, 0, sizeof(char) * 256);
+                snprintf(dir, 255, "%s", optarg);
+
+                break;
+            }
+
+            /* rate */
+            case 3 :
+            {
+                /* set the rate */
+                config.rate = (uint32_t)atol(optarg);
+                if (config.rate == 0)
+                {
+                    return 5;
+                }
+
+                break;
+            }
+
+            /* expect */
+            case 4 :
+            {
+                /* set the expect */
+                expect = atof(optarg);
+
+                break;
+            }
+
+            /* verbose */
+            case 5 :
+            {
+                /* set the verbose */
+                config.verbose = 1;
+
+                break;
+            }
+
+            /* threads */
+            case 6 :
+            {
+                /* set the threads */
+                threads = (uint32_t)atol(optarg);
+
+                break;
+            }
+
+            /* oversample */
+            case 7 :
+            {
+                /* set the oversample */
+                config.oversample = (uint8_t)atoi(optarg);
+
+                break;
+            }
+
+            /* glitch */
+            case 8 :
+            {
+                /* set the glitch */
+                config.glitch = (uint8_t)atoi(optarg);
+
+                break;
+            }
+
+            /* noise */
+            case 9 :
+            {
+                /* set the noise */
+                config.noise_ppm = (uint32_t)atol(optarg);
+
+                break;
+            }
+
+            /* noise width */
+            case 10 :
+            {
+                /* set the noise width */
+                config.noise_width = (uint32_t)atol(optarg);
+
+                break;
+            }
+
+            /* vote */
+            case 11 :
+            {
+                /* set the vote */
+                config.vote = (uint8_t)atoi(optarg);
+                if (config.vote == 1)
+                {
+                    return 5;
+                }
+
+                break;
+            }
+
+            /* gap */
+            case 12 :
+            {
+                /* set the gap */
+                config.gap = (uint16_t)atoi(optarg);
+
+                break;
+            }
+
+            /* allow */
+            case 13 :
+            {
+                /* set the allow list */
+                memset(allow_path, 0, sizeof(char) * 256);
+                snprintf(allow_path, 255, "%s", optarg);
+
+                break;
+            }
+
+            /* output */
+            case 14 :
+            {
+                /* set the output */
+                memset(output, 0, sizeof(char) * 256);
+                snprintf(output, 255, "%s", optarg);
+
+                break;
+            }
+
+            /* bits */
+            case 15 :
+            {
+                /* set the bloom filter bits */
+                bits = (uint8_t)atoi(optarg);
+
+                break;
+            }
+
+            /* formats */
+            case 16 :
+            {
+                /* set the formats */
+                config.formats = 1;
+
+                break;
+            }
+
+            /* payload */
+            case 17 :
+            {
+                /* set the payload */
+                memset(payload, 0, sizeof(char) * 33);
+                snprintf(payload, 32, "%s", optarg);
+
+                break;
+            }
+
+            /* length */
+            case 18 :
+            {
+                /* set the length */
+                length = (uint8_t)atoi(optarg);
+
+                break;
+            }
+
+            /* format */
+            case 19 :
+            {
+                /* set the format */
+                memset(format, 0, sizeof(char) * 33);
+                snprintf(format, 32, "%s", optarg);
+
+                break;
+            }
+
+            /* facility */
+            case 20 :
+            {
+                /* set the facility */
+                facility = (uint32_t)strtoul(optarg, NULL, 10);
+
+                break;
+            }
+
+            /* card */
+            case 21 :
+            {
+                /* set the card */
+                card = (uint32_t)strtoul(optarg, NULL, 10);
+
+                break;
+            }
+
+            /* osdp device */
+            case 22 :
+            {
+                /* set the device */
+                memset(device, 0, sizeof(char) * 256);
+                strncpy(device, optarg, 255);
+
+                break;
+            }
+
+            /* osdp baud rate */
+            case 23 :
+            {
+                /* set the baud rate */
+                baud = (uint32_t)strtoul(optarg, NULL, 10);
+
+                break;
+            }
+
+            /* osdp address */
+            case 24 :
+            {
+                /* set the address */
+                address = (uint8_t)strtoul(optarg, NULL, 10);
+                if (address >= EM4095_OSDP_BROADCAST)
+                {
+                    printf("em4095: address must be 0 - %d.\n", EM4095_OSDP_BROADCAST - 1);
+
+                    return 5;
+                }
+
+                break;
+            }
+
+            /* poll times */
+            case 25 :
+            {
+                /* set the times */
+                times = (uint32_t)strtoul(optarg, NULL, 10);
+
+                break;
+            }
+
+            /* window */
+            case 26 :
+            {
+                /* set the window */
+                window = (uint32_t)strtoul(optarg, NULL, 10);
+
+                break;
+            }
+
+            /* secure channel base key */
+            case 27 :
+            {
+                uint8_t i;
+                char hex[3];
+                char *end;
+
+                /* set the key */
+                if (strlen(optarg) != EM4095_AES_KEY * 2)
+                {
+                    printf("em4095: key must be %d hex characters.\n", EM4095_AES_KEY * 2);
+
+                    return 5;
+                }
+                for (i = 0; i < EM4095_AES_KEY; i++)
+                {
+                    hex[0] = optarg[i * 2];
+                    hex[1] = optarg[i * 2 + 1];
+                    hex[2] = 0;
+                    key[i] = (uint8_t)strtoul(hex, &end, 16);
+                    if (*end != 0)
+                    {
+                        printf("em4095: key must be %d hex characters.\n", EM4095_AES_KEY * 2);
+
+                        return 5;
+                    }
+                }
+                key_set = 1;
+
+                break;
+            }
+
+            /* pll */
+            case 28 :
+            {
+                /* set the pll */
+                config.pll = (uint8_t)atoi(optarg);
+                if (config.pll > EM4095_MAX_PLL_SHIFT)
+                {
+                    printf("em4095: pll must be 0 - %d.\n", EM4095_MAX_PLL_SHIFT);
+
+                    return 5;
+                }
+
+                break;
+            }
+
+            /* tag clock offset */
+            case 29 :
+            {
+                /* set the ppm */
+                config.clock_ppm = (int32_t)atol(optarg);
+
+                break;
+            }
+
+            /* edge jitter */
+            case 30 :
+            {
+                /* set the jitter */
+                config.jitter = (uint32_t)atol(optarg);
+
+                break;
+            }
+
+            /* the end */
+            case -1 :
+            {
+                break;
+            }
+
+            /* others */
+            default :
+            {
+                return 5;
+            }
+        }
+    } while (c != -1);
+
+    /* load the allow list */
+    if ((allow_path[0] != 0) && ((strcmp("e_replay", type) == 0) || (strcmp("e_analyze", type) == 0)))
+    {
+        if (a_load(allow_path, &image, &image_len) != 0)
+        {
+            printf("em4095: open %s failed.\n", allow_path);
+
+            return 1;
+        }
+        if (em4095_allow_init(&allow, image, image_len) != 0)
+        {
+            printf("em4095: %s is not an allow list image.\n", allow_path);
+            free(image);
+
+            return 1;
+        }
+        config.allow = &allow;
+    }
+
+    /* run the function */
+    if (strcmp("e_dump", type) == 0)
+    {
+        /* dump the capture */
+        return a_dump(file);
+    }
+    else if (strcmp("e_replay", type) == 0)
+    {
+        /* replay the captures */
+        res = a_replay(file, dir, &config, expect);
+        free(image);
+
+        return res;
+    }
+    else if (strcmp("e_analyze", type) == 0)
+    {
+        analyze_config_t analyze;
+
+        /* analyze the captures */
+        analyze.replay = config;
+        analyze.threads = threads;
+        analyze.file_callback = a_analyze_file_callback;
+        analyze.reader_callback = a_analyze_reader_callback;
+
+        res = a_analyze(dir, &analyze, expect);
+        free(image);
+
+        return res;
+    }
+    else if (strcmp("e_allow", type) == 0)
+    {
+        /* build the allow list */
+        return a_allow_build(file, output, bits);
+    }
+    else if (strcmp("e_wiegand", type) == 0)
+    {
+        /* parse or encode the wiegand payload */
+        return a_wiegand(payload, length, format, facility, card, config.verbose);
+    }
+    else if (strcmp("e_osdp", type) == 0)
+    {
+        /* run the osdp panel */
+        return a_osdp(device, baud, address, format, facility, card, times, (key_set != 0) ? key : NULL);
+    }
+    else if (strcmp("e_host", type) == 0)
+    {
+        /* run the host test rig */
+        return a_host(device, baud, times, window);
+    }
+    else if (strcmp("e_blocking", type) == 0)
+    {
+        /* read a capture with the blocking helper */
+        return a_blocking(file);
+    }
+    else if (strcmp("e_cache", type) == 0)
+    {
+        /* check the tag cache */
+        return a_cache();
+    }
+    else if (strcmp("e_log", type) == 0)
+    {
+        /* check the deferred log */
+        return a_log(threads);
+    }
+    else if (strcmp("h", type) == 0)
+    {
+        help:
+        printf("Usage:\n");
+        printf("  em4095 (-i | --information)\n");
+        printf("  em4095 (-h | --help)\n");
+        printf("  em4095 (-e dump | --example=dump) --file=<path>\n");
+        printf("  em4095 (-e replay | --example=replay) (--file=<path> | --dir=<path>) [--rate=<n>]\n");
+        printf("         [--expect=<percent>] [--oversample=<n>] [--glitch=<n>] [--pll=<n>] [--noise=<ppm>] [--noise-width=<n>]\n");
+        printf("         [--ppm=<n>] [--jitter=<n>] [--vote=<n>] [--gap=<n>] [--allow=<path>] [--formats] [--verbose]\n");
+        printf("  em4095 (-e analyze | --example=analyze) --dir=<path> [--threads=<n>] [--rate=<n>]\n");
+        printf("         [--expect=<percent>] [--oversample=<n>] [--glitch=<n>] [--pll=<n>] [--noise=<ppm>] [--noise-width=<n>]\n");
+        printf("         [--ppm=<n>] [--jitter=<n>] [--vote=<n>] [--gap=<n>] [--allow=<path>] [--formats] [--verbose]\n");
+        printf("  em4095 (-e allow | --example=allow) --file=<path> --output=<path> [--bits=<n>]\n");
+        printf("  em4095 (-e wiegand | --example=wiegand) --payload=<hex> [--length=<n>]\n");
+        printf("  em4095 (-e wiegand | --example=wiegand) [--format=<name>] --facility=<n> --card=<n> [--verbose]\n");
+        printf("  em4095 (-e osdp | --example=osdp) [--device=<path>] [--baud=<n>] [--address=<n>] [--times=<num>]\n");
+        printf("         [--format=<name>] [--facility=<n>] [--card=<n>] [--key=<hex>]\n");
+        printf("  em4095 (-e host | --example=host) [--device=<path>] [--baud=<n>] [--times=<num>] [--window=<n>]\n");
+        printf("  em4095 (-e blocking | --example=blocking) --file=<path>\n");
+        printf("  em4095 (-e cache | --example=cache)\n");
+        printf("  em4095 (-e log | --example=log) [--threads=<n>]\n");
+        printf("\n");
+        printf("Options:\n");
+        printf("  -e <dump | replay | analyze | allow | wiegand | osdp | host | blocking | cache | log>, --example=<dump | replay | analyze | allow | wiegand | osdp | host | blocking | cache | log>\n");
+        printf("                                 Run the driver example.\n");
+        printf("      --address=<n>              Set the osdp pd address.([default: 0])\n");
+        printf("      --allow=<path>             Set the allow list image checked at every decoded id.\n");
+        printf("      --baud=<n>                 Set the osdp or host baud rate.([default: 115200])\n");
+        printf("      --bits=<n>                 Set the bloom filter bits per id of the allow list, 0 disables it.([default: 10])\n");
+        printf("      --card=<n>                 Set the wiegand card number.([default: 0])\n");
+        printf("      --device=<path>            Set the osdp or host serial device, a host side board on a pseudo terminal is used without it.\n");
+        printf("      --dir=<path>               Set the capture directory path.\n");
+        printf("      --expect=<percent>         Set the min decoded percent, the run fails below it.\n");
+        printf("      --facility=<n>             Set the wiegand facility code.([default: 0])\n");
+        printf("      --file=<path>              Set the capture or id list file path.\n");
+        printf("      --format=<name>            Set the wiegand format, h10301, h10306, c1k35, h10304, c1k48, aba or fmt.([default: h10301])\n");
+        printf("      --formats                  Decode with the built in format table instead of the em4100 decoder.\n");
+        printf("      --gap=<n>                  Set the frame gap in sample periods, 0 uses the fixed 200ms.([default: 0])\n");
+        printf("      --glitch=<n>               Set the glitch filter width in clock irqs, 0 disables it.([default: 0])\n");
+        printf("      --jitter=<n>               Move every replayed edge by up to n clock irqs either way.([default: 0])\n");
+        printf("      --key=<hex>                Set the 16 bytes osdp secure channel base key, the default key scbk-d is used without it.\n");
+        printf("      --length=<n>               Set the wiegand payload bits.([default: 26])\n");
+        printf("      --noise=<ppm>              Inject glitches per million clock irqs.([default: 0])\n");
+        printf("      --noise-width=<n>          Set the injected glitch width in clock irqs.([default: 1])\n");
+        printf("      --output=<path>            Set the allow list image path, a .h path is written as a c array.\n");
+        printf("      --oversample=<n>           Set the odd reads per sample, 1 disables it.([default: 1])\n");
+        printf("      --payload=<hex>            Set the wiegand payload, the first bit is the msb.\n");
+        printf("      --pll=<n>                  Set the sample phase loop gain as 1/2^n, 0 disables it.([default: 0])\n");
+        printf("      --ppm=<n>                  Offset the replayed tag clock by n ppm, a positive offset is a slower tag.([default: 0])\n");
+        printf("      --rate=<n>                 Set the tag data rate as rf/n.([default: 64])\n");
+        printf("      --threads=<n>              Set the worker threads, 0 means all cores.([default: 0])\n");
+        printf("      --times=<num>              Set the osdp poll times of a serial device or the host write and read cycles.([default: 10])\n");
+        printf("      --vote=<n>                 Set the max frames voted by the em4100 combiner, 0 disables it.([default: 0])\n");
+        printf("      --verbose                  Print every replayed frame or wiegand edge.\n");
+        printf("      --window=<n>               Set the host requests in flight.([default: 16])\n");
+        printf("  -h, --help                     Show the help.\n");
+        printf("  -i, --information              Show the chip information.\n");
+
+        return 0;
+    }
+    else if (strcmp("i", type) == 0)
+    {
+        em4095_info_t info;
+
+        /* print em4095 info */
+        em4095_info(&info);
+        printf("em4095: chip is %s.\n", info.chip_name);
+        printf("em4095: manufacturer is %s.\n", info.manufacturer_name);
+        printf("em4095: interface is %s.\n", info.interface);
+        printf("em4095: driver version is %d.%d.\n", info.driver_version / 1000, (info.driver_version % 1000) / 100);
+        printf("em4095: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
+        printf("em4095: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
+        printf("em4095: max current is %0.2fmA.\n", info.max_current_ma);
+        printf("em4095: max temperature is %0.1fC.\n", info.temperature_max);
+        printf("em4095: min temperature is %0.1fC.\n", info.temperature_min);
+
+        return 0;
+    }
+    else
+    {
+        return 5;
+    }
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 5 param is invalid
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    uint8_t res;
+
+    res = em4095((uint8_t)argc, argv);
+    if (res == 0)
+    {
+        /* run success */
+    }
+    else if (res == 1)
+    {
+        printf("em4095: run failed.\n");
+    }
+    else if (res == 5)
+    {
+        printf("em4095: param is invalid.\n");
+    }
+    else
+    {
+        printf("em4095: unknown status code.\n");
+    }
+
+    return res;
+}
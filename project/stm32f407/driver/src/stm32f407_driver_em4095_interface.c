@@ -35,17 +35,95 @@
  */
 
 #include "driver_em4095_interface.h"
+#include "driver_em4095_log.h"
 #include "delay.h"
 #include "wire.h"
 #include "uart.h"
 #include "tim.h"
 #include <stdarg.h>
 
+/**
+ * @brief stm32f407 reader pin structure definition
+ */
+typedef struct stm32f407_reader_pin_s
+{
+    GPIO_TypeDef *shd_port;          /**< shd port */
+    uint16_t shd_pin;                /**< shd pin */
+    GPIO_TypeDef *mod_port;          /**< mod port */
+    uint16_t mod_pin;                /**< mod pin */
+    GPIO_TypeDef *demod_port;        /**< demod port */
+    uint16_t demod_pin;              /**< demod pin */
+} stm32f407_reader_pin_t;
+
+/**
+ * @brief reader pin definition
+ * @note  reader 0 is the wire board wiring, ctx points to the uint8_t reader index and NULL is reader 0
+ */
+static const stm32f407_reader_pin_t gs_reader_pin[3] =
+{
+    {GPIOC, GPIO_PIN_6, GPIOC, GPIO_PIN_5, GPIOC, GPIO_PIN_4},        /**< reader 1 */
+    {GPIOE, GPIO_PIN_6, GPIOE, GPIO_PIN_5, GPIOE, GPIO_PIN_4},        /**< reader 2 */
+    {GPIOE, GPIO_PIN_9, GPIOE, GPIO_PIN_8, GPIOE, GPIO_PIN_7},        /**< reader 3 */
+};
+
+/**
+ * @brief     get the reader of a context
+ * @param[in] *ctx pointer to the interface context
+ * @return    reader index
+ * @note      none
+ */
+static uint8_t a_reader(void *ctx)
+{
+    return (ctx == NULL) ? 0 : *(const uint8_t *)ctx;
+}
+
+/**
+ * @brief     init a reader pin
+ * @param[in] *port pointer to a gpio port
+ * @param[in] pin gpio pin
+ * @param[in] mode gpio mode
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_pin_init(GPIO_TypeDef *port, uint16_t pin, uint32_t mode)
+{
+    GPIO_InitTypeDef GPIO_Initure;
+
+    /* enable gpio clock */
+    if (port == GPIOC)
+    {
+        __HAL_RCC_GPIOC_CLK_ENABLE();
+    }
+    else if (port == GPIOD)
+    {
+        __HAL_RCC_GPIOD_CLK_ENABLE();
+    }
+    else
+    {
+        __HAL_RCC_GPIOE_CLK_ENABLE();
+    }
+
+    /* gpio init */
+    GPIO_Initure.Pin = pin;
+    GPIO_Initure.Mode = mode;
+    GPIO_Initure.Pull = GPIO_PULLUP;
+    GPIO_Initure.Speed = GPIO_SPEED_FREQ_HIGH;
+    HAL_GPIO_Init(port, &GPIO_Initure);
+
+    return 0;
+}
+
 /**
  * @brief timer var definition
  */
 static uint64_t gs_second = 0;        /**< second */
 
+/**
+ * @brief mux var definition
+ */
+static uint8_t gs_mux_inited = 0;        /**< mux address pins inited flag */
+
 /**
  * @brief     timer callback
  * @param[in] us timer cnt
@@ -81,114 +159,258 @@ uint8_t em4095_interface_timer_init(void)
 }
 
 /**
- * @brief  interface shd gpio init
- * @return status code
- *         - 0 success
- *         - 1 init failed
- * @note   none
+ * @brief     interface shd gpio init
+ * @param[in] *ctx pointer to the interface context
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
  */
-uint8_t em4095_interface_shd_gpio_init(void)
+uint8_t em4095_interface_shd_gpio_init(void *ctx)
 {
-    return wire_en_init();
+    uint8_t reader = a_reader(ctx);
+
+    if (reader == 0)
+    {
+        return wire_en_init();
+    }
+    if (reader > 3)
+    {
+        return 1;
+    }
+
+    return a_pin_init(gs_reader_pin[reader - 1].shd_port, gs_reader_pin[reader - 1].shd_pin, GPIO_MODE_OUTPUT_PP);
 }
 
 /**
- * @brief  interface shd gpio deinit
- * @return status code
- *         - 0 success
- *         - 1 deinit failed
- * @note   none
+ * @brief     interface shd gpio deinit
+ * @param[in] *ctx pointer to the interface context
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
  */
-uint8_t em4095_interface_shd_gpio_deinit(void)
+uint8_t em4095_interface_shd_gpio_deinit(void *ctx)
 {
-    return wire_en_deinit();
+    uint8_t reader = a_reader(ctx);
+
+    if (reader == 0)
+    {
+        return wire_en_deinit();
+    }
+    if (reader > 3)
+    {
+        return 1;
+    }
+    HAL_GPIO_DeInit(gs_reader_pin[reader - 1].shd_port, gs_reader_pin[reader - 1].shd_pin);
+
+    return 0;
 }
 
 /**
  * @brief     interface shd gpio write
+ * @param[in] *ctx pointer to the interface context
  * @param[in] data set level
  * @return    status code
  *            - 0 success
  *            - 1 write failed
  * @note      none
  */
-uint8_t em4095_interface_shd_gpio_write(uint8_t data)
+uint8_t em4095_interface_shd_gpio_write(void *ctx, uint8_t data)
 {
-    return wire_en_write(data);
+    uint8_t reader = a_reader(ctx);
+
+    if (reader == 0)
+    {
+        return wire_en_write(data);
+    }
+    if (reader > 3)
+    {
+        return 1;
+    }
+    HAL_GPIO_WritePin(gs_reader_pin[reader - 1].shd_port, gs_reader_pin[reader - 1].shd_pin, (data != 0) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+
+    return 0;
 }
 
 /**
- * @brief  interface mod gpio init
- * @return status code
- *         - 0 success
- *         - 1 init failed
- * @note   none
+ * @brief     interface mod gpio init
+ * @param[in] *ctx pointer to the interface context
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
  */
-uint8_t em4095_interface_mod_gpio_init(void)
+uint8_t em4095_interface_mod_gpio_init(void *ctx)
 {
-    return wire_ce_init();
+    uint8_t reader = a_reader(ctx);
+
+    if (reader == 0)
+    {
+        return wire_ce_init();
+    }
+    if (reader > 3)
+    {
+        return 1;
+    }
+
+    return a_pin_init(gs_reader_pin[reader - 1].mod_port, gs_reader_pin[reader - 1].mod_pin, GPIO_MODE_OUTPUT_PP);
 }
 
 /**
- * @brief  interface mod gpio deinit
- * @return status code
- *         - 0 success
- *         - 1 deinit failed
- * @note   none
+ * @brief     interface mod gpio deinit
+ * @param[in] *ctx pointer to the interface context
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
  */
-uint8_t em4095_interface_mod_gpio_deinit(void)
+uint8_t em4095_interface_mod_gpio_deinit(void *ctx)
 {
-    return wire_ce_deinit();
+    uint8_t reader = a_reader(ctx);
+
+    if (reader == 0)
+    {
+        return wire_ce_deinit();
+    }
+    if (reader > 3)
+    {
+        return 1;
+    }
+    HAL_GPIO_DeInit(gs_reader_pin[reader - 1].mod_port, gs_reader_pin[reader - 1].mod_pin);
+
+    return 0;
 }
 
 /**
  * @brief     interface mod gpio write
+ * @param[in] *ctx pointer to the interface context
  * @param[in] data set level
  * @return    status code
  *            - 0 success
  *            - 1 write failed
  * @note      none
  */
-uint8_t em4095_interface_mod_gpio_write(uint8_t data)
+uint8_t em4095_interface_mod_gpio_write(void *ctx, uint8_t data)
 {
-    return wire_ce_write(data);
+    uint8_t reader = a_reader(ctx);
+
+    if (reader == 0)
+    {
+        return wire_ce_write(data);
+    }
+    if (reader > 3)
+    {
+        return 1;
+    }
+    HAL_GPIO_WritePin(gs_reader_pin[reader - 1].mod_port, gs_reader_pin[reader - 1].mod_pin, (data != 0) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+
+    return 0;
 }
 
 /**
- * @brief  interface demod gpio init
- * @return status code
- *         - 0 success
- *         - 1 init failed
- * @note   none
+ * @brief     interface demod gpio init
+ * @param[in] *ctx pointer to the interface context
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
  */
-uint8_t em4095_interface_demod_gpio_init(void)
+uint8_t em4095_interface_demod_gpio_init(void *ctx)
 {
-    return wire_init();
+    uint8_t reader = a_reader(ctx);
+
+    if (reader == 0)
+    {
+        return wire_init();
+    }
+    if (reader > 3)
+    {
+        return 1;
+    }
+
+    return a_pin_init(gs_reader_pin[reader - 1].demod_port, gs_reader_pin[reader - 1].demod_pin, GPIO_MODE_INPUT);
 }
 
 /**
- * @brief  interface demod gpio deinit
- * @return status code
- *         - 0 success
- *         - 1 deinit failed
- * @note   none
+ * @brief     interface demod gpio deinit
+ * @param[in] *ctx pointer to the interface context
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
  */
-uint8_t em4095_interface_demod_gpio_deinit(void)
+uint8_t em4095_interface_demod_gpio_deinit(void *ctx)
 {
-    return wire_deinit();
+    uint8_t reader = a_reader(ctx);
+
+    if (reader == 0)
+    {
+        return wire_deinit();
+    }
+    if (reader > 3)
+    {
+        return 1;
+    }
+    HAL_GPIO_DeInit(gs_reader_pin[reader - 1].demod_port, gs_reader_pin[reader - 1].demod_pin);
+
+    return 0;
 }
 
 /**
  * @brief      interface demod gpio read
+ * @param[in]  *ctx pointer to the interface context
  * @param[out] *data pointer to a data level buffer
  * @return     status code
  *             - 0 success
  *             - 1 read failed
  * @note       none
  */
-uint8_t em4095_interface_demod_gpio_read(uint8_t *data)
+uint8_t em4095_interface_demod_gpio_read(void *ctx, uint8_t *data)
 {
-    return wire_read(data);
+    uint8_t reader = a_reader(ctx);
+
+    if (reader == 0)
+    {
+        return wire_read(data);
+    }
+    if (reader > 3)
+    {
+        return 1;
+    }
+    *data = (HAL_GPIO_ReadPin(gs_reader_pin[reader - 1].demod_port, gs_reader_pin[reader - 1].demod_pin) == GPIO_PIN_SET) ? 1 : 0;
+
+    return 0;
+}
+
+/**
+ * @brief     interface antenna select
+ * @param[in] *ctx pointer to the interface context
+ * @param[in] antenna antenna index
+ * @return    status code
+ *            - 0 success
+ *            - 1 select failed
+ * @note      it drives the analog mux between the coils of one em4095, only the scheduler example uses it
+ */
+uint8_t em4095_interface_antenna_select(void *ctx, uint8_t antenna)
+{
+    (void)ctx;
+
+    if (antenna > 3)
+    {
+        return 1;
+    }
+    if (gs_mux_inited == 0)
+    {
+        (void)a_pin_init(GPIOD, GPIO_PIN_0 | GPIO_PIN_1, GPIO_MODE_OUTPUT_PP);
+        gs_mux_inited = 1;
+    }
+
+    /* mux address a0 and a1 */
+    HAL_GPIO_WritePin(GPIOD, GPIO_PIN_0, ((antenna & 0x01) != 0) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(GPIOD, GPIO_PIN_1, ((antenna & 0x02) != 0) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+
+    return 0;
 }
 
 /**
@@ -207,6 +429,39 @@ uint8_t em4095_interface_timestamp_read(em4095_time_t *t)
     return 0;
 }
 
+/**
+ * @brief log dropped records definition
+ */
+static uint32_t gs_log_dropped = 0;        /**< reported dropped records */
+
+/**
+ * @brief interface log flush
+ * @note  formats and sends the queued log records, it does nothing in an irq
+ */
+void em4095_interface_log_flush(void)
+{
+    em4095_log_record_t record;
+    char str[256];
+    uint16_t len;
+    
+    if (__get_IPSR() != 0)
+    {
+        return;
+    }
+    while (em4095_log_read(&record) == 0)
+    {
+        (void)em4095_log_format(&record, str, 256);
+        len = strlen(str);
+        (void)uart_write((uint8_t *)str, len);
+    }
+    if (em4095_log_get_dropped() != gs_log_dropped)
+    {
+        gs_log_dropped = em4095_log_get_dropped();
+        len = snprintf(str, 256, "em4095: %u log records dropped.\n", (unsigned int)gs_log_dropped);
+        (void)uart_write((uint8_t *)str, len);
+    }
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -214,69 +469,73 @@ uint8_t em4095_interface_timestamp_read(em4095_time_t *t)
  */
 void em4095_interface_delay_ms(uint32_t ms)
 {
+    em4095_interface_log_flush();
     delay_ms(ms);
 }
 
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
- * @note      none
+ * @note      the text is queued in the binary log and sent by em4095_interface_log_flush,
+ *            a full queue is flushed first in the thread mode
  */
 void em4095_interface_debug_print(const char *const fmt, ...)
 {
-    char str[256];
-    uint16_t len;
     va_list args;
     
-    memset((char *)str, 0, sizeof(char) * 256); 
+    if ((__get_IPSR() == 0) && (em4095_log_get_free() < EM4095_LOG_MAX_ARGS + 2))
+    {
+        em4095_interface_log_flush();
+    }
     va_start(args, fmt);
-    vsnprintf((char *)str, 255, (char const *)fmt, args);
+    (void)em4095_log_vwrite(EM4095_LOG_LEVEL_INFO, fmt, args);
     va_end(args);
-    
-    len = strlen((char *)str);
-    (void)uart_write((uint8_t *)str, len);
 }
 
 /**
  * @brief     interface receive callback
+ * @param[in] *ctx pointer to the interface context
  * @param[in] mode running mode
  * @param[in] *buf pointer to a decode buffer
  * @param[in] len data length
  * @note      none
  */
-void em4095_interface_receive_callback(em4095_mode_t mode, em4095_decode_t *buf, uint16_t len)
+void em4095_interface_receive_callback(void *ctx, em4095_mode_t mode, em4095_decode_t *buf, uint16_t len)
 {
     uint16_t i;
     
+    (void)ctx;
+    (void)buf;
+    
     switch (mode)
     {
         case EM4095_MODE_READ :
         {
-            em4095_interface_debug_print("em4095: irq read done.\n");
-            em4095_interface_debug_print("raw data: ");
+            EM4095_LOG_INFO("em4095: irq read done.\n");
+            EM4095_LOG_DEBUG("raw data: ");
             for (i = 0; i < len; i++)
             {
-                em4095_interface_debug_print("0x%02X ", buf[i].level);
+                EM4095_LOG_DEBUG("0x%02X ", buf[i].level);
             }
-            em4095_interface_debug_print(".\n");
+            EM4095_LOG_DEBUG(".\n");
             
             break;
         }
         case EM4095_MODE_WRITE :
         {
-            em4095_interface_debug_print("em4095: irq write done.\n");
-            em4095_interface_debug_print("raw data: ");
+            EM4095_LOG_INFO("em4095: irq write done.\n");
+            EM4095_LOG_DEBUG("raw data: ");
             for (i = 0; i < len; i++)
             {
-                em4095_interface_debug_print("0x%02X ", buf[i].level);
+                EM4095_LOG_DEBUG("0x%02X ", buf[i].level);
             }
-            em4095_interface_debug_print(".\n");
+            EM4095_LOG_DEBUG(".\n");
             
             break;
         }
         default :
         {
-            em4095_interface_debug_print("em4095: irq unknown mode.\n");
+            EM4095_LOG_WARN("em4095: irq unknown mode.\n");
             
             break;
         }
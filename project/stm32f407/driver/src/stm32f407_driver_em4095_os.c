@@ -0,0 +1,493 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      stm32f407_driver_em4095_os.c
+ * @brief     stm32f407 driver em4095 os source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_em4095_os.h"
+#include "driver_em4095_interface.h"
+#include "stm32f4xx_hal.h"
+#include <string.h>
+
+/**
+ * @brief os pool size definition
+ */
+#ifndef EM4095_OS_SEM_NUM
+    #define EM4095_OS_SEM_NUM          8         /**< semaphore number */
+#endif
+#ifndef EM4095_OS_MUTEX_NUM
+    #define EM4095_OS_MUTEX_NUM        4         /**< mutex number */
+#endif
+#ifndef EM4095_OS_QUEUE_NUM
+    #define EM4095_OS_QUEUE_NUM        2         /**< queue number */
+#endif
+#ifndef EM4095_OS_QUEUE_SIZE
+    #define EM4095_OS_QUEUE_SIZE       256       /**< queue buffer size in bytes */
+#endif
+
+/**
+ * @brief stm32f407 os semaphore structure definition
+ */
+typedef struct stm32f407_os_sem_s
+{
+    volatile uint8_t used;         /**< used flag */
+    volatile uint8_t given;        /**< given flag */
+} stm32f407_os_sem_t;
+
+/**
+ * @brief stm32f407 os mutex structure definition
+ */
+typedef struct stm32f407_os_mutex_s
+{
+    volatile uint8_t used;          /**< used flag */
+    volatile uint8_t locked;        /**< locked flag */
+} stm32f407_os_mutex_t;
+
+/**
+ * @brief stm32f407 os queue structure definition
+ */
+typedef struct stm32f407_os_queue_s
+{
+    volatile uint8_t used;                  /**< used flag */
+    uint16_t item_size;                     /**< item size */
+    uint16_t depth;                         /**< max items */
+    volatile uint16_t head;                 /**< first item */
+    volatile uint16_t count;                /**< item number */
+    uint8_t buf[EM4095_OS_QUEUE_SIZE];      /**< item buffer */
+} stm32f407_os_queue_t;
+
+/**
+ * @brief os pool var definition
+ */
+static stm32f407_os_sem_t gs_sem[EM4095_OS_SEM_NUM];              /**< semaphore pool */
+static stm32f407_os_mutex_t gs_mutex[EM4095_OS_MUTEX_NUM];        /**< mutex pool */
+static stm32f407_os_queue_t gs_queue[EM4095_OS_QUEUE_NUM];        /**< queue pool */
+
+/**
+ * @brief  os read the elapsed time
+ * @return elapsed time in us
+ * @note   none
+ */
+static uint64_t a_os_now(void)
+{
+    uint64_t us;
+
+    (void)em4095_os_monotonic_us(&us);
+
+    return us;
+}
+
+/**
+ * @brief     os check a deadline
+ * @param[in] start start time in us
+ * @param[in] timeout_ms timeout in ms
+ * @return    1 if expired else 0
+ * @note      none
+ */
+static uint8_t a_os_expired(uint64_t start, uint32_t timeout_ms)
+{
+    if (timeout_ms == EM4095_OS_WAIT_FOREVER)
+    {
+        return 0;
+    }
+
+    return ((a_os_now() - start) >= (uint64_t)timeout_ms * 1000ULL) ? 1 : 0;
+}
+
+/**
+ * @brief      os create a binary semaphore
+ * @param[out] *sem pointer to a semaphore buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 create failed
+ * @note       it is created empty
+ */
+uint8_t em4095_os_sem_create(em4095_os_sem_t *sem)
+{
+    uint8_t i;
+
+    __disable_irq();
+    for (i = 0; i < EM4095_OS_SEM_NUM; i++)
+    {
+        if (gs_sem[i].used == 0)
+        {
+            gs_sem[i].used = 1;
+            gs_sem[i].given = 0;
+            __enable_irq();
+            *sem = &gs_sem[i];
+
+            return 0;
+        }
+    }
+    __enable_irq();
+
+    return 1;
+}
+
+/**
+ * @brief     os delete a binary semaphore
+ * @param[in] sem semaphore
+ * @return    status code
+ *            - 0 success
+ *            - 1 delete failed
+ * @note      none
+ */
+uint8_t em4095_os_sem_delete(em4095_os_sem_t sem)
+{
+    stm32f407_os_sem_t *s = (stm32f407_os_sem_t *)sem;
+
+    if (s == NULL)
+    {
+        return 1;
+    }
+    s->used = 0;
+
+    return 0;
+}
+
+/**
+ * @brief     os give a binary semaphore
+ * @param[in] sem semaphore
+ * @return    status code
+ *            - 0 success
+ *            - 1 give failed
+ * @note      it can be called in the irq
+ */
+uint8_t em4095_os_sem_give(em4095_os_sem_t sem)
+{
+    stm32f407_os_sem_t *s = (stm32f407_os_sem_t *)sem;
+
+    if (s == NULL)
+    {
+        return 1;
+    }
+    s->given = 1;
+
+    return 0;
+}
+
+/**
+ * @brief     os take a binary semaphore
+ * @param[in] sem semaphore
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout
+ * @note      the core sleeps until the next interrupt while waiting
+ */
+uint8_t em4095_os_sem_take(em4095_os_sem_t sem, uint32_t timeout_ms)
+{
+    uint64_t start;
+    stm32f407_os_sem_t *s = (stm32f407_os_sem_t *)sem;
+
+    if (s == NULL)
+    {
+        return 1;
+    }
+    start = a_os_now();
+    while (1)
+    {
+        __disable_irq();
+        if (s->given != 0)
+        {
+            s->given = 0;
+            __enable_irq();
+
+            return 0;
+        }
+        __WFI();
+        __enable_irq();
+        if ((a_os_expired(start, timeout_ms) != 0) && (s->given == 0))
+        {
+            return 1;
+        }
+    }
+}
+
+/**
+ * @brief      os create a mutex
+ * @param[out] *mutex pointer to a mutex buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 create failed
+ * @note       none
+ */
+uint8_t em4095_os_mutex_create(em4095_os_mutex_t *mutex)
+{
+    uint8_t i;
+
+    __disable_irq();
+    for (i = 0; i < EM4095_OS_MUTEX_NUM; i++)
+    {
+        if (gs_mutex[i].used == 0)
+        {
+            gs_mutex[i].used = 1;
+            gs_mutex[i].locked = 0;
+            __enable_irq();
+            *mutex = &gs_mutex[i];
+
+            return 0;
+        }
+    }
+    __enable_irq();
+
+    return 1;
+}
+
+/**
+ * @brief     os delete a mutex
+ * @param[in] mutex mutex
+ * @return    status code
+ *            - 0 success
+ *            - 1 delete failed
+ * @note      none
+ */
+uint8_t em4095_os_mutex_delete(em4095_os_mutex_t mutex)
+{
+    stm32f407_os_mutex_t *m = (stm32f407_os_mutex_t *)mutex;
+
+    if (m == NULL)
+    {
+        return 1;
+    }
+    m->used = 0;
+
+    return 0;
+}
+
+/**
+ * @brief     os lock a mutex
+ * @param[in] mutex mutex
+ * @return    status code
+ *            - 0 success
+ *            - 1 lock failed
+ * @note      there is only one thread on bare metal, so a locked mutex is a recursion error
+ */
+uint8_t em4095_os_mutex_lock(em4095_os_mutex_t mutex)
+{
+    stm32f407_os_mutex_t *m = (stm32f407_os_mutex_t *)mutex;
+
+    if ((m == NULL) || (m->locked != 0))
+    {
+        return 1;
+    }
+    m->locked = 1;
+
+    return 0;
+}
+
+/**
+ * @brief     os unlock a mutex
+ * @param[in] mutex mutex
+ * @return    status code
+ *            - 0 success
+ *            - 1 unlock failed
+ * @note      none
+ */
+uint8_t em4095_os_mutex_unlock(em4095_os_mutex_t mutex)
+{
+    stm32f407_os_mutex_t *m = (stm32f407_os_mutex_t *)mutex;
+
+    if (m == NULL)
+    {
+        return 1;
+    }
+    m->locked = 0;
+
+    return 0;
+}
+
+/**
+ * @brief      os create a message queue
+ * @param[out] *queue pointer to a queue buffer
+ * @param[in]  item_size item size in bytes
+ * @param[in]  depth max items
+ * @return     status code
+ *             - 0 success
+ *             - 1 create failed
+ * @note       item_size * depth can't be over EM4095_OS_QUEUE_SIZE
+ */
+uint8_t em4095_os_queue_create(em4095_os_queue_t *queue, uint16_t item_size, uint16_t depth)
+{
+    uint8_t i;
+
+    if ((item_size == 0) || (depth == 0) || ((uint32_t)item_size * depth > EM4095_OS_QUEUE_SIZE))
+    {
+        return 1;
+    }
+    __disable_irq();
+    for (i = 0; i < EM4095_OS_QUEUE_NUM; i++)
+    {
+        if (gs_queue[i].used == 0)
+        {
+            gs_queue[i].used = 1;
+            gs_queue[i].item_size = item_size;
+            gs_queue[i].depth = depth;
+            gs_queue[i].head = 0;
+            gs_queue[i].count = 0;
+            __enable_irq();
+            *queue = &gs_queue[i];
+
+            return 0;
+        }
+    }
+    __enable_irq();
+
+    return 1;
+}
+
+/**
+ * @brief     os delete a message queue
+ * @param[in] queue queue
+ * @return    status code
+ *            - 0 success
+ *            - 1 delete failed
+ * @note      none
+ */
+uint8_t em4095_os_queue_delete(em4095_os_queue_t queue)
+{
+    stm32f407_os_queue_t *q = (stm32f407_os_queue_t *)queue;
+
+    if (q == NULL)
+    {
+        return 1;
+    }
+    q->used = 0;
+
+    return 0;
+}
+
+/**
+ * @brief     os send an item to a message queue
+ * @param[in] queue queue
+ * @param[in] *item pointer to an item
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ * @note      it never blocks and can be called in the irq
+ */
+uint8_t em4095_os_queue_send(em4095_os_queue_t queue, const void *item)
+{
+    uint16_t tail;
+    uint32_t primask;
+    stm32f407_os_queue_t *q = (stm32f407_os_queue_t *)queue;
+
+    if (q == NULL)
+    {
+        return 1;
+    }
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if (q->count == q->depth)
+    {
+        __set_PRIMASK(primask);
+
+        return 1;
+    }
+    tail = (uint16_t)((q->head + q->count) % q->depth);
+    memcpy(&q->buf[tail * q->item_size], item, q->item_size);
+    q->count++;
+    __set_PRIMASK(primask);
+
+    return 0;
+}
+
+/**
+ * @brief      os receive an item from a message queue
+ * @param[in]  queue queue
+ * @param[out] *item pointer to an item buffer
+ * @param[in]  timeout_ms timeout in ms
+ * @return     status code
+ *             - 0 success
+ *             - 1 timeout
+ * @note       the core sleeps until the next interrupt while waiting
+ */
+uint8_t em4095_os_queue_receive(em4095_os_queue_t queue, void *item, uint32_t timeout_ms)
+{
+    uint64_t start;
+    stm32f407_os_queue_t *q = (stm32f407_os_queue_t *)queue;
+
+    if (q == NULL)
+    {
+        return 1;
+    }
+    start = a_os_now();
+    while (1)
+    {
+        __disable_irq();
+        if (q->count != 0)
+        {
+            memcpy(item, &q->buf[q->head * q->item_size], q->item_size);
+            q->head = (uint16_t)((q->head + 1) % q->depth);
+            q->count--;
+            __enable_irq();
+
+            return 0;
+        }
+        __WFI();
+        __enable_irq();
+        if ((a_os_expired(start, timeout_ms) != 0) && (q->count == 0))
+        {
+            return 1;
+        }
+    }
+}
+
+/**
+ * @brief      os read the monotonic clock
+ * @param[out] *us pointer to a time buffer in us
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the second counter is read twice to catch a timer wrap
+ */
+uint8_t em4095_os_monotonic_us(uint64_t *us)
+{
+    em4095_time_t t1;
+    em4095_time_t t2;
+
+    do
+    {
+        if (em4095_interface_timestamp_read(&t1) != 0)
+        {
+            return 1;
+        }
+        if (em4095_interface_timestamp_read(&t2) != 0)
+        {
+            return 1;
+        }
+    } while (t1.s != t2.s);
+    *us = t2.s * 1000000ULL + t2.us;
+
+    return 0;
+}
@@ -65,6 +65,27 @@ uint8_t gpio_interrupt_init(void);
  */
 uint8_t gpio_interrupt_deinit(void);
 
+/**
+ * @brief     gpio interrupt line init
+ * @param[in] line exti line
+ * @return    status code
+ *            - 0 success
+ *            - 1 line is invalid
+ * @note      line 0 is PB0, line 1 is PC1, line 2 is PE2 and line 3 is PE3,
+ *            all lines have the same priority so the irqs never nest
+ */
+uint8_t gpio_interrupt_line_init(uint8_t line);
+
+/**
+ * @brief     gpio interrupt line deinit
+ * @param[in] line exti line
+ * @return    status code
+ *            - 0 success
+ *            - 1 line is invalid
+ * @note      none
+ */
+uint8_t gpio_interrupt_line_deinit(uint8_t line);
+
 /**
  * @}
  */
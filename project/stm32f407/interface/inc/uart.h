@@ -52,8 +52,9 @@ extern "C"{
 /**
  * @brief uart max rx buffer length definition
  */
-#define UART_MAX_LEN        256        /**< uart max len */
+#define UART_MAX_LEN        1024       /**< uart max len */
 #define UART2_MAX_LEN       512        /**< uart2 max len */
+#define UART_TX_LEN         2048       /**< uart tx length of each dma buffer */
 
 /**
  * @brief     uart init with 8 data bits, 1 stop bit and no parity
@@ -61,7 +62,8 @@ extern "C"{
  * @return    status code
  *            - 0 success
  *            - 1 init failed
- * @note      TX is PA9 and RX is PA10
+ * @note      TX is PA9 and RX is PA10, tx is DMA2 stream 7,
+ *            over 5.25Mbaud (APB2 / 16) the oversampling is 8 and the max is 10.5Mbaud
  */
 uint8_t uart_init(uint32_t baud_rate);
 
@@ -70,7 +72,7 @@ uint8_t uart_init(uint32_t baud_rate);
  * @return status code
  *         - 0 success
  *         - 1 deinit
- * @note   none
+ * @note   the queued data is dropped
  */
 uint8_t uart_deinit(void);
 
@@ -81,10 +83,28 @@ uint8_t uart_deinit(void);
  * @return    status code
  *            - 0 success
  *            - 1 write failed
- * @note      none
+ * @note      the data is copied to the tx queue, it only waits while the queue is full
  */
 uint8_t uart_write(uint8_t *buf, uint16_t len);
 
+/**
+ * @brief     uart write data without waiting
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ * @note      all the data is queued or nothing, a data over UART_TX_LEN never fits
+ */
+uint8_t uart_write_async(const uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     uart set the tx callback
+ * @param[in] *callback pointer to a tx done callback
+ * @note      the callback runs in the irq with the sent length after every dma buffer, NULL is none
+ */
+void uart_set_tx_callback(void (*callback)(uint16_t len));
+
 /**
  * @brief      uart read data
  * @param[out] *buf pointer to a data buffer
@@ -94,6 +114,15 @@ uint8_t uart_write(uint8_t *buf, uint16_t len);
  */
 uint16_t uart_read(uint8_t *buf, uint16_t len);
 
+/**
+ * @brief      uart read data without waiting the line idle
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
+ * @return     length of the read data
+ * @note       the bytes behind the read length are kept for the next read
+ */
+uint16_t uart_read_nowait(uint8_t *buf, uint16_t len);
+
 /**
  * @brief  uart flush data
  * @return status code
@@ -119,10 +148,22 @@ UART_HandleTypeDef* uart_get_handle(void);
 
 /**
  * @brief uart set tx done
- * @note  none
+ * @note  the sent buffer is free, the other one is sent next
  */
 void uart_set_tx_done(void);
 
+/**
+ * @brief uart error handler
+ * @note  a dma tx error ends the transfer without the tx done callback, the buffer is dropped
+ */
+void uart_error_handler(void);
+
+/**
+ * @brief uart dma tx irq handler
+ * @note  none
+ */
+void uart_dma_tx_irq_handler(void);
+
 /**
  * @brief uart irq handler
  * @note  none
@@ -195,6 +236,66 @@ void uart2_set_tx_done(void);
  */
 void uart2_irq_handler(void);
 
+/**
+ * @brief     uart2 dma init with 8 data bits, 1 stop bit and no parity
+ * @param[in] baud baud rate
+ * @param[in] *receive pointer to a receive callback
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      TX is PA2, RX is PA3 and the rs485 DE is PA1, rx is DMA1 stream 5 and tx is DMA1 stream 6,
+ *            the callback gets the received bytes in place at every idle line and returns the used length,
+ *            the unused bytes are kept for the next call
+ */
+uint8_t uart2_dma_init(uint32_t baud, uint16_t (*receive)(uint8_t *buf, uint16_t len));
+
+/**
+ * @brief  uart2 dma deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t uart2_dma_deinit(void);
+
+/**
+ * @brief     uart2 dma write data
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      it never waits, DE is high until the last stop bit is out and
+ *            the buffer must be kept until then
+ */
+uint8_t uart2_dma_write(const uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     uart2 rx event handler
+ * @param[in] size received length behind the kept bytes
+ * @note      osdp is half duplex, the panel waits the reply, so the bytes are handled in place
+ *            before the dma restarts and a split packet is moved to the buffer front
+ */
+void uart2_rx_event_handler(uint16_t size);
+
+/**
+ * @brief uart2 dma error handler
+ * @note  the hal stops the dma reception at an error, the kept bytes are dropped
+ */
+void uart2_dma_error_handler(void);
+
+/**
+ * @brief uart2 dma rx irq handler
+ * @note  none
+ */
+void uart2_dma_rx_irq_handler(void);
+
+/**
+ * @brief uart2 dma tx irq handler
+ * @note  none
+ */
+void uart2_dma_tx_irq_handler(void);
+
 /**
  * @}
  */
@@ -0,0 +1,118 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      wiegand.h
+ * @brief     wiegand header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#ifndef WIEGAND_H
+#define WIEGAND_H
+
+#include "stm32f4xx_hal.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup wiegand wiegand function
+ * @brief    wiegand function modules
+ * @{
+ */
+
+/**
+ * @brief     wiegand output init
+ * @param[in] pulse_us pulse width in us
+ * @param[in] interval_us bit interval in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ *            - 2 pulse_us or interval_us is invalid
+ * @note      d0 or data is PB12, d1 or clock is PB13, TIM3 update requests DMA1 stream 2 channel 5
+ *            to write the line actions of every pulse_us slot to the GPIOB BSRR
+ */
+uint8_t wiegand_init(uint32_t pulse_us, uint32_t interval_us);
+
+/**
+ * @brief  wiegand output deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t wiegand_deinit(void);
+
+/**
+ * @brief     queue a wiegand payload
+ * @param[in] payload right aligned payload, the first bit is the msb
+ * @param[in] bits payload bits
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ *            - 2 bits is invalid
+ * @note      it never waits, the frame is clocked out in the background
+ */
+uint8_t wiegand_send(uint64_t payload, uint8_t bits);
+
+/**
+ * @brief     queue an aba track 2 frame
+ * @param[in] *digits pointer to a decimal digit string
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ *            - 2 digits is invalid
+ * @note      it never waits, the frame is clocked out in the background
+ */
+uint8_t wiegand_send_aba(const char *digits);
+
+/**
+ * @brief  get the wiegand output busy status
+ * @return 1 while a frame is queued or sent
+ * @note   none
+ */
+uint8_t wiegand_busy(void);
+
+/**
+ * @brief wiegand dma irq handler
+ * @note  none
+ */
+void wiegand_dma_irq_handler(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -36,6 +36,27 @@
 
 #include "gpio.h"
 
+/**
+ * @brief gpio line structure definition
+ */
+typedef struct gpio_line_s
+{
+    GPIO_TypeDef *port;        /**< gpio port */
+    uint16_t pin;              /**< gpio pin */
+    IRQn_Type irq;             /**< exti irq */
+} gpio_line_t;
+
+/**
+ * @brief gpio line definition
+ */
+static const gpio_line_t gs_line[4] =
+{
+    {GPIOB, GPIO_PIN_0, EXTI0_IRQn},        /**< line 0 */
+    {GPIOC, GPIO_PIN_1, EXTI1_IRQn},        /**< line 1 */
+    {GPIOE, GPIO_PIN_2, EXTI2_IRQn},        /**< line 2 */
+    {GPIOE, GPIO_PIN_3, EXTI3_IRQn},        /**< line 3 */
+};
+
 /**
  * @brief  gpio interrupt init
  * @return status code
@@ -79,3 +100,64 @@ uint8_t gpio_interrupt_deinit(void)
     
     return 0;
 }
+
+/**
+ * @brief     gpio interrupt line init
+ * @param[in] line exti line
+ * @return    status code
+ *            - 0 success
+ *            - 1 line is invalid
+ * @note      line 0 is PB0, line 1 is PC1, line 2 is PE2 and line 3 is PE3,
+ *            all lines have the same priority so the irqs never nest
+ */
+uint8_t gpio_interrupt_line_init(uint8_t line)
+{
+    GPIO_InitTypeDef GPIO_InitStruct;
+    
+    if (line > 3)
+    {
+        return 1;
+    }
+    
+    /* enable gpio clock */
+    __HAL_RCC_GPIOB_CLK_ENABLE();
+    __HAL_RCC_GPIOC_CLK_ENABLE();
+    __HAL_RCC_GPIOE_CLK_ENABLE();
+    
+    /* gpio init */
+    GPIO_InitStruct.Pin = gs_line[line].pin;
+    GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING_FALLING;
+    GPIO_InitStruct.Pull = GPIO_PULLUP;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+    HAL_GPIO_Init(gs_line[line].port, &GPIO_InitStruct);
+    
+    /* enable nvic */
+    HAL_NVIC_SetPriority(gs_line[line].irq, 4, 0);
+    HAL_NVIC_EnableIRQ(gs_line[line].irq);
+    
+    return 0;
+}
+
+/**
+ * @brief     gpio interrupt line deinit
+ * @param[in] line exti line
+ * @return    status code
+ *            - 0 success
+ *            - 1 line is invalid
+ * @note      none
+ */
+uint8_t gpio_interrupt_line_deinit(uint8_t line)
+{
+    if (line > 3)
+    {
+        return 1;
+    }
+    
+    /* gpio deinit */
+    HAL_GPIO_DeInit(gs_line[line].port, gs_line[line].pin);
+    
+    /* disable nvic */
+    HAL_NVIC_DisableIRQ(gs_line[line].irq);
+    
+    return 0;
+}
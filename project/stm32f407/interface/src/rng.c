@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      rng.c
+ * @brief     rng source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+
+#include "rng.h"
+
+/**
+ * @brief rng var definition
+ */
+RNG_HandleTypeDef g_rng_handle;        /**< rng handle */
+
+/**
+ * @brief  rng init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   the rng runs from the 48MHz pll q clock
+ */
+uint8_t rng_init(void)
+{
+    /* enable the rng clock */
+    __HAL_RCC_RNG_CLK_ENABLE();
+    
+    /* rng init */
+    g_rng_handle.Instance = RNG;
+    if (HAL_RNG_Init(&g_rng_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  rng deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t rng_deinit(void)
+{
+    /* rng deinit */
+    if (HAL_RNG_DeInit(&g_rng_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    __HAL_RCC_RNG_CLK_DISABLE();
+    
+    return 0;
+}
+
+/**
+ * @brief      rng read
+ * @param[out] *buf pointer to a random buffer
+ * @param[in]  len random length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t rng_read(uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+    uint32_t r;
+    
+    /* 4 bytes per number */
+    r = 0;
+    for (i = 0; i < len; i++)
+    {
+        if ((i % 4) == 0)
+        {
+            if (HAL_RNG_GenerateRandomNumber(&g_rng_handle, &r) != HAL_OK)
+            {
+                return 1;
+            }
+        }
+        buf[i] = (uint8_t)(r >> ((i % 4) * 8));
+    }
+    
+    return 0;
+}
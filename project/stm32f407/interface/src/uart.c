@@ -46,7 +46,17 @@ UART_HandleTypeDef g_uart_handle;              /**< uart handle */
 uint8_t g_uart_rx_buffer[UART_MAX_LEN];        /**< uart rx buffer */
 uint8_t g_uart_buffer;                         /**< uart one buffer */
 volatile uint16_t g_uart_point;                /**< uart rx point */
-volatile uint8_t g_uart_tx_done;               /**< uart tx done flag */
+
+/**
+ * @brief uart dma tx var definition
+ */
+DMA_HandleTypeDef g_uart_dma_tx_handle;                           /**< uart dma tx handle */
+uint8_t g_uart_tx_buffer[2][UART_TX_LEN];                         /**< uart tx double buffer */
+volatile uint16_t g_uart_tx_len[2];                               /**< uart tx buffer length */
+volatile uint8_t g_uart_tx_fill;                                  /**< uart tx buffer being filled */
+volatile uint8_t g_uart_tx_busy;                                  /**< uart tx dma is sending the other buffer */
+volatile uint8_t g_uart_tx_lock;                                  /**< uart tx buffer is being copied */
+void (*g_uart_tx_callback)(uint16_t len);                         /**< uart tx done callback */
 
 /**
  * @brief uart2 var definition
@@ -57,13 +67,96 @@ uint8_t g_uart2_buffer;                          /**< uart2 one buffer */
 volatile uint16_t g_uart2_point;                 /**< uart2 rx point */
 volatile uint8_t g_uart2_tx_done;                /**< uart2 tx done flag */
 
+/**
+ * @brief uart2 dma var definition
+ */
+DMA_HandleTypeDef g_uart2_dma_rx_handle;                          /**< uart2 dma rx handle */
+DMA_HandleTypeDef g_uart2_dma_tx_handle;                          /**< uart2 dma tx handle */
+uint16_t g_uart2_dma_point;                                       /**< uart2 bytes kept at the buffer front */
+uint16_t (*g_uart2_dma_receive)(uint8_t *buf, uint16_t len);      /**< uart2 dma receive callback */
+
+/**
+ * @brief  uart start sending the filled buffer
+ * @note   it runs with the irq disabled or in the tx irq, it does nothing while the dma
+ *         is busy, a buffer is being copied or the filled buffer is empty
+ */
+static void a_uart_tx_start(void)
+{
+    uint8_t fill;
+
+    /* check the state */
+    fill = g_uart_tx_fill;
+    if ((g_uart_tx_busy != 0) || (g_uart_tx_lock != 0) || (g_uart_tx_len[fill] == 0))
+    {
+        return;
+    }
+
+    /* the other buffer is out, fill it next */
+    g_uart_tx_fill = fill ^ 1;
+    g_uart_tx_len[fill ^ 1] = 0;
+    g_uart_tx_busy = 1;
+
+    /* transmit */
+    if (HAL_UART_Transmit_DMA(&g_uart_handle, g_uart_tx_buffer[fill], g_uart_tx_len[fill]) != HAL_OK)
+    {
+        g_uart_tx_fill = fill;
+        g_uart_tx_busy = 0;
+    }
+}
+
+/**
+ * @brief     uart copy data to the filled buffer
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @param[in] split 1 to copy what fits, 0 to copy all or nothing
+ * @return    length of the copied data
+ * @note      the copy runs with the irq enabled, the lock keeps the tx irq from swapping the buffer
+ */
+static uint16_t a_uart_tx_push(const uint8_t *buf, uint16_t len, uint8_t split)
+{
+    uint32_t primask;
+    uint16_t pos;
+    uint8_t fill;
+
+    /* reserve the filled buffer */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    fill = g_uart_tx_fill;
+    pos = g_uart_tx_len[fill];
+    if ((g_uart_tx_lock != 0) || (pos == UART_TX_LEN) || ((split == 0) && (len > UART_TX_LEN - pos)))
+    {
+        __set_PRIMASK(primask);
+
+        return 0;
+    }
+    if (len > UART_TX_LEN - pos)
+    {
+        len = (uint16_t)(UART_TX_LEN - pos);
+    }
+    g_uart_tx_lock = 1;
+    __set_PRIMASK(primask);
+
+    /* copy the data */
+    memcpy(&g_uart_tx_buffer[fill][pos], buf, len);
+
+    /* commit and start */
+    __disable_irq();
+    g_uart_tx_len[fill] = (uint16_t)(pos + len);
+    g_uart_tx_lock = 0;
+    a_uart_tx_start();
+    __set_PRIMASK(primask);
+
+    return len;
+}
+
 /**
  * @brief     uart init with 8 data bits, 1 stop bit and no parity
  * @param[in] baud baud rate
  * @return    status code
  *            - 0 success
  *            - 1 init failed
- * @note      TX is PA9 and RX is PA10
+ * @note      TX is PA9 and RX is PA10, tx is DMA2 stream 7,
+ *            over 5.25Mbaud (APB2 / 16) the oversampling is 8 and the max is 10.5Mbaud
  */
 uint8_t uart_init(uint32_t baud)
 {
@@ -74,7 +167,7 @@ uint8_t uart_init(uint32_t baud)
     g_uart_handle.Init.Parity = UART_PARITY_NONE;
     g_uart_handle.Init.Mode = UART_MODE_TX_RX;
     g_uart_handle.Init.HwFlowCtl = UART_HWCONTROL_NONE;
-    g_uart_handle.Init.OverSampling = UART_OVERSAMPLING_16;
+    g_uart_handle.Init.OverSampling = (baud > 5250000) ? UART_OVERSAMPLING_8 : UART_OVERSAMPLING_16;
 
     /* uart init */
     if (HAL_UART_Init(&g_uart_handle) != HAL_OK)
@@ -82,6 +175,37 @@ uint8_t uart_init(uint32_t baud)
         return 1;
     }
 
+    /* tx dma init */
+    __HAL_RCC_DMA2_CLK_ENABLE();
+    g_uart_dma_tx_handle.Instance = DMA2_Stream7;
+    g_uart_dma_tx_handle.Init.Channel = DMA_CHANNEL_4;
+    g_uart_dma_tx_handle.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    g_uart_dma_tx_handle.Init.PeriphInc = DMA_PINC_DISABLE;
+    g_uart_dma_tx_handle.Init.MemInc = DMA_MINC_ENABLE;
+    g_uart_dma_tx_handle.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    g_uart_dma_tx_handle.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    g_uart_dma_tx_handle.Init.Mode = DMA_NORMAL;
+    g_uart_dma_tx_handle.Init.Priority = DMA_PRIORITY_LOW;
+    g_uart_dma_tx_handle.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&g_uart_dma_tx_handle) != HAL_OK)
+    {
+        (void)HAL_UART_DeInit(&g_uart_handle);
+
+        return 1;
+    }
+    __HAL_LINKDMA(&g_uart_handle, hdmatx, g_uart_dma_tx_handle);
+
+    /* same priority as the usart1 irq */
+    HAL_NVIC_SetPriority(DMA2_Stream7_IRQn, 1, 0);
+    HAL_NVIC_EnableIRQ(DMA2_Stream7_IRQn);
+
+    /* empty queue */
+    g_uart_tx_len[0] = 0;
+    g_uart_tx_len[1] = 0;
+    g_uart_tx_fill = 0;
+    g_uart_tx_busy = 0;
+    g_uart_tx_lock = 0;
+
     /* receive one byte */
     if (HAL_UART_Receive_IT(&g_uart_handle, (uint8_t *)&g_uart_buffer, 1) != HAL_OK)
     {
@@ -96,10 +220,16 @@ uint8_t uart_init(uint32_t baud)
  * @return status code
  *         - 0 success
  *         - 1 deinit
- * @note   none
+ * @note   the queued data is dropped
  */
 uint8_t uart_deinit(void)
 {
+    /* stop the dma */
+    (void)HAL_UART_Abort(&g_uart_handle);
+    HAL_NVIC_DisableIRQ(DMA2_Stream7_IRQn);
+    (void)HAL_DMA_DeInit(&g_uart_dma_tx_handle);
+    g_uart_tx_busy = 0;
+
     /* uart deinit */
     if (HAL_UART_DeInit(&g_uart_handle) != HAL_OK)
     {
@@ -116,37 +246,74 @@ uint8_t uart_deinit(void)
  * @return    status code
  *            - 0 success
  *            - 1 write failed
- * @note      none
+ * @note      the data is copied to the tx queue, it only waits while the queue is full
  */
 uint8_t uart_write(uint8_t *buf, uint16_t len)
 {
     uint16_t timeout = 1000;
+    uint16_t n;
 
-    /* set tx done 0 */
-    g_uart_tx_done = 0;
-
-    /* transmit */
-    if (HAL_UART_Transmit_IT(&g_uart_handle, (uint8_t *)buf, len) != HAL_OK)
-    {
-        return 1;
-    }
-
-    /* wait for events */
-    while ((g_uart_tx_done == 0) && (timeout != 0))
+    while (len != 0)
     {
+        /* queue what fits */
+        n = a_uart_tx_push(buf, len, 1);
+        if (n != 0)
+        {
+            buf += n;
+            len -= n;
+            timeout = 1000;
+
+            continue;
+        }
+
+        /* check the timeout */
+        if (timeout == 0)
+        {
+            return 1;
+        }
+
+        /* wait for a free buffer */
         HAL_Delay(1);
         timeout--;
     }
 
-    /* check the timeout */
-    if (timeout != 0)
+    return 0;
+}
+
+/**
+ * @brief     uart write data without waiting
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ * @note      all the data is queued or nothing, a data over UART_TX_LEN never fits
+ */
+uint8_t uart_write_async(const uint8_t *buf, uint16_t len)
+{
+    /* check the length */
+    if (len == 0)
     {
         return 0;
     }
-    else
+
+    /* queue all */
+    if (a_uart_tx_push(buf, len, 0) == 0)
     {
         return 1;
     }
+
+    return 0;
+}
+
+/**
+ * @brief     uart set the tx callback
+ * @param[in] *callback pointer to a tx done callback
+ * @note      the callback runs in the irq with the sent length after every dma buffer, NULL is none
+ */
+void uart_set_tx_callback(void (*callback)(uint16_t len))
+{
+    g_uart_tx_callback = callback;
 }
 
 /**
@@ -180,6 +347,30 @@ uint16_t uart_read(uint8_t *buf, uint16_t len)
     return read_len;
 }
 
+/**
+ * @brief      uart read data without waiting the line idle
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
+ * @return     length of the read data
+ * @note       the bytes behind the read length are kept for the next read
+ */
+uint16_t uart_read_nowait(uint8_t *buf, uint16_t len)
+{
+    uint32_t primask;
+    uint16_t read_len;
+
+    /* take the bytes with the irq off */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    read_len = (len < g_uart_point) ? len : g_uart_point;
+    memcpy(buf, g_uart_rx_buffer, read_len);
+    memmove(g_uart_rx_buffer, &g_uart_rx_buffer[read_len], g_uart_point - read_len);
+    g_uart_point = (uint16_t)(g_uart_point - read_len);
+    __set_PRIMASK(primask);
+
+    return read_len;
+}
+
 /**
  * @brief  uart flush data
  * @return status code
@@ -383,11 +574,46 @@ UART_HandleTypeDef* uart2_get_handle(void)
 
 /**
  * @brief uart set tx done
- * @note  none
+ * @note  the sent buffer is free, the other one is sent next
  */
 void uart_set_tx_done(void)
 {
-    g_uart_tx_done = 1;
+    uint16_t len;
+
+    /* free the sent buffer */
+    len = g_uart_tx_len[g_uart_tx_fill ^ 1];
+    g_uart_tx_busy = 0;
+
+    /* send the filled buffer */
+    a_uart_tx_start();
+
+    /* run the callback */
+    if (g_uart_tx_callback != NULL)
+    {
+        g_uart_tx_callback(len);
+    }
+}
+
+/**
+ * @brief uart error handler
+ * @note  a dma tx error ends the transfer without the tx done callback, the buffer is dropped
+ */
+void uart_error_handler(void)
+{
+    if ((g_uart_tx_busy != 0) && (g_uart_handle.gState != HAL_UART_STATE_BUSY_TX))
+    {
+        g_uart_tx_busy = 0;
+        a_uart_tx_start();
+    }
+}
+
+/**
+ * @brief uart dma tx irq handler
+ * @note  none
+ */
+void uart_dma_tx_irq_handler(void)
+{
+    HAL_DMA_IRQHandler(&g_uart_dma_tx_handle);
 }
 
 /**
@@ -397,6 +623,12 @@ void uart_set_tx_done(void)
 void uart2_set_tx_done(void)
 {
     g_uart2_tx_done = 1;
+
+    /* release the rs485 bus */
+    if (g_uart2_dma_receive != NULL)
+    {
+        HAL_GPIO_WritePin(GPIOA, GPIO_PIN_1, GPIO_PIN_RESET);
+    }
 }
 
 /**
@@ -434,3 +666,250 @@ void uart2_irq_handler(void)
     /* receive one byte */
     (void)HAL_UART_Receive_IT(&g_uart2_handle, (uint8_t *)&g_uart2_buffer, 1);
 }
+
+/**
+ * @brief  uart2 dma start receiving behind the kept bytes
+ * @note   the half transfer irq is off, the callback runs at an idle line or a full buffer
+ */
+static void a_uart2_dma_receive_start(void)
+{
+    if (HAL_UARTEx_ReceiveToIdle_DMA(&g_uart2_handle, &g_uart2_rx_buffer[g_uart2_dma_point],
+                                     (uint16_t)(UART2_MAX_LEN - g_uart2_dma_point)) == HAL_OK)
+    {
+        __HAL_DMA_DISABLE_IT(&g_uart2_dma_rx_handle, DMA_IT_HT);
+    }
+}
+
+/**
+ * @brief     uart2 dma init with 8 data bits, 1 stop bit and no parity
+ * @param[in] baud baud rate
+ * @param[in] *receive pointer to a receive callback
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      TX is PA2, RX is PA3 and the rs485 DE is PA1, rx is DMA1 stream 5 and tx is DMA1 stream 6,
+ *            the callback gets the received bytes in place at every idle line and returns the used length,
+ *            the unused bytes are kept for the next call
+ */
+uint8_t uart2_dma_init(uint32_t baud, uint16_t (*receive)(uint8_t *buf, uint16_t len))
+{
+    GPIO_InitTypeDef GPIO_InitStruct;
+
+    /* check the callback */
+    if (receive == NULL)
+    {
+        return 1;
+    }
+
+    /* enable the clocks */
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    /* DE is low while receiving */
+    HAL_GPIO_WritePin(GPIOA, GPIO_PIN_1, GPIO_PIN_RESET);
+    GPIO_InitStruct.Pin = GPIO_PIN_1;
+    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+    GPIO_InitStruct.Pull = GPIO_NOPULL;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+
+    g_uart2_handle.Instance = USART2;
+    g_uart2_handle.Init.BaudRate = baud;
+    g_uart2_handle.Init.WordLength = UART_WORDLENGTH_8B;
+    g_uart2_handle.Init.StopBits = UART_STOPBITS_1;
+    g_uart2_handle.Init.Parity = UART_PARITY_NONE;
+    g_uart2_handle.Init.Mode = UART_MODE_TX_RX;
+    g_uart2_handle.Init.HwFlowCtl = UART_HWCONTROL_NONE;
+    g_uart2_handle.Init.OverSampling = UART_OVERSAMPLING_16;
+
+    /* uart init */
+    if (HAL_UART_Init(&g_uart2_handle) != HAL_OK)
+    {
+        return 1;
+    }
+
+    /* rx dma init */
+    g_uart2_dma_rx_handle.Instance = DMA1_Stream5;
+    g_uart2_dma_rx_handle.Init.Channel = DMA_CHANNEL_4;
+    g_uart2_dma_rx_handle.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    g_uart2_dma_rx_handle.Init.PeriphInc = DMA_PINC_DISABLE;
+    g_uart2_dma_rx_handle.Init.MemInc = DMA_MINC_ENABLE;
+    g_uart2_dma_rx_handle.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    g_uart2_dma_rx_handle.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    g_uart2_dma_rx_handle.Init.Mode = DMA_NORMAL;
+    g_uart2_dma_rx_handle.Init.Priority = DMA_PRIORITY_MEDIUM;
+    g_uart2_dma_rx_handle.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&g_uart2_dma_rx_handle) != HAL_OK)
+    {
+        (void)HAL_UART_DeInit(&g_uart2_handle);
+
+        return 1;
+    }
+    __HAL_LINKDMA(&g_uart2_handle, hdmarx, g_uart2_dma_rx_handle);
+
+    /* tx dma init */
+    g_uart2_dma_tx_handle.Instance = DMA1_Stream6;
+    g_uart2_dma_tx_handle.Init.Channel = DMA_CHANNEL_4;
+    g_uart2_dma_tx_handle.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    g_uart2_dma_tx_handle.Init.PeriphInc = DMA_PINC_DISABLE;
+    g_uart2_dma_tx_handle.Init.MemInc = DMA_MINC_ENABLE;
+    g_uart2_dma_tx_handle.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    g_uart2_dma_tx_handle.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    g_uart2_dma_tx_handle.Init.Mode = DMA_NORMAL;
+    g_uart2_dma_tx_handle.Init.Priority = DMA_PRIORITY_MEDIUM;
+    g_uart2_dma_tx_handle.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&g_uart2_dma_tx_handle) != HAL_OK)
+    {
+        (void)HAL_DMA_DeInit(&g_uart2_dma_rx_handle);
+        (void)HAL_UART_DeInit(&g_uart2_handle);
+
+        return 1;
+    }
+    __HAL_LINKDMA(&g_uart2_handle, hdmatx, g_uart2_dma_tx_handle);
+
+    /* enable nvic */
+    HAL_NVIC_SetPriority(DMA1_Stream5_IRQn, 2, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Stream5_IRQn);
+    HAL_NVIC_SetPriority(DMA1_Stream6_IRQn, 2, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Stream6_IRQn);
+
+    /* start receiving */
+    g_uart2_tx_done = 1;
+    g_uart2_dma_point = 0;
+    g_uart2_dma_receive = receive;
+    a_uart2_dma_receive_start();
+
+    return 0;
+}
+
+/**
+ * @brief  uart2 dma deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t uart2_dma_deinit(void)
+{
+    /* stop */
+    g_uart2_dma_receive = NULL;
+    (void)HAL_UART_Abort(&g_uart2_handle);
+
+    /* disable nvic */
+    HAL_NVIC_DisableIRQ(DMA1_Stream5_IRQn);
+    HAL_NVIC_DisableIRQ(DMA1_Stream6_IRQn);
+
+    /* dma deinit */
+    (void)HAL_DMA_DeInit(&g_uart2_dma_rx_handle);
+    (void)HAL_DMA_DeInit(&g_uart2_dma_tx_handle);
+    HAL_GPIO_DeInit(GPIOA, GPIO_PIN_1);
+
+    /* uart deinit */
+    if (HAL_UART_DeInit(&g_uart2_handle) != HAL_OK)
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     uart2 dma write data
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      it never waits, DE is high until the last stop bit is out and
+ *            the buffer must be kept until then
+ */
+uint8_t uart2_dma_write(const uint8_t *buf, uint16_t len)
+{
+    /* check the last frame */
+    if (g_uart2_tx_done == 0)
+    {
+        return 1;
+    }
+
+    /* drive the bus */
+    g_uart2_tx_done = 0;
+    HAL_GPIO_WritePin(GPIOA, GPIO_PIN_1, GPIO_PIN_SET);
+
+    /* transmit */
+    if (HAL_UART_Transmit_DMA(&g_uart2_handle, (uint8_t *)buf, len) != HAL_OK)
+    {
+        HAL_GPIO_WritePin(GPIOA, GPIO_PIN_1, GPIO_PIN_RESET);
+        g_uart2_tx_done = 1;
+
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     uart2 rx event handler
+ * @param[in] size received length behind the kept bytes
+ * @note      osdp is half duplex, the panel waits the reply, so the bytes are handled in place
+ *            before the dma restarts and a split packet is moved to the buffer front
+ */
+void uart2_rx_event_handler(uint16_t size)
+{
+    uint16_t len;
+    uint16_t used;
+
+    /* check the mode */
+    if (g_uart2_dma_receive == NULL)
+    {
+        return;
+    }
+
+    /* run the callback */
+    len = (uint16_t)(g_uart2_dma_point + size);
+    used = g_uart2_dma_receive(g_uart2_rx_buffer, len);
+    if ((used == 0) && (len >= UART2_MAX_LEN))
+    {
+        used = len;
+    }
+
+    /* keep the rest */
+    if ((used != 0) && (used < len))
+    {
+        memmove(g_uart2_rx_buffer, &g_uart2_rx_buffer[used], len - used);
+    }
+    g_uart2_dma_point = (used < len) ? (uint16_t)(len - used) : 0;
+
+    /* receive again */
+    a_uart2_dma_receive_start();
+}
+
+/**
+ * @brief uart2 dma error handler
+ * @note  the hal stops the dma reception at an error, the kept bytes are dropped
+ */
+void uart2_dma_error_handler(void)
+{
+    if (g_uart2_dma_receive != NULL)
+    {
+        g_uart2_dma_point = 0;
+        a_uart2_dma_receive_start();
+    }
+}
+
+/**
+ * @brief uart2 dma rx irq handler
+ * @note  none
+ */
+void uart2_dma_rx_irq_handler(void)
+{
+    HAL_DMA_IRQHandler(&g_uart2_dma_rx_handle);
+}
+
+/**
+ * @brief uart2 dma tx irq handler
+ * @note  none
+ */
+void uart2_dma_tx_irq_handler(void)
+{
+    HAL_DMA_IRQHandler(&g_uart2_dma_tx_handle);
+}
@@ -0,0 +1,369 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      wiegand.c
+ * @brief     wiegand source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#include "wiegand.h"
+#include "driver_em4095_wiegand.h"
+
+/**
+ * @brief wiegand definition
+ */
+#define WIEGAND_D0_PIN          GPIO_PIN_12        /**< d0 or data pin */
+#define WIEGAND_D1_PIN          GPIO_PIN_13        /**< d1 or clock pin */
+#define WIEGAND_RING            64                 /**< slot ring, half of it is refilled at a time */
+#define WIEGAND_FRAME_GAP_US    20000              /**< idle time after a frame */
+
+/**
+ * @brief wiegand var definition
+ */
+static TIM_HandleTypeDef gs_tim_handle;              /**< tim handle */
+static DMA_HandleTypeDef gs_dma_handle;              /**< dma handle */
+static em4095_wiegand_tx_t gs_tx;                    /**< transmitter */
+static uint32_t gs_ring[WIEGAND_RING];               /**< bsrr words of the slots */
+static volatile uint8_t gs_running = 0;              /**< dma is running */
+static uint8_t gs_idle = 0;                          /**< idle ring halves in a row */
+
+/**
+ * @brief     fill one half of the slot ring
+ * @param[in] *p pointer to the ring half
+ * @param[in] n slot number
+ * @return    1 if every slot is idle
+ * @note      a bsrr word of 0 keeps the lines
+ */
+static uint8_t a_wiegand_fill(uint32_t *p, uint16_t n)
+{
+    uint16_t i;
+    uint8_t lines;
+    uint8_t idle;
+    uint32_t w;
+    
+    idle = 1;
+    for (i = 0; i < n; i++)
+    {
+        w = 0;
+        if (em4095_wiegand_tx_next(&gs_tx, &lines) == 0)
+        {
+            idle = 0;
+            if ((lines & EM4095_WIEGAND_LINE_D0_LOW) != 0)
+            {
+                w |= (uint32_t)WIEGAND_D0_PIN << 16;
+            }
+            if ((lines & EM4095_WIEGAND_LINE_D0_HIGH) != 0)
+            {
+                w |= WIEGAND_D0_PIN;
+            }
+            if ((lines & EM4095_WIEGAND_LINE_D1_LOW) != 0)
+            {
+                w |= (uint32_t)WIEGAND_D1_PIN << 16;
+            }
+            if ((lines & EM4095_WIEGAND_LINE_D1_HIGH) != 0)
+            {
+                w |= WIEGAND_D1_PIN;
+            }
+        }
+        p[i] = w;
+    }
+    
+    return idle;
+}
+
+/**
+ * @brief  stop the slot dma
+ * @note   the lines are released at the end of every frame
+ */
+static void a_wiegand_stop(void)
+{
+    HAL_TIM_Base_Stop(&gs_tim_handle);
+    __HAL_TIM_DISABLE_DMA(&gs_tim_handle, TIM_DMA_UPDATE);
+    (void)HAL_DMA_Abort_IT(&gs_dma_handle);
+    gs_running = 0;
+}
+
+/**
+ * @brief     refill a ring half
+ * @param[in] *p pointer to the ring half
+ * @note      the dma stops after two idle halves, then every queued slot is out
+ */
+static void a_wiegand_refill(uint32_t *p)
+{
+    if (a_wiegand_fill(p, WIEGAND_RING / 2) != 0)
+    {
+        gs_idle++;
+        if (gs_idle >= 2)
+        {
+            a_wiegand_stop();
+        }
+    }
+    else
+    {
+        gs_idle = 0;
+    }
+}
+
+/**
+ * @brief     dma half transfer callback
+ * @param[in] *hdma pointer to a dma handle
+ * @note      the first half is sent, refill it
+ */
+static void a_wiegand_half_callback(DMA_HandleTypeDef *hdma)
+{
+    (void)hdma;
+    
+    a_wiegand_refill(&gs_ring[0]);
+}
+
+/**
+ * @brief     dma transfer complete callback
+ * @param[in] *hdma pointer to a dma handle
+ * @note      the second half is sent, refill it
+ */
+static void a_wiegand_full_callback(DMA_HandleTypeDef *hdma)
+{
+    (void)hdma;
+    
+    a_wiegand_refill(&gs_ring[WIEGAND_RING / 2]);
+}
+
+/**
+ * @brief  start the slot dma if it is stopped
+ * @return status code
+ *         - 0 success
+ *         - 1 start failed
+ * @note   the irq mask is restored, so it may run in an irq
+ */
+static uint8_t a_wiegand_start(void)
+{
+    uint8_t res;
+    uint32_t primask;
+    
+    res = 0;
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if (gs_running == 0)
+    {
+        gs_idle = 0;
+        (void)a_wiegand_fill(&gs_ring[0], WIEGAND_RING);
+        __HAL_TIM_SET_COUNTER(&gs_tim_handle, 0);
+        if (HAL_DMA_Start_IT(&gs_dma_handle, (uint32_t)gs_ring, (uint32_t)&GPIOB->BSRR, WIEGAND_RING) != HAL_OK)
+        {
+            res = 1;
+        }
+        else
+        {
+            __HAL_TIM_ENABLE_DMA(&gs_tim_handle, TIM_DMA_UPDATE);
+            HAL_TIM_Base_Start(&gs_tim_handle);
+            gs_running = 1;
+        }
+    }
+    __set_PRIMASK(primask);
+    
+    return res;
+}
+
+/**
+ * @brief     wiegand output init
+ * @param[in] pulse_us pulse width in us
+ * @param[in] interval_us bit interval in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ *            - 2 pulse_us or interval_us is invalid
+ * @note      d0 or data is PB12, d1 or clock is PB13, TIM3 update requests DMA1 stream 2 channel 5
+ *            to write the line actions of every pulse_us slot to the GPIOB BSRR
+ */
+uint8_t wiegand_init(uint32_t pulse_us, uint32_t interval_us)
+{
+    GPIO_InitTypeDef GPIO_InitStruct;
+    
+    /* check the timing */
+    if ((pulse_us == 0) || (pulse_us > 65536) || (interval_us / pulse_us < 3) ||
+        (interval_us / pulse_us > 65535) || (WIEGAND_FRAME_GAP_US / pulse_us == 0))
+    {
+        return 2;
+    }
+    
+    /* init the transmitter */
+    if (em4095_wiegand_tx_init(&gs_tx, (uint16_t)(interval_us / pulse_us),
+                               (uint16_t)(WIEGAND_FRAME_GAP_US / pulse_us)) != 0)
+    {
+        return 2;
+    }
+    
+    /* enable the clocks */
+    __HAL_RCC_GPIOB_CLK_ENABLE();
+    __HAL_RCC_DMA1_CLK_ENABLE();
+    
+    /* the lines idle high */
+    HAL_GPIO_WritePin(GPIOB, WIEGAND_D0_PIN | WIEGAND_D1_PIN, GPIO_PIN_SET);
+    GPIO_InitStruct.Pin = WIEGAND_D0_PIN | WIEGAND_D1_PIN;
+    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_OD;
+    GPIO_InitStruct.Pull = GPIO_PULLUP;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+    HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
+    
+    /* one update per slot */
+    gs_tim_handle.Instance = TIM3;
+    gs_tim_handle.Init.Prescaler = ((SystemCoreClock / 2) / 1000000) - 1;
+    gs_tim_handle.Init.CounterMode = TIM_COUNTERMODE_UP;
+    gs_tim_handle.Init.Period = pulse_us - 1;
+    gs_tim_handle.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    if (HAL_TIM_Base_Init(&gs_tim_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    /* memory to the bsrr in a circle */
+    gs_dma_handle.Instance = DMA1_Stream2;
+    gs_dma_handle.Init.Channel = DMA_CHANNEL_5;
+    gs_dma_handle.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    gs_dma_handle.Init.PeriphInc = DMA_PINC_DISABLE;
+    gs_dma_handle.Init.MemInc = DMA_MINC_ENABLE;
+    gs_dma_handle.Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+    gs_dma_handle.Init.MemDataAlignment = DMA_MDATAALIGN_WORD;
+    gs_dma_handle.Init.Mode = DMA_CIRCULAR;
+    gs_dma_handle.Init.Priority = DMA_PRIORITY_HIGH;
+    gs_dma_handle.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&gs_dma_handle) != HAL_OK)
+    {
+        (void)HAL_TIM_Base_DeInit(&gs_tim_handle);
+        
+        return 1;
+    }
+    gs_dma_handle.XferHalfCpltCallback = a_wiegand_half_callback;
+    gs_dma_handle.XferCpltCallback = a_wiegand_full_callback;
+    
+    /* enable nvic */
+    HAL_NVIC_SetPriority(DMA1_Stream2_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Stream2_IRQn);
+    gs_running = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief  wiegand output deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t wiegand_deinit(void)
+{
+    /* stop the slots */
+    if (gs_running != 0)
+    {
+        a_wiegand_stop();
+    }
+    
+    /* disable nvic */
+    HAL_NVIC_DisableIRQ(DMA1_Stream2_IRQn);
+    
+    /* deinit */
+    (void)HAL_DMA_DeInit(&gs_dma_handle);
+    (void)HAL_TIM_Base_DeInit(&gs_tim_handle);
+    HAL_GPIO_DeInit(GPIOB, WIEGAND_D0_PIN | WIEGAND_D1_PIN);
+    
+    return 0;
+}
+
+/**
+ * @brief     queue a wiegand payload
+ * @param[in] payload right aligned payload, the first bit is the msb
+ * @param[in] bits payload bits
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ *            - 2 bits is invalid
+ * @note      it never waits, the frame is clocked out in the background
+ */
+uint8_t wiegand_send(uint64_t payload, uint8_t bits)
+{
+    uint8_t res;
+    
+    res = em4095_wiegand_tx_push_payload(&gs_tx, payload, bits);
+    if (res != 0)
+    {
+        return (res == 1) ? 1 : 2;
+    }
+    
+    return a_wiegand_start();
+}
+
+/**
+ * @brief     queue an aba track 2 frame
+ * @param[in] *digits pointer to a decimal digit string
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ *            - 2 digits is invalid
+ * @note      it never waits, the frame is clocked out in the background
+ */
+uint8_t wiegand_send_aba(const char *digits)
+{
+    uint8_t res;
+    uint8_t bits;
+    uint8_t buf[EM4095_WIEGAND_TX_MAX_BITS / 8];
+    
+    if (em4095_wiegand_aba_encode(digits, buf, sizeof(buf), &bits) != 0)
+    {
+        return 2;
+    }
+    res = em4095_wiegand_tx_push(&gs_tx, EM4095_WIEGAND_TX_MODE_ABA, buf, bits);
+    if (res != 0)
+    {
+        return (res == 1) ? 1 : 2;
+    }
+    
+    return a_wiegand_start();
+}
+
+/**
+ * @brief  get the wiegand output busy status
+ * @return 1 while a frame is queued or sent
+ * @note   none
+ */
+uint8_t wiegand_busy(void)
+{
+    return (gs_running != 0) ? 1 : 0;
+}
+
+/**
+ * @brief wiegand dma irq handler
+ * @note  none
+ */
+void wiegand_dma_irq_handler(void)
+{
+    HAL_DMA_IRQHandler(&gs_dma_handle);
+}
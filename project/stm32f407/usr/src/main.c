@@ -35,12 +35,24 @@
  */
 
 #include "driver_em4095_basic.h"
+#include "driver_em4095_capture.h"
+#include "driver_em4095_presence.h"
+#include "driver_em4095_multi.h"
+#include "driver_em4095_scheduler.h"
+#include "driver_em4095_cache.h"
+#include "driver_em4095_wiegand.h"
+#include "driver_em4095_osdp.h"
+#include "driver_em4095_log.h"
+#include "driver_em4095_host.h"
 #include "driver_em4095_read_write_test.h"
+#include "driver_em4095_benchmark_test.h"
 #include "shell.h"
 #include "clock.h"
 #include "delay.h"
 #include "gpio.h"
 #include "uart.h"
+#include "rng.h"
+#include "wiegand.h"
 #include "getopt.h"
 #include <math.h>
 #include <stdlib.h>
@@ -53,7 +65,64 @@ uint8_t g_rx_buf[256];                                   /**< rx buffer */
 volatile uint16_t g_len;                                 /**< uart buffer length */
 volatile uint8_t g_flag;                                 /**< interrupt flag */
 uint8_t (*g_gpio_irq)(void) = NULL;                      /**< gpio irq */
+uint8_t (*g_gpio_line_irq)(uint8_t line) = NULL;         /**< gpio line irq */
+uint8_t g_capture_buf[EM4095_CAPTURE_FRAME_MAX_SIZE];    /**< capture buffer */
+volatile uint16_t g_capture_len;                         /**< capture buffer length */
 extern uint8_t em4095_interface_timer_init(void);        /**< timer init function */
+extern void em4095_interface_log_flush(void);            /**< log flush function */
+
+/**
+ * @brief capture clock definition
+ */
+#define CAPTURE_TICK_HZ         1000000        /**< timestamp is in us */
+#define CAPTURE_CLOCK_HZ        250000         /**< both edges of the 125KHz CLK */
+
+/**
+ * @brief carrier window definition
+ */
+#define CARRIER_WINDOW          25000          /**< 100ms of both clk edges */
+
+/**
+ * @brief scheduler cache definition
+ */
+#define SCHEDULER_HOLDOFF_MS    1000           /**< present report hold off */
+#define SCHEDULER_EXPIRY_MS     1000           /**< a tag left after 1s without a read */
+static em4095_cache_t gs_cache;                /**< scheduler id cache */
+
+/**
+ * @brief wiegand output definition
+ */
+#define WIEGAND_PULSE_US        50             /**< 50us pulse */
+#define WIEGAND_INTERVAL_US     2000           /**< 2ms bit interval */
+static uint8_t gs_wiegand_out = 0;             /**< send the arrived ids */
+
+/**
+ * @brief osdp output definition
+ */
+static em4095_osdp_pd_t gs_osdp;               /**< osdp pd */
+static uint8_t gs_osdp_out = 0;                /**< report the arrived ids */
+static const em4095_osdp_id_t gs_osdp_id =     /**< osdp id report */
+{
+    {0x00, 0x00, 0x00}, 0x01, 0x01, 0x00000001, {1, 0, 0},
+};
+
+/**
+ * @brief host protocol definition
+ */
+#define HOST_IDLE_MS            1000           /**< back to the shell after 1s without a byte */
+static em4095_host_t gs_host;                  /**< host protocol */
+static uint8_t gs_host_buf[EM4095_HOST_MAX_PAYLOAD + EM4095_HOST_OVERHEAD];        /**< host receive buffer */
+static uint16_t gs_host_len;                   /**< host received length */
+static uint32_t gs_host_config[5] =            /**< div, oversample, glitch, gap and pll */
+{
+    EM4095_BASIC_DEFAULT_DIV, 1, 0, 0, 0,
+};
+
+/**
+ * @brief benchmark definition
+ */
+static volatile uint32_t gs_bench_cycles;      /**< irq handler cycles */
+static volatile uint32_t gs_bench_irqs;        /**< irq handler calls */
 
 /**
  * @brief exti 0 irq
@@ -64,10 +133,37 @@ void EXTI0_IRQHandler(void)
     HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_0);
 }
 
+/**
+ * @brief exti 1 irq
+ * @note  none
+ */
+void EXTI1_IRQHandler(void)
+{
+    HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_1);
+}
+
+/**
+ * @brief exti 2 irq
+ * @note  none
+ */
+void EXTI2_IRQHandler(void)
+{
+    HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_2);
+}
+
+/**
+ * @brief exti 3 irq
+ * @note  none
+ */
+void EXTI3_IRQHandler(void)
+{
+    HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_3);
+}
+
 /**
  * @brief     gpio exti callback
  * @param[in] pin gpio pin
- * @note      none
+ * @note      each exti line is routed to the reader with the same index
  */
 void HAL_GPIO_EXTI_Callback(uint16_t pin)
 {
@@ -79,6 +175,200 @@ void HAL_GPIO_EXTI_Callback(uint16_t pin)
             g_gpio_irq();
         }
     }
+    if (g_gpio_line_irq != NULL)
+    {
+        /* run the reader of the line */
+        if (pin == GPIO_PIN_0)
+        {
+            g_gpio_line_irq(0);
+        }
+        else if (pin == GPIO_PIN_1)
+        {
+            g_gpio_line_irq(1);
+        }
+        else if (pin == GPIO_PIN_2)
+        {
+            g_gpio_line_irq(2);
+        }
+        else if (pin == GPIO_PIN_3)
+        {
+            g_gpio_line_irq(3);
+        }
+        else
+        {
+            /* not a reader line */
+        }
+    }
+}
+
+/**
+ * @brief  benchmark irq
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   the dwt cycle counter is attributed to the driver irq handler
+ */
+static uint8_t a_benchmark_irq(void)
+{
+    uint8_t res;
+    uint32_t start;
+
+    start = DWT->CYCCNT;
+    res = em4095_benchmark_test_irq_handler();
+    gs_bench_cycles += DWT->CYCCNT - start;
+    gs_bench_irqs++;
+
+    return res;
+}
+
+/**
+ * @brief     send an h10301 frame
+ * @param[in] facility facility code
+ * @param[in] card card number
+ * @note      it never waits, a full queue drops the frame
+ */
+static void a_wiegand_send_h10301(uint32_t facility, uint32_t card)
+{
+    uint64_t payload;
+    const em4095_wiegand_format_t *table;
+    uint8_t count;
+
+    (void)em4095_wiegand_get_formats(&table, &count);
+    if (em4095_wiegand_encode(&table[0], facility, card, &payload) != 0)
+    {
+        return;
+    }
+    if (wiegand_send(payload, table[0].bits) != 0)
+    {
+        em4095_interface_debug_print("em4095: wiegand queue is full.\n");
+    }
+}
+
+/**
+ * @brief     osdp receive callback
+ * @param[in] *buf pointer to the received bytes
+ * @param[in] len received length
+ * @return    used length
+ * @note      runs in the uart2 irq, the packets are parsed in place and answered at once
+ */
+static uint16_t a_osdp_receive(uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    uint16_t pos;
+    uint16_t used;
+    uint16_t reply_len;
+    const uint8_t *reply;
+    em4095_osdp_packet_t packet;
+
+    pos = 0;
+    while (pos < len)
+    {
+        res = em4095_osdp_parse(&buf[pos], (uint16_t)(len - pos), &packet, &used);
+        pos = (uint16_t)(pos + used);
+        if (res == 1)
+        {
+            break;
+        }
+        if (res != 0)
+        {
+            gs_osdp.errors++;
+
+            continue;
+        }
+        if (em4095_osdp_pd_handle(&gs_osdp, &packet, &reply, &reply_len) == 0)
+        {
+            (void)uart2_dma_write(reply, reply_len);
+        }
+    }
+
+    return pos;
+}
+
+/**
+ * @brief     report an h10301 card read on osdp
+ * @param[in] facility facility code
+ * @param[in] card card number
+ * @note      the read is the reply of the next poll, a full queue drops it
+ */
+static void a_osdp_push_h10301(uint32_t facility, uint32_t card)
+{
+    uint8_t i;
+    uint8_t buf[4];
+    uint64_t payload;
+    const em4095_wiegand_format_t *table;
+    uint8_t count;
+
+    (void)em4095_wiegand_get_formats(&table, &count);
+    if (em4095_wiegand_encode(&table[0], facility, card, &payload) != 0)
+    {
+        return;
+    }
+    payload <<= 64 - table[0].bits;
+    for (i = 0; i < 4; i++)
+    {
+        buf[i] = (uint8_t)(payload >> (56 - i * 8));
+    }
+    if (em4095_osdp_pd_push_raw(&gs_osdp, EM4095_OSDP_RAW_FORMAT_WIEGAND, buf, table[0].bits) != 0)
+    {
+        em4095_interface_debug_print("em4095: osdp card queue is full.\n");
+    }
+}
+
+/**
+ * @brief     scheduler id callback
+ * @param[in] antenna antenna index
+ * @param[in] *id pointer to an em4100 id structure
+ * @note      none
+ */
+static void a_scheduler_callback(uint8_t antenna, const em4095_em4100_id_t *id)
+{
+    uint64_t key;
+    em4095_time_t t;
+    em4095_cache_event_t event;
+
+    /* antenna, version and id make the key */
+    key = ((uint64_t)antenna << 40) | ((uint64_t)id->version << 32) | id->id;
+    if (em4095_interface_timestamp_read(&t) != 0)
+    {
+        return;
+    }
+    if (em4095_cache_push(&gs_cache, key, &t, &event) != 0)
+    {
+        return;
+    }
+    if (event == EM4095_CACHE_EVENT_ARRIVED)
+    {
+        em4095_interface_debug_print("em4095: antenna %d id %02X%08X arrived.\n", antenna, id->version, (unsigned int)id->id);
+        if (gs_wiegand_out != 0)
+        {
+            a_wiegand_send_h10301((id->id >> 16) & 0xFF, id->id & 0xFFFF);
+        }
+        if (gs_osdp_out != 0)
+        {
+            a_osdp_push_h10301((id->id >> 16) & 0xFF, id->id & 0xFFFF);
+        }
+    }
+}
+
+/**
+ * @brief  report the tags which left the field
+ * @note   none
+ */
+static void a_scheduler_expire(void)
+{
+    uint64_t key;
+    em4095_time_t t;
+    em4095_cache_event_t event;
+
+    if (em4095_interface_timestamp_read(&t) != 0)
+    {
+        return;
+    }
+    while (em4095_cache_expire(&gs_cache, &t, &key, &event) == 0)
+    {
+        em4095_interface_debug_print("em4095: antenna %d id %02X%08X left.\n", (uint8_t)(key >> 40),
+                                     (uint8_t)(key >> 32), (unsigned int)(key & 0xFFFFFFFFU));
+    }
 }
 
 /**
@@ -94,19 +384,24 @@ static void a_receive_callback(em4095_mode_t mode, em4095_decode_t *buf, uint16_
     {
         case EM4095_MODE_READ :
         {
-            em4095_interface_debug_print("em4095: irq read done.\n");
+            EM4095_LOG_INFO("em4095: irq read done.\n");
 
             break;
         }
         case EM4095_MODE_WRITE :
         {
-            em4095_interface_debug_print("em4095: irq write done.\n");
+            EM4095_LOG_INFO("em4095: irq write done.\n");
 
             break;
         }
+        case EM4095_MODE_SENSE :
+        case EM4095_MODE_MEASURE :
+        {
+            break;
+        }
         default :
         {
-            em4095_interface_debug_print("em4095: irq unknown mode.\n");
+            EM4095_LOG_WARN("em4095: irq unknown mode.\n");
 
             break;
         }
@@ -114,118 +409,460 @@ static void a_receive_callback(em4095_mode_t mode, em4095_decode_t *buf, uint16_
 }
 
 /**
- * @brief     em4095 full function
- * @param[in] argc arg numbers
- * @param[in] **argv arg address
- * @return    status code
- *            - 0 success
- *            - 1 run failed
- *            - 5 param is invalid
- * @note      none
+ * @brief     async completion callback
+ * @param[in] token request token
+ * @param[in] status final status
+ * @note      runs in the irq or in the poll that times the request out
  */
-uint8_t em4095(uint8_t argc, char **argv)
+static void a_async_callback(uint32_t token, em4095_basic_status_t status)
 {
-    int c;
-    int longindex = 0;
-    char short_options[] = "hipe:t:";
-    struct option long_options[] =
-    {
-        {"help", no_argument, NULL, 'h'},
-        {"information", no_argument, NULL, 'i'},
-        {"port", no_argument, NULL, 'p'},
-        {"example", required_argument, NULL, 'e'},
-        {"test", required_argument, NULL, 't'},
-        {"data", required_argument, NULL, 1},
-        {"length", required_argument, NULL, 2},
-        {"times", required_argument, NULL, 3},
-        {NULL, 0, NULL, 0},
-    };
-    char type[33] = "unknown";
-    uint32_t times = 3;
-    uint32_t length = 256;
+    EM4095_LOG_INFO("em4095: request 0x%08X finished with status %d.\n", token, status);
+}
 
-    /* if no params */
-    if (argc == 1)
+/**
+ * @brief      poll an async request until it finishes
+ * @param[in]  token request token
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 poll failed
+ * @note       none
+ */
+static uint8_t a_async_poll(uint32_t token, em4095_basic_status_t *status)
+{
+    uint32_t polls;
+
+    polls = 0;
+    while (1)
     {
-        /* goto the help */
-        goto help;
+        /* the poll also checks the timeout */
+        if (em4095_basic_poll(token, status) != 0)
+        {
+            return 1;
+        }
+        if ((*status != EM4095_BASIC_STATUS_PENDING) && (*status != EM4095_BASIC_STATUS_RUNNING))
+        {
+            break;
+        }
+
+        /* other work would run here */
+        em4095_interface_delay_ms(1);
+        polls++;
     }
+    em4095_interface_debug_print("em4095: request 0x%08X status %d after %d polls.\n", token, *status, polls);
 
-    /* init 0 */
-    optind = 0;
+    return 0;
+}
 
-    /* init 0 */
-    memset(g_rx_buf, 0, sizeof(uint8_t) * 256);
-    
-    /* parse */
-    do
+/**
+ * @brief     capture receive callback
+ * @param[in] mode running mode
+ * @param[in] *buf pointer to a decode buffer
+ * @param[in] len data length
+ * @note      runs in the irq, only the frame block is encoded here
+ */
+static void a_capture_callback(em4095_mode_t mode, em4095_decode_t *buf, uint16_t len)
+{
+    uint16_t l;
+
+    if (mode == EM4095_MODE_READ)
     {
-        /* parse the args */
-        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        l = EM4095_CAPTURE_FRAME_MAX_SIZE;
+        if (em4095_capture_encode_frame(buf, len, g_capture_buf, &l) == 0)
+        {
+            g_capture_len = l;
+        }
+        else
+        {
+            g_capture_len = 0;
+        }
+    }
+}
 
-        /* judge the result */
-        switch (c)
+/**
+ * @brief      host command callback
+ * @param[in]  code request code
+ * @param[in]  *data pointer to a payload buffer
+ * @param[in]  len payload length
+ * @param[out] *out pointer to a response data buffer
+ * @param[in]  size response data buffer size
+ * @param[out] *out_len pointer to a response data length buffer
+ * @return     em4095_host_status_t
+ * @note       read, write and capture use the basic example which the host mode keeps inited
+ */
+static uint8_t a_host_command(uint8_t code, const uint8_t *data, uint16_t len,
+                              uint8_t *out, uint16_t size, uint16_t *out_len)
+{
+    uint8_t res;
+    uint8_t key;
+    uint16_t n;
+    uint32_t value;
+
+    switch (code)
+    {
+        case EM4095_HOST_CODE_READ :
+        case EM4095_HOST_CODE_CAPTURE :
         {
-            /* help */
-            case 'h' :
+            /* 16 bits read length */
+            if (len != 2)
             {
-                /* set the type */
-                memset(type, 0, sizeof(char) * 33);
-                snprintf(type, 32, "h");
-
-                break;
+                return EM4095_HOST_STATUS_LENGTH;
             }
-
-            /* information */
-            case 'i' :
+            n = (uint16_t)(data[0] | ((uint16_t)data[1] << 8));
+            if ((n == 0) || (n > sizeof(g_rx_buf)) || (n > size))
             {
-                /* set the type */
-                memset(type, 0, sizeof(char) * 33);
-                snprintf(type, 32, "i");
-
-                break;
+                return EM4095_HOST_STATUS_PARAM;
             }
 
-            /* port */
-            case 'p' :
+            /* read data */
+            g_capture_len = 0;
+            if (em4095_basic_read(g_rx_buf, n) != 0)
             {
-                /* set the type */
-                memset(type, 0, sizeof(char) * 33);
-                snprintf(type, 32, "p");
-
-                break;
+                return EM4095_HOST_STATUS_FAILED;
             }
-
-            /* example */
-            case 'e' :
+            if (code == EM4095_HOST_CODE_READ)
             {
-                /* set the type */
-                memset(type, 0, sizeof(char) * 33);
-                snprintf(type, 32, "e_%s", optarg);
+                memcpy(out, g_rx_buf, n);
+                *out_len = n;
 
-                break;
+                return EM4095_HOST_STATUS_OK;
             }
 
-            /* test */
-            case 't' :
+            /* the frame block of the capture callback */
+            if ((g_capture_len == 0) || (g_capture_len > size))
             {
-                /* set the type */
-                memset(type, 0, sizeof(char) * 33);
-                snprintf(type, 32, "t_%s", optarg);
-
-                break;
+                return EM4095_HOST_STATUS_FAILED;
             }
+            memcpy(out, g_capture_buf, g_capture_len);
+            *out_len = g_capture_len;
 
-            /* data */
-            case 1 :
+            return EM4095_HOST_STATUS_OK;
+        }
+        case EM4095_HOST_CODE_WRITE :
+        {
+            if ((len == 0) || (len > sizeof(g_rx_buf)))
             {
-                char *p;
-                uint32_t l;
-                uint16_t i;
-                uint8_t hex_data;
-
-                /* set the data */
-                l = strlen(optarg);
+                return EM4095_HOST_STATUS_LENGTH;
+            }
+            memcpy(g_rx_buf, data, len);
+            if (em4095_basic_write(g_rx_buf, len) != 0)
+            {
+                return EM4095_HOST_STATUS_FAILED;
+            }
+
+            return EM4095_HOST_STATUS_OK;
+        }
+        case EM4095_HOST_CODE_CONFIG :
+        {
+            /* a key to get, a key and a value to set */
+            if ((len != 1) && (len != 5))
+            {
+                return EM4095_HOST_STATUS_LENGTH;
+            }
+            key = data[0];
+            if ((key < EM4095_HOST_CONFIG_DIV) || (key > EM4095_HOST_CONFIG_PLL))
+            {
+                return EM4095_HOST_STATUS_UNKNOWN;
+            }
+            if (len == 5)
+            {
+                value = (uint32_t)data[1] | ((uint32_t)data[2] << 8) |
+                        ((uint32_t)data[3] << 16) | ((uint32_t)data[4] << 24);
+                if (key == EM4095_HOST_CONFIG_DIV)
+                {
+                    res = em4095_basic_set_div(value);
+                }
+                else if (key == EM4095_HOST_CONFIG_OVERSAMPLE)
+                {
+                    res = (value > 0xFF) ? 4 : em4095_basic_set_oversample((uint8_t)value);
+                }
+                else if (key == EM4095_HOST_CONFIG_GLITCH)
+                {
+                    res = (value > 0xFF) ? 4 : em4095_basic_set_glitch_filter((uint8_t)value);
+                }
+                else if (key == EM4095_HOST_CONFIG_GAP)
+                {
+                    res = (value > 0xFFFF) ? 4 : em4095_basic_set_gap((uint16_t)value);
+                }
+                else
+                {
+                    res = (value > 0xFF) ? 4 : em4095_basic_set_pll((uint8_t)value);
+                }
+                if (res != 0)
+                {
+                    return EM4095_HOST_STATUS_PARAM;
+                }
+                gs_host_config[key - 1] = value;
+            }
+            value = gs_host_config[key - 1];
+            out[0] = (uint8_t)(value & 0xFF);
+            out[1] = (uint8_t)((value >> 8) & 0xFF);
+            out[2] = (uint8_t)((value >> 16) & 0xFF);
+            out[3] = (uint8_t)((value >> 24) & 0xFF);
+            *out_len = 4;
+
+            return EM4095_HOST_STATUS_OK;
+        }
+        default :
+        {
+            return EM4095_HOST_STATUS_UNKNOWN;
+        }
+    }
+}
+
+/**
+ * @brief     run the binary host protocol
+ * @param[in] *buf pointer to the first received bytes
+ * @param[in] len received length
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      requests are handled back to back as they arrive and the responses are queued to
+ *            the uart dma, it goes back to the shell after HOST_IDLE_MS without a byte
+ */
+static uint8_t a_host_run(const uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    uint16_t n;
+    uint16_t used;
+    uint16_t response_len;
+    uint32_t last;
+    const uint8_t *response;
+    em4095_host_frame_t frame;
+
+    /* gpio init */
+    res = gpio_interrupt_init();
+    if (res != 0)
+    {
+        return 1;
+    }
+
+    /* set the irq */
+    g_gpio_irq = em4095_basic_irq_handler;
+
+    /* basic init, the capture callback keeps the frame block of every read */
+    res = em4095_basic_init(a_capture_callback);
+    if (res != 0)
+    {
+        (void)gpio_interrupt_deinit();
+        g_gpio_irq = NULL;
+
+        return 1;
+    }
+
+    /* basic init sets the default config */
+    gs_host_config[0] = EM4095_BASIC_DEFAULT_DIV;
+    gs_host_config[1] = 1;
+    gs_host_config[2] = 0;
+    gs_host_config[3] = 0;
+    gs_host_config[4] = 0;
+
+    /* keep the first bytes */
+    gs_host_len = (len > sizeof(gs_host_buf)) ? sizeof(gs_host_buf) : len;
+    memcpy(gs_host_buf, buf, gs_host_len);
+    last = HAL_GetTick();
+    while (1)
+    {
+        /* handle a request */
+        res = em4095_host_parse(gs_host_buf, gs_host_len, &frame, &used);
+        if (res == 0)
+        {
+            if (em4095_host_handle(&gs_host, &frame, &response, &response_len) == 0)
+            {
+                (void)uart_write((uint8_t *)response, response_len);
+            }
+        }
+        else if ((res == 4) || (used != 0))
+        {
+            gs_host.stats.errors++;
+        }
+        else
+        {
+            /* wait the rest */
+        }
+
+        /* drop the used bytes */
+        if (used != 0)
+        {
+            memmove(gs_host_buf, &gs_host_buf[used], gs_host_len - used);
+            gs_host_len = (uint16_t)(gs_host_len - used);
+        }
+        if (res != 1)
+        {
+            continue;
+        }
+
+        /* receive more */
+        n = uart_read_nowait(&gs_host_buf[gs_host_len], (uint16_t)(sizeof(gs_host_buf) - gs_host_len));
+        if (n != 0)
+        {
+            gs_host_len = (uint16_t)(gs_host_len + n);
+            last = HAL_GetTick();
+        }
+        else if ((HAL_GetTick() - last) > HOST_IDLE_MS)
+        {
+            break;
+        }
+        else
+        {
+            /* poll again */
+        }
+    }
+
+    /* basic deinit */
+    (void)em4095_basic_deinit();
+
+    /* gpio deinit */
+    (void)gpio_interrupt_deinit();
+    g_gpio_irq = NULL;
+
+    return 0;
+}
+
+/**
+ * @brief     em4095 full function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 5 param is invalid
+ * @note      none
+ */
+uint8_t em4095(uint8_t argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    char short_options[] = "hipe:t:";
+    struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"information", no_argument, NULL, 'i'},
+        {"port", no_argument, NULL, 'p'},
+        {"example", required_argument, NULL, 'e'},
+        {"test", required_argument, NULL, 't'},
+        {"data", required_argument, NULL, 1},
+        {"length", required_argument, NULL, 2},
+        {"times", required_argument, NULL, 3},
+        {"oversample", required_argument, NULL, 4},
+        {"glitch", required_argument, NULL, 5},
+        {"gap", required_argument, NULL, 6},
+        {"readers", required_argument, NULL, 7},
+        {"antennas", required_argument, NULL, 8},
+        {"format", required_argument, NULL, 9},
+        {"facility", required_argument, NULL, 10},
+        {"card", required_argument, NULL, 11},
+        {"address", required_argument, NULL, 12},
+        {"baud", required_argument, NULL, 13},
+        {"duration", required_argument, NULL, 14},
+        {"timebase", required_argument, NULL, 15},
+        {"pll", required_argument, NULL, 16},
+        {"timeout", required_argument, NULL, 17},
+        {"key", required_argument, NULL, 18},
+        {NULL, 0, NULL, 0},
+    };
+    char type[33] = "unknown";
+    uint32_t times = 3;
+    uint32_t length = 256;
+    uint8_t oversample = 1;
+    uint8_t glitch = 0;
+    uint16_t gap = 0;
+    uint8_t readers = 2;
+    uint8_t antennas = 2;
+    char format[17] = "h10301";
+    uint32_t facility = 0;
+    uint32_t card = 0;
+    uint8_t address = 0;
+    uint32_t baud = 115200;
+    uint32_t duration = 10000;
+    em4095_timebase_t timebase = EM4095_TIMEBASE_TIMER;
+    uint8_t pll = 0;
+    uint32_t timeout = 1000;
+    uint8_t key[16];
+    uint8_t key_set = 0;
+
+    /* if no params */
+    if (argc == 1)
+    {
+        /* goto the help */
+        goto help;
+    }
+
+    /* init 0 */
+    optind = 0;
+
+    /* init 0 */
+    memset(g_rx_buf, 0, sizeof(uint8_t) * 256);
+    
+    /* parse */
+    do
+    {
+        /* parse the args */
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+
+        /* judge the result */
+        switch (c)
+        {
+            /* help */
+            case 'h' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "h");
+
+                break;
+            }
+
+            /* information */
+            case 'i' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "i");
+
+                break;
+            }
+
+            /* port */
+            case 'p' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "p");
+
+                break;
+            }
+
+            /* example */
+            case 'e' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "e_%s", optarg);
+
+                break;
+            }
+
+            /* test */
+            case 't' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "t_%s", optarg);
+
+                break;
+            }
+
+            /* data */
+            case 1 :
+            {
+                char *p;
+                uint32_t l;
+                uint16_t i;
+                uint8_t hex_data;
+
+                /* set the data */
+                l = strlen(optarg);
 
                 /* check the header */
                 if (l >= 2)
@@ -308,24 +945,583 @@ uint8_t em4095(uint8_t argc, char **argv)
                 break;
             }
 
-            /* the end */
-            case -1 :
-            {
-                break;
-            }
+            /* oversample */
+            case 4 :
+            {
+                /* set the oversample */
+                oversample = (uint8_t)atol(optarg);
+
+                break;
+            }
+
+            /* glitch filter */
+            case 5 :
+            {
+                /* set the glitch filter */
+                glitch = (uint8_t)atol(optarg);
+
+                break;
+            }
+
+            /* gap */
+            case 6 :
+            {
+                /* set the gap */
+                gap = (uint16_t)atol(optarg);
+
+                break;
+            }
+
+            /* readers */
+            case 7 :
+            {
+                /* set the readers */
+                readers = (uint8_t)atol(optarg);
+                if ((readers == 0) || (readers > EM4095_MULTI_MAX_READERS))
+                {
+                    em4095_interface_debug_print("em4095: readers must be 1 - %d.\n", EM4095_MULTI_MAX_READERS);
+
+                    return 5;
+                }
+
+                break;
+            }
+
+            /* antennas */
+            case 8 :
+            {
+                /* set the antennas */
+                antennas = (uint8_t)atol(optarg);
+                if ((antennas == 0) || (antennas > EM4095_SCHEDULER_MAX_ANTENNAS))
+                {
+                    em4095_interface_debug_print("em4095: antennas must be 1 - %d.\n", EM4095_SCHEDULER_MAX_ANTENNAS);
+
+                    return 5;
+                }
+
+                break;
+            }
+
+            /* wiegand format */
+            case 9 :
+            {
+                /* set the format */
+                memset(format, 0, sizeof(char) * 17);
+                strncpy(format, optarg, 16);
+
+                break;
+            }
+
+            /* facility code */
+            case 10 :
+            {
+                /* set the facility */
+                facility = (uint32_t)atol(optarg);
+
+                break;
+            }
+
+            /* card number */
+            case 11 :
+            {
+                /* set the card */
+                card = (uint32_t)atol(optarg);
+
+                break;
+            }
+
+            /* osdp address */
+            case 12 :
+            {
+                /* set the address */
+                address = (uint8_t)atol(optarg);
+                if (address >= EM4095_OSDP_BROADCAST)
+                {
+                    em4095_interface_debug_print("em4095: address must be 0 - %d.\n", EM4095_OSDP_BROADCAST - 1);
+
+                    return 5;
+                }
+
+                break;
+            }
+
+            /* osdp baud rate */
+            case 13 :
+            {
+                /* set the baud rate */
+                baud = (uint32_t)atol(optarg);
+
+                break;
+            }
+
+            /* benchmark duration */
+            case 14 :
+            {
+                /* set the duration */
+                duration = (uint32_t)atol(optarg);
+
+                break;
+            }
+
+            /* timebase */
+            case 15 :
+            {
+                /* set the timebase */
+                if (strcmp("timer", optarg) == 0)
+                {
+                    timebase = EM4095_TIMEBASE_TIMER;
+                }
+                else if (strcmp("carrier", optarg) == 0)
+                {
+                    timebase = EM4095_TIMEBASE_CARRIER;
+                }
+                else
+                {
+                    em4095_interface_debug_print("em4095: timebase must be timer or carrier.\n");
+
+                    return 5;
+                }
+
+                break;
+            }
+
+            /* pll */
+            case 16 :
+            {
+                /* set the pll */
+                pll = (uint8_t)atol(optarg);
+                if (pll > EM4095_MAX_PLL_SHIFT)
+                {
+                    em4095_interface_debug_print("em4095: pll must be 0 - %d.\n", EM4095_MAX_PLL_SHIFT);
+
+                    return 5;
+                }
+
+                break;
+            }
+
+            /* timeout */
+            case 17 :
+            {
+                /* set the timeout */
+                timeout = (uint32_t)atol(optarg);
+                if (timeout == 0)
+                {
+                    em4095_interface_debug_print("em4095: timeout must be > 0.\n");
+
+                    return 5;
+                }
+
+                break;
+            }
+
+            /* osdp secure channel base key */
+            case 18 :
+            {
+                uint8_t i;
+                char hex[3];
+                char *end;
+
+                /* set the key */
+                if (strlen(optarg) != 32)
+                {
+                    em4095_interface_debug_print("em4095: key must be 32 hex characters.\n");
+
+                    return 5;
+                }
+                for (i = 0; i < 16; i++)
+                {
+                    hex[0] = optarg[i * 2];
+                    hex[1] = optarg[i * 2 + 1];
+                    hex[2] = 0;
+                    key[i] = (uint8_t)strtoul(hex, &end, 16);
+                    if (*end != 0)
+                    {
+                        em4095_interface_debug_print("em4095: key must be 32 hex characters.\n");
+
+                        return 5;
+                    }
+                }
+                key_set = 1;
+
+                break;
+            }
+
+            /* the end */
+            case -1 :
+            {
+                break;
+            }
+
+            /* others */
+            default :
+            {
+                return 5;
+            }
+        }
+    } while (c != -1);
+
+    /* run the function */
+    if (strcmp("t_read", type) == 0)
+    {
+        uint8_t res;
+
+        /* gpio init */
+        res = gpio_interrupt_init();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        /* set the irq */
+        g_gpio_irq = em4095_read_write_test_irq_handler;
+
+        /* run the read write test */
+        res = em4095_read_write_test(times);
+        if (res != 0)
+        {
+            (void)gpio_interrupt_deinit();
+            g_gpio_irq = NULL;
+
+            return 1;
+        }
+
+        /* gpio deinit */
+        (void)gpio_interrupt_deinit();
+        g_gpio_irq = NULL;
+
+        return 0;
+    }
+    else if (strcmp("t_bench", type) == 0)
+    {
+        uint8_t res;
+        uint32_t ms;
+
+        /* gpio init */
+        res = gpio_interrupt_init();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        /* start the dwt cycle counter */
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+        gs_bench_cycles = 0;
+        gs_bench_irqs = 0;
+
+        /* set the irq */
+        g_gpio_irq = a_benchmark_irq;
+
+        /* run the benchmark test */
+        ms = HAL_GetTick();
+        res = em4095_benchmark_test(duration);
+        ms = HAL_GetTick() - ms;
+        (void)gpio_interrupt_deinit();
+        g_gpio_irq = NULL;
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        /* the irq handler share of the whole run */
+        if ((gs_bench_irqs != 0) && (ms != 0))
+        {
+            em4095_interface_debug_print("em4095: irq handler %d calls, %0.1f cycles per call, %0.2f%% of the cpu.\n",
+                                         gs_bench_irqs, (float)gs_bench_cycles / (float)gs_bench_irqs,
+                                         (float)gs_bench_cycles * 100.0f / ((float)ms * (float)(SystemCoreClock / 1000)));
+        }
+
+        return 0;
+    }
+    else if (strcmp("e_read", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        uint16_t corrected;
+        uint16_t glitches;
+
+        /* gpio init */
+        res = gpio_interrupt_init();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        /* set the irq */
+        g_gpio_irq = em4095_basic_irq_handler;
+
+        /* basic init */
+        res = em4095_basic_init(a_receive_callback);
+        if (res != 0)
+        {
+            (void)gpio_interrupt_deinit();
+            g_gpio_irq = NULL;
+
+            return 1;
+        }
+
+        /* set the filters */
+        res = em4095_basic_set_oversample(oversample);
+        if (res != 0)
+        {
+            (void)gpio_interrupt_deinit();
+            (void)em4095_basic_deinit();
+            g_gpio_irq = NULL;
+
+            return 1;
+        }
+        res = em4095_basic_set_glitch_filter(glitch);
+        if (res != 0)
+        {
+            (void)gpio_interrupt_deinit();
+            (void)em4095_basic_deinit();
+            g_gpio_irq = NULL;
+
+            return 1;
+        }
+        res = em4095_basic_set_gap(gap);
+        if (res != 0)
+        {
+            (void)gpio_interrupt_deinit();
+            (void)em4095_basic_deinit();
+            g_gpio_irq = NULL;
+
+            return 1;
+        }
+        res = em4095_basic_set_timebase(timebase);
+        if (res != 0)
+        {
+            (void)gpio_interrupt_deinit();
+            (void)em4095_basic_deinit();
+            g_gpio_irq = NULL;
+
+            return 1;
+        }
+        res = em4095_basic_set_pll(pll);
+        if (res != 0)
+        {
+            (void)gpio_interrupt_deinit();
+            (void)em4095_basic_deinit();
+            g_gpio_irq = NULL;
+
+            return 1;
+        }
+
+        /* read data */
+        res = em4095_basic_read(g_rx_buf, length);
+        if (res != 0)
+        {
+            (void)gpio_interrupt_deinit();
+            (void)em4095_basic_deinit();
+            g_gpio_irq = NULL;
+
+            return 1;
+        }
+
+        em4095_interface_debug_print("read data: ");
+        for (i = 0; i < length; i++)
+        {
+            em4095_interface_debug_print("0x%02X ", g_rx_buf[i]);
+        }
+        em4095_interface_debug_print(".\n");
+        if (em4095_basic_get_corrected_samples(&corrected, &glitches) == 0)
+        {
+            em4095_interface_debug_print("em4095: corrected samples %d, filtered glitches %d.\n", corrected, glitches);
+        }
+
+        /* basic deinit */
+        (void)em4095_basic_deinit();
+
+        /* gpio deinit */
+        (void)gpio_interrupt_deinit();
+        g_gpio_irq = NULL;
+
+        return 0;
+    }
+    else if (strcmp("e_write", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+
+        /* gpio init */
+        res = gpio_interrupt_init();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        /* set the irq */
+        g_gpio_irq = em4095_basic_irq_handler;
+
+        /* basic init */
+        res = em4095_basic_init(a_receive_callback);
+        if (res != 0)
+        {
+            (void)gpio_interrupt_deinit();
+            g_gpio_irq = NULL;
+
+            return 1;
+        }
+
+        em4095_interface_debug_print("write data: ");
+        for (i = 0; i < length; i++)
+        {
+            em4095_interface_debug_print("0x%02X ", g_rx_buf[i]);
+        }
+        em4095_interface_debug_print(".\n");
+
+        /* write data */
+        res = em4095_basic_write(g_rx_buf, length);
+        if (res != 0)
+        {
+            (void)gpio_interrupt_deinit();
+            (void)em4095_basic_deinit();
+            g_gpio_irq = NULL;
+
+            return 1;
+        }
+
+        /* basic deinit */
+        (void)em4095_basic_deinit();
+
+        /* gpio deinit */
+        (void)gpio_interrupt_deinit();
+        g_gpio_irq = NULL;
+
+        return 0;
+    }
+    else if (strcmp("e_async", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        uint32_t token;
+        uint32_t queued;
+        em4095_basic_status_t status;
+
+        /* gpio init */
+        res = gpio_interrupt_init();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        /* set the irq */
+        g_gpio_irq = em4095_basic_irq_handler;
+
+        /* basic init */
+        res = em4095_basic_init(a_receive_callback);
+        if (res != 0)
+        {
+            (void)gpio_interrupt_deinit();
+            g_gpio_irq = NULL;
+
+            return 1;
+        }
+
+        /* submit a read and poll it */
+        em4095_interface_debug_print("em4095: submit a read with a %dms timeout.\n", timeout);
+        res = em4095_basic_read_async(g_rx_buf, length, timeout, a_async_callback, &token);
+        if (res != 0)
+        {
+            (void)gpio_interrupt_deinit();
+            (void)em4095_basic_deinit();
+            g_gpio_irq = NULL;
+
+            return 1;
+        }
+        res = a_async_poll(token, &status);
+        if (res != 0)
+        {
+            (void)gpio_interrupt_deinit();
+            (void)em4095_basic_deinit();
+            g_gpio_irq = NULL;
+
+            return 1;
+        }
+        if (status == EM4095_BASIC_STATUS_DONE)
+        {
+            em4095_interface_debug_print("read data: ");
+            for (i = 0; i < length; i++)
+            {
+                em4095_interface_debug_print("0x%02X ", g_rx_buf[i]);
+            }
+            em4095_interface_debug_print(".\n");
+        }
+
+        /* queue a second read behind a first one and cancel both */
+        em4095_interface_debug_print("em4095: submit two reads and cancel them.\n");
+        res = em4095_basic_read_async(g_rx_buf, length, timeout, a_async_callback, &token);
+        if (res != 0)
+        {
+            (void)gpio_interrupt_deinit();
+            (void)em4095_basic_deinit();
+            g_gpio_irq = NULL;
+
+            return 1;
+        }
+        res = em4095_basic_read_async(g_rx_buf, length, timeout, a_async_callback, &queued);
+        if (res != 0)
+        {
+            (void)em4095_basic_cancel(token);
+            (void)gpio_interrupt_deinit();
+            (void)em4095_basic_deinit();
+            g_gpio_irq = NULL;
+
+            return 1;
+        }
+        if (em4095_basic_cancel(queued) != 0)
+        {
+            em4095_interface_debug_print("em4095: request 0x%08X finished before the cancel.\n", queued);
+        }
+        if (em4095_basic_cancel(token) != 0)
+        {
+            em4095_interface_debug_print("em4095: request 0x%08X finished before the cancel.\n", token);
+        }
+        (void)a_async_poll(queued, &status);
+        (void)a_async_poll(token, &status);
+
+        /* a read with a 1ms timeout can't finish a frame */
+        em4095_interface_debug_print("em4095: submit a read with a 1ms timeout.\n");
+        res = em4095_basic_read_async(g_rx_buf, length, 1, a_async_callback, &token);
+        if (res != 0)
+        {
+            (void)gpio_interrupt_deinit();
+            (void)em4095_basic_deinit();
+            g_gpio_irq = NULL;
+
+            return 1;
+        }
+        res = a_async_poll(token, &status);
+        if (res != 0)
+        {
+            (void)gpio_interrupt_deinit();
+            (void)em4095_basic_deinit();
+            g_gpio_irq = NULL;
 
-            /* others */
-            default :
-            {
-                return 5;
-            }
+            return 1;
+        }
+        if (status != EM4095_BASIC_STATUS_TIMEOUT)
+        {
+            em4095_interface_debug_print("em4095: request 0x%08X didn't time out.\n", token);
         }
-    } while (c != -1);
 
-    /* run the function */
-    if (strcmp("t_read", type) == 0)
+        /* basic deinit */
+        (void)em4095_basic_deinit();
+
+        /* gpio deinit */
+        (void)gpio_interrupt_deinit();
+        g_gpio_irq = NULL;
+
+        return 0;
+    }
+    else if (strcmp("e_capture", type) == 0)
     {
         uint8_t res;
+        uint16_t l;
+        uint32_t i;
+        em4095_capture_header_t header;
 
         /* gpio init */
         res = gpio_interrupt_init();
@@ -335,27 +1531,87 @@ uint8_t em4095(uint8_t argc, char **argv)
         }
 
         /* set the irq */
-        g_gpio_irq = em4095_read_write_test_irq_handler;
+        g_gpio_irq = em4095_basic_irq_handler;
 
-        /* run the read write test */
-        res = em4095_read_write_test(times);
+        /* basic init */
+        res = em4095_basic_init(a_capture_callback);
+        if (res != 0)
+        {
+            (void)gpio_interrupt_deinit();
+            g_gpio_irq = NULL;
+
+            return 1;
+        }
+
+        /* set the timebase and the pll */
+        res = em4095_basic_set_timebase(timebase);
+        if (res != 0)
+        {
+            (void)gpio_interrupt_deinit();
+            (void)em4095_basic_deinit();
+            g_gpio_irq = NULL;
+
+            return 1;
+        }
+        res = em4095_basic_set_pll(pll);
         if (res != 0)
         {
             (void)gpio_interrupt_deinit();
+            (void)em4095_basic_deinit();
             g_gpio_irq = NULL;
 
             return 1;
         }
 
+        /* stream the file header, a carrier tick is a clock irq */
+        header.version = EM4095_CAPTURE_VERSION;
+        header.mode = EM4095_MODE_READ;
+        header.div = EM4095_BASIC_DEFAULT_DIV;
+        header.tick_hz = (timebase == EM4095_TIMEBASE_CARRIER) ? CAPTURE_CLOCK_HZ : CAPTURE_TICK_HZ;
+        header.clock_hz = CAPTURE_CLOCK_HZ;
+        header.reader_id = HAL_GetUIDw0();
+        l = EM4095_CAPTURE_FRAME_MAX_SIZE;
+        (void)em4095_capture_encode_header(&header, g_capture_buf, &l);
+        em4095_interface_log_flush();
+        (void)uart_write(g_capture_buf, l);
+
+        /* stream the frames */
+        for (i = 0; i < times; i++)
+        {
+            /* init 0 */
+            g_capture_len = 0;
+
+            /* read data */
+            res = em4095_basic_read(g_rx_buf, length);
+            if ((res != 0) || (g_capture_len == 0))
+            {
+                (void)gpio_interrupt_deinit();
+                (void)em4095_basic_deinit();
+                g_gpio_irq = NULL;
+
+                return 1;
+            }
+
+            /* send the frame block */
+            em4095_interface_log_flush();
+            (void)uart_write(g_capture_buf, g_capture_len);
+        }
+
+        /* basic deinit */
+        (void)em4095_basic_deinit();
+
         /* gpio deinit */
         (void)gpio_interrupt_deinit();
         g_gpio_irq = NULL;
 
         return 0;
     }
-    else if (strcmp("e_read", type) == 0)
+    else if (strcmp("e_presence", type) == 0)
     {
         uint8_t res;
+        uint8_t found;
+        uint16_t baseline;
+        uint16_t deviation;
         uint32_t i;
 
         /* gpio init */
@@ -378,8 +1634,8 @@ uint8_t em4095(uint8_t argc, char **argv)
             return 1;
         }
 
-        /* read data */
-        res = em4095_basic_read(g_rx_buf, length);
+        /* presence init with the default schedule */
+        res = em4095_presence_init(NULL);
         if (res != 0)
         {
             (void)gpio_interrupt_deinit();
@@ -389,12 +1645,44 @@ uint8_t em4095(uint8_t argc, char **argv)
             return 1;
         }
 
-        em4095_interface_debug_print("read data: ");
-        for (i = 0; i < length; i++)
+        /* calibrate without a tag */
+        res = em4095_presence_calibrate(8);
+        if (res != 0)
         {
-            em4095_interface_debug_print("0x%02X ", g_rx_buf[i]);
+            (void)gpio_interrupt_deinit();
+            (void)em4095_basic_deinit();
+            g_gpio_irq = NULL;
+
+            return 1;
+        }
+        if (em4095_presence_get_baseline(&baseline, &deviation) == 0)
+        {
+            em4095_interface_debug_print("em4095: baseline %d edges, deviation %d edges.\n", baseline, deviation);
+        }
+
+        /* wait for a tag */
+        res = em4095_presence_read(times, g_rx_buf, length, &found);
+        if (res != 0)
+        {
+            (void)gpio_interrupt_deinit();
+            (void)em4095_basic_deinit();
+            g_gpio_irq = NULL;
+
+            return 1;
+        }
+        if (found != 0)
+        {
+            em4095_interface_debug_print("read data: ");
+            for (i = 0; i < length; i++)
+            {
+                em4095_interface_debug_print("0x%02X ", g_rx_buf[i]);
+            }
+            em4095_interface_debug_print(".\n");
+        }
+        else
+        {
+            em4095_interface_debug_print("em4095: no tag found.\n");
         }
-        em4095_interface_debug_print(".\n");
 
         /* basic deinit */
         (void)em4095_basic_deinit();
@@ -405,10 +1693,15 @@ uint8_t em4095(uint8_t argc, char **argv)
 
         return 0;
     }
-    else if (strcmp("e_write", type) == 0)
+    else if (strcmp("e_carrier", type) == 0)
     {
         uint8_t res;
         uint32_t i;
+        float hz;
+        float ppm;
+        float min_hz = 0.0f;
+        float max_hz = 0.0f;
+        float sum_hz = 0.0f;
 
         /* gpio init */
         res = gpio_interrupt_init();
@@ -430,31 +1723,330 @@ uint8_t em4095(uint8_t argc, char **argv)
             return 1;
         }
 
-        em4095_interface_debug_print("write data: ");
-        for (i = 0; i < length; i++)
+        for (i = 0; i < times; i++)
         {
-            em4095_interface_debug_print("0x%02X ", g_rx_buf[i]);
+            /* measure 100ms of clk edges */
+            res = em4095_basic_measure_carrier(CARRIER_WINDOW, &hz, &ppm);
+            if (res != 0)
+            {
+                em4095_interface_debug_print("em4095: no carrier.\n");
+                (void)gpio_interrupt_deinit();
+                (void)em4095_basic_deinit();
+                g_gpio_irq = NULL;
+
+                return 1;
+            }
+            em4095_interface_debug_print("em4095: carrier is %0.1fHz, detuning is %0.0fppm.\n", hz, ppm);
+            if ((i == 0) || (hz < min_hz))
+            {
+                min_hz = hz;
+            }
+            if ((i == 0) || (hz > max_hz))
+            {
+                max_hz = hz;
+            }
+            sum_hz += hz;
+        }
+        if (times != 0)
+        {
+            em4095_interface_debug_print("em4095: mean carrier is %0.1fHz, drift is %0.1fHz.\n",
+                                         sum_hz / (float)times, max_hz - min_hz);
         }
-        em4095_interface_debug_print(".\n");
 
-        /* write data */
-        res = em4095_basic_write(g_rx_buf, length);
+        /* basic deinit */
+        (void)em4095_basic_deinit();
+
+        /* gpio deinit */
+        (void)gpio_interrupt_deinit();
+        g_gpio_irq = NULL;
+
+        return 0;
+    }
+    else if (strcmp("e_multi", type) == 0)
+    {
+        uint8_t res;
+        uint8_t r;
+        uint32_t i;
+        uint32_t j;
+        uint32_t done;
+        static uint8_t index[EM4095_MULTI_MAX_READERS];
+        static uint8_t buf[EM4095_MULTI_MAX_READERS][256];
+        void *ctx[EM4095_MULTI_MAX_READERS];
+        uint8_t *buf_list[EM4095_MULTI_MAX_READERS];
+
+        /* the context of a reader is its index */
+        for (r = 0; r < readers; r++)
+        {
+            index[r] = r;
+            ctx[r] = &index[r];
+            buf_list[r] = buf[r];
+        }
+
+        /* gpio init */
+        for (r = 0; r < readers; r++)
+        {
+            res = gpio_interrupt_line_init(r);
+            if (res != 0)
+            {
+                while (r != 0)
+                {
+                    r--;
+                    (void)gpio_interrupt_line_deinit(r);
+                }
+
+                return 1;
+            }
+        }
+
+        /* set the irq */
+        g_gpio_line_irq = em4095_multi_irq_handler;
+
+        /* multi init */
+        res = em4095_multi_init(readers, ctx, NULL);
+        if (res != 0)
+        {
+            for (r = 0; r < readers; r++)
+            {
+                (void)gpio_interrupt_line_deinit(r);
+            }
+            g_gpio_line_irq = NULL;
+
+            return 1;
+        }
+
+        for (i = 0; i < times; i++)
+        {
+            /* read all readers with timeout 5s */
+            res = em4095_multi_read(buf_list, (uint16_t)length, 5000, &done);
+            if (res != 0)
+            {
+                (void)em4095_multi_deinit();
+                for (r = 0; r < readers; r++)
+                {
+                    (void)gpio_interrupt_line_deinit(r);
+                }
+                g_gpio_line_irq = NULL;
+
+                return 1;
+            }
+            for (r = 0; r < readers; r++)
+            {
+                if ((done & (1UL << r)) == 0)
+                {
+                    em4095_interface_debug_print("em4095: reader %d timeout.\n", r);
+
+                    continue;
+                }
+                em4095_interface_debug_print("reader %d data: ", r);
+                for (j = 0; j < length; j++)
+                {
+                    em4095_interface_debug_print("0x%02X ", buf[r][j]);
+                }
+                em4095_interface_debug_print(".\n");
+            }
+        }
+
+        /* multi deinit */
+        (void)em4095_multi_deinit();
+
+        /* gpio deinit */
+        for (r = 0; r < readers; r++)
+        {
+            (void)gpio_interrupt_line_deinit(r);
+        }
+        g_gpio_line_irq = NULL;
+
+        return 0;
+    }
+    else if ((strcmp("e_scheduler", type) == 0) || (strcmp("e_osdp", type) == 0))
+    {
+        uint8_t res;
+        uint8_t a;
+        em4095_scheduler_config_t config;
+        uint32_t i;
+        em4095_scheduler_stats_t stats;
+
+        /* cache init */
+        (void)em4095_cache_init(&gs_cache, SCHEDULER_HOLDOFF_MS, SCHEDULER_EXPIRY_MS);
+
+        if (strcmp("e_osdp", type) == 0)
+        {
+            /* the arrived ids are reported to the osdp panel */
+            (void)em4095_osdp_pd_init(&gs_osdp, address, 0, &gs_osdp_id);
+            if (rng_init() != 0)
+            {
+                return 1;
+            }
+            (void)em4095_osdp_pd_set_secure(&gs_osdp, (key_set != 0) ? key : NULL, rng_read);
+            if (uart2_dma_init(baud, a_osdp_receive) != 0)
+            {
+                (void)rng_deinit();
+
+                return 1;
+            }
+            gs_osdp_out = 1;
+        }
+        else
+        {
+            /* the arrived ids are sent as h10301 */
+            gs_wiegand_out = (wiegand_init(WIEGAND_PULSE_US, WIEGAND_INTERVAL_US) == 0) ? 1 : 0;
+        }
+
+        /* gpio init */
+        res = gpio_interrupt_init();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        /* set the irq */
+        g_gpio_irq = em4095_scheduler_irq_handler;
+
+        /* scheduler init */
+        config.antennas = antennas;
+        config.settle_us = EM4095_SCHEDULER_DEFAULT_SETTLE_US;
+        config.min_dwell_us = EM4095_SCHEDULER_DEFAULT_MIN_DWELL_US;
+        config.max_dwell_us = EM4095_SCHEDULER_DEFAULT_MAX_DWELL_US;
+        config.half_us = EM4095_SCHEDULER_DEFAULT_HALF_US;
+        res = em4095_scheduler_init(NULL, &config, a_scheduler_callback);
         if (res != 0)
         {
             (void)gpio_interrupt_deinit();
-            (void)em4095_basic_deinit();
             g_gpio_irq = NULL;
 
             return 1;
         }
 
-        /* basic deinit */
-        (void)em4095_basic_deinit();
+        /* run the cycles */
+        for (i = 0; i < times; i++)
+        {
+            res = em4095_scheduler_run(1);
+            if (res != 0)
+            {
+                (void)em4095_scheduler_deinit();
+                (void)gpio_interrupt_deinit();
+                g_gpio_irq = NULL;
+
+                return 1;
+            }
+            a_scheduler_expire();
+        }
+        for (a = 0; a < antennas; a++)
+        {
+            if (em4095_scheduler_get_stats(a, &stats) == 0)
+            {
+                em4095_interface_debug_print("em4095: antenna %d read %d of %d visits in %dms, next dwell %dms.\n",
+                                             a, stats.reads, stats.dwells, stats.busy_us / 1000, stats.dwell_us / 1000);
+            }
+        }
+
+        /* scheduler deinit */
+        (void)em4095_scheduler_deinit();
 
         /* gpio deinit */
         (void)gpio_interrupt_deinit();
         g_gpio_irq = NULL;
 
+        /* wiegand deinit */
+        if (gs_wiegand_out != 0)
+        {
+            while (wiegand_busy() != 0)
+            {
+                delay_ms(10);
+            }
+            (void)wiegand_deinit();
+            gs_wiegand_out = 0;
+        }
+
+        /* osdp deinit */
+        if (gs_osdp_out != 0)
+        {
+            gs_osdp_out = 0;
+            (void)uart2_dma_deinit();
+            (void)rng_deinit();
+            em4095_interface_debug_print("em4095: osdp handled %d packets with %d errors.\n",
+                                         gs_osdp.packets, gs_osdp.errors);
+        }
+
+        return 0;
+    }
+    else if (strcmp("e_wiegand", type) == 0)
+    {
+        uint8_t res;
+        uint8_t i;
+        uint8_t count;
+        uint64_t payload;
+        char digits[11];
+        const em4095_wiegand_format_t *table;
+
+        /* wiegand init */
+        res = wiegand_init(WIEGAND_PULSE_US, WIEGAND_INTERVAL_US);
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        if (strcmp(format, "aba") == 0)
+        {
+            /* send the card number as aba track 2 */
+            (void)snprintf(digits, 11, "%u", (unsigned int)card);
+            res = wiegand_send_aba(digits);
+            if (res != 0)
+            {
+                (void)wiegand_deinit();
+
+                return 1;
+            }
+            em4095_interface_debug_print("em4095: aba track 2 %s.\n", digits);
+        }
+        else
+        {
+            /* find the format */
+            (void)em4095_wiegand_get_formats(&table, &count);
+            for (i = 0; i < count; i++)
+            {
+                if (strcmp(table[i].name, format) == 0)
+                {
+                    break;
+                }
+            }
+            if (i == count)
+            {
+                em4095_interface_debug_print("em4095: format %s is unknown.\n", format);
+                (void)wiegand_deinit();
+
+                return 5;
+            }
+
+            /* encode and send */
+            res = em4095_wiegand_encode(&table[i], facility, card, &payload);
+            if (res != 0)
+            {
+                em4095_interface_debug_print("em4095: facility or card is too large.\n");
+                (void)wiegand_deinit();
+
+                return 5;
+            }
+            res = wiegand_send(payload, table[i].bits);
+            if (res != 0)
+            {
+                (void)wiegand_deinit();
+
+                return 1;
+            }
+            em4095_interface_debug_print("em4095: %s facility %u card %u.\n", table[i].name,
+                                         (unsigned int)facility, (unsigned int)card);
+        }
+
+        /* wait the frame out */
+        while (wiegand_busy() != 0)
+        {
+            delay_ms(10);
+        }
+
+        /* wiegand deinit */
+        (void)wiegand_deinit();
+
         return 0;
     }
     else if (strcmp("h", type) == 0)
@@ -465,18 +2057,47 @@ uint8_t em4095(uint8_t argc, char **argv)
         em4095_interface_debug_print("  em4095 (-h | --help)\n");
         em4095_interface_debug_print("  em4095 (-p | --port)\n");
         em4095_interface_debug_print("  em4095 (-t readwrite | --test=readwrite) [--times=<num>]\n");
-        em4095_interface_debug_print("  em4095 (-e read | --example=read) [--length=<len>]\n");
+        em4095_interface_debug_print("  em4095 (-t bench | --test=bench) [--duration=<ms>]\n");
+        em4095_interface_debug_print("  em4095 (-e read | --example=read) [--length=<len>] [--oversample=<n>] [--glitch=<n>]\n");
+        em4095_interface_debug_print("         [--gap=<n>] [--timebase=<timer | carrier>] [--pll=<n>]\n");
         em4095_interface_debug_print("  em4095 (-e write | --example=wirte) [--data=<hex>]\n");
+        em4095_interface_debug_print("  em4095 (-e async | --example=async) [--length=<len>] [--timeout=<ms>]\n");
+        em4095_interface_debug_print("  em4095 (-e capture | --example=capture) [--length=<len>] [--times=<num>] [--timebase=<timer | carrier>]\n");
+        em4095_interface_debug_print("         [--pll=<n>]\n");
+        em4095_interface_debug_print("  em4095 (-e presence | --example=presence) [--length=<len>] [--times=<num>]\n");
+        em4095_interface_debug_print("  em4095 (-e carrier | --example=carrier) [--times=<num>]\n");
+        em4095_interface_debug_print("  em4095 (-e multi | --example=multi) [--readers=<n>] [--length=<len>] [--times=<num>]\n");
+        em4095_interface_debug_print("  em4095 (-e scheduler | --example=scheduler) [--antennas=<n>] [--times=<num>]\n");
+        em4095_interface_debug_print("  em4095 (-e wiegand | --example=wiegand) [--format=<name>] [--facility=<n>] [--card=<n>]\n");
+        em4095_interface_debug_print("  em4095 (-e osdp | --example=osdp) [--address=<n>] [--baud=<n>] [--antennas=<n>] [--times=<num>]\n");
+        em4095_interface_debug_print("         [--key=<hex>]\n");
         em4095_interface_debug_print("\n");
         em4095_interface_debug_print("Options:\n");
+        em4095_interface_debug_print("      --address=<n>              Set the osdp pd address.([default: 0])\n");
+        em4095_interface_debug_print("      --antennas=<n>             Set the antenna number of the scheduler example.([default: 2])\n");
+        em4095_interface_debug_print("      --baud=<n>                 Set the osdp baud rate.([default: 115200])\n");
+        em4095_interface_debug_print("      --card=<n>                 Set the wiegand card number.([default: 0])\n");
         em4095_interface_debug_print("      --data=<data>              Set the written data.([default: 0])\n");
-        em4095_interface_debug_print("  -e <read | write>, --example=<read | write>\n");
+        em4095_interface_debug_print("      --duration=<ms>            Set the benchmark duration.([default: 10000])\n");
+        em4095_interface_debug_print("  -e <read | write | async | capture | presence | carrier | multi | scheduler | wiegand | osdp>, --example=<read | write | async | capture | presence | carrier | multi | scheduler | wiegand | osdp>\n");
+        em4095_interface_debug_print("      --facility=<n>             Set the wiegand facility code.([default: 0])\n");
+        em4095_interface_debug_print("      --format=<name>            Set the wiegand format, h10301, h10306, c1k35, h10304, c1k48 or aba.([default: h10301])\n");
         em4095_interface_debug_print("                                 Run the driver example.\n");
+        em4095_interface_debug_print("      --gap=<n>                  Set the frame gap in sample periods, 0 uses the fixed 200ms.([default: 0])\n");
+        em4095_interface_debug_print("      --glitch=<n>               Set the glitch filter width in clock irqs, 0 disables it.([default: 0])\n");
         em4095_interface_debug_print("  -h, --help                     Show the help.\n");
         em4095_interface_debug_print("  -i, --information              Show the chip information.\n");
+        em4095_interface_debug_print("      --key=<hex>                Set the 16 bytes osdp secure channel base key, the default key scbk-d is used without it.\n");
         em4095_interface_debug_print("      --length=<len>             Set the read length.\n");
+        em4095_interface_debug_print("      --oversample=<n>           Set the odd reads per sample, 1 disables it.([default: 1])\n");
         em4095_interface_debug_print("  -p, --port                     Display the pin connections of the current board.\n");
-        em4095_interface_debug_print("  -t <read>, --test=<read>       Run the driver test.([default: 128])\n");
+        em4095_interface_debug_print("      --pll=<n>                  Set the sampling phase loop gain as 1 / 2^n, 0 disables it.([default: 0])\n");
+        em4095_interface_debug_print("      --readers=<n>              Set the reader number of the multi example.([default: 2])\n");
+        em4095_interface_debug_print("  -t <read | bench>, --test=<read | bench>\n");
+        em4095_interface_debug_print("                                 Run the driver test.\n");
+        em4095_interface_debug_print("      --timebase=<timer | carrier>\n");
+        em4095_interface_debug_print("                                 Set the sample timebase, carrier counts the clock irqs.([default: timer])\n");
+        em4095_interface_debug_print("      --timeout=<ms>             Set the async request timeout.([default: 1000])\n");
         em4095_interface_debug_print("      --times=<num>              Set the running times.([default: 3])\n");
 
         return 0;
@@ -506,6 +2127,12 @@ uint8_t em4095(uint8_t argc, char **argv)
         em4095_interface_debug_print("em4095: SHD connected to GPIOB PIN2.\n");
         em4095_interface_debug_print("em4095: DEMOD_OUT connected to GPIOA PIN8.\n");
         em4095_interface_debug_print("em4095: MOD connected to GPIOB PIN1.\n");
+        em4095_interface_debug_print("em4095: reader 1 CLK, SHD, DEMOD_OUT and MOD connected to GPIOC PIN1, PIN6, PIN4 and PIN5.\n");
+        em4095_interface_debug_print("em4095: reader 2 CLK, SHD, DEMOD_OUT and MOD connected to GPIOE PIN2, PIN6, PIN4 and PIN5.\n");
+        em4095_interface_debug_print("em4095: reader 3 CLK, SHD, DEMOD_OUT and MOD connected to GPIOE PIN3, PIN9, PIN7 and PIN8.\n");
+        em4095_interface_debug_print("em4095: antenna mux A0 and A1 connected to GPIOD PIN0 and PIN1.\n");
+        em4095_interface_debug_print("em4095: wiegand D0 and D1 connected to GPIOB PIN12 and PIN13.\n");
+        em4095_interface_debug_print("em4095: osdp rs485 TX, RX and DE connected to GPIOA PIN2, PIN3 and PIN1.\n");
 
         return 0;
     }
@@ -538,16 +2165,27 @@ int main(void)
     /* shell init && register em4095 function */
     shell_init();
     shell_register("em4095", em4095);
+    (void)em4095_host_init(&gs_host, a_host_command);
     uart_print("em4095: welcome to libdriver em4095.\n");
 
     while (1)
     {
         /* read uart */
         g_len = uart_read(g_buf, 256);
-        if (g_len != 0)
+        if ((g_len != 0) && (g_buf[0] == EM4095_HOST_SOF))
+        {
+            /* run the binary host protocol */
+            if (a_host_run(g_buf, g_len) != 0)
+            {
+                uart_print("em4095: host init failed.\n");
+            }
+            uart_flush();
+        }
+        else if (g_len != 0)
         {
             /* run shell */
             res = shell_parse((char *)g_buf, g_len);
+            em4095_interface_log_flush();
             if (res == 0)
             {
                 /* run success */
@@ -578,6 +2216,9 @@ int main(void)
             }
             uart_flush();
         }
+
+        /* send the irq log */
+        em4095_interface_log_flush();
         delay_ms(100);
     }
 }
@@ -165,6 +165,11 @@ void HAL_TIM_Base_MspInit(TIM_HandleTypeDef *htim)
         /* enable nvic */
         HAL_NVIC_EnableIRQ(TIM2_IRQn);
     }
+    else if (htim->Instance == TIM3)
+    {
+        /* enable tim3 clock */
+        __HAL_RCC_TIM3_CLK_ENABLE();
+    }
 }
 
 /**
@@ -182,6 +187,11 @@ void HAL_TIM_Base_MspDeInit(TIM_HandleTypeDef *htim)
         /* disable nvic */
         HAL_NVIC_DisableIRQ(TIM2_IRQn);
     }
+    else if (htim->Instance == TIM3)
+    {
+        /* disable tim3 clock */
+        __HAL_RCC_TIM3_CLK_DISABLE();
+    }
 }
 
 /**
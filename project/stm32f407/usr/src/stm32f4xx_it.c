@@ -37,6 +37,7 @@
 #include "stm32f4xx_it.h"
 #include "tim.h"
 #include "uart.h"
+#include "wiegand.h"
 
 /**
  * @brief nmi handler
@@ -173,6 +174,61 @@ void USART2_IRQHandler(void)
 void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
 {
     __HAL_UART_CLEAR_FEFLAG(huart);
+    if (huart->Instance == USART1)
+    {
+        /* restart the uart tx queue */
+        uart_error_handler();
+    }
+    if (huart->Instance == USART2)
+    {
+        /* restart the uart2 dma reception */
+        uart2_dma_error_handler();
+    }
+}
+
+/**
+ * @brief     uart rx event callback
+ * @param[in] *huart pointer to a uart handle
+ * @param[in] Size received length
+ * @note      none
+ */
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+    if (huart->Instance == USART2)
+    {
+        /* run the uart2 rx event handler */
+        uart2_rx_event_handler(Size);
+    }
+}
+
+/**
+ * @brief dma1 stream5 irq handler
+ * @note  none
+ */
+void DMA1_Stream5_IRQHandler(void)
+{
+    /* run the uart2 dma rx handler */
+    uart2_dma_rx_irq_handler();
+}
+
+/**
+ * @brief dma1 stream6 irq handler
+ * @note  none
+ */
+void DMA1_Stream6_IRQHandler(void)
+{
+    /* run the uart2 dma tx handler */
+    uart2_dma_tx_irq_handler();
+}
+
+/**
+ * @brief dma2 stream7 irq handler
+ * @note  none
+ */
+void DMA2_Stream7_IRQHandler(void)
+{
+    /* run the uart dma tx handler */
+    uart_dma_tx_irq_handler();
 }
 
 /**
@@ -213,6 +269,16 @@ void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
     }
 }
 
+/**
+ * @brief dma1 stream2 irq handler
+ * @note  none
+ */
+void DMA1_Stream2_IRQHandler(void)
+{
+    /* run the wiegand dma handler */
+    wiegand_dma_irq_handler();
+}
+
 /**
  * @brief tim2 irq handler
  * @note  none
@@ -35,6 +35,9 @@
  */
 
 #include "driver_em4095.h"
+#if (EM4095_OS != 0)
+#include "driver_em4095_os.h"
+#endif
 
 /**
  * @brief chip information definition
@@ -48,6 +51,53 @@
 #define TEMPERATURE_MAX           110.0f                             /**< chip max operating temperature */
 #define DRIVER_VERSION            1000                               /**< driver version */
 
+/**
+ * @brief      read the time of the timebase
+ * @param[in]  *handle pointer to an em4095 handle structure
+ * @param[out] *t pointer to a time structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 timestamp read failed
+ * @note       the carrier timebase takes the edge counter without calling timestamp_read
+ */
+static uint8_t a_em4095_time_read(em4095_handle_t *handle, em4095_time_t *t)
+{
+    if (handle->timebase == EM4095_TIMEBASE_CARRIER)                    /* carrier timebase */
+    {
+        t->s = 0;                                                       /* no second */
+        t->us = handle->edges;                                          /* edge counter */
+
+        return 0;                                                       /* success return 0 */
+    }
+    if (handle->timestamp_read(t) != 0)                                 /* timestamp read */
+    {
+        handle->debug_print("em4095: timestamp read failed.\n");        /* timestamp read failed */
+
+        return 1;                                                       /* return error */
+    }
+
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief     get the diff of two times
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @param[in] *now pointer to a later time
+ * @param[in] *last pointer to an earlier time
+ * @return    diff in us or in clock irqs
+ * @note      the edge counter diff is taken modulo 2^32
+ */
+static int64_t a_em4095_time_sub(em4095_handle_t *handle, const em4095_time_t *now, const em4095_time_t *last)
+{
+    if (handle->timebase == EM4095_TIMEBASE_CARRIER)           /* carrier timebase */
+    {
+        return (int64_t)(uint32_t)(now->us - last->us);        /* wrapped edge diff */
+    }
+
+    return (int64_t)(now->s - last->s) * 1000000 +
+           ((int64_t)now->us - (int64_t)last->us);             /* us diff */
+}
+
 /**
  * @brief     em4095 get diff time
  * @param[in] *handle pointer to an em4095 handle structure
@@ -63,14 +113,188 @@ static void a_em4095_time_diff(em4095_handle_t *handle)
     {
         int64_t diff;
 
-        diff = (int64_t)((int64_t)handle->decode[i + 1].t.s -
-               (int64_t)handle->decode[i].t.s) * 1000000 +
-               (int64_t)((int64_t)handle->decode[i + 1].t.us -
-               (int64_t)handle->decode[i].t.us);                       /* diff time */
+        diff = a_em4095_time_sub(handle, &handle->decode[i + 1].t,
+                                 &handle->decode[i].t);                /* diff time */
         handle->decode[i].diff_us = (uint32_t)diff;                    /* save the time diff */
     }
 }
 
+/**
+ * @brief     update the glitch filter
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_glitch_filter(em4095_handle_t *handle)
+{
+    uint8_t res;
+    uint8_t level;
+
+    res = handle->demod_gpio_read(handle->ctx, &level);                  /* read gpio level */
+    if (res != 0)                                                        /* check result */
+    {
+        handle->debug_print("em4095: demod gpio read failed.\n");        /* demod gpio read failed */
+
+        return 1;                                                        /* return error */
+    }
+    if (level != handle->filter_level)                                   /* level changed */
+    {
+        handle->glitch_count++;                                          /* count++ */
+        if (handle->glitch_count >= handle->glitch)                      /* stable long enough */
+        {
+            handle->filter_level = level;                                /* take the level */
+            handle->glitch_count = 0;                                    /* init 0 */
+        }
+    }
+    else if (handle->glitch_count != 0)                                  /* pulse is too short */
+    {
+        handle->glitch_count = 0;                                        /* init 0 */
+        handle->glitches++;                                              /* glitches++ */
+    }
+    else
+    {
+        /* stable level */
+    }
+
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief      read the demod level
+ * @param[in]  *handle pointer to an em4095 handle structure
+ * @param[out] *level pointer to a level buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       the filtered level is used when the glitch filter is enabled
+ */
+static uint8_t a_read_level(em4095_handle_t *handle, uint8_t *level)
+{
+    uint8_t res;
+
+    if (handle->glitch != 0)                                             /* glitch filter enabled */
+    {
+        *level = handle->filter_level;                                   /* filtered level */
+
+        return 0;                                                        /* success return 0 */
+    }
+    res = handle->demod_gpio_read(handle->ctx, level);                   /* read gpio level */
+    if (res != 0)                                                        /* check result */
+    {
+        handle->debug_print("em4095: demod gpio read failed.\n");        /* demod gpio read failed */
+
+        return 1;                                                        /* return error */
+    }
+
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief     read vote
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 not sync
+ * @note      the reads are step irqs apart and centered half a div after the sync edge, the same
+ *            phase the pll samples at, the sample is ready at the last read and div length
+ *            restarts at the end of the period
+ */
+static uint8_t a_read_vote(em4095_handle_t *handle)
+{
+    uint8_t level;
+    uint32_t step;
+    uint32_t first;
+
+    step = handle->div / (2 * (uint32_t)handle->oversample);                    /* middle half of the period */
+    if (step == 0)                                                              /* check step */
+    {
+        step = 1;                                                               /* at least 1 */
+    }
+    first = handle->div / 2 - ((handle->oversample - 1) * step) / 2;            /* first read before the middle */
+    if (handle->div_len >= handle->div)                                         /* end of the period */
+    {
+        handle->div_len = 0;                                                    /* init 0 */
+    }
+    if (handle->div_len != first + handle->vote_count * step)                   /* not a read point */
+    {
+        return 2;                                                               /* return error */
+    }
+    if (a_read_level(handle, &level) != 0)                                      /* read level */
+    {
+        return 1;                                                               /* return error */
+    }
+    handle->vote_ones += level;                                                 /* add the vote */
+    handle->vote_count++;                                                       /* count++ */
+    if (handle->vote_count < handle->oversample)                                /* not the last read */
+    {
+        return 2;                                                               /* return error */
+    }
+    handle->vote_level = ((uint32_t)handle->vote_ones * 2 >
+                          handle->oversample) ? 1 : 0;                          /* majority */
+    handle->vote_count = 0;                                                     /* init 0 */
+
+    return 0;                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     update the sampling phase loop
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      an edge belongs in the middle of two sample points, its distance from there is the
+ *            phase error, 1 / 2^shift of it is taken from the div length and 1 / 2^(2 * shift + 2)
+ *            of it is integrated as the frequency term, so a tag clock offset leaves no phase error
+ */
+static uint8_t a_read_pll(em4095_handle_t *handle)
+{
+    uint8_t level;
+    int32_t err;
+    int32_t corr;
+    int32_t pos;
+    int32_t limit;
+
+    if (a_read_level(handle, &level) != 0)                                   /* read level */
+    {
+        return 1;                                                            /* return error */
+    }
+    if (level == handle->last_bit)                                           /* no edge */
+    {
+        return 0;                                                            /* success return 0 */
+    }
+    handle->last_bit = level;                                                /* save bit */
+    err = (int32_t)handle->div_len - (int32_t)(handle->div / 2);             /* edge phase error */
+    limit = (int32_t)handle->div * 32;                                       /* 1/8 of a cell */
+    handle->pll_freq += (err * 256) / (4 << (2 * handle->pll_shift));        /* integrate the error */
+    if (handle->pll_freq > limit)                                            /* check the max */
+    {
+        handle->pll_freq = limit;                                            /* limit */
+    }
+    if (handle->pll_freq < -limit)                                           /* check the min */
+    {
+        handle->pll_freq = -limit;                                           /* limit */
+    }
+    handle->pll_acc += (err * 256) / (1 << handle->pll_shift) +
+                       handle->pll_freq;                                     /* add the gain of the error */
+    corr = handle->pll_acc / 256;                                            /* whole irqs */
+    handle->pll_acc -= corr * 256;                                           /* keep the fraction */
+    pos = (int32_t)handle->div_len - corr;                                   /* move the sample point */
+    if (pos < 0)                                                             /* check the min */
+    {
+        pos = 0;                                                             /* at least 0 */
+    }
+    if (pos > (int32_t)handle->div - 1)                                      /* check the max */
+    {
+        pos = (int32_t)handle->div - 1;                                      /* sample at the next irq */
+    }
+    handle->div_len = (uint32_t)pos;                                         /* set div length */
+
+    return 0;                                                                /* success return 0 */
+}
+
 /**
  * @brief     read sync
  * @param[in] *handle pointer to an em4095 handle structure
@@ -89,11 +313,9 @@ static uint8_t a_read_sync(em4095_handle_t *handle)
     {
         uint8_t level;
 
-        res = handle->demod_gpio_read(&level);                               /* read gpio level */
+        res = a_read_level(handle, &level);                                  /* read level */
         if (res != 0)                                                        /* check result */
         {
-            handle->debug_print("em4095: demod gpio read failed.\n");        /* demod gpio read failed */
-
             return 1;                                                        /* return error */
         }
         if (handle->last_bit != level)                                       /* check last bit */
@@ -102,6 +324,12 @@ static uint8_t a_read_sync(em4095_handle_t *handle)
             handle->start_flag++;                                            /* start flag++ */
             if (handle->start_flag >= 1)                                     /* check flag */
             {
+                if ((handle->pll_shift != 0) && (handle->oversample <= 1))   /* pll enabled */
+                {
+                    handle->div_len = handle->div / 2;                       /* sample in the middle */
+                    handle->pll_acc = 0;                                     /* init 0 */
+                    handle->pll_freq = 0;                                    /* init 0 */
+                }
                 goto start;                                                  /* goto flag */
             }
 
@@ -115,6 +343,17 @@ static uint8_t a_read_sync(em4095_handle_t *handle)
 
     start:
     handle->div_len++;                                                       /* div length++ */
+    if (handle->oversample > 1)                                              /* oversampling */
+    {
+        return a_read_vote(handle);                                          /* vote */
+    }
+    if (handle->pll_shift != 0)                                              /* pll enabled */
+    {
+        if (a_read_pll(handle) != 0)                                         /* track the edges */
+        {
+            return 1;                                                        /* return error */
+        }
+    }
     if (handle->div_len >= handle->div)                                      /* wait for div */
     {
         handle->div_len = 0;                                                 /* init to 0 */
@@ -150,6 +389,86 @@ static uint8_t a_write_sync(em4095_handle_t *handle)
     }
 }
 
+/**
+ * @brief     check the read gap
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @param[in] diff time from the last sample in us
+ * @return    status code
+ *            - 0 no gap
+ *            - 1 gap
+ * @note      none
+ */
+static uint8_t a_read_gap(em4095_handle_t *handle, int64_t diff)
+{
+    if ((handle->gap == 0) || (handle->period_us == 0))                      /* no gap or no period */
+    {
+        if (handle->timebase == EM4095_TIMEBASE_CARRIER)                     /* carrier timebase */
+        {
+            return (diff - (int64_t)EM4095_GAP_TIMEOUT_EDGES >= 0) ? 1 : 0;  /* fixed edges */
+        }
+
+        return (diff - (int64_t)EM4095_GAP_TIMEOUT_US >= 0) ? 1 : 0;         /* fixed timeout */
+    }
+    if (diff > (int64_t)handle->gap * (int64_t)handle->period_us)            /* check the periods */
+    {
+        return 1;                                                            /* gap */
+    }
+
+    return 0;                                                                /* no gap */
+}
+
+/**
+ * @brief     update the average sample period
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @param[in] diff time from the last sample in us
+ * @note      1/8 exponential moving average
+ */
+static void a_read_period(em4095_handle_t *handle, int64_t diff)
+{
+    int64_t period;
+
+    if (handle->period_us == 0)                                              /* first period */
+    {
+        handle->period_us = (uint32_t)diff;                                  /* save period */
+
+        return;
+    }
+    period = (int64_t)handle->period_us;                                     /* get period */
+    period += (diff - period) / 8;                                           /* 1/8 of the error */
+    handle->period_us = (uint32_t)period;                                    /* save period */
+}
+
+#if (EM4095_OS != 0)
+/**
+ * @brief     wake the blocking caller
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @note      none
+ */
+static void a_em4095_done(em4095_handle_t *handle)
+{
+    if (handle->done != NULL)                          /* check the semaphore */
+    {
+        (void)em4095_os_sem_give(handle->done);        /* wake the caller */
+    }
+}
+#endif
+
+/**
+ * @brief     end the read frame
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @param[in] event frame boundary event
+ * @note      the event callback gets the samples before the boundary
+ */
+static void a_read_event(em4095_handle_t *handle, em4095_event_t event)
+{
+    if (handle->event_callback != NULL)                                      /* check event callback */
+    {
+        handle->event_callback(handle->ctx, event,
+                               handle->decode, handle->decode_len);          /* run the event callback */
+    }
+    handle->decode_len = 0;                                                  /* reset the decode */
+}
+
 /**
  * @brief     irq handler
  * @param[in] *handle pointer to an em4095 handle structure
@@ -175,58 +494,99 @@ uint8_t em4095_irq_handler(em4095_handle_t *handle)
         return 3;                                                              /* return error */
     }
 
+    handle->edges++;                                                           /* edges++ */
     if (handle->mode == EM4095_MODE_READ)                                      /* read mode */
     {
         uint8_t level;
 
-        if (a_read_sync(handle) != 0)                                          /* wait read sync */
+        if (handle->glitch != 0)                                               /* glitch filter enabled */
         {
-            return 0;                                                          /* success return 0 */
+            if (a_glitch_filter(handle) != 0)                                  /* update the filter */
+            {
+                return 1;                                                      /* return error */
+            }
         }
-        res = handle->timestamp_read(&t);                                      /* timestamp read */
-        if (res != 0)                                                          /* check result */
+        res = a_read_sync(handle);                                             /* wait read sync */
+        if (res == 1)                                                          /* check result */
         {
-            handle->debug_print("em4095: timestamp read failed.\n");           /* timestamp read failed */
-
             return 1;                                                          /* return error */
         }
-        res = handle->demod_gpio_read(&level);                                 /* read gpio level */
-        if (res != 0)                                                          /* check result */
+        if (res != 0)                                                          /* not sync */
+        {
+            return 0;                                                          /* success return 0 */
+        }
+        if (a_em4095_time_read(handle, &t) != 0)                               /* time read */
         {
-            handle->debug_print("em4095: demod gpio read failed.\n");          /* demod gpio read failed */
-
             return 1;                                                          /* return error */
         }
-        diff = (int64_t)(t.s - handle->last_time.s) * 1000000 +
-               (int64_t)(t.us - handle->last_time.us) ;                        /* now - last time */
-        if (diff - (int64_t)200000L >= 0)                                      /* if over 1s, force reset */
+        if (handle->oversample > 1)                                            /* oversampling */
+        {
+            level = handle->vote_level;                                        /* voted level */
+        }
+        else
+        {
+            res = a_read_level(handle, &level);                                /* read level */
+            if (res != 0)                                                      /* check result */
+            {
+                return 1;                                                      /* return error */
+            }
+        }
+        diff = a_em4095_time_sub(handle, &t, &handle->last_time);              /* now - last time */
+        if (handle->decode_len != 0)                                           /* not the first sample */
         {
-            handle->decode_len = 0;                                            /* reset the decode */
+            handle->decode[handle->decode_len - 1].diff_us = (uint32_t)diff;   /* diff of the last sample */
+            if (a_read_gap(handle, diff) != 0)                                 /* check the gap */
+            {
+                a_read_event(handle, EM4095_EVENT_GAP);                        /* frame boundary */
+            }
+            else
+            {
+                a_read_period(handle, diff);                                   /* update the period */
+            }
         }
         if (handle->decode_len >= (EM4095_MAX_LENGTH - 1))                     /* check the max length */
         {
-            handle->decode_len = 0;                                            /* reset the decode */
+            a_read_event(handle, EM4095_EVENT_OVERFLOW);                       /* frame boundary */
+        }
+        if (handle->decode_len == 0)                                           /* a new frame */
+        {
+            handle->corrected = 0;                                             /* init 0 */
+            handle->glitches = 0;                                              /* init 0 */
+        }
+        if ((handle->oversample > 1) && (handle->vote_ones != 0) &&
+            (handle->vote_ones != handle->oversample))                         /* votes are not unanimous */
+        {
+            handle->corrected++;                                               /* corrected++ */
         }
+        handle->vote_ones = 0;                                                 /* init 0 */
         handle->decode[handle->decode_len].t.s = t.s;                          /* save s */
         handle->decode[handle->decode_len].t.us = t.us;                        /* save us */
+        handle->decode[handle->decode_len].diff_us = 0;                        /* not known yet */
         handle->decode[handle->decode_len].level = level;                      /* save level */
+        if (handle->sample_callback != NULL)                                   /* check sample callback */
+        {
+            handle->sample_callback(handle->ctx, handle->decode_len, level,
+                                    (uint32_t)diff);                           /* run the sample callback */
+        }
         handle->decode_len++;                                                  /* length++ */
         handle->last_time.s = t.s;                                             /* save last time */
         handle->last_time.us = t.us;                                           /* save last time */
         if (handle->decode_len >= handle->len)                                 /* check length */
         {
-            res = handle->shd_gpio_write(1);                                   /* goto sleep mode */
+            res = handle->shd_gpio_write(handle->ctx, 1);                      /* goto sleep mode */
             if (res != 0)                                                      /* check result */
             {
                 handle->debug_print("em4095: shd gpio write failed.\n");       /* shd gpio write failed */
 
                 return 1;                                                      /* return error */
             }
-            a_em4095_time_diff(handle);                                        /* get time diff */
-            handle->receive_callback((em4095_mode_t)handle->mode,
+            handle->mode = EM4095_MODE_IDLE;                                   /* set idle mode */
+            handle->receive_callback(handle->ctx, EM4095_MODE_READ,
                                      handle->decode,
                                      handle->decode_len);                      /* run the callback */
-            handle->mode = EM4095_MODE_IDLE;                                   /* set idle mode */
+#if (EM4095_OS != 0)
+            a_em4095_done(handle);                                             /* wake the blocking caller */
+#endif
         }
     }
     else if (handle->mode == EM4095_MODE_WRITE)                                /* write mode */
@@ -237,11 +597,8 @@ uint8_t em4095_irq_handler(em4095_handle_t *handle)
         {
             return 0;                                                          /* success return 0 */
         }
-        res = handle->timestamp_read(&t);                                      /* timestamp read */
-        if (res != 0)                                                          /* check result */
+        if (a_em4095_time_read(handle, &t) != 0)                               /* time read */
         {
-            handle->debug_print("em4095: timestamp read failed.\n");           /* timestamp read failed */
-
             return 1;                                                          /* return error */
         }
         handle->decode[handle->len].t.s = t.s;                                 /* save s */
@@ -250,7 +607,7 @@ uint8_t em4095_irq_handler(em4095_handle_t *handle)
         handle->len++;                                                         /* length++ */
         if (handle->last_bit != level)                                         /* if not the set level */
         {
-            res = handle->mod_gpio_write(level);                               /* mod gpio write level */
+            res = handle->mod_gpio_write(handle->ctx, level);                  /* mod gpio write level */
             if (res != 0)                                                      /* check result */
             {
                 handle->debug_print("em4095: mod gpio write failed.\n");       /* mod gpio write */
@@ -261,7 +618,7 @@ uint8_t em4095_irq_handler(em4095_handle_t *handle)
         handle->last_bit = level;                                              /* save last bit */
         if (handle->len >= handle->decode_len)                                 /* check length */
         {
-            res = handle->shd_gpio_write(1);                                   /* goto sleep mode */
+            res = handle->shd_gpio_write(handle->ctx, 1);                      /* goto sleep mode */
             if (res != 0)                                                      /* check result */
             {
                 handle->debug_print("em4095: shd gpio write failed.\n");       /* shd gpio write failed */
@@ -269,10 +626,93 @@ uint8_t em4095_irq_handler(em4095_handle_t *handle)
                 return 1;                                                      /* return error */
             }
             a_em4095_time_diff(handle);                                        /* get time diff */
-            handle->receive_callback((em4095_mode_t)handle->mode,
+            handle->mode = EM4095_MODE_IDLE;                                   /* set idle mode */
+            handle->receive_callback(handle->ctx, EM4095_MODE_WRITE,
                                      handle->decode,
                                      handle->decode_len);                      /* run the callback */
+#if (EM4095_OS != 0)
+            a_em4095_done(handle);                                             /* wake the blocking caller */
+#endif
+        }
+    }
+    else if (handle->mode == EM4095_MODE_SENSE)                                /* sense mode */
+    {
+        uint8_t level;
+
+        if (handle->glitch != 0)                                               /* glitch filter enabled */
+        {
+            if (a_glitch_filter(handle) != 0)                                  /* update the filter */
+            {
+                return 1;                                                      /* return error */
+            }
+        }
+        if (a_read_level(handle, &level) != 0)                                 /* read level */
+        {
+            return 1;                                                          /* return error */
+        }
+        handle->sense_ticks++;                                                 /* ticks++ */
+        if ((handle->sense_ticks > handle->sense_settle) &&
+            (level != handle->last_bit) && (handle->sense_edges < 0xFFFFU))    /* an edge in the window */
+        {
+            handle->sense_edges++;                                             /* edges++ */
+        }
+        handle->last_bit = level;                                              /* save last bit */
+        if (handle->sense_ticks >= (uint32_t)handle->sense_settle +
+                                   handle->sense_window)                       /* check the window */
+        {
+            res = handle->shd_gpio_write(handle->ctx, 1);                      /* goto sleep mode */
+            if (res != 0)                                                      /* check result */
+            {
+                handle->debug_print("em4095: shd gpio write failed.\n");       /* shd gpio write failed */
+
+                return 1;                                                      /* return error */
+            }
+            handle->mode = EM4095_MODE_IDLE;                                   /* set idle mode */
+            handle->receive_callback(handle->ctx, EM4095_MODE_SENSE,
+                                     NULL,
+                                     handle->sense_edges);                     /* run the callback */
+        }
+    }
+    else if (handle->mode == EM4095_MODE_MEASURE)                              /* measure mode */
+    {
+        handle->sense_ticks++;                                                 /* ticks++ */
+        if (handle->sense_ticks == (uint32_t)handle->sense_settle + 1)         /* window start */
+        {
+            res = handle->timestamp_read(&handle->measure_start);              /* timestamp read */
+            if (res != 0)                                                      /* check result */
+            {
+                handle->debug_print("em4095: timestamp read failed.\n");       /* timestamp read failed */
+
+                return 1;                                                      /* return error */
+            }
+        }
+        else if (handle->sense_ticks == (uint32_t)handle->sense_settle + 1 +
+                                       handle->measure_window)                 /* window end */
+        {
+            res = handle->timestamp_read(&t);                                  /* timestamp read */
+            if (res != 0)                                                      /* check result */
+            {
+                handle->debug_print("em4095: timestamp read failed.\n");       /* timestamp read failed */
+
+                return 1;                                                      /* return error */
+            }
+            diff = (int64_t)(t.s - handle->measure_start.s) * 1000000 +
+                   (int64_t)(t.us - handle->measure_start.us);                 /* now - start time */
+            handle->measure_us = (uint32_t)diff;                               /* save the window time */
+            res = handle->shd_gpio_write(handle->ctx, 1);                      /* goto sleep mode */
+            if (res != 0)                                                      /* check result */
+            {
+                handle->debug_print("em4095: shd gpio write failed.\n");       /* shd gpio write failed */
+
+                return 1;                                                      /* return error */
+            }
             handle->mode = EM4095_MODE_IDLE;                                   /* set idle mode */
+            handle->receive_callback(handle->ctx, EM4095_MODE_MEASURE,
+                                     NULL, 0);                                 /* run the callback */
+        }
+        else
+        {
+            /* inside the window */
         }
     }
     else
@@ -379,37 +819,37 @@ uint8_t em4095_init(em4095_handle_t *handle)
         return 3;                                                          /* return error */
     }
 
-    res = handle->demod_gpio_init();                                       /* demod gpio init */
+    res = handle->demod_gpio_init(handle->ctx);                            /* demod gpio init */
     if (res != 0)                                                          /* check the result */
     {
         handle->debug_print("em4095: demod gpio init failed.\n");          /* demod gpio init failed */
 
         return 1;                                                          /* return error */
     }
-    res = handle->mod_gpio_init();                                         /* mod gpio init */
+    res = handle->mod_gpio_init(handle->ctx);                              /* mod gpio init */
     if (res != 0)                                                          /* check the result */
     {
         handle->debug_print("em4095: mod gpio init failed.\n");            /* mod gpio init failed */
-        (void)handle->demod_gpio_deinit();                                 /* demod gpio deinit */
+        (void)handle->demod_gpio_deinit(handle->ctx);                      /* demod gpio deinit */
 
         return 1;                                                          /* return error */
     }
-    res = handle->shd_gpio_init();                                         /* shd gpio init */
+    res = handle->shd_gpio_init(handle->ctx);                              /* shd gpio init */
     if (res != 0)                                                          /* check the result */
     {
         handle->debug_print("em4095: shd gpio init failed.\n");            /* shd gpio init failed */
-        (void)handle->demod_gpio_deinit();                                 /* demod gpio deinit */
-        (void)handle->mod_gpio_deinit();                                   /* mod gpio deinit */
+        (void)handle->demod_gpio_deinit(handle->ctx);                      /* demod gpio deinit */
+        (void)handle->mod_gpio_deinit(handle->ctx);                        /* mod gpio deinit */
 
         return 1;                                                          /* return error */
     }
-    res = handle->shd_gpio_write(1);                                       /* goto sleep mode */
+    res = handle->shd_gpio_write(handle->ctx, 1);                          /* goto sleep mode */
     if (res != 0)                                                          /* check the result */
     {
         handle->debug_print("em4095: shd gpio write failed.\n");           /* shd gpio write failed */
-        (void)handle->demod_gpio_deinit();                                 /* demod gpio deinit */
-        (void)handle->mod_gpio_deinit();                                   /* mod gpio deinit */
-        (void)handle->shd_gpio_deinit();                                   /* shd gpio deinit */
+        (void)handle->demod_gpio_deinit(handle->ctx);                      /* demod gpio deinit */
+        (void)handle->mod_gpio_deinit(handle->ctx);                        /* mod gpio deinit */
+        (void)handle->shd_gpio_deinit(handle->ctx);                        /* shd gpio deinit */
 
         return 1;                                                          /* return error */
     }
@@ -417,9 +857,9 @@ uint8_t em4095_init(em4095_handle_t *handle)
     if (res != 0)                                                          /* check result */
     {
         handle->debug_print("em4095: timestamp read failed.\n");           /* timestamp read failed */
-        (void)handle->demod_gpio_deinit();                                 /* demod gpio deinit */
-        (void)handle->mod_gpio_deinit();                                   /* mod gpio deinit */
-        (void)handle->shd_gpio_deinit();                                   /* shd gpio deinit */
+        (void)handle->demod_gpio_deinit(handle->ctx);                      /* demod gpio deinit */
+        (void)handle->mod_gpio_deinit(handle->ctx);                        /* mod gpio deinit */
+        (void)handle->shd_gpio_deinit(handle->ctx);                        /* shd gpio deinit */
 
         return 1;                                                          /* return error */
     }
@@ -432,6 +872,17 @@ uint8_t em4095_init(em4095_handle_t *handle)
     handle->div_len = 0;                                                   /* init 0 */
     handle->start_flag = 0;                                                /* flag not start */
     handle->last_bit = 0;                                                  /* init 0 */
+    handle->oversample = 1;                                                /* no oversampling */
+    handle->glitch = 0;                                                    /* no glitch filter */
+    handle->corrected = 0;                                                 /* init 0 */
+    handle->glitches = 0;                                                  /* init 0 */
+    handle->gap = 0;                                                       /* fixed timeout */
+    handle->period_us = 0;                                                 /* not known */
+    handle->timebase = EM4095_TIMEBASE_TIMER;                              /* timer timebase */
+    handle->pll_shift = 0;                                                 /* no pll */
+    handle->pll_acc = 0;                                                   /* init 0 */
+    handle->pll_freq = 0;                                                  /* init 0 */
+    handle->edges = 0;                                                     /* init 0 */
     handle->inited = 1;                                                    /* flag inited */
 
     return 0;                                                              /* success return 0 */
@@ -460,35 +911,42 @@ uint8_t em4095_deinit(em4095_handle_t *handle)
         return 3;                                                        /* return error */
     }
 
-    res = handle->shd_gpio_write(1);                                     /* goto sleep mode */
+    res = handle->shd_gpio_write(handle->ctx, 1);                        /* goto sleep mode */
     if (res != 0)                                                        /* check the result */
     {
         handle->debug_print("em4095: shd gpio write failed.\n");         /* shd gpio write failed */
 
         return 1;                                                        /* return error */
     }
-    res = handle->demod_gpio_deinit();                                   /* demod gpio deinit */
+    res = handle->demod_gpio_deinit(handle->ctx);                        /* demod gpio deinit */
     if (res != 0)                                                        /* check the result */
     {
         handle->debug_print("em4095: demod gpio deinit failed.\n");      /* demod gpio deinit failed */
 
         return 1;                                                        /* return error */
     }
-    res = handle->mod_gpio_deinit();                                     /* mod gpio deinit */
+    res = handle->mod_gpio_deinit(handle->ctx);                          /* mod gpio deinit */
     if (res != 0)                                                        /* check the result */
     {
         handle->debug_print("em4095: mod gpio deinit failed.\n");        /* mod gpio deinit failed */
 
         return 1;                                                        /* return error */
     }
-    res = handle->shd_gpio_deinit();                                     /* shd gpio deinit */
+    res = handle->shd_gpio_deinit(handle->ctx);                          /* shd gpio deinit */
     if (res != 0)                                                        /* check the result */
     {
         handle->debug_print("em4095: shd gpio deinit failed.\n");        /* shd gpio deinit failed */
 
         return 1;                                                        /* return error */
     }
-    handle->inited = 0;                                                  /* flag close */
+#if (EM4095_OS != 0)
+    if (handle->done != NULL)                                            /* check the semaphore */
+    {
+        (void)em4095_os_sem_delete(handle->done);                        /* delete the semaphore */
+        handle->done = NULL;                                             /* clear the semaphore */
+    }
+#endif
+    handle->inited = 0;                                                  /* flag close */
 
     return 0;                                                            /* success return 0 */
 }
@@ -516,7 +974,42 @@ uint8_t em4095_power_down(em4095_handle_t *handle)
         return 3;                                                       /* return error */
     }
 
-    res = handle->shd_gpio_write(1);                                    /* goto sleep mode */
+    res = handle->shd_gpio_write(handle->ctx, 1);                       /* goto sleep mode */
+    if (res != 0)                                                       /* check the result */
+    {
+        handle->debug_print("em4095: shd gpio write failed.\n");        /* shd gpio write failed */
+
+        return 1;                                                       /* return error */
+    }
+
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief     abort the running read, write, sense or measure
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 abort failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the chip goes to the sleep mode and the receive callback isn't run
+ */
+uint8_t em4095_abort(em4095_handle_t *handle)
+{
+    uint8_t res;
+
+    if (handle == NULL)                                                 /* check handle */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (handle->inited != 1)                                            /* check handle initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+
+    handle->mode = EM4095_MODE_IDLE;                                    /* set idle mode */
+    res = handle->shd_gpio_write(handle->ctx, 1);                       /* goto sleep mode */
     if (res != 0)                                                       /* check the result */
     {
         handle->debug_print("em4095: shd gpio write failed.\n");        /* shd gpio write failed */
@@ -550,7 +1043,7 @@ uint8_t em4095_power_on(em4095_handle_t *handle)
         return 3;                                                       /* return error */
     }
 
-    res = handle->shd_gpio_write(0);                                    /* exit sleep mode */
+    res = handle->shd_gpio_write(handle->ctx, 0);                       /* exit sleep mode */
     if (res != 0)                                                       /* check the result */
     {
         handle->debug_print("em4095: shd gpio write failed.\n");        /* shd gpio write failed */
@@ -590,6 +1083,7 @@ uint8_t em4095_set_div(em4095_handle_t *handle, uint32_t clock_div)
     }
 
     handle->div = clock_div;                                     /* set div */
+    handle->period_us = 0;                                       /* not known */
 
     return 0;                                                    /* success return 0 */
 }
@@ -620,6 +1114,551 @@ uint8_t em4095_get_div(em4095_handle_t *handle, uint32_t *clock_div)
     return 0;                       /* success return 0 */
 }
 
+/**
+ * @brief     set the read oversampling
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @param[in] times reads per sample
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 times is invalid
+ * @note      times must be odd and <= EM4095_MAX_OVERSAMPLE, 1 disables it.
+ *            the reads are spread over the middle half of the sample period and the majority is saved,
+ *            div must be at least 2 * times
+ */
+uint8_t em4095_set_oversample(em4095_handle_t *handle, uint8_t times)
+{
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                   /* check handle initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    if ((times == 0) || ((times % 2) == 0) || (times > EM4095_MAX_OVERSAMPLE)) /* check the times */
+    {
+        handle->debug_print("em4095: oversample is invalid.\n");               /* oversample is invalid */
+
+        return 4;                                                              /* return error */
+    }
+
+    handle->oversample = times;                                                /* set oversample */
+    handle->vote_count = 0;                                                    /* init 0 */
+    handle->vote_ones = 0;                                                     /* init 0 */
+
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      get the read oversampling
+ * @param[in]  *handle pointer to an em4095 handle structure
+ * @param[out] *times pointer to a times buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t em4095_get_oversample(em4095_handle_t *handle, uint8_t *times)
+{
+    if (handle == NULL)                /* check handle */
+    {
+        return 2;                      /* return error */
+    }
+    if (handle->inited != 1)           /* check handle initialization */
+    {
+        return 3;                      /* return error */
+    }
+
+    *times = handle->oversample;       /* get oversample */
+
+    return 0;                          /* success return 0 */
+}
+
+/**
+ * @brief     set the glitch filter
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @param[in] width min pulse width in clock irqs
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      0 disables it, when enabled DEMOD_OUT is read in every clock irq of the read mode and
+ *            a level change is only taken after it is stable for width irqs
+ */
+uint8_t em4095_set_glitch_filter(em4095_handle_t *handle, uint8_t width)
+{
+    if (handle == NULL)                 /* check handle */
+    {
+        return 2;                       /* return error */
+    }
+    if (handle->inited != 1)            /* check handle initialization */
+    {
+        return 3;                       /* return error */
+    }
+
+    handle->glitch = width;             /* set width */
+    handle->glitch_count = 0;           /* init 0 */
+
+    return 0;                           /* success return 0 */
+}
+
+/**
+ * @brief      get the glitch filter
+ * @param[in]  *handle pointer to an em4095 handle structure
+ * @param[out] *width pointer to a width buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t em4095_get_glitch_filter(em4095_handle_t *handle, uint8_t *width)
+{
+    if (handle == NULL)             /* check handle */
+    {
+        return 2;                   /* return error */
+    }
+    if (handle->inited != 1)        /* check handle initialization */
+    {
+        return 3;                   /* return error */
+    }
+
+    *width = handle->glitch;        /* get width */
+
+    return 0;                       /* success return 0 */
+}
+
+/**
+ * @brief      get the corrected samples of the last read
+ * @param[in]  *handle pointer to an em4095 handle structure
+ * @param[out] *corrected pointer to a corrected sample number buffer
+ * @param[out] *glitches pointer to a filtered glitch number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       corrected counts the samples whose reads were not unanimous,
+ *             glitches counts the pulses shorter than the glitch filter width
+ */
+uint8_t em4095_get_corrected_samples(em4095_handle_t *handle, uint16_t *corrected, uint16_t *glitches)
+{
+    if (handle == NULL)                     /* check handle */
+    {
+        return 2;                           /* return error */
+    }
+    if (handle->inited != 1)                /* check handle initialization */
+    {
+        return 3;                           /* return error */
+    }
+
+    *corrected = handle->corrected;         /* get corrected */
+    *glitches = handle->glitches;           /* get glitches */
+
+    return 0;                               /* success return 0 */
+}
+
+/**
+ * @brief     set the read gap
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @param[in] periods gap in sample periods
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      two samples further apart than periods times the average sample period end the frame,
+ *            0 uses the fixed EM4095_GAP_TIMEOUT_US or EM4095_GAP_TIMEOUT_EDGES of the carrier timebase
+ */
+uint8_t em4095_set_gap(em4095_handle_t *handle, uint16_t periods)
+{
+    if (handle == NULL)              /* check handle */
+    {
+        return 2;                    /* return error */
+    }
+    if (handle->inited != 1)         /* check handle initialization */
+    {
+        return 3;                    /* return error */
+    }
+
+    handle->gap = periods;           /* set gap */
+
+    return 0;                        /* success return 0 */
+}
+
+/**
+ * @brief      get the read gap
+ * @param[in]  *handle pointer to an em4095 handle structure
+ * @param[out] *periods pointer to a periods buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t em4095_get_gap(em4095_handle_t *handle, uint16_t *periods)
+{
+    if (handle == NULL)              /* check handle */
+    {
+        return 2;                    /* return error */
+    }
+    if (handle->inited != 1)         /* check handle initialization */
+    {
+        return 3;                    /* return error */
+    }
+
+    *periods = handle->gap;          /* get gap */
+
+    return 0;                        /* success return 0 */
+}
+
+/**
+ * @brief      get the average sample period of the read
+ * @param[in]  *handle pointer to an em4095 handle structure
+ * @param[out] *us pointer to a period buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       0 means it is not known yet, it is in clock irqs with the carrier timebase
+ */
+uint8_t em4095_get_sample_period(em4095_handle_t *handle, uint32_t *us)
+{
+    if (handle == NULL)              /* check handle */
+    {
+        return 2;                    /* return error */
+    }
+    if (handle->inited != 1)         /* check handle initialization */
+    {
+        return 3;                    /* return error */
+    }
+
+    *us = handle->period_us;         /* get period */
+
+    return 0;                        /* success return 0 */
+}
+
+/**
+ * @brief     set the sampling phase loop
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @param[in] shift loop gain is 1 / 2^shift, 0 disables the loop
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 shift is over EM4095_MAX_PLL_SHIFT
+ * @note      every demod edge moves the sample point by its phase error times the gain, so the
+ *            sample stays in the middle of the div cell, a larger shift is a narrower bandwidth,
+ *            div must be one cell (a half bit for manchester) and it is not used with oversampling
+ */
+uint8_t em4095_set_pll(em4095_handle_t *handle, uint8_t shift)
+{
+    if (handle == NULL)                                                            /* check handle */
+    {
+        return 2;                                                                  /* return error */
+    }
+    if (handle->inited != 1)                                                       /* check handle initialization */
+    {
+        return 3;                                                                  /* return error */
+    }
+    if (shift > EM4095_MAX_PLL_SHIFT)                                              /* check the shift */
+    {
+        handle->debug_print("em4095: shift > %d.\n", EM4095_MAX_PLL_SHIFT);        /* shift is too large */
+
+        return 4;                                                                  /* return error */
+    }
+
+    handle->pll_shift = shift;                                                     /* set shift */
+    handle->pll_acc = 0;                                                           /* init 0 */
+    handle->pll_freq = 0;                                                          /* init 0 */
+
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief      get the sampling phase loop
+ * @param[in]  *handle pointer to an em4095 handle structure
+ * @param[out] *shift pointer to a shift buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t em4095_get_pll(em4095_handle_t *handle, uint8_t *shift)
+{
+    if (handle == NULL)                /* check handle */
+    {
+        return 2;                      /* return error */
+    }
+    if (handle->inited != 1)           /* check handle initialization */
+    {
+        return 3;                      /* return error */
+    }
+
+    *shift = handle->pll_shift;        /* get shift */
+
+    return 0;                          /* success return 0 */
+}
+
+/**
+ * @brief     set the timebase
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @param[in] timebase read and write timebase
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 timebase is invalid
+ * @note      the carrier timebase counts the clock irqs instead of calling timestamp_read per sample,
+ *            so the diffs, the gap and the sample period are in clock irqs and coherent with the tag,
+ *            set it before a read or a write
+ */
+uint8_t em4095_set_timebase(em4095_handle_t *handle, em4095_timebase_t timebase)
+{
+    if (handle == NULL)                                               /* check handle */
+    {
+        return 2;                                                     /* return error */
+    }
+    if (handle->inited != 1)                                          /* check handle initialization */
+    {
+        return 3;                                                     /* return error */
+    }
+    if ((timebase != EM4095_TIMEBASE_TIMER) &&
+        (timebase != EM4095_TIMEBASE_CARRIER))                        /* check the timebase */
+    {
+        handle->debug_print("em4095: timebase is invalid.\n");        /* timebase is invalid */
+
+        return 4;                                                     /* return error */
+    }
+
+    handle->timebase = (uint8_t)timebase;                             /* set timebase */
+    handle->period_us = 0;                                            /* not known in the new unit */
+
+    return 0;                                                         /* success return 0 */
+}
+
+/**
+ * @brief      get the timebase
+ * @param[in]  *handle pointer to an em4095 handle structure
+ * @param[out] *timebase pointer to a timebase buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t em4095_get_timebase(em4095_handle_t *handle, em4095_timebase_t *timebase)
+{
+    if (handle == NULL)                                       /* check handle */
+    {
+        return 2;                                             /* return error */
+    }
+    if (handle->inited != 1)                                  /* check handle initialization */
+    {
+        return 3;                                             /* return error */
+    }
+
+    *timebase = (em4095_timebase_t)(handle->timebase);        /* get timebase */
+
+    return 0;                                                 /* success return 0 */
+}
+
+/**
+ * @brief     sense the field for a tag
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @param[in] settle ignored clock irqs after the power on
+ * @param[in] window counted clock irqs
+ * @return    status code
+ *            - 0 success
+ *            - 1 sense failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 window is 0
+ * @note      the chip is powered on here, the demod edges of the window are counted in the irq and
+ *            the chip is powered down at the end of the window before the receive callback runs
+ */
+uint8_t em4095_sense(em4095_handle_t *handle, uint16_t settle, uint16_t window)
+{
+    uint8_t res;
+    uint8_t level;
+
+    if (handle == NULL)                                                 /* check handle */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (handle->inited != 1)                                            /* check handle initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+    if (window == 0)                                                    /* check window */
+    {
+        handle->debug_print("em4095: window can't be 0.\n");            /* window can't be 0 */
+
+        return 4;                                                       /* return error */
+    }
+
+    res = handle->mod_gpio_write(handle->ctx, 0);                       /* mod gpio write level */
+    if (res != 0)                                                       /* check result */
+    {
+        handle->debug_print("em4095: mod gpio write failed.\n");        /* mod gpio write */
+
+        return 1;                                                       /* return error */
+    }
+    res = handle->demod_gpio_read(handle->ctx, &level);                 /* read gpio level */
+    if (res != 0)                                                       /* check result */
+    {
+        handle->debug_print("em4095: demod gpio read failed.\n");       /* demod gpio read failed */
+
+        return 1;                                                       /* return error */
+    }
+    handle->last_bit = level;                                           /* init level */
+    handle->filter_level = level;                                       /* init filtered level */
+    handle->glitch_count = 0;                                           /* init 0 */
+    handle->glitches = 0;                                               /* init 0 */
+    handle->sense_settle = settle;                                      /* set settle */
+    handle->sense_window = window;                                      /* set window */
+    handle->sense_ticks = 0;                                            /* init 0 */
+    handle->sense_edges = 0;                                            /* init 0 */
+    handle->mode = EM4095_MODE_SENSE;                                   /* set sense mode */
+    res = handle->shd_gpio_write(handle->ctx, 0);                       /* power on */
+    if (res != 0)                                                       /* check result */
+    {
+        handle->debug_print("em4095: shd gpio write failed.\n");        /* shd gpio write failed */
+        handle->mode = EM4095_MODE_IDLE;                                /* set idle mode */
+
+        return 1;                                                       /* return error */
+    }
+
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief      get the edges of the last sense
+ * @param[in]  *handle pointer to an em4095 handle structure
+ * @param[out] *edges pointer to an edge number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t em4095_get_sense_edges(em4095_handle_t *handle, uint16_t *edges)
+{
+    if (handle == NULL)              /* check handle */
+    {
+        return 2;                    /* return error */
+    }
+    if (handle->inited != 1)         /* check handle initialization */
+    {
+        return 3;                    /* return error */
+    }
+
+    *edges = handle->sense_edges;    /* get edges */
+
+    return 0;                        /* success return 0 */
+}
+
+/**
+ * @brief     measure the clock irq rate
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @param[in] settle ignored clock irqs after the power on
+ * @param[in] window measured clock irqs
+ * @return    status code
+ *            - 0 success
+ *            - 1 measure failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 window is 0
+ * @note      the chip is powered on here, the window is timed with timestamp_read in the irq and
+ *            the chip is powered down at the end of the window before the receive callback runs
+ */
+uint8_t em4095_measure(em4095_handle_t *handle, uint16_t settle, uint32_t window)
+{
+    uint8_t res;
+
+    if (handle == NULL)                                                 /* check handle */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (handle->inited != 1)                                            /* check handle initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+    if (window == 0)                                                    /* check window */
+    {
+        handle->debug_print("em4095: window can't be 0.\n");            /* window can't be 0 */
+
+        return 4;                                                       /* return error */
+    }
+
+    res = handle->mod_gpio_write(handle->ctx, 0);                       /* mod gpio write level */
+    if (res != 0)                                                       /* check result */
+    {
+        handle->debug_print("em4095: mod gpio write failed.\n");        /* mod gpio write */
+
+        return 1;                                                       /* return error */
+    }
+    handle->sense_settle = settle;                                      /* set settle */
+    handle->sense_ticks = 0;                                            /* init 0 */
+    handle->measure_window = window;                                    /* set window */
+    handle->measure_us = 0;                                             /* no result */
+    handle->mode = EM4095_MODE_MEASURE;                                 /* set measure mode */
+    res = handle->shd_gpio_write(handle->ctx, 0);                       /* power on */
+    if (res != 0)                                                       /* check result */
+    {
+        handle->debug_print("em4095: shd gpio write failed.\n");        /* shd gpio write failed */
+        handle->mode = EM4095_MODE_IDLE;                                /* set idle mode */
+
+        return 1;                                                       /* return error */
+    }
+
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief      get the carrier frequency of the last measure
+ * @param[in]  *handle pointer to an em4095 handle structure
+ * @param[in]  irqs_per_cycle clock irqs per carrier cycle
+ * @param[out] *hz pointer to a frequency buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no measure
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 irqs_per_cycle is 0
+ * @note       irqs_per_cycle is 2 when both clk edges raise the irq
+ */
+uint8_t em4095_get_carrier_frequency(em4095_handle_t *handle, uint8_t irqs_per_cycle, float *hz)
+{
+    if (handle == NULL)                                                       /* check handle */
+    {
+        return 2;                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                  /* check handle initialization */
+    {
+        return 3;                                                             /* return error */
+    }
+    if (irqs_per_cycle == 0)                                                  /* check irqs per cycle */
+    {
+        handle->debug_print("em4095: irqs per cycle can't be 0.\n");          /* irqs per cycle can't be 0 */
+
+        return 4;                                                             /* return error */
+    }
+    if (handle->measure_us == 0)                                              /* check the result */
+    {
+        handle->debug_print("em4095: no measure.\n");                         /* no measure */
+
+        return 1;                                                             /* return error */
+    }
+
+    *hz = (float)((double)handle->measure_window * 1000000.0 /
+                  ((double)handle->measure_us * (double)irqs_per_cycle));     /* irq rate / irqs per cycle */
+
+    return 0;                                                                 /* success return 0 */
+}
+
 /**
  * @brief     read data
  * @param[in] *handle pointer to an em4095 handle structure
@@ -630,7 +1669,8 @@ uint8_t em4095_get_div(em4095_handle_t *handle, uint32_t *clock_div)
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 len is too long
- * @note      none
+ * @note      with len == EM4095_MAX_LENGTH the read never ends and every EM4095_MAX_LENGTH - 1 samples
+ *            are delivered by the overflow event
  */
 uint8_t em4095_read(em4095_handle_t *handle, uint16_t len)
 {
@@ -652,36 +1692,51 @@ uint8_t em4095_read(em4095_handle_t *handle, uint16_t len)
 
         return 4;                                                       /* return error */
     }
+    if ((handle->oversample > 1) && (handle->div < 2 * (uint32_t)handle->oversample))      /* check div */
+    {
+        handle->debug_print("em4095: div < 2 * oversample.\n");                            /* div is too small */
+
+        return 4;                                                                          /* return error */
+    }
 
-    res = handle->timestamp_read(&t);                                   /* timestamp read */
+    handle->mode = EM4095_MODE_IDLE;                                    /* stop the irq while resetting */
+    res = a_em4095_time_read(handle, &t);                               /* time read */
     if (res != 0)                                                       /* check result */
     {
-        handle->debug_print("em4095: timestamp read failed.\n");        /* timestamp read failed */
-
         return 1;                                                       /* return error */
     }
-    res = handle->mod_gpio_write(0);                                    /* mod gpio write level */
+    res = handle->mod_gpio_write(handle->ctx, 0);                       /* mod gpio write level */
     if (res != 0)                                                       /* check result */
     {
         handle->debug_print("em4095: mod gpio write failed.\n");        /* mod gpio write */
 
         return 1;                                                       /* return error */
     }
-    handle->last_time.s = t.s;                                          /* save last time */
-    handle->last_time.us = t.us;                                        /* save last time */
-    handle->decode_len = 0;                                             /* init 0 */
-    handle->len = len;                                                  /* set read length */
-    handle->div_len = 0;                                                /* init 0 */
-    handle->mode = EM4095_MODE_READ;                                    /* set read mode */
-    handle->start_flag = 0;                                             /* flag not start */
-    res = handle->demod_gpio_read(&level);                              /* read gpio level */
+    res = handle->demod_gpio_read(handle->ctx, &level);                 /* read gpio level */
     if (res != 0)                                                       /* check result */
     {
         handle->debug_print("em4095: demod gpio read failed.\n");       /* demod gpio read failed */
 
         return 1;                                                       /* return error */
     }
+    handle->last_time.s = t.s;                                          /* save last time */
+    handle->last_time.us = t.us;                                        /* save last time */
+    handle->decode_len = 0;                                             /* init 0 */
+    handle->len = len;                                                  /* set read length */
+    handle->div_len = 0;                                                /* init 0 */
+    handle->period_us = 0;                                              /* not known */
+    handle->start_flag = 0;                                             /* flag not start */
     handle->last_bit = level;                                           /* init level */
+    handle->filter_level = level;                                       /* init filtered level */
+    handle->vote_level = level;                                         /* init voted level */
+    handle->glitch_count = 0;                                           /* init 0 */
+    handle->vote_count = 0;                                             /* init 0 */
+    handle->vote_ones = 0;                                              /* init 0 */
+    handle->corrected = 0;                                              /* init 0 */
+    handle->glitches = 0;                                               /* init 0 */
+    handle->pll_acc = 0;                                                /* init 0 */
+    handle->pll_freq = 0;                                               /* init 0 */
+    handle->mode = EM4095_MODE_READ;                                    /* set read mode last */
 
     return 0;                                                           /* success return 0 */
 }
@@ -721,14 +1776,12 @@ uint8_t em4095_write(em4095_handle_t *handle, uint8_t *buf, uint16_t len)
         return 4;                                                       /* return error */
     }
 
-    res = handle->timestamp_read(&t);                                   /* timestamp read */
+    res = a_em4095_time_read(handle, &t);                               /* time read */
     if (res != 0)                                                       /* check result */
     {
-        handle->debug_print("em4095: timestamp read failed.\n");        /* timestamp read failed */
-
         return 1;                                                       /* return error */
     }
-    res = handle->mod_gpio_write(0);                                    /* mod gpio write level */
+    res = handle->mod_gpio_write(handle->ctx, 0);                       /* mod gpio write level */
     if (res != 0)                                                       /* check result */
     {
         handle->debug_print("em4095: mod gpio write failed.\n");        /* mod gpio write */
@@ -752,6 +1805,143 @@ uint8_t em4095_write(em4095_handle_t *handle, uint8_t *buf, uint16_t len)
     return 0;                                                           /* success return 0 */
 }
 
+#if (EM4095_OS != 0)
+/**
+ * @brief     sleep until the running read or write is done
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 power on failed
+ *            - 5 timeout
+ * @note      a timed out read or write is aborted
+ */
+static uint8_t a_em4095_wait(em4095_handle_t *handle, uint32_t timeout_ms)
+{
+    if (em4095_power_on(handle) != 0)                             /* power on */
+    {
+        (void)em4095_abort(handle);                               /* stop the irq */
+
+        return 1;                                                 /* return error */
+    }
+    if (em4095_os_sem_take(handle->done, timeout_ms) != 0)        /* sleep until the irq is done */
+    {
+        (void)em4095_abort(handle);                               /* stop the irq */
+        handle->debug_print("em4095: wait timeout.\n");           /* wait timeout */
+
+        return 5;                                                 /* return error */
+    }
+
+    return 0;                                                     /* success return 0 */
+}
+
+/**
+ * @brief     create the completion semaphore
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 create failed
+ * @note      it is created at the first blocking call and a stale give is dropped
+ */
+static uint8_t a_em4095_done_init(em4095_handle_t *handle)
+{
+    if (handle->done == NULL)                                                 /* first blocking call */
+    {
+        if (em4095_os_sem_create(&handle->done) != 0)                         /* create the semaphore */
+        {
+            handle->debug_print("em4095: create semaphore failed.\n");        /* create semaphore failed */
+
+            return 1;                                                         /* return error */
+        }
+    }
+    (void)em4095_os_sem_take(handle->done, 0);                                /* drop a stale give */
+
+    return 0;                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     read data and sleep until it is done
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @param[in] len read length
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 len is too long
+ *            - 5 timeout
+ * @note      the caller sleeps on a semaphore given by the irq after the receive callback, a timed
+ *            out read is aborted
+ */
+uint8_t em4095_read_blocking(em4095_handle_t *handle, uint16_t len, uint32_t timeout_ms)
+{
+    uint8_t res;
+
+    if (handle == NULL)                              /* check handle */
+    {
+        return 2;                                    /* return error */
+    }
+    if (handle->inited != 1)                         /* check handle initialization */
+    {
+        return 3;                                    /* return error */
+    }
+
+    if (a_em4095_done_init(handle) != 0)             /* init the semaphore */
+    {
+        return 1;                                    /* return error */
+    }
+    res = em4095_read(handle, len);                  /* start reading */
+    if (res != 0)                                    /* check result */
+    {
+        return res;                                  /* return error */
+    }
+
+    return a_em4095_wait(handle, timeout_ms);        /* sleep until it is done */
+}
+
+/**
+ * @brief     write data and sleep until it is done
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len written length
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 len is too long
+ *            - 5 timeout
+ * @note      the caller sleeps on a semaphore given by the irq, a timed out write is aborted
+ */
+uint8_t em4095_write_blocking(em4095_handle_t *handle, uint8_t *buf, uint16_t len, uint32_t timeout_ms)
+{
+    uint8_t res;
+
+    if (handle == NULL)                              /* check handle */
+    {
+        return 2;                                    /* return error */
+    }
+    if (handle->inited != 1)                         /* check handle initialization */
+    {
+        return 3;                                    /* return error */
+    }
+
+    if (a_em4095_done_init(handle) != 0)             /* init the semaphore */
+    {
+        return 1;                                    /* return error */
+    }
+    res = em4095_write(handle, buf, len);            /* start writing */
+    if (res != 0)                                    /* check result */
+    {
+        return res;                                  /* return error */
+    }
+
+    return a_em4095_wait(handle, timeout_ms);        /* sleep until it is done */
+}
+#endif
+
 /**
  * @brief      copy decode buffer
  * @param[in]  *handle pointer to an em4095 handle structure
@@ -63,6 +63,47 @@ extern "C"{
     #define EM4095_MAX_LENGTH   384        /**< 384 */
 #endif
 
+/**
+ * @brief em4095 max oversample definition
+ */
+#define EM4095_MAX_OVERSAMPLE   15         /**< 15 */
+
+/**
+ * @brief em4095 max pll shift definition
+ */
+#define EM4095_MAX_PLL_SHIFT    8          /**< 1/256 of the phase error */
+
+/**
+ * @brief em4095 gap timeout definition
+ * @note  used when the gap is disabled or the sample period is not known yet
+ */
+#ifndef EM4095_GAP_TIMEOUT_US
+    #define EM4095_GAP_TIMEOUT_US   200000L    /**< 200ms */
+#endif
+
+/**
+ * @brief em4095 gap timeout edges definition
+ * @note  the fixed gap timeout of the carrier timebase
+ */
+#ifndef EM4095_GAP_TIMEOUT_EDGES
+    #define EM4095_GAP_TIMEOUT_EDGES   50000L    /**< 200ms of both 125KHz clk edges */
+#endif
+
+/**
+ * @brief em4095 os layer definition
+ * @note  1 links the os layer (/interface/driver_em4095_os.h), the irq gives a semaphore when a read or
+ *        a write is done and em4095_read_blocking and em4095_write_blocking sleep on it
+ */
+#ifndef EM4095_OS
+    #define EM4095_OS    0        /**< no os layer */
+#endif
+
+/**
+ * @brief em4095 carrier definition
+ */
+#define EM4095_CARRIER_125K_HZ   125000.0f   /**< 125KHz */
+#define EM4095_CARRIER_134K_HZ   134200.0f   /**< 134.2KHz */
+
 /**
  * @brief em4095 mode enumeration definition
  */
@@ -71,8 +112,28 @@ typedef enum
     EM4095_MODE_IDLE  = 0x00,        /**< idle */
     EM4095_MODE_READ  = 0x01,        /**< read */
     EM4095_MODE_WRITE = 0x02,        /**< write */
+    EM4095_MODE_SENSE = 0x03,        /**< sense */
+    EM4095_MODE_MEASURE = 0x04,      /**< measure */
 } em4095_mode_t;
 
+/**
+ * @brief em4095 event enumeration definition
+ */
+typedef enum
+{
+    EM4095_EVENT_GAP      = 0x01,        /**< no sample for longer than the gap */
+    EM4095_EVENT_OVERFLOW = 0x02,        /**< decode buffer is full */
+} em4095_event_t;
+
+/**
+ * @brief em4095 timebase enumeration definition
+ */
+typedef enum
+{
+    EM4095_TIMEBASE_TIMER   = 0x00,        /**< timestamp_read in us */
+    EM4095_TIMEBASE_CARRIER = 0x01,        /**< clock irqs of the running edge counter */
+} em4095_timebase_t;
+
 /**
  * @brief em4095 time structure definition
  */
@@ -87,8 +148,8 @@ typedef struct em4095_time_s
  */
 typedef struct em4095_decode_s
 {
-    em4095_time_t t;         /**< timestamp */
-    uint32_t diff_us;        /**< diff us */
+    em4095_time_t t;         /**< timestamp, the edge counter in us with the carrier timebase */
+    uint32_t diff_us;        /**< diff us to the next sample, clock irqs with the carrier timebase */
     uint8_t level;           /**< gpio level */
 } em4095_decode_t;
 
@@ -97,21 +158,27 @@ typedef struct em4095_decode_s
  */
 typedef struct em4095_handle_s
 {
-    uint8_t (*shd_gpio_init)(void);                              /**< point to an shd_gpio_init function address */
-    uint8_t (*shd_gpio_deinit)(void);                            /**< point to an shd_gpio_deinit function address */
-    uint8_t (*shd_gpio_write)(uint8_t data);                     /**< point to an shd_gpio_write function address */
-    uint8_t (*mod_gpio_init)(void);                              /**< point to an mod_gpio_init function address */
-    uint8_t (*mod_gpio_deinit)(void);                            /**< point to an mod_gpio_deinit function address */
-    uint8_t (*mod_gpio_write)(uint8_t data);                     /**< point to an mod_gpio_write function address */
-    uint8_t (*demod_gpio_init)(void);                            /**< point to an demod_gpio_init function address */
-    uint8_t (*demod_gpio_deinit)(void);                          /**< point to an demod_gpio_deinit function address */
-    uint8_t (*demod_gpio_read)(uint8_t *data);                   /**< point to an demod_gpio_read function address */
+    uint8_t (*shd_gpio_init)(void *ctx);                         /**< point to an shd_gpio_init function address */
+    uint8_t (*shd_gpio_deinit)(void *ctx);                       /**< point to an shd_gpio_deinit function address */
+    uint8_t (*shd_gpio_write)(void *ctx, uint8_t data);          /**< point to an shd_gpio_write function address */
+    uint8_t (*mod_gpio_init)(void *ctx);                         /**< point to an mod_gpio_init function address */
+    uint8_t (*mod_gpio_deinit)(void *ctx);                       /**< point to an mod_gpio_deinit function address */
+    uint8_t (*mod_gpio_write)(void *ctx, uint8_t data);          /**< point to an mod_gpio_write function address */
+    uint8_t (*demod_gpio_init)(void *ctx);                       /**< point to an demod_gpio_init function address */
+    uint8_t (*demod_gpio_deinit)(void *ctx);                     /**< point to an demod_gpio_deinit function address */
+    uint8_t (*demod_gpio_read)(void *ctx, uint8_t *data);        /**< point to an demod_gpio_read function address */
     uint8_t (*timestamp_read)(em4095_time_t *t);                 /**< point to a timestamp_read function address */
     void (*delay_ms)(uint32_t ms);                               /**< point to a delay_ms function address */
     void (*debug_print)(const char *const fmt, ...);             /**< point to a debug_print function address */
-    void (*receive_callback)(em4095_mode_t mode, 
+    void (*receive_callback)(void *ctx, em4095_mode_t mode, 
                              em4095_decode_t *buf, 
                              uint16_t len);                      /**< point to a receive_callback function address */
+    void (*sample_callback)(void *ctx, uint16_t index,
+                            uint8_t level, uint32_t diff_us);    /**< point to a sample_callback function address */
+    void (*event_callback)(void *ctx, em4095_event_t event,
+                           em4095_decode_t *buf,
+                           uint16_t len);                        /**< point to an event_callback function address */
+    void *ctx;                                                   /**< interface context of the instance */
     uint8_t inited;                                              /**< inited flag */
     em4095_decode_t decode[EM4095_MAX_LENGTH];                   /**< decode buffer */
     uint16_t decode_len;                                         /**< decode length */
@@ -122,6 +189,30 @@ typedef struct em4095_handle_s
     uint32_t div_len;                                            /**< div length */
     uint8_t start_flag;                                          /**< start flag */
     uint8_t last_bit;                                            /**< last bit */
+    uint8_t oversample;                                          /**< reads per sample */
+    uint8_t vote_count;                                          /**< votes of the current sample */
+    uint8_t vote_ones;                                           /**< high votes of the current sample */
+    uint8_t vote_level;                                          /**< voted level */
+    uint8_t glitch;                                              /**< glitch filter width in irqs */
+    uint8_t glitch_count;                                        /**< irqs of the pending level */
+    uint8_t filter_level;                                        /**< filtered level */
+    uint16_t corrected;                                          /**< corrected samples of the frame */
+    uint16_t glitches;                                           /**< filtered glitches of the frame */
+    uint16_t gap;                                                /**< gap in sample periods */
+    uint32_t period_us;                                          /**< average sample period */
+    uint16_t sense_settle;                                       /**< sense or measure settle irqs */
+    uint16_t sense_window;                                       /**< sense window irqs */
+    uint32_t sense_ticks;                                        /**< sense or measure irqs */
+    uint16_t sense_edges;                                        /**< sensed demod edges */
+    uint32_t measure_window;                                     /**< measure window irqs */
+    em4095_time_t measure_start;                                 /**< measure start time */
+    uint32_t measure_us;                                         /**< measured window time */
+    uint8_t timebase;                                            /**< timebase */
+    uint8_t pll_shift;                                           /**< pll gain is 1 / 2^shift, 0 disables it */
+    int32_t pll_acc;                                             /**< pll correction fraction in 1/256 irq */
+    int32_t pll_freq;                                            /**< pll frequency term in 1/256 irq per edge */
+    uint32_t edges;                                              /**< running clock irq counter */
+    void *done;                                                  /**< completion semaphore of the blocking helpers */
 } em4095_handle_t;
 
 /**
@@ -159,6 +250,14 @@ typedef struct em4095_info_s
  */
 #define DRIVER_EM4095_LINK_INIT(HANDLE, STRUCTURE)           memset(HANDLE, 0, sizeof(STRUCTURE))
 
+/**
+ * @brief     link the interface context
+ * @param[in] HANDLE pointer to an em4095 handle structure
+ * @param[in] CTX pointer to the context passed to the gpio functions
+ * @note      every instance on the same mcu has its own context
+ */
+#define DRIVER_EM4095_LINK_CONTEXT(HANDLE, CTX)             (HANDLE)->ctx = CTX
+
 /**
  * @brief     link shd_gpio_init function
  * @param[in] HANDLE pointer to an em4095 handle structure
@@ -259,10 +358,31 @@ typedef struct em4095_info_s
  * @brief     link receive_callback function
  * @param[in] HANDLE pointer to an em4095 handle structure
  * @param[in] FUC pointer to a receive_callback function address
- * @note      none
+ * @note      the mode is already idle when it runs, so it can start the next operation.
+ *            ctx is the interface context of the handle, so one callback can serve many handles.
+ *            in the sense mode buf is NULL and len is the counted edge number,
+ *            in the measure mode buf is NULL and len is 0
  */
 #define DRIVER_EM4095_LINK_RECEIVE_CALLBACK(HANDLE, FUC)    (HANDLE)->receive_callback = FUC
 
+/**
+ * @brief     link sample_callback function
+ * @param[in] HANDLE pointer to an em4095 handle structure
+ * @param[in] FUC pointer to a sample_callback function address
+ * @note      optional, it runs in the irq for every read sample, index 0 starts a new decode buffer
+ *            and diff_us is the time from the previous sample or from the read start
+ */
+#define DRIVER_EM4095_LINK_SAMPLE_CALLBACK(HANDLE, FUC)     (HANDLE)->sample_callback = FUC
+
+/**
+ * @brief     link event_callback function
+ * @param[in] HANDLE pointer to an em4095 handle structure
+ * @param[in] FUC pointer to an event_callback function address
+ * @note      optional, it runs in the irq with the samples before the frame boundary,
+ *            the decode buffer restarts from 0 after it returns
+ */
+#define DRIVER_EM4095_LINK_EVENT_CALLBACK(HANDLE, FUC)      (HANDLE)->event_callback = FUC
+
 /**
  * @}
  */
@@ -330,7 +450,8 @@ uint8_t em4095_deinit(em4095_handle_t *handle);
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 len is too long
- * @note      none
+ * @note      with len == EM4095_MAX_LENGTH the read never ends and every EM4095_MAX_LENGTH - 1 samples
+ *            are delivered by the overflow event
  */
 uint8_t em4095_read(em4095_handle_t *handle, uint16_t len);
 
@@ -349,6 +470,42 @@ uint8_t em4095_read(em4095_handle_t *handle, uint16_t len);
  */
 uint8_t em4095_write(em4095_handle_t *handle, uint8_t *buf, uint16_t len);
 
+#if (EM4095_OS != 0)
+/**
+ * @brief     read data and sleep until it is done
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @param[in] len read length
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 len is too long
+ *            - 5 timeout
+ * @note      the caller sleeps on a semaphore given by the irq after the receive callback, a timed
+ *            out read is aborted
+ */
+uint8_t em4095_read_blocking(em4095_handle_t *handle, uint16_t len, uint32_t timeout_ms);
+
+/**
+ * @brief     write data and sleep until it is done
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len written length
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 len is too long
+ *            - 5 timeout
+ * @note      the caller sleeps on a semaphore given by the irq, a timed out write is aborted
+ */
+uint8_t em4095_write_blocking(em4095_handle_t *handle, uint8_t *buf, uint16_t len, uint32_t timeout_ms);
+#endif
+
 /**
  * @brief      copy decode buffer
  * @param[in]  *handle pointer to an em4095 handle structure
@@ -362,6 +519,18 @@ uint8_t em4095_write(em4095_handle_t *handle, uint8_t *buf, uint16_t len);
  */
 uint8_t em4095_copy_decode_buffer(em4095_handle_t *handle, uint8_t *buf, uint16_t *len);
 
+/**
+ * @brief     abort the running read, write, sense or measure
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 abort failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the chip goes to the sleep mode and the receive callback isn't run
+ */
+uint8_t em4095_abort(em4095_handle_t *handle);
+
 /**
  * @brief     power on
  * @param[in] *handle pointer to an em4095 handle structure
@@ -411,6 +580,222 @@ uint8_t em4095_set_div(em4095_handle_t *handle, uint32_t clock_div);
  */
 uint8_t em4095_get_div(em4095_handle_t *handle, uint32_t *clock_div);
 
+/**
+ * @brief     set the read oversampling
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @param[in] times reads per sample
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 times is invalid
+ * @note      times must be odd and <= EM4095_MAX_OVERSAMPLE, 1 disables it.
+ *            the reads are spread over the middle half of the sample period and the majority is saved,
+ *            div must be at least 2 * times
+ */
+uint8_t em4095_set_oversample(em4095_handle_t *handle, uint8_t times);
+
+/**
+ * @brief      get the read oversampling
+ * @param[in]  *handle pointer to an em4095 handle structure
+ * @param[out] *times pointer to a times buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t em4095_get_oversample(em4095_handle_t *handle, uint8_t *times);
+
+/**
+ * @brief     set the glitch filter
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @param[in] width min pulse width in clock irqs
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      0 disables it, when enabled DEMOD_OUT is read in every clock irq of the read mode and
+ *            a level change is only taken after it is stable for width irqs
+ */
+uint8_t em4095_set_glitch_filter(em4095_handle_t *handle, uint8_t width);
+
+/**
+ * @brief      get the glitch filter
+ * @param[in]  *handle pointer to an em4095 handle structure
+ * @param[out] *width pointer to a width buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t em4095_get_glitch_filter(em4095_handle_t *handle, uint8_t *width);
+
+/**
+ * @brief      get the corrected samples of the last read
+ * @param[in]  *handle pointer to an em4095 handle structure
+ * @param[out] *corrected pointer to a corrected sample number buffer
+ * @param[out] *glitches pointer to a filtered glitch number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       corrected counts the samples whose reads were not unanimous,
+ *             glitches counts the pulses shorter than the glitch filter width
+ */
+uint8_t em4095_get_corrected_samples(em4095_handle_t *handle, uint16_t *corrected, uint16_t *glitches);
+
+/**
+ * @brief     set the read gap
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @param[in] periods gap in sample periods
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      two samples further apart than periods times the average sample period end the frame,
+ *            0 uses the fixed EM4095_GAP_TIMEOUT_US or EM4095_GAP_TIMEOUT_EDGES of the carrier timebase
+ */
+uint8_t em4095_set_gap(em4095_handle_t *handle, uint16_t periods);
+
+/**
+ * @brief      get the read gap
+ * @param[in]  *handle pointer to an em4095 handle structure
+ * @param[out] *periods pointer to a periods buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t em4095_get_gap(em4095_handle_t *handle, uint16_t *periods);
+
+/**
+ * @brief      get the average sample period of the read
+ * @param[in]  *handle pointer to an em4095 handle structure
+ * @param[out] *us pointer to a period buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       0 means it is not known yet, it is in clock irqs with the carrier timebase
+ */
+uint8_t em4095_get_sample_period(em4095_handle_t *handle, uint32_t *us);
+
+/**
+ * @brief     set the sampling phase loop
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @param[in] shift loop gain is 1 / 2^shift, 0 disables the loop
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 shift is over EM4095_MAX_PLL_SHIFT
+ * @note      every demod edge moves the sample point by its phase error times the gain, so the
+ *            sample stays in the middle of the div cell, a larger shift is a narrower bandwidth,
+ *            div must be one cell (a half bit for manchester) and it is not used with oversampling
+ */
+uint8_t em4095_set_pll(em4095_handle_t *handle, uint8_t shift);
+
+/**
+ * @brief      get the sampling phase loop
+ * @param[in]  *handle pointer to an em4095 handle structure
+ * @param[out] *shift pointer to a shift buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t em4095_get_pll(em4095_handle_t *handle, uint8_t *shift);
+
+/**
+ * @brief     set the timebase
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @param[in] timebase read and write timebase
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 timebase is invalid
+ * @note      the carrier timebase counts the clock irqs instead of calling timestamp_read per sample,
+ *            so the diffs, the gap and the sample period are in clock irqs and coherent with the tag,
+ *            set it before a read or a write
+ */
+uint8_t em4095_set_timebase(em4095_handle_t *handle, em4095_timebase_t timebase);
+
+/**
+ * @brief      get the timebase
+ * @param[in]  *handle pointer to an em4095 handle structure
+ * @param[out] *timebase pointer to a timebase buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t em4095_get_timebase(em4095_handle_t *handle, em4095_timebase_t *timebase);
+
+/**
+ * @brief     sense the field for a tag
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @param[in] settle ignored clock irqs after the power on
+ * @param[in] window counted clock irqs
+ * @return    status code
+ *            - 0 success
+ *            - 1 sense failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 window is 0
+ * @note      the chip is powered on here, the demod edges of the window are counted in the irq and
+ *            the chip is powered down at the end of the window before the receive callback runs
+ */
+uint8_t em4095_sense(em4095_handle_t *handle, uint16_t settle, uint16_t window);
+
+/**
+ * @brief      get the edges of the last sense
+ * @param[in]  *handle pointer to an em4095 handle structure
+ * @param[out] *edges pointer to an edge number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t em4095_get_sense_edges(em4095_handle_t *handle, uint16_t *edges);
+
+/**
+ * @brief     measure the clock irq rate
+ * @param[in] *handle pointer to an em4095 handle structure
+ * @param[in] settle ignored clock irqs after the power on
+ * @param[in] window measured clock irqs
+ * @return    status code
+ *            - 0 success
+ *            - 1 measure failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 window is 0
+ * @note      the chip is powered on here, the window is timed with timestamp_read in the irq and
+ *            the chip is powered down at the end of the window before the receive callback runs
+ */
+uint8_t em4095_measure(em4095_handle_t *handle, uint16_t settle, uint32_t window);
+
+/**
+ * @brief      get the carrier frequency of the last measure
+ * @param[in]  *handle pointer to an em4095 handle structure
+ * @param[in]  irqs_per_cycle clock irqs per carrier cycle
+ * @param[out] *hz pointer to a frequency buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no measure
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 irqs_per_cycle is 0
+ * @note       irqs_per_cycle is 2 when both clk edges raise the irq
+ */
+uint8_t em4095_get_carrier_frequency(em4095_handle_t *handle, uint8_t irqs_per_cycle, float *hz);
+
 /**
  * @}
  */
@@ -0,0 +1,378 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_aes.c
+ * @brief     driver em4095 aes source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+
+#include "driver_em4095_aes.h"
+
+/**
+ * @brief aes substitution box definition
+ */
+static const uint8_t gs_aes_sbox[256] =
+{
+    0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+    0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+    0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+    0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+    0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+    0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+    0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+    0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+    0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+    0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+    0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+    0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+    0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+    0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+    0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+    0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16,
+};
+
+/**
+ * @brief aes inverse substitution box definition
+ */
+static const uint8_t gs_aes_inv_sbox[256] =
+{
+    0x52, 0x09, 0x6A, 0xD5, 0x30, 0x36, 0xA5, 0x38, 0xBF, 0x40, 0xA3, 0x9E, 0x81, 0xF3, 0xD7, 0xFB,
+    0x7C, 0xE3, 0x39, 0x82, 0x9B, 0x2F, 0xFF, 0x87, 0x34, 0x8E, 0x43, 0x44, 0xC4, 0xDE, 0xE9, 0xCB,
+    0x54, 0x7B, 0x94, 0x32, 0xA6, 0xC2, 0x23, 0x3D, 0xEE, 0x4C, 0x95, 0x0B, 0x42, 0xFA, 0xC3, 0x4E,
+    0x08, 0x2E, 0xA1, 0x66, 0x28, 0xD9, 0x24, 0xB2, 0x76, 0x5B, 0xA2, 0x49, 0x6D, 0x8B, 0xD1, 0x25,
+    0x72, 0xF8, 0xF6, 0x64, 0x86, 0x68, 0x98, 0x16, 0xD4, 0xA4, 0x5C, 0xCC, 0x5D, 0x65, 0xB6, 0x92,
+    0x6C, 0x70, 0x48, 0x50, 0xFD, 0xED, 0xB9, 0xDA, 0x5E, 0x15, 0x46, 0x57, 0xA7, 0x8D, 0x9D, 0x84,
+    0x90, 0xD8, 0xAB, 0x00, 0x8C, 0xBC, 0xD3, 0x0A, 0xF7, 0xE4, 0x58, 0x05, 0xB8, 0xB3, 0x45, 0x06,
+    0xD0, 0x2C, 0x1E, 0x8F, 0xCA, 0x3F, 0x0F, 0x02, 0xC1, 0xAF, 0xBD, 0x03, 0x01, 0x13, 0x8A, 0x6B,
+    0x3A, 0x91, 0x11, 0x41, 0x4F, 0x67, 0xDC, 0xEA, 0x97, 0xF2, 0xCF, 0xCE, 0xF0, 0xB4, 0xE6, 0x73,
+    0x96, 0xAC, 0x74, 0x22, 0xE7, 0xAD, 0x35, 0x85, 0xE2, 0xF9, 0x37, 0xE8, 0x1C, 0x75, 0xDF, 0x6E,
+    0x47, 0xF1, 0x1A, 0x71, 0x1D, 0x29, 0xC5, 0x89, 0x6F, 0xB7, 0x62, 0x0E, 0xAA, 0x18, 0xBE, 0x1B,
+    0xFC, 0x56, 0x3E, 0x4B, 0xC6, 0xD2, 0x79, 0x20, 0x9A, 0xDB, 0xC0, 0xFE, 0x78, 0xCD, 0x5A, 0xF4,
+    0x1F, 0xDD, 0xA8, 0x33, 0x88, 0x07, 0xC7, 0x31, 0xB1, 0x12, 0x10, 0x59, 0x27, 0x80, 0xEC, 0x5F,
+    0x60, 0x51, 0x7F, 0xA9, 0x19, 0xB5, 0x4A, 0x0D, 0x2D, 0xE5, 0x7A, 0x9F, 0x93, 0xC9, 0x9C, 0xEF,
+    0xA0, 0xE0, 0x3B, 0x4D, 0xAE, 0x2A, 0xF5, 0xB0, 0xC8, 0xEB, 0xBB, 0x3C, 0x83, 0x53, 0x99, 0x61,
+    0x17, 0x2B, 0x04, 0x7E, 0xBA, 0x77, 0xD6, 0x26, 0xE1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0C, 0x7D,
+};
+
+/**
+ * @brief aes round constant definition
+ */
+static const uint8_t gs_aes_rcon[10] =
+{
+    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36,
+};
+
+/**
+ * @brief     multiply by x in gf(2^8)
+ * @param[in] x input byte
+ * @return    product
+ * @note      none
+ */
+static uint8_t a_aes_xtime(uint8_t x)
+{
+    return (uint8_t)((x << 1) ^ (((x & 0x80) != 0) ? 0x1B : 0x00));        /* reduce by the polynomial */
+}
+
+/**
+ * @brief         add a round key
+ * @param[in,out] *s pointer to a state buffer
+ * @param[in]     *k pointer to a round key
+ * @note          none
+ */
+static void a_aes_add_round_key(uint8_t *s, const uint8_t *k)
+{
+    uint8_t i;
+
+    for (i = 0; i < 16; i++)        /* every byte */
+    {
+        s[i] ^= k[i];               /* xor the key */
+    }
+}
+
+/**
+ * @brief         mix the columns
+ * @param[in,out] *s pointer to a state buffer
+ * @note          none
+ */
+static void a_aes_mix_columns(uint8_t *s)
+{
+    uint8_t c;
+    uint8_t t;
+    uint8_t a0;
+    uint8_t a1;
+    uint8_t a2;
+    uint8_t a3;
+
+    for (c = 0; c < 16; c += 4)                                                /* every column */
+    {
+        a0 = s[c + 0];                                                         /* row 0 */
+        a1 = s[c + 1];                                                         /* row 1 */
+        a2 = s[c + 2];                                                         /* row 2 */
+        a3 = s[c + 3];                                                         /* row 3 */
+        t = (uint8_t)(a0 ^ a1 ^ a2 ^ a3);                                      /* column sum */
+        s[c + 0] = (uint8_t)(a0 ^ t ^ a_aes_xtime((uint8_t)(a0 ^ a1)));        /* 2 a0 + 3 a1 + a2 + a3 */
+        s[c + 1] = (uint8_t)(a1 ^ t ^ a_aes_xtime((uint8_t)(a1 ^ a2)));        /* a0 + 2 a1 + 3 a2 + a3 */
+        s[c + 2] = (uint8_t)(a2 ^ t ^ a_aes_xtime((uint8_t)(a2 ^ a3)));        /* a0 + a1 + 2 a2 + 3 a3 */
+        s[c + 3] = (uint8_t)(a3 ^ t ^ a_aes_xtime((uint8_t)(a3 ^ a0)));        /* 3 a0 + a1 + a2 + 2 a3 */
+    }
+}
+
+/**
+ * @brief     expand an aes-128 key
+ * @param[in] *aes pointer to an aes structure
+ * @param[in] *key pointer to a 16 bytes key
+ * @return    status code
+ *            - 0 success
+ *            - 2 aes or key is NULL
+ * @note      none
+ */
+uint8_t em4095_aes_init(em4095_aes_t *aes, const uint8_t *key)
+{
+    uint8_t i;
+    uint8_t t[4];
+    uint8_t *w;
+
+    if ((aes == NULL) || (key == NULL))                                                        /* check the pointers */
+    {
+        return 2;                                                                              /* return error */
+    }
+
+    w = aes->round_key;                                                                        /* expanded key */
+    for (i = 0; i < 16; i++)                                                                   /* the first round */
+    {
+        w[i] = key[i];                                                                         /* copy the key */
+    }
+    for (i = 4; i < 44; i++)                                                                   /* the other words */
+    {
+        t[0] = w[(i - 1) * 4 + 0];                                                             /* previous word */
+        t[1] = w[(i - 1) * 4 + 1];                                                             /* previous word */
+        t[2] = w[(i - 1) * 4 + 2];                                                             /* previous word */
+        t[3] = w[(i - 1) * 4 + 3];                                                             /* previous word */
+        if ((i % 4) == 0)                                                                      /* first word of a round */
+        {
+            t[0] = (uint8_t)(gs_aes_sbox[w[(i - 1) * 4 + 1]] ^ gs_aes_rcon[i / 4 - 1]);        /* rotate, substitute and add the constant */
+            t[1] = gs_aes_sbox[w[(i - 1) * 4 + 2]];                                            /* rotate and substitute */
+            t[2] = gs_aes_sbox[w[(i - 1) * 4 + 3]];                                            /* rotate and substitute */
+            t[3] = gs_aes_sbox[w[(i - 1) * 4 + 0]];                                            /* rotate and substitute */
+        }
+        w[i * 4 + 0] = (uint8_t)(w[(i - 4) * 4 + 0] ^ t[0]);                                   /* set the word */
+        w[i * 4 + 1] = (uint8_t)(w[(i - 4) * 4 + 1] ^ t[1]);                                   /* set the word */
+        w[i * 4 + 2] = (uint8_t)(w[(i - 4) * 4 + 2] ^ t[2]);                                   /* set the word */
+        w[i * 4 + 3] = (uint8_t)(w[(i - 4) * 4 + 3] ^ t[3]);                                   /* set the word */
+    }
+
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief         encrypt one block in place
+ * @param[in]     *aes pointer to an aes structure
+ * @param[in,out] *block pointer to a 16 bytes block
+ * @return        status code
+ *                - 0 success
+ *                - 2 aes or block is NULL
+ * @note          none
+ */
+uint8_t em4095_aes_encrypt(const em4095_aes_t *aes, uint8_t *block)
+{
+    uint8_t r;
+    uint8_t i;
+    uint8_t t[16];
+
+    if ((aes == NULL) || (block == NULL))                                        /* check the pointers */
+    {
+        return 2;                                                                /* return error */
+    }
+
+    a_aes_add_round_key(block, aes->round_key);                                  /* round 0 */
+    for (r = 1; r <= 10; r++)                                                    /* every round */
+    {
+        for (i = 0; i < 16; i++)                                                 /* every byte */
+        {
+            t[i] = gs_aes_sbox[block[((i / 4 + i % 4) % 4) * 4 + i % 4]];        /* substitute and shift the rows */
+        }
+        for (i = 0; i < 16; i++)                                                 /* every byte */
+        {
+            block[i] = t[i];                                                     /* copy back */
+        }
+        if (r != 10)                                                             /* not the last round */
+        {
+            a_aes_mix_columns(block);                                            /* mix the columns */
+        }
+        a_aes_add_round_key(block, &aes->round_key[r * 16]);                     /* add the round key */
+    }
+
+    return 0;                                                                    /* success return 0 */
+}
+
+/**
+ * @brief         decrypt one block in place
+ * @param[in]     *aes pointer to an aes structure
+ * @param[in,out] *block pointer to a 16 bytes block
+ * @return        status code
+ *                - 0 success
+ *                - 2 aes or block is NULL
+ * @note          none
+ */
+uint8_t em4095_aes_decrypt(const em4095_aes_t *aes, uint8_t *block)
+{
+    uint8_t r;
+    uint8_t i;
+    uint8_t u;
+    uint8_t v;
+    uint8_t t[16];
+
+    if ((aes == NULL) || (block == NULL))                                                    /* check the pointers */
+    {
+        return 2;                                                                            /* return error */
+    }
+
+    a_aes_add_round_key(block, &aes->round_key[160]);                                        /* round 10 */
+    for (r = 10; r >= 1; r--)                                                                /* every round */
+    {
+        for (i = 0; i < 16; i++)                                                             /* every byte */
+        {
+            t[i] = gs_aes_inv_sbox[block[((i / 4 + 4 - i % 4) % 4) * 4 + i % 4]];            /* shift back the rows and substitute */
+        }
+        for (i = 0; i < 16; i++)                                                             /* every byte */
+        {
+            block[i] = t[i];                                                                 /* copy back */
+        }
+        a_aes_add_round_key(block, &aes->round_key[(r - 1) * 16]);                           /* add the round key */
+        if (r != 1)                                                                          /* not the last round */
+        {
+            for (i = 0; i < 16; i += 4)                                                      /* every column */
+            {
+                u = a_aes_xtime(a_aes_xtime((uint8_t)(block[i + 0] ^ block[i + 2])));        /* 4 (a0 + a2) */
+                v = a_aes_xtime(a_aes_xtime((uint8_t)(block[i + 1] ^ block[i + 3])));        /* 4 (a1 + a3) */
+                block[i + 0] ^= u;                                                           /* fold into row 0 */
+                block[i + 1] ^= v;                                                           /* fold into row 1 */
+                block[i + 2] ^= u;                                                           /* fold into row 2 */
+                block[i + 3] ^= v;                                                           /* fold into row 3 */
+            }
+            a_aes_mix_columns(block);                                                        /* inverse mix the columns */
+        }
+    }
+
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief         encrypt a buffer in place in cbc mode
+ * @param[in]     *aes pointer to an aes structure
+ * @param[in]     *iv pointer to a 16 bytes initial vector
+ * @param[in,out] *buf pointer to a data buffer
+ * @param[in]     len data length
+ * @return        status code
+ *                - 0 success
+ *                - 2 aes, iv or buf is NULL
+ *                - 4 len is not a multiple of 16
+ * @note          the caller pads the data
+ */
+uint8_t em4095_aes_cbc_encrypt(const em4095_aes_t *aes, const uint8_t *iv, uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+    uint8_t j;
+    const uint8_t *prev;
+
+    if ((aes == NULL) || (iv == NULL) || (buf == NULL))        /* check the pointers */
+    {
+        return 2;                                              /* return error */
+    }
+    if ((len % EM4095_AES_BLOCK) != 0)                         /* check the length */
+    {
+        return 4;                                              /* return error */
+    }
+
+    prev = iv;                                                 /* chain from the iv */
+    for (i = 0; i < len; i += EM4095_AES_BLOCK)                /* every block */
+    {
+        for (j = 0; j < EM4095_AES_BLOCK; j++)                 /* every byte */
+        {
+            buf[i + j] ^= prev[j];                             /* chain the previous block */
+        }
+        (void)em4095_aes_encrypt(aes, &buf[i]);                /* encrypt the block */
+        prev = &buf[i];                                        /* next chain */
+    }
+
+    return 0;                                                  /* success return 0 */
+}
+
+/**
+ * @brief         decrypt a buffer in place in cbc mode
+ * @param[in]     *aes pointer to an aes structure
+ * @param[in]     *iv pointer to a 16 bytes initial vector
+ * @param[in,out] *buf pointer to a data buffer
+ * @param[in]     len data length
+ * @return        status code
+ *                - 0 success
+ *                - 2 aes, iv or buf is NULL
+ *                - 4 len is not a multiple of 16
+ * @note          the padding is left in the buffer
+ */
+uint8_t em4095_aes_cbc_decrypt(const em4095_aes_t *aes, const uint8_t *iv, uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+    uint8_t j;
+    uint8_t prev[EM4095_AES_BLOCK];
+    uint8_t next[EM4095_AES_BLOCK];
+
+    if ((aes == NULL) || (iv == NULL) || (buf == NULL))        /* check the pointers */
+    {
+        return 2;                                              /* return error */
+    }
+    if ((len % EM4095_AES_BLOCK) != 0)                         /* check the length */
+    {
+        return 4;                                              /* return error */
+    }
+
+    for (j = 0; j < EM4095_AES_BLOCK; j++)                     /* every byte */
+    {
+        prev[j] = iv[j];                                       /* chain from the iv */
+    }
+    for (i = 0; i < len; i += EM4095_AES_BLOCK)                /* every block */
+    {
+        for (j = 0; j < EM4095_AES_BLOCK; j++)                 /* every byte */
+        {
+            next[j] = buf[i + j];                              /* keep the cipher block */
+        }
+        (void)em4095_aes_decrypt(aes, &buf[i]);                /* decrypt the block */
+        for (j = 0; j < EM4095_AES_BLOCK; j++)                 /* every byte */
+        {
+            buf[i + j] ^= prev[j];                             /* unchain the previous block */
+            prev[j] = next[j];                                 /* next chain */
+        }
+    }
+
+    return 0;                                                  /* success return 0 */
+}
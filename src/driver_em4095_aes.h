@@ -0,0 +1,140 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_aes.h
+ * @brief     driver em4095 aes header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+
+#ifndef DRIVER_EM4095_AES_H
+#define DRIVER_EM4095_AES_H
+
+#include "driver_em4095.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup em4095_aes_driver em4095 aes driver function
+ * @brief    em4095 aes driver modules
+ * @ingroup  em4095_driver
+ * @details  a table based aes-128 block cipher for the osdp secure channel, one block in place or a
+ *           buffer in cbc mode. it keeps the expanded key and needs no other library.
+ * @{
+ */
+
+/**
+ * @brief em4095 aes definition
+ */
+#define EM4095_AES_BLOCK        16        /**< block length */
+#define EM4095_AES_KEY          16        /**< key length */
+
+/**
+ * @brief em4095 aes structure definition
+ */
+typedef struct em4095_aes_s
+{
+    uint8_t round_key[176];        /**< expanded key of the 11 rounds */
+} em4095_aes_t;
+
+/**
+ * @brief     expand an aes-128 key
+ * @param[in] *aes pointer to an aes structure
+ * @param[in] *key pointer to a 16 bytes key
+ * @return    status code
+ *            - 0 success
+ *            - 2 aes or key is NULL
+ * @note      none
+ */
+uint8_t em4095_aes_init(em4095_aes_t *aes, const uint8_t *key);
+
+/**
+ * @brief         encrypt one block in place
+ * @param[in]     *aes pointer to an aes structure
+ * @param[in,out] *block pointer to a 16 bytes block
+ * @return        status code
+ *                - 0 success
+ *                - 2 aes or block is NULL
+ * @note          none
+ */
+uint8_t em4095_aes_encrypt(const em4095_aes_t *aes, uint8_t *block);
+
+/**
+ * @brief         decrypt one block in place
+ * @param[in]     *aes pointer to an aes structure
+ * @param[in,out] *block pointer to a 16 bytes block
+ * @return        status code
+ *                - 0 success
+ *                - 2 aes or block is NULL
+ * @note          none
+ */
+uint8_t em4095_aes_decrypt(const em4095_aes_t *aes, uint8_t *block);
+
+/**
+ * @brief         encrypt a buffer in place in cbc mode
+ * @param[in]     *aes pointer to an aes structure
+ * @param[in]     *iv pointer to a 16 bytes initial vector
+ * @param[in,out] *buf pointer to a data buffer
+ * @param[in]     len data length
+ * @return        status code
+ *                - 0 success
+ *                - 2 aes, iv or buf is NULL
+ *                - 4 len is not a multiple of 16
+ * @note          the caller pads the data
+ */
+uint8_t em4095_aes_cbc_encrypt(const em4095_aes_t *aes, const uint8_t *iv, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief         decrypt a buffer in place in cbc mode
+ * @param[in]     *aes pointer to an aes structure
+ * @param[in]     *iv pointer to a 16 bytes initial vector
+ * @param[in,out] *buf pointer to a data buffer
+ * @param[in]     len data length
+ * @return        status code
+ *                - 0 success
+ *                - 2 aes, iv or buf is NULL
+ *                - 4 len is not a multiple of 16
+ * @note          the padding is left in the buffer
+ */
+uint8_t em4095_aes_cbc_decrypt(const em4095_aes_t *aes, const uint8_t *iv, uint8_t *buf, uint16_t len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
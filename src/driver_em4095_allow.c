@@ -0,0 +1,472 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_allow.c
+ * @brief     driver em4095 allow source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#include "driver_em4095_allow.h"
+
+/**
+ * @brief      hash a key
+ * @param[in]  key hashed key
+ * @param[out] *h1 pointer to the first hash buffer
+ * @param[out] *h2 pointer to the second hash buffer
+ * @note       the k bloom filter bits are h1 + i * h2, h2 is odd so the bits don't repeat
+ */
+static void a_allow_hash(uint64_t key, uint32_t *h1, uint32_t *h2)
+{
+    uint64_t h;
+
+    h = key * 0x9E3779B97F4A7C15ULL;        /* fibonacci hash */
+    h ^= h >> 29;                           /* mix the high bits down */
+    h *= 0xBF58476D1CE4E5B9ULL;             /* mix again */
+    *h1 = (uint32_t)(h >> 32);              /* high half */
+    *h2 = (uint32_t)h | 1;                  /* odd low half */
+}
+
+/**
+ * @brief     read one image key
+ * @param[in] *p pointer to a key
+ * @return    key
+ * @note      none
+ */
+static uint64_t a_allow_read_key(const uint8_t *p)
+{
+    return ((uint64_t)p[0] << 32) | ((uint64_t)p[1] << 24) | ((uint64_t)p[2] << 16) |
+           ((uint64_t)p[3] << 8) | (uint64_t)p[4];        /* big endian */
+}
+
+/**
+ * @brief     write one image key
+ * @param[in] *p pointer to a key
+ * @param[in] key written key
+ * @note      none
+ */
+static void a_allow_write_key(uint8_t *p, uint64_t key)
+{
+    p[0] = (uint8_t)(key >> 32);        /* set byte 0 */
+    p[1] = (uint8_t)(key >> 24);        /* set byte 1 */
+    p[2] = (uint8_t)(key >> 16);        /* set byte 2 */
+    p[3] = (uint8_t)(key >> 8);         /* set byte 3 */
+    p[4] = (uint8_t)(key >> 0);         /* set byte 4 */
+}
+
+/**
+ * @brief     sift one key down the heap
+ * @param[in] *keys pointer to a key buffer
+ * @param[in] root root index
+ * @param[in] count heap size
+ * @note      none
+ */
+static void a_allow_sift(uint64_t *keys, uint32_t root, uint32_t count)
+{
+    uint32_t child;
+    uint64_t tmp;
+
+    while ((child = root * 2 + 1) < count)                                 /* has a child */
+    {
+        if ((child + 1 < count) && (keys[child] < keys[child + 1]))        /* pick the larger child */
+        {
+            child++;                                                       /* right child */
+        }
+        if (keys[root] >= keys[child])                                     /* heap is ordered */
+        {
+            return;                                                        /* return */
+        }
+        tmp = keys[root];                                                  /* swap */
+        keys[root] = keys[child];                                          /* swap */
+        keys[child] = tmp;                                                 /* swap */
+        root = child;                                                      /* go down */
+    }
+}
+
+/**
+ * @brief     init the allow list from an image
+ * @param[in] *handle pointer to an allow structure
+ * @param[in] *image pointer to an image buffer
+ * @param[in] len image length
+ * @return    status code
+ *            - 0 success
+ *            - 1 image is invalid
+ *            - 2 handle or image is NULL
+ * @note      the image must stay valid while it is used, the keys are checked to be sorted
+ */
+uint8_t em4095_allow_init(em4095_allow_t *handle, const uint8_t *image, uint32_t len)
+{
+    uint8_t bloom_log2;
+    uint32_t i;
+    uint32_t count;
+    uint32_t size;
+    uint64_t prev;
+    uint64_t key;
+
+    if ((handle == NULL) || (image == NULL))                                                     /* check the pointers */
+    {
+        return 2;                                                                                /* return error */
+    }
+
+    handle->keys = NULL;                                                                         /* not inited */
+    if (len < EM4095_ALLOW_HEADER_SIZE)                                                          /* check the header */
+    {
+        return 1;                                                                                /* return error */
+    }
+    if ((image[0] != 'E') || (image[1] != 'M') || (image[2] != 'A') || (image[3] != 'L'))        /* check the magic */
+    {
+        return 1;                                                                                /* return error */
+    }
+    if (image[4] != EM4095_ALLOW_VERSION)                                                        /* check the version */
+    {
+        return 1;                                                                                /* return error */
+    }
+    bloom_log2 = image[5];                                                                       /* get the bloom bits */
+    if ((bloom_log2 != 0) && ((image[6] == 0) || (image[6] > EM4095_ALLOW_HASHES_MAX)))          /* check the hashes */
+    {
+        return 1;                                                                                /* return error */
+    }
+    count = (uint32_t)image[8] | ((uint32_t)image[9] << 8) |
+            ((uint32_t)image[10] << 16) | ((uint32_t)image[11] << 24);                           /* get the count */
+    if (em4095_allow_image_size(count, bloom_log2, &size) != 0)                                  /* get the size */
+    {
+        return 1;                                                                                /* return error */
+    }
+    if (size != len)                                                                             /* check the length */
+    {
+        return 1;                                                                                /* return error */
+    }
+
+    handle->bloom = (bloom_log2 != 0) ? (image + EM4095_ALLOW_HEADER_SIZE) : NULL;               /* set the bloom */
+    handle->mask = (bloom_log2 != 0) ? ((1U << bloom_log2) - 1) : 0;                             /* set the mask */
+    handle->hashes = image[6];                                                                   /* set the hashes */
+    handle->count = count;                                                                       /* set the count */
+    prev = 0;                                                                                    /* init 0 */
+    for (i = 0; i < count; i++)                                                                  /* check the order */
+    {
+        key = a_allow_read_key(image + len - (count - i) * EM4095_ALLOW_KEY_SIZE);               /* read the key */
+        if ((i != 0) && (key <= prev))                                                           /* not sorted */
+        {
+            return 1;                                                                            /* return error */
+        }
+        prev = key;                                                                              /* save the key */
+    }
+    handle->keys = image + len - count * EM4095_ALLOW_KEY_SIZE;                                  /* set the keys */
+
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief      check a key against the allow list
+ * @param[in]  *handle pointer to an allow structure
+ * @param[in]  key checked key
+ * @param[out] *allowed pointer to an allowed flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or allowed is NULL
+ *             - 3 handle is not initialized
+ * @note       no allocation, no lock and no write, it can run in the decoder completion path of
+ *             several readers at once
+ */
+uint8_t em4095_allow_check(const em4095_allow_t *handle, uint64_t key, uint8_t *allowed)
+{
+    uint8_t i;
+    uint32_t h1;
+    uint32_t h2;
+    uint32_t bit;
+    uint32_t lo;
+    uint32_t hi;
+    uint32_t mid;
+    uint64_t k;
+
+    if ((handle == NULL) || (allowed == NULL))                                   /* check the pointers */
+    {
+        return 2;                                                                /* return error */
+    }
+    if (handle->keys == NULL)                                                    /* check handle initialization */
+    {
+        return 3;                                                                /* return error */
+    }
+
+    *allowed = 0;                                                                /* init denied */
+    if (key > EM4095_ALLOW_KEY_MAX)                                              /* out of the key range */
+    {
+        return 0;                                                                /* denied */
+    }
+    if (handle->bloom != NULL)                                                   /* bloom filter */
+    {
+        a_allow_hash(key, &h1, &h2);                                             /* hash the key */
+        for (i = 0; i < handle->hashes; i++)                                     /* k bits */
+        {
+            bit = (h1 + i * h2) & handle->mask;                                  /* get the bit */
+            if ((handle->bloom[bit >> 3] & (1 << (bit & 7))) == 0)               /* bit is clear */
+            {
+                return 0;                                                        /* denied */
+            }
+        }
+    }
+    lo = 0;                                                                      /* first key */
+    hi = handle->count;                                                          /* past the last key */
+    while (lo < hi)                                                              /* binary search */
+    {
+        mid = lo + (hi - lo) / 2;                                                /* middle */
+        k = a_allow_read_key(handle->keys + mid * EM4095_ALLOW_KEY_SIZE);        /* read the key */
+        if (k == key)                                                            /* found */
+        {
+            *allowed = 1;                                                        /* allowed */
+
+            return 0;                                                            /* success return 0 */
+        }
+        else if (k < key)                                                        /* upper half */
+        {
+            lo = mid + 1;                                                        /* set the low */
+        }
+        else                                                                     /* lower half */
+        {
+            hi = mid;                                                            /* set the high */
+        }
+    }
+
+    return 0;                                                                    /* denied */
+}
+
+/**
+ * @brief      get the image size
+ * @param[in]  count key number
+ * @param[in]  bloom_log2 bloom filter bits as a power of 2, 0 disables the filter
+ * @param[out] *size pointer to a size buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 size is NULL
+ *             - 4 bloom_log2 is invalid
+ * @note       none
+ */
+uint8_t em4095_allow_image_size(uint32_t count, uint8_t bloom_log2, uint32_t *size)
+{
+    uint64_t s;
+
+    if (size == NULL)                                                              /* check size */
+    {
+        return 2;                                                                  /* return error */
+    }
+    if ((bloom_log2 != 0) &&
+        ((bloom_log2 < EM4095_ALLOW_BLOOM_LOG2_MIN) ||
+         (bloom_log2 > EM4095_ALLOW_BLOOM_LOG2_MAX)))                              /* check bloom_log2 */
+    {
+        return 4;                                                                  /* return error */
+    }
+
+    s = EM4095_ALLOW_HEADER_SIZE + (uint64_t)count * EM4095_ALLOW_KEY_SIZE;        /* header and keys */
+    if (bloom_log2 != 0)                                                           /* bloom filter */
+    {
+        s += (1U << bloom_log2) / 8;                                               /* filter bytes */
+    }
+    if (s > 0xFFFFFFFFULL)                                                         /* check the size */
+    {
+        return 4;                                                                  /* return error */
+    }
+    *size = (uint32_t)s;                                                           /* set the size */
+
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief      get the bloom filter size for a key number
+ * @param[in]  count key number
+ * @param[in]  bits_per_key bloom filter bits per key
+ * @param[out] *bloom_log2 pointer to a bloom filter bits buffer
+ * @param[out] *hashes pointer to a hash number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 bloom_log2 or hashes is NULL
+ *             - 4 bits_per_key can't be 0
+ * @note       the bits are rounded up to a power of 2, the hash number is bits / count * ln2
+ */
+uint8_t em4095_allow_bloom_size(uint32_t count, uint8_t bits_per_key, uint8_t *bloom_log2, uint8_t *hashes)
+{
+    uint8_t log2;
+    uint64_t bits;
+    uint64_t k;
+
+    if ((bloom_log2 == NULL) || (hashes == NULL))                                             /* check the pointers */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (bits_per_key == 0)                                                                    /* check bits_per_key */
+    {
+        return 4;                                                                             /* return error */
+    }
+
+    bits = (uint64_t)count * bits_per_key;                                                    /* wanted bits */
+    log2 = EM4095_ALLOW_BLOOM_LOG2_MIN;                                                       /* min bits */
+    while ((log2 < EM4095_ALLOW_BLOOM_LOG2_MAX) && ((1ULL << log2) < bits))                   /* round up */
+    {
+        log2++;                                                                               /* log2++ */
+    }
+    if (count == 0)                                                                           /* no key */
+    {
+        k = 1;                                                                                /* one hash */
+    }
+    else
+    {
+        k = ((1ULL << log2) * 693 + (uint64_t)count * 500) / ((uint64_t)count * 1000);        /* bits / count * ln2 */
+    }
+    if (k < 1)                                                                                /* min one hash */
+    {
+        k = 1;                                                                                /* set 1 */
+    }
+    if (k > EM4095_ALLOW_HASHES_MAX)                                                          /* check the max */
+    {
+        k = EM4095_ALLOW_HASHES_MAX;                                                          /* set the max */
+    }
+    *bloom_log2 = log2;                                                                       /* set the bits */
+    *hashes = (uint8_t)k;                                                                     /* set the hashes */
+
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief      build an allow list image
+ * @param[in]  *keys pointer to a key buffer
+ * @param[in]  count key number
+ * @param[in]  bloom_log2 bloom filter bits as a power of 2, 0 disables the filter
+ * @param[in]  hashes hash number
+ * @param[out] *image pointer to an image buffer
+ * @param[in]  len image buffer length
+ * @param[out] *used pointer to a used length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 image buffer is too small
+ *             - 2 keys, image or used is NULL
+ *             - 4 key, bloom_log2 or hashes is invalid
+ * @note       the keys are sorted in place and duplicates are dropped, so *used can be smaller than
+ *             the em4095_allow_image_size of count
+ */
+uint8_t em4095_allow_build(uint64_t *keys, uint32_t count, uint8_t bloom_log2, uint8_t hashes,
+                           uint8_t *image, uint32_t len, uint32_t *used)
+{
+    uint8_t j;
+    uint32_t i;
+    uint32_t n;
+    uint32_t size;
+    uint32_t mask;
+    uint32_t h1;
+    uint32_t h2;
+    uint32_t bit;
+    uint64_t tmp;
+    uint8_t *bloom;
+    uint8_t *p;
+
+    if ((keys == NULL) || (image == NULL) || (used == NULL))                               /* check the pointers */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if ((bloom_log2 != 0) && ((hashes == 0) || (hashes > EM4095_ALLOW_HASHES_MAX)))        /* check the hashes */
+    {
+        return 4;                                                                          /* return error */
+    }
+    for (i = 0; i < count; i++)                                                            /* check the keys */
+    {
+        if (keys[i] > EM4095_ALLOW_KEY_MAX)                                                /* more than 40 bits */
+        {
+            return 4;                                                                      /* return error */
+        }
+    }
+
+    for (i = count / 2; i > 0; i--)                                                        /* build the heap */
+    {
+        a_allow_sift(keys, i - 1, count);                                                  /* sift down */
+    }
+    for (i = count; i > 1; i--)                                                            /* heap sort */
+    {
+        tmp = keys[0];                                                                     /* move the max */
+        keys[0] = keys[i - 1];                                                             /* to the end */
+        keys[i - 1] = tmp;                                                                 /* swap */
+        a_allow_sift(keys, 0, i - 1);                                                      /* sift down */
+    }
+    n = 0;                                                                                 /* init 0 */
+    for (i = 0; i < count; i++)                                                            /* drop the duplicates */
+    {
+        if ((n == 0) || (keys[i] != keys[n - 1]))                                          /* a new key */
+        {
+            keys[n++] = keys[i];                                                           /* keep it */
+        }
+    }
+    if (em4095_allow_image_size(n, bloom_log2, &size) != 0)                                /* get the size */
+    {
+        return 4;                                                                          /* return error */
+    }
+    if (size > len)                                                                        /* check the length */
+    {
+        return 1;                                                                          /* return error */
+    }
+
+    image[0] = 'E';                                                                        /* set the magic */
+    image[1] = 'M';                                                                        /* set the magic */
+    image[2] = 'A';                                                                        /* set the magic */
+    image[3] = 'L';                                                                        /* set the magic */
+    image[4] = EM4095_ALLOW_VERSION;                                                       /* set the version */
+    image[5] = bloom_log2;                                                                 /* set the bloom bits */
+    image[6] = (bloom_log2 != 0) ? hashes : 0;                                             /* set the hashes */
+    image[7] = 0;                                                                          /* reserved */
+    image[8] = (uint8_t)(n >> 0);                                                          /* set the count */
+    image[9] = (uint8_t)(n >> 8);                                                          /* set the count */
+    image[10] = (uint8_t)(n >> 16);                                                        /* set the count */
+    image[11] = (uint8_t)(n >> 24);                                                        /* set the count */
+    p = image + EM4095_ALLOW_HEADER_SIZE;                                                  /* after the header */
+    if (bloom_log2 != 0)                                                                   /* bloom filter */
+    {
+        bloom = p;                                                                         /* set the filter */
+        mask = (1U << bloom_log2) - 1;                                                     /* set the mask */
+        for (i = 0; i < (1U << bloom_log2) / 8; i++)                                       /* clear the filter */
+        {
+            bloom[i] = 0;                                                                  /* set 0 */
+        }
+        for (i = 0; i < n; i++)                                                            /* all keys */
+        {
+            a_allow_hash(keys[i], &h1, &h2);                                               /* hash the key */
+            for (j = 0; j < hashes; j++)                                                   /* k bits */
+            {
+                bit = (h1 + j * h2) & mask;                                                /* get the bit */
+                bloom[bit >> 3] |= (uint8_t)(1 << (bit & 7));                              /* set the bit */
+            }
+        }
+        p += (1U << bloom_log2) / 8;                                                       /* after the filter */
+    }
+    for (i = 0; i < n; i++)                                                                /* all keys */
+    {
+        a_allow_write_key(p, keys[i]);                                                     /* write the key */
+        p += EM4095_ALLOW_KEY_SIZE;                                                        /* next key */
+    }
+    *used = size;                                                                          /* set the used length */
+
+    return 0;                                                                              /* success return 0 */
+}
@@ -0,0 +1,173 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_allow.h
+ * @brief     driver em4095 allow header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#ifndef DRIVER_EM4095_ALLOW_H
+#define DRIVER_EM4095_ALLOW_H
+
+#include "driver_em4095.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup em4095_allow_driver em4095 allow driver function
+ * @brief    em4095 allow driver modules
+ * @ingroup  em4095_driver
+ * @details  an allow list image is a 12 bytes header, a bloom filter and the sorted 40 bits keys. the
+ *           image is built once on the host and linked to the flash, a lookup reads it in place.
+ *           the header is the "EMAL" magic, the version, the bloom filter bits as a power of 2, the
+ *           hash number, a reserved byte and the little endian key number. the keys are stored in
+ *           5 big endian bytes each. a key absent from the bloom filter is rejected with k bit reads,
+ *           the others are confirmed by a binary search, about 17 probes for 100000 keys.
+ * @{
+ */
+
+/**
+ * @brief em4095 allow definition
+ */
+#define EM4095_ALLOW_VERSION            1                             /**< image version */
+#define EM4095_ALLOW_HEADER_SIZE        12                            /**< image header size */
+#define EM4095_ALLOW_KEY_SIZE           5                             /**< key size in the image */
+#define EM4095_ALLOW_KEY_MAX            0xFFFFFFFFFFULL               /**< max key */
+#define EM4095_ALLOW_BLOOM_LOG2_MIN     3                             /**< min bloom filter bits as a power of 2 */
+#define EM4095_ALLOW_BLOOM_LOG2_MAX     24                            /**< max bloom filter bits as a power of 2 */
+#define EM4095_ALLOW_HASHES_MAX         16                            /**< max hash number */
+
+/**
+ * @brief     em4095 allow key of an em4100 id
+ * @param[in] VERSION version or customer id
+ * @param[in] ID card id
+ * @note      none
+ */
+#define EM4095_ALLOW_KEY(VERSION, ID)   ((((uint64_t)(VERSION)) << 32) | ((uint64_t)(uint32_t)(ID)))
+
+/**
+ * @brief em4095 allow structure definition
+ */
+typedef struct em4095_allow_s
+{
+    const uint8_t *bloom;           /**< bloom filter, NULL if it is disabled */
+    const uint8_t *keys;            /**< sorted keys */
+    uint32_t count;                 /**< key number */
+    uint32_t mask;                  /**< bloom filter bit mask */
+    uint8_t hashes;                 /**< hash number */
+} em4095_allow_t;
+
+/**
+ * @brief     init the allow list from an image
+ * @param[in] *handle pointer to an allow structure
+ * @param[in] *image pointer to an image buffer
+ * @param[in] len image length
+ * @return    status code
+ *            - 0 success
+ *            - 1 image is invalid
+ *            - 2 handle or image is NULL
+ * @note      the image must stay valid while it is used, the keys are checked to be sorted
+ */
+uint8_t em4095_allow_init(em4095_allow_t *handle, const uint8_t *image, uint32_t len);
+
+/**
+ * @brief      check a key against the allow list
+ * @param[in]  *handle pointer to an allow structure
+ * @param[in]  key checked key
+ * @param[out] *allowed pointer to an allowed flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or allowed is NULL
+ *             - 3 handle is not initialized
+ * @note       no allocation, no lock and no write, it can run in the decoder completion path of
+ *             several readers at once
+ */
+uint8_t em4095_allow_check(const em4095_allow_t *handle, uint64_t key, uint8_t *allowed);
+
+/**
+ * @brief      get the image size
+ * @param[in]  count key number
+ * @param[in]  bloom_log2 bloom filter bits as a power of 2, 0 disables the filter
+ * @param[out] *size pointer to a size buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 size is NULL
+ *             - 4 bloom_log2 is invalid
+ * @note       none
+ */
+uint8_t em4095_allow_image_size(uint32_t count, uint8_t bloom_log2, uint32_t *size);
+
+/**
+ * @brief      get the bloom filter size for a key number
+ * @param[in]  count key number
+ * @param[in]  bits_per_key bloom filter bits per key
+ * @param[out] *bloom_log2 pointer to a bloom filter bits buffer
+ * @param[out] *hashes pointer to a hash number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 bloom_log2 or hashes is NULL
+ *             - 4 bits_per_key can't be 0
+ * @note       the bits are rounded up to a power of 2, the hash number is bits / count * ln2
+ */
+uint8_t em4095_allow_bloom_size(uint32_t count, uint8_t bits_per_key, uint8_t *bloom_log2, uint8_t *hashes);
+
+/**
+ * @brief      build an allow list image
+ * @param[in]  *keys pointer to a key buffer
+ * @param[in]  count key number
+ * @param[in]  bloom_log2 bloom filter bits as a power of 2, 0 disables the filter
+ * @param[in]  hashes hash number
+ * @param[out] *image pointer to an image buffer
+ * @param[in]  len image buffer length
+ * @param[out] *used pointer to a used length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 image buffer is too small
+ *             - 2 keys, image or used is NULL
+ *             - 4 key, bloom_log2 or hashes is invalid
+ * @note       the keys are sorted in place and duplicates are dropped, so *used can be smaller than
+ *             the em4095_allow_image_size of count
+ */
+uint8_t em4095_allow_build(uint64_t *keys, uint32_t count, uint8_t bloom_log2, uint8_t hashes,
+                           uint8_t *image, uint32_t len, uint32_t *used);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
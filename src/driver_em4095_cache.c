@@ -0,0 +1,317 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_cache.c
+ * @brief     driver em4095 cache source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#include "driver_em4095_cache.h"
+
+/**
+ * @brief cache mask definition
+ */
+#define EM4095_CACHE_MASK        (EM4095_CACHE_SIZE - 1)        /**< index mask */
+
+/**
+ * @brief     convert a timestamp to microseconds
+ * @param[in] *t pointer to a timestamp
+ * @return    microseconds
+ * @note      none
+ */
+static uint64_t a_cache_us(const em4095_time_t *t)
+{
+    return t->s * 1000000ULL + t->us;        /* convert to us */
+}
+
+/**
+ * @brief     get the home slot of a key
+ * @param[in] key tag key
+ * @return    slot index
+ * @note      multiplicative hash, the high bits are mixed best
+ */
+static uint16_t a_cache_home(uint64_t key)
+{
+    return (uint16_t)((key * 0x9E3779B97F4A7C15ULL) >> 32) & EM4095_CACHE_MASK;        /* fibonacci hash */
+}
+
+/**
+ * @brief      find the slot of a key
+ * @param[in]  *handle pointer to a cache structure
+ * @param[in]  key tag key
+ * @param[out] *index pointer to a slot index buffer
+ * @return     status code
+ *             - 0 found
+ *             - 1 not found, *index is the first free slot
+ * @note       the cache must not be full when the key is not found
+ */
+static uint8_t a_cache_probe(em4095_cache_t *handle, uint64_t key, uint16_t *index)
+{
+    uint16_t i;
+    uint16_t n;
+
+    i = a_cache_home(key);                         /* start from the home slot */
+    for (n = 0; n < EM4095_CACHE_SIZE; n++)        /* probe all slots */
+    {
+        if (handle->entry[i].used == 0)            /* free slot */
+        {
+            *index = i;                            /* save the free slot */
+
+            return 1;                              /* not found */
+        }
+        if (handle->entry[i].key == key)           /* check the key */
+        {
+            *index = i;                            /* save the slot */
+
+            return 0;                              /* found */
+        }
+        i = (i + 1) & EM4095_CACHE_MASK;           /* next slot */
+    }
+    *index = EM4095_CACHE_SIZE;                    /* no free slot */
+
+    return 1;                                      /* not found */
+}
+
+/**
+ * @brief     remove one slot
+ * @param[in] *handle pointer to a cache structure
+ * @param[in] index slot index
+ * @note      backward shift deletion keeps every probe chain unbroken without tombstones
+ */
+static void a_cache_remove(em4095_cache_t *handle, uint16_t index)
+{
+    uint16_t i;
+    uint16_t j;
+    uint16_t k;
+
+    i = index;                                                /* the hole */
+    j = index;                                                /* the scan */
+    handle->entry[i].used = 0;                                /* free the hole */
+    while (1)                                                 /* loop */
+    {
+        j = (j + 1) & EM4095_CACHE_MASK;                      /* next slot */
+        if (handle->entry[j].used == 0)                       /* end of the chain */
+        {
+            break;                                            /* break */
+        }
+        k = a_cache_home(handle->entry[j].key);               /* home of the entry */
+        if (((uint16_t)((j - k) & EM4095_CACHE_MASK)) >=
+            ((uint16_t)((j - i) & EM4095_CACHE_MASK)))        /* the hole is on its chain */
+        {
+            handle->entry[i] = handle->entry[j];              /* shift it back */
+            handle->entry[j].used = 0;                        /* free the old slot */
+            i = j;                                            /* the new hole */
+        }
+    }
+    handle->count--;                                          /* count-- */
+}
+
+/**
+ * @brief     init the cache
+ * @param[in] *handle pointer to a cache structure
+ * @param[in] holdoff_ms hold off between two reports of one tag
+ * @param[in] expiry_ms time without a read before a tag left
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 expiry_ms can't be 0
+ * @note      holdoff_ms 0 reports every read as present
+ */
+uint8_t em4095_cache_init(em4095_cache_t *handle, uint32_t holdoff_ms, uint32_t expiry_ms)
+{
+    uint16_t i;
+
+    if (handle == NULL)                            /* check handle */
+    {
+        return 2;                                  /* return error */
+    }
+    if (expiry_ms == 0)                            /* check expiry_ms */
+    {
+        return 4;                                  /* return error */
+    }
+
+    for (i = 0; i < EM4095_CACHE_SIZE; i++)        /* all entries */
+    {
+        handle->entry[i].used = 0;                 /* free */
+    }
+    handle->holdoff_ms = holdoff_ms;               /* set the hold off */
+    handle->expiry_ms = expiry_ms;                 /* set the expiry */
+    handle->count = 0;                             /* init 0 */
+    handle->evicted = 0;                           /* init 0 */
+
+    return 0;                                      /* success return 0 */
+}
+
+/**
+ * @brief      push one read to the cache
+ * @param[in]  *handle pointer to a cache structure
+ * @param[in]  key tag key
+ * @param[in]  *t pointer to the read timestamp
+ * @param[out] *event pointer to an event buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle, t or event is NULL
+ * @note       when the cache is full the least recently read tag is dropped without a left event
+ */
+uint8_t em4095_cache_push(em4095_cache_t *handle, uint64_t key, const em4095_time_t *t, em4095_cache_event_t *event)
+{
+    uint16_t i;
+    uint16_t oldest;
+    uint64_t now;
+    em4095_cache_entry_t *e;
+
+    if ((handle == NULL) || (t == NULL) || (event == NULL))                         /* check the pointers */
+    {
+        return 2;                                                                   /* return error */
+    }
+
+    now = a_cache_us(t);                                                            /* get the time */
+    if (a_cache_probe(handle, key, &i) == 0)                                        /* a known tag */
+    {
+        e = &handle->entry[i];                                                      /* get the entry */
+        e->last_us = now;                                                           /* set the last read */
+        e->reads++;                                                                 /* reads++ */
+        if ((now >= e->report_us) &&
+            ((now - e->report_us) >= ((uint64_t)handle->holdoff_ms * 1000)))        /* hold off passed */
+        {
+            e->report_us = now;                                                     /* set the report time */
+            *event = EM4095_CACHE_EVENT_PRESENT;                                    /* still present */
+        }
+        else
+        {
+            *event = EM4095_CACHE_EVENT_NONE;                                       /* duplicate read */
+        }
+
+        return 0;                                                                   /* success return 0 */
+    }
+
+    if (handle->count >= EM4095_CACHE_SIZE)                                         /* the cache is full */
+    {
+        oldest = 0;                                                                 /* init 0 */
+        for (i = 1; i < EM4095_CACHE_SIZE; i++)                                     /* find the oldest */
+        {
+            if (handle->entry[i].last_us < handle->entry[oldest].last_us)           /* older */
+            {
+                oldest = i;                                                         /* save the index */
+            }
+        }
+        a_cache_remove(handle, oldest);                                             /* drop it */
+        handle->evicted++;                                                          /* evicted++ */
+        (void)a_cache_probe(handle, key, &i);                                       /* probe again */
+    }
+    e = &handle->entry[i];                                                          /* get the free slot */
+    e->key = key;                                                                   /* set the key */
+    e->first_us = now;                                                              /* set the first read */
+    e->last_us = now;                                                               /* set the last read */
+    e->report_us = now;                                                             /* set the report time */
+    e->reads = 1;                                                                   /* first read */
+    e->used = 1;                                                                    /* used */
+    handle->count++;                                                                /* count++ */
+    *event = EM4095_CACHE_EVENT_ARRIVED;                                            /* arrived */
+
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      pop one expired tag from the cache
+ * @param[in]  *handle pointer to a cache structure
+ * @param[in]  *t pointer to the current timestamp
+ * @param[out] *key pointer to a tag key buffer
+ * @param[out] *event pointer to an event buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no expired tag
+ *             - 2 handle, t, key or event is NULL
+ * @note       call it until it returns 1, every call removes one tag and reports it as left
+ */
+uint8_t em4095_cache_expire(em4095_cache_t *handle, const em4095_time_t *t, uint64_t *key, em4095_cache_event_t *event)
+{
+    uint16_t i;
+    uint64_t now;
+    uint64_t expiry;
+
+    if ((handle == NULL) || (t == NULL) || (key == NULL) || (event == NULL))        /* check the pointers */
+    {
+        return 2;                                                                   /* return error */
+    }
+
+    *event = EM4095_CACHE_EVENT_NONE;                                               /* init none */
+    if (handle->count == 0)                                                         /* empty */
+    {
+        return 1;                                                                   /* nothing expired */
+    }
+    now = a_cache_us(t);                                                            /* get the time */
+    expiry = (uint64_t)handle->expiry_ms * 1000;                                    /* expiry in us */
+    for (i = 0; i < EM4095_CACHE_SIZE; i++)                                         /* all entries */
+    {
+        if ((handle->entry[i].used != 0) && (now >= handle->entry[i].last_us) &&
+            ((now - handle->entry[i].last_us) >= expiry))                           /* expired */
+        {
+            *key = handle->entry[i].key;                                            /* save the key */
+            *event = EM4095_CACHE_EVENT_LEFT;                                       /* left */
+            a_cache_remove(handle, i);                                              /* remove it */
+
+            return 0;                                                               /* success return 0 */
+        }
+    }
+
+    return 1;                                                                       /* nothing expired */
+}
+
+/**
+ * @brief      look up one tag in the cache
+ * @param[in]  *handle pointer to a cache structure
+ * @param[in]  key tag key
+ * @param[out] **entry pointer to an entry pointer buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 tag is not in the cache
+ *             - 2 handle or entry is NULL
+ * @note       the entry is valid until the next push or expire
+ */
+uint8_t em4095_cache_find(em4095_cache_t *handle, uint64_t key, const em4095_cache_entry_t **entry)
+{
+    uint16_t i;
+
+    if ((handle == NULL) || (entry == NULL))        /* check the pointers */
+    {
+        return 2;                                   /* return error */
+    }
+
+    if (a_cache_probe(handle, key, &i) != 0)        /* probe the key */
+    {
+        return 1;                                   /* not found */
+    }
+    *entry = &handle->entry[i];                     /* save the entry */
+
+    return 0;                                       /* success return 0 */
+}
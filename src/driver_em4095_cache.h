@@ -0,0 +1,160 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_cache.h
+ * @brief     driver em4095 cache header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#ifndef DRIVER_EM4095_CACHE_H
+#define DRIVER_EM4095_CACHE_H
+
+#include "driver_em4095.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup em4095_cache_driver em4095 cache driver function
+ * @brief    em4095 cache driver modules
+ * @ingroup  em4095_driver
+ * @details  a fixed size open addressing table of the tags in the field, a tag is read many times per second
+ *           while it stays in the field, the cache turns the reads into arrived, present and left events.
+ * @{
+ */
+
+/**
+ * @brief em4095 cache definition
+ */
+#ifndef EM4095_CACHE_SIZE
+    #define EM4095_CACHE_SIZE        16        /**< cache entries, must be a power of 2 */
+#endif
+
+/**
+ * @brief em4095 cache event enumeration definition
+ */
+typedef enum
+{
+    EM4095_CACHE_EVENT_NONE    = 0x00,        /**< duplicate read, nothing to report */
+    EM4095_CACHE_EVENT_ARRIVED = 0x01,        /**< tag arrived */
+    EM4095_CACHE_EVENT_PRESENT = 0x02,        /**< tag still present after the hold off */
+    EM4095_CACHE_EVENT_LEFT    = 0x03,        /**< tag left */
+} em4095_cache_event_t;
+
+/**
+ * @brief em4095 cache entry structure definition
+ */
+typedef struct em4095_cache_entry_s
+{
+    uint64_t key;             /**< tag key */
+    uint64_t first_us;        /**< first read time */
+    uint64_t last_us;         /**< last read time */
+    uint64_t report_us;       /**< last report time */
+    uint32_t reads;           /**< read times */
+    uint8_t used;             /**< used flag */
+} em4095_cache_entry_t;
+
+/**
+ * @brief em4095 cache structure definition
+ */
+typedef struct em4095_cache_s
+{
+    em4095_cache_entry_t entry[EM4095_CACHE_SIZE];        /**< entries */
+    uint32_t holdoff_ms;                                  /**< hold off between two reports of one tag */
+    uint32_t expiry_ms;                                   /**< time without a read before a tag left */
+    uint16_t count;                                       /**< used entries */
+    uint32_t evicted;                                     /**< evicted entries when the cache was full */
+} em4095_cache_t;
+
+/**
+ * @brief     init the cache
+ * @param[in] *handle pointer to a cache structure
+ * @param[in] holdoff_ms hold off between two reports of one tag
+ * @param[in] expiry_ms time without a read before a tag left
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 expiry_ms can't be 0
+ * @note      holdoff_ms 0 reports every read as present
+ */
+uint8_t em4095_cache_init(em4095_cache_t *handle, uint32_t holdoff_ms, uint32_t expiry_ms);
+
+/**
+ * @brief      push one read to the cache
+ * @param[in]  *handle pointer to a cache structure
+ * @param[in]  key tag key
+ * @param[in]  *t pointer to the read timestamp
+ * @param[out] *event pointer to an event buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle, t or event is NULL
+ * @note       when the cache is full the least recently read tag is dropped without a left event
+ */
+uint8_t em4095_cache_push(em4095_cache_t *handle, uint64_t key, const em4095_time_t *t, em4095_cache_event_t *event);
+
+/**
+ * @brief      pop one expired tag from the cache
+ * @param[in]  *handle pointer to a cache structure
+ * @param[in]  *t pointer to the current timestamp
+ * @param[out] *key pointer to a tag key buffer
+ * @param[out] *event pointer to an event buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no expired tag
+ *             - 2 handle, t, key or event is NULL
+ * @note       call it until it returns 1, every call removes one tag and reports it as left
+ */
+uint8_t em4095_cache_expire(em4095_cache_t *handle, const em4095_time_t *t, uint64_t *key, em4095_cache_event_t *event);
+
+/**
+ * @brief      look up one tag in the cache
+ * @param[in]  *handle pointer to a cache structure
+ * @param[in]  key tag key
+ * @param[out] **entry pointer to an entry pointer buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 tag is not in the cache
+ *             - 2 handle or entry is NULL
+ * @note       the entry is valid until the next push or expire
+ */
+uint8_t em4095_cache_find(em4095_cache_t *handle, uint64_t key, const em4095_cache_entry_t **entry);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,377 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_capture.c
+ * @brief     driver em4095 capture source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_em4095_capture.h"
+
+/**
+ * @brief capture magic definition
+ */
+static const uint8_t gs_magic[4] = {'E', 'M', '9', '5'};        /**< magic */
+
+/**
+ * @brief crc16 ccitt nibble table definition
+ */
+static const uint16_t gs_crc_table[16] =
+{
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+};
+
+/**
+ * @brief     crc16 ccitt false
+ * @param[in] crc crc seed
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len buffer length
+ * @return    crc
+ * @note      none
+ */
+static uint16_t a_capture_crc16(uint16_t crc, const uint8_t *buf, uint32_t len)
+{
+    uint32_t i;
+
+    for (i = 0; i < len; i++)                                                          /* run all bytes */
+    {
+        crc = (uint16_t)(crc << 4) ^ gs_crc_table[((crc >> 12) ^ (buf[i] >> 4)) & 0x0F];       /* high nibble */
+        crc = (uint16_t)(crc << 4) ^ gs_crc_table[((crc >> 12) ^ (buf[i] & 0x0F)) & 0x0F];     /* low nibble */
+    }
+
+    return crc;                                                                        /* return crc */
+}
+
+/**
+ * @brief     put uint32 in little endian
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] value set value
+ * @note      none
+ */
+static void a_capture_put_u32(uint8_t *buf, uint32_t value)
+{
+    buf[0] = (uint8_t)(value >> 0);         /* byte 0 */
+    buf[1] = (uint8_t)(value >> 8);         /* byte 1 */
+    buf[2] = (uint8_t)(value >> 16);        /* byte 2 */
+    buf[3] = (uint8_t)(value >> 24);        /* byte 3 */
+}
+
+/**
+ * @brief     get uint32 in little endian
+ * @param[in] *buf pointer to a data buffer
+ * @return    value
+ * @note      none
+ */
+static uint32_t a_capture_get_u32(const uint8_t *buf)
+{
+    return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) |
+           ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);        /* return value */
+}
+
+/**
+ * @brief      put a varint
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  value set value
+ * @return     used bytes
+ * @note       buf must have 5 bytes at least
+ */
+static uint8_t a_capture_put_varint(uint8_t *buf, uint32_t value)
+{
+    uint8_t i;
+
+    i = 0;                                                   /* init 0 */
+    while (value >= 0x80)                                    /* 7 bits per byte */
+    {
+        buf[i] = (uint8_t)((value & 0x7F) | 0x80);           /* set continue bit */
+        value >>= 7;                                         /* next 7 bits */
+        i++;                                                 /* byte++ */
+    }
+    buf[i] = (uint8_t)value;                                 /* last byte */
+
+    return (uint8_t)(i + 1);                                 /* return used bytes */
+}
+
+/**
+ * @brief      encode the capture file header
+ * @param[in]  *header pointer to a capture header structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  *len pointer to a length buffer
+ * @param[out] *len pointer to a length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is too small
+ *             - 2 header or buf is NULL
+ * @note       *len is the buffer size on input and the used size on output
+ */
+uint8_t em4095_capture_encode_header(const em4095_capture_header_t *header, uint8_t *buf, uint16_t *len)
+{
+    if ((header == NULL) || (buf == NULL) || (len == NULL))         /* check the params */
+    {
+        return 2;                                                   /* return error */
+    }
+    if ((*len) < EM4095_CAPTURE_HEADER_SIZE)                        /* check the size */
+    {
+        return 1;                                                   /* return error */
+    }
+
+    memcpy(buf, gs_magic, 4);                                       /* set magic */
+    buf[4] = EM4095_CAPTURE_VERSION;                                /* set version */
+    buf[5] = EM4095_CAPTURE_HEADER_SIZE;                            /* set header size */
+    buf[6] = header->mode;                                          /* set mode */
+    buf[7] = 0;                                                     /* reserved */
+    a_capture_put_u32(&buf[8], header->div);                        /* set div */
+    a_capture_put_u32(&buf[12], header->tick_hz);                   /* set tick rate */
+    a_capture_put_u32(&buf[16], header->clock_hz);                  /* set clock rate */
+    a_capture_put_u32(&buf[20], header->reader_id);                 /* set reader id */
+    *len = EM4095_CAPTURE_HEADER_SIZE;                              /* set used size */
+
+    return 0;                                                       /* success return 0 */
+}
+
+/**
+ * @brief      encode a decode buffer as a frame block
+ * @param[in]  *decode pointer to a decode buffer
+ * @param[in]  decode_len decode buffer length
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  *len pointer to a length buffer
+ * @param[out] *len pointer to a length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is too small
+ *             - 2 decode or buf is NULL
+ *             - 4 decode_len is 0
+ * @note       the decode diff_us must be valid, the last sample lasts as long as the one before it
+ */
+uint8_t em4095_capture_encode_frame(const em4095_decode_t *decode, uint16_t decode_len, uint8_t *buf, uint16_t *len)
+{
+    uint16_t i;
+    uint16_t count;
+    uint32_t size;
+    uint32_t run;
+    uint32_t cell;
+    uint16_t crc;
+
+    if ((decode == NULL) || (buf == NULL) || (len == NULL))                       /* check the params */
+    {
+        return 2;                                                                 /* return error */
+    }
+    if (decode_len == 0)                                                          /* check the length */
+    {
+        return 4;                                                                 /* return error */
+    }
+
+    size = 6;                                                                     /* skip the block header */
+    count = 0;                                                                    /* init 0 */
+    run = 0;                                                                      /* init 0 */
+    for (i = 0; i < decode_len; i++)                                              /* run all samples */
+    {
+        if (i + 1 < decode_len)                                                   /* not the last one */
+        {
+            cell = decode[i].diff_us;                                             /* sample duration */
+        }
+        else
+        {
+            cell = (i != 0) ? decode[i - 1].diff_us : 0;                          /* last one uses the previous */
+        }
+        run += cell;                                                              /* add to the run */
+        if ((i + 1 == decode_len) || (decode[i + 1].level != decode[i].level))    /* check the edge */
+        {
+            if (size + 5 + 2 > (uint32_t)(*len))                                  /* check the size */
+            {
+                return 1;                                                         /* return error */
+            }
+            size += a_capture_put_varint(&buf[size], run);                        /* put the run */
+            count++;                                                              /* count++ */
+            run = 0;                                                              /* reset the run */
+        }
+    }
+    buf[0] = EM4095_CAPTURE_TAG_FRAME;                                            /* set tag */
+    buf[1] = (decode[0].level != 0) ? 1 : 0;                                      /* set first level */
+    buf[2] = (uint8_t)(count >> 0);                                               /* set count */
+    buf[3] = (uint8_t)(count >> 8);                                               /* set count */
+    buf[4] = (uint8_t)((size - 6) >> 0);                                          /* set payload size */
+    buf[5] = (uint8_t)((size - 6) >> 8);                                          /* set payload size */
+    crc = a_capture_crc16(0xFFFF, buf, size);                                     /* get crc */
+    buf[size + 0] = (uint8_t)(crc >> 0);                                          /* set crc */
+    buf[size + 1] = (uint8_t)(crc >> 8);                                          /* set crc */
+    *len = (uint16_t)(size + 2);                                                  /* set used size */
+
+    return 0;                                                                     /* success return 0 */
+}
+
+/**
+ * @brief      parse the capture file header
+ * @param[in]  *buf pointer to a data buffer
+ * @param[in]  len buffer length
+ * @param[out] *header pointer to a capture header structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 header is invalid
+ *             - 2 buf or header is NULL
+ *             - 4 buffer is too short
+ * @note       none
+ */
+uint8_t em4095_capture_parse_header(const uint8_t *buf, uint32_t len, em4095_capture_header_t *header)
+{
+    if ((buf == NULL) || (header == NULL))                               /* check the params */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (len < EM4095_CAPTURE_HEADER_SIZE)                                /* check the length */
+    {
+        return 4;                                                        /* return error */
+    }
+    if (memcmp(buf, gs_magic, 4) != 0)                                   /* check the magic */
+    {
+        return 1;                                                        /* return error */
+    }
+    if ((buf[4] != EM4095_CAPTURE_VERSION) ||
+        (buf[5] < EM4095_CAPTURE_HEADER_SIZE))                           /* check the version */
+    {
+        return 1;                                                        /* return error */
+    }
+
+    header->version = buf[4];                                            /* get version */
+    header->mode = buf[6];                                               /* get mode */
+    header->div = a_capture_get_u32(&buf[8]);                            /* get div */
+    header->tick_hz = a_capture_get_u32(&buf[12]);                       /* get tick rate */
+    header->clock_hz = a_capture_get_u32(&buf[16]);                      /* get clock rate */
+    header->reader_id = a_capture_get_u32(&buf[20]);                     /* get reader id */
+    if ((header->div == 0) || (header->tick_hz == 0) ||
+        (header->clock_hz == 0))                                         /* check the rates */
+    {
+        return 1;                                                        /* return error */
+    }
+
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief      parse one frame block
+ * @param[in]  *buf pointer to a data buffer
+ * @param[in]  len buffer length
+ * @param[out] *frame pointer to a capture frame structure
+ * @param[out] *used pointer to a used length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 block is invalid
+ *             - 2 buf, frame or used is NULL
+ *             - 4 buffer is too short
+ * @note       the frame payload points into buf, nothing is copied
+ */
+uint8_t em4095_capture_parse_frame(const uint8_t *buf, uint32_t len, em4095_capture_frame_t *frame, uint32_t *used)
+{
+    uint16_t size;
+    uint16_t crc;
+
+    if ((buf == NULL) || (frame == NULL) || (used == NULL))                          /* check the params */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (len < EM4095_CAPTURE_FRAME_OVERHEAD)                                         /* check the length */
+    {
+        return 4;                                                                    /* return error */
+    }
+    if ((buf[0] != EM4095_CAPTURE_TAG_FRAME) || (buf[1] > 1))                        /* check the tag */
+    {
+        return 1;                                                                    /* return error */
+    }
+    size = (uint16_t)((uint16_t)buf[4] | ((uint16_t)buf[5] << 8));                   /* get payload size */
+    if ((uint32_t)size + EM4095_CAPTURE_FRAME_OVERHEAD > len)                        /* check the length */
+    {
+        return 4;                                                                    /* return error */
+    }
+    crc = (uint16_t)((uint16_t)buf[6 + size] | ((uint16_t)buf[7 + size] << 8));     /* get crc */
+    if (crc != a_capture_crc16(0xFFFF, buf, (uint32_t)size + 6))                     /* check crc */
+    {
+        return 1;                                                                    /* return error */
+    }
+
+    frame->level = buf[1];                                                           /* get first level */
+    frame->count = (uint16_t)((uint16_t)buf[2] | ((uint16_t)buf[3] << 8));           /* get count */
+    frame->size = size;                                                              /* get payload size */
+    frame->payload = &buf[6];                                                        /* point to payload */
+    *used = (uint32_t)size + EM4095_CAPTURE_FRAME_OVERHEAD;                          /* set used size */
+
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief         get the next run duration of a frame
+ * @param[in]     *frame pointer to a capture frame structure
+ * @param[in,out] *offset pointer to a payload offset buffer
+ * @param[out]    *duration pointer to a duration buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 payload is invalid
+ *                - 2 frame, offset or duration is NULL
+ *                - 4 no more runs
+ * @note          start with *offset = 0
+ */
+uint8_t em4095_capture_next_run(const em4095_capture_frame_t *frame, uint16_t *offset, uint32_t *duration)
+{
+    uint8_t shift;
+    uint32_t value;
+
+    if ((frame == NULL) || (offset == NULL) || (duration == NULL))        /* check the params */
+    {
+        return 2;                                                         /* return error */
+    }
+    if ((*offset) >= frame->size)                                         /* check the end */
+    {
+        return 4;                                                         /* return error */
+    }
+
+    value = 0;                                                            /* init 0 */
+    shift = 0;                                                            /* init 0 */
+    while ((*offset) < frame->size)                                       /* decode the varint */
+    {
+        uint8_t b;
+
+        b = frame->payload[*offset];                                      /* get byte */
+        (*offset)++;                                                      /* offset++ */
+        value |= (uint32_t)(b & 0x7F) << shift;                           /* add 7 bits */
+        if ((b & 0x80) == 0)                                              /* check the last byte */
+        {
+            *duration = value;                                            /* set duration */
+
+            return 0;                                                     /* success return 0 */
+        }
+        shift += 7;                                                       /* next 7 bits */
+        if (shift > 28)                                                   /* check the overflow */
+        {
+            return 1;                                                     /* return error */
+        }
+    }
+
+    return 1;                                                             /* return error */
+}
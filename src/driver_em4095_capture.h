@@ -0,0 +1,177 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_capture.h
+ * @brief     driver em4095 capture header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_EM4095_CAPTURE_H
+#define DRIVER_EM4095_CAPTURE_H
+
+#include "driver_em4095.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup em4095_capture_driver em4095 capture driver function
+ * @brief    em4095 capture driver modules
+ * @ingroup  em4095_driver
+ * @details  a capture is a file header followed by any number of frame blocks, all fields are little endian.
+ *           file header (24 bytes):
+ *           - magic "EM95" (4), version (1), header size (1), mode (1), reserved (1)
+ *           - div (4), tick rate in Hz of the durations (4), clock irq rate in Hz (4), reader id (4)
+ *           frame block (8 bytes + payload):
+ *           - tag (1), level of the first run (1), run count (2), payload size (2)
+ *           - payload: run count durations in ticks, each one coded as an unsigned LEB128 varint
+ *           - crc16 ccitt false of the tag, level, run count, payload size and payload (2)
+ *           a run is the time between two DEMOD_OUT edges, so the level toggles after each run.
+ * @{
+ */
+
+/**
+ * @brief em4095 capture definition
+ */
+#define EM4095_CAPTURE_VERSION               0x01                                           /**< format version */
+#define EM4095_CAPTURE_HEADER_SIZE           24                                             /**< file header size */
+#define EM4095_CAPTURE_FRAME_OVERHEAD        8                                              /**< frame block overhead */
+#define EM4095_CAPTURE_TAG_FRAME             0x01                                           /**< frame block tag */
+#define EM4095_CAPTURE_FRAME_MAX_SIZE        (EM4095_CAPTURE_FRAME_OVERHEAD + \
+                                              5 * EM4095_MAX_LENGTH)                        /**< max frame block size */
+
+/**
+ * @brief em4095 capture header structure definition
+ */
+typedef struct em4095_capture_header_s
+{
+    uint8_t version;           /**< format version */
+    uint8_t mode;              /**< capture mode */
+    uint32_t div;              /**< irq div */
+    uint32_t tick_hz;          /**< duration tick rate */
+    uint32_t clock_hz;         /**< clock irq rate */
+    uint32_t reader_id;        /**< reader id */
+} em4095_capture_header_t;
+
+/**
+ * @brief em4095 capture frame structure definition
+ */
+typedef struct em4095_capture_frame_s
+{
+    uint8_t level;                 /**< level of the first run */
+    uint16_t count;                /**< run count */
+    uint16_t size;                 /**< payload size */
+    const uint8_t *payload;        /**< pointer to the coded durations */
+} em4095_capture_frame_t;
+
+/**
+ * @brief      encode the capture file header
+ * @param[in]  *header pointer to a capture header structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  *len pointer to a length buffer
+ * @param[out] *len pointer to a length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is too small
+ *             - 2 header or buf is NULL
+ * @note       *len is the buffer size on input and the used size on output
+ */
+uint8_t em4095_capture_encode_header(const em4095_capture_header_t *header, uint8_t *buf, uint16_t *len);
+
+/**
+ * @brief      encode a decode buffer as a frame block
+ * @param[in]  *decode pointer to a decode buffer
+ * @param[in]  decode_len decode buffer length
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  *len pointer to a length buffer
+ * @param[out] *len pointer to a length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is too small
+ *             - 2 decode or buf is NULL
+ *             - 4 decode_len is 0
+ * @note       the decode diff_us must be valid, the last sample lasts as long as the one before it
+ */
+uint8_t em4095_capture_encode_frame(const em4095_decode_t *decode, uint16_t decode_len, uint8_t *buf, uint16_t *len);
+
+/**
+ * @brief      parse the capture file header
+ * @param[in]  *buf pointer to a data buffer
+ * @param[in]  len buffer length
+ * @param[out] *header pointer to a capture header structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 header is invalid
+ *             - 2 buf or header is NULL
+ *             - 4 buffer is too short
+ * @note       none
+ */
+uint8_t em4095_capture_parse_header(const uint8_t *buf, uint32_t len, em4095_capture_header_t *header);
+
+/**
+ * @brief      parse one frame block
+ * @param[in]  *buf pointer to a data buffer
+ * @param[in]  len buffer length
+ * @param[out] *frame pointer to a capture frame structure
+ * @param[out] *used pointer to a used length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 block is invalid
+ *             - 2 buf, frame or used is NULL
+ *             - 4 buffer is too short
+ * @note       the frame payload points into buf, nothing is copied
+ */
+uint8_t em4095_capture_parse_frame(const uint8_t *buf, uint32_t len, em4095_capture_frame_t *frame, uint32_t *used);
+
+/**
+ * @brief         get the next run duration of a frame
+ * @param[in]     *frame pointer to a capture frame structure
+ * @param[in,out] *offset pointer to a payload offset buffer
+ * @param[out]    *duration pointer to a duration buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 payload is invalid
+ *                - 2 frame, offset or duration is NULL
+ *                - 4 no more runs
+ * @note          start with *offset = 0
+ */
+uint8_t em4095_capture_next_run(const em4095_capture_frame_t *frame, uint16_t *offset, uint32_t *duration);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,364 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_em4100.c
+ * @brief     driver em4095 em4100 source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_em4095_em4100.h"
+
+/**
+ * @brief      check a raw em4100 frame
+ * @param[in]  raw raw frame, the first bit is the msb
+ * @param[out] *data pointer to a 40 bits data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 frame is invalid
+ * @note       none
+ */
+static uint8_t a_em4100_check(uint64_t raw, uint64_t *data)
+{
+    uint8_t r;
+    uint8_t col;
+    uint64_t d;
+
+    if ((raw >> 55) != 0x1FF)                                        /* check 9 header ones */
+    {
+        return 1;                                                    /* return error */
+    }
+    if ((raw & 0x01) != 0)                                           /* check the stop bit */
+    {
+        return 1;                                                    /* return error */
+    }
+
+    col = 0;                                                         /* init 0 */
+    d = 0;                                                           /* init 0 */
+    for (r = 0; r < 10; r++)                                         /* check 10 rows */
+    {
+        uint8_t row;
+        uint8_t p;
+
+        row = (uint8_t)((raw >> (50 - 5 * r)) & 0x1F);               /* 4 data bits and parity */
+        p = row ^ (row >> 1) ^ (row >> 2) ^ (row >> 3) ^ (row >> 4); /* xor all bits */
+        if ((p & 0x01) != 0)                                         /* check even parity */
+        {
+            return 1;                                                /* return error */
+        }
+        col ^= (uint8_t)(row >> 1);                                  /* column parity */
+        d = (d << 4) | (uint64_t)(row >> 1);                         /* save data */
+    }
+    if ((col ^ (uint8_t)((raw >> 1) & 0x0F)) != 0)                   /* check column parity */
+    {
+        return 1;                                                    /* return error */
+    }
+    *data = d;                                                       /* save data */
+
+    return 0;                                                        /* success return 0 */
+}
+
+/**
+ * @brief     init the em4100 decoder
+ * @param[in] *handle pointer to an em4100 decoder structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      none
+ */
+uint8_t em4095_em4100_init(em4095_em4100_t *handle)
+{
+    if (handle == NULL)        /* check handle */
+    {
+        return 2;              /* return error */
+    }
+
+    handle->raw = 0;           /* init 0 */
+    handle->bits = 0;          /* init 0 */
+
+    return 0;                  /* success return 0 */
+}
+
+/**
+ * @brief      decode a raw em4100 frame
+ * @param[in]  raw raw frame, the first bit is the msb
+ * @param[out] *id pointer to an em4100 id structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 frame is invalid
+ *             - 2 id is NULL
+ * @note       none
+ */
+uint8_t em4095_em4100_decode(uint64_t raw, em4095_em4100_id_t *id)
+{
+    uint64_t data;
+
+    if (id == NULL)                                        /* check id */
+    {
+        return 2;                                          /* return error */
+    }
+
+    if (a_em4100_check(raw, &data) == 0)                   /* check normal polarity */
+    {
+        id->inverted = 0;                                  /* not inverted */
+        id->raw = raw;                                     /* save raw */
+    }
+    else if (a_em4100_check(~raw, &data) == 0)             /* check inverted polarity */
+    {
+        id->inverted = 1;                                  /* inverted */
+        id->raw = ~raw;                                    /* save raw */
+    }
+    else
+    {
+        return 1;                                          /* return error */
+    }
+    id->version = (uint8_t)(data >> 32);                   /* set version */
+    id->id = (uint32_t)(data & 0xFFFFFFFFU);               /* set id */
+
+    return 0;                                              /* success return 0 */
+}
+
+/**
+ * @brief      push one bit to the em4100 decoder
+ * @param[in]  *handle pointer to an em4100 decoder structure
+ * @param[in]  bit pushed bit
+ * @param[out] *id pointer to an em4100 id structure
+ * @return     status code
+ *             - 0 frame decoded
+ *             - 1 no frame
+ *             - 2 handle or id is NULL
+ * @note       constant work per bit, both manchester polarities are checked
+ */
+uint8_t em4095_em4100_push_bit(em4095_em4100_t *handle, uint8_t bit, em4095_em4100_id_t *id)
+{
+    if ((handle == NULL) || (id == NULL))                                 /* check handle */
+    {
+        return 2;                                                         /* return error */
+    }
+
+    handle->raw = (handle->raw << 1) | (uint64_t)(bit & 0x01);            /* shift in */
+    if (handle->bits < EM4095_EM4100_FRAME_BITS)                          /* check the bits */
+    {
+        handle->bits++;                                                   /* bits++ */
+        if (handle->bits < EM4095_EM4100_FRAME_BITS)                      /* not a full frame */
+        {
+            return 1;                                                     /* no frame */
+        }
+    }
+    if (em4095_em4100_decode(handle->raw, id) != 0)                       /* decode */
+    {
+        return 1;                                                         /* no frame */
+    }
+
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief      decode the level samples of a decode buffer
+ * @param[in]  *buf pointer to a decode buffer
+ * @param[in]  len buffer length
+ * @param[in]  samples_per_bit sampled levels per data bit
+ * @param[out] *id pointer to an em4100 id structure
+ * @param[out] *index pointer to a sample index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no frame
+ *             - 2 buf, id or index is NULL
+ *             - 4 samples_per_bit can't be 0
+ * @note       every bit phase is tried, *index is the sample which completes the first frame
+ */
+uint8_t em4095_em4100_decode_buffer(const em4095_decode_t *buf, uint16_t len, uint8_t samples_per_bit,
+                                    em4095_em4100_id_t *id, uint16_t *index)
+{
+    uint8_t phase;
+    uint8_t found;
+    uint16_t i;
+    em4095_em4100_t decoder;
+    em4095_em4100_id_t tmp;
+
+    if ((buf == NULL) || (id == NULL) || (index == NULL))                     /* check the params */
+    {
+        return 2;                                                             /* return error */
+    }
+    if (samples_per_bit == 0)                                                 /* check samples per bit */
+    {
+        return 4;                                                             /* return error */
+    }
+
+    found = 0;                                                                /* init 0 */
+    for (phase = 0; phase < samples_per_bit; phase++)                         /* try every phase */
+    {
+        (void)em4095_em4100_init(&decoder);                                   /* init the decoder */
+        for (i = phase; i < len; i += samples_per_bit)                        /* one sample per bit */
+        {
+            if ((found != 0) && (i >= (*index)))                              /* later than the best */
+            {
+                break;                                                        /* break */
+            }
+            if (em4095_em4100_push_bit(&decoder, buf[i].level, &tmp) == 0)    /* push the bit */
+            {
+                *id = tmp;                                                    /* save id */
+                *index = i;                                                   /* save index */
+                found = 1;                                                    /* flag found */
+
+                break;                                                        /* break */
+            }
+        }
+    }
+
+    return (found != 0) ? 0 : 1;                                              /* return the result */
+}
+
+/**
+ * @brief     init the em4100 frame combiner
+ * @param[in] *handle pointer to an em4100 combiner structure
+ * @param[in] max_frames max voted frames
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 max_frames is invalid
+ * @note      2 <= max_frames <= EM4095_EM4100_MAX_VOTE
+ */
+uint8_t em4095_em4100_combiner_init(em4095_em4100_combiner_t *handle, uint8_t max_frames)
+{
+    if (handle == NULL)                                                    /* check handle */
+    {
+        return 2;                                                          /* return error */
+    }
+    if ((max_frames < 2) || (max_frames > EM4095_EM4100_MAX_VOTE))         /* check max frames */
+    {
+        return 4;                                                          /* return error */
+    }
+
+    handle->raw = 0;                                                       /* init 0 */
+    handle->head = 0;                                                      /* init 0 */
+    handle->count = 0;                                                     /* no bits */
+    handle->max_frames = max_frames;                                       /* set max frames */
+    handle->used = 0;                                                      /* init 0 */
+
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief      push one bit to the em4100 frame combiner
+ * @param[in]  *handle pointer to an em4100 combiner structure
+ * @param[in]  bit pushed bit
+ * @param[in]  confidence bit confidence
+ * @param[out] *id pointer to an em4100 id structure
+ * @return     status code
+ *             - 0 frame decoded
+ *             - 1 no frame
+ *             - 2 handle or id is NULL
+ * @note       when the last 64 bits start with a header and end with a stop bit but fail the parity
+ *             check, the frames before it are aligned 64 bits apart and voted bit by bit weighted by
+ *             the bit confidence, one more frame at a time until the voted frame passes the check.
+ *             handle->used is the number of frames used by the decoded id
+ */
+uint8_t em4095_em4100_combiner_push_bit(em4095_em4100_combiner_t *handle, uint8_t bit, uint8_t confidence,
+                                        em4095_em4100_id_t *id)
+{
+    uint8_t i;
+    uint8_t k;
+    uint8_t frames;
+    uint16_t size;
+    uint16_t start;
+    uint64_t header;
+    int16_t score[EM4095_EM4100_FRAME_BITS];
+
+    if ((handle == NULL) || (id == NULL))                                               /* check handle */
+    {
+        return 2;                                                                       /* return error */
+    }
+
+    size = (uint16_t)handle->max_frames * EM4095_EM4100_FRAME_BITS;                     /* ring size */
+    bit &= 0x01;                                                                        /* one bit */
+    handle->bit[handle->head] = bit;                                                    /* save bit */
+    handle->confidence[handle->head] = confidence;                                      /* save confidence */
+    handle->head = (uint16_t)((handle->head + 1) % size);                               /* next index */
+    if (handle->count < size)                                                           /* not full */
+    {
+        handle->count++;                                                                /* count++ */
+    }
+    handle->raw = (handle->raw << 1) | (uint64_t)bit;                                   /* shift in */
+    if (handle->count < EM4095_EM4100_FRAME_BITS)                                       /* not a full frame */
+    {
+        return 1;                                                                       /* no frame */
+    }
+
+    header = handle->raw >> 55;                                                         /* 9 header bits */
+    if (!(((header == 0x1FF) && ((handle->raw & 0x01) == 0)) ||
+          ((header == 0x000) && ((handle->raw & 0x01) != 0))))                          /* header and stop bit */
+    {
+        return 1;                                                                       /* no frame */
+    }
+    if (em4095_em4100_decode(handle->raw, id) == 0)                                     /* a clean frame */
+    {
+        handle->used = 1;                                                               /* one frame */
+
+        return 0;                                                                       /* success return 0 */
+    }
+
+    frames = (uint8_t)(handle->count / EM4095_EM4100_FRAME_BITS);                       /* frames in the ring */
+    for (i = 0; i < EM4095_EM4100_FRAME_BITS; i++)                                      /* clear the votes */
+    {
+        score[i] = 0;                                                                   /* init 0 */
+    }
+    for (k = 0; k < frames; k++)                                                        /* one more frame */
+    {
+        uint64_t voted;
+
+        start = (uint16_t)((handle->head + size -
+                           (uint16_t)(k + 1) * EM4095_EM4100_FRAME_BITS) % size);       /* frame start */
+        voted = 0;                                                                      /* init 0 */
+        for (i = 0; i < EM4095_EM4100_FRAME_BITS; i++)                                  /* vote every bit */
+        {
+            uint16_t index;
+            int16_t weight;
+
+            index = (uint16_t)((start + i) % size);                                     /* bit index */
+            weight = (int16_t)handle->confidence[index] + 1;                            /* never 0 */
+            score[i] += (handle->bit[index] != 0) ? weight : (int16_t)(-weight);        /* add the vote */
+            if ((score[i] > 0) ||
+                ((score[i] == 0) &&
+                 (((handle->raw >> (EM4095_EM4100_FRAME_BITS - 1 - i)) & 0x01) != 0)))  /* ties go to the newest frame */
+            {
+                voted |= (uint64_t)1 << (EM4095_EM4100_FRAME_BITS - 1 - i);             /* set one */
+            }
+        }
+        if ((k != 0) && (em4095_em4100_decode(voted, id) == 0))                         /* check the voted frame */
+        {
+            handle->used = (uint8_t)(k + 1);                                            /* voted frames */
+
+            return 0;                                                                   /* success return 0 */
+        }
+    }
+
+    return 1;                                                                           /* no frame */
+}
@@ -0,0 +1,187 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_em4100.h
+ * @brief     driver em4095 em4100 header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_EM4095_EM4100_H
+#define DRIVER_EM4095_EM4100_H
+
+#include "driver_em4095.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup em4095_em4100_driver em4095 em4100 driver function
+ * @brief    em4095 em4100 driver modules
+ * @ingroup  em4095_driver
+ * @details  an em4100 frame is 64 bits: 9 header ones, 10 rows of 4 data bits and an even row parity,
+ *           4 even column parity bits and a stop zero.
+ * @{
+ */
+
+/**
+ * @brief em4095 em4100 definition
+ */
+#define EM4095_EM4100_FRAME_BITS        64        /**< frame bits */
+#ifndef EM4095_EM4100_MAX_VOTE
+    #define EM4095_EM4100_MAX_VOTE      5         /**< max voted frames */
+#endif
+
+/**
+ * @brief em4095 em4100 decoder structure definition
+ */
+typedef struct em4095_em4100_s
+{
+    uint64_t raw;        /**< bit shift register, the newest bit is the lsb */
+    uint8_t bits;        /**< valid bits */
+} em4095_em4100_t;
+
+/**
+ * @brief em4095 em4100 id structure definition
+ */
+typedef struct em4095_em4100_id_s
+{
+    uint8_t version;         /**< version or customer id */
+    uint32_t id;             /**< card id */
+    uint8_t inverted;        /**< decoded from the inverted bits */
+    uint64_t raw;            /**< raw frame */
+} em4095_em4100_id_t;
+
+/**
+ * @brief em4095 em4100 combiner structure definition
+ */
+typedef struct em4095_em4100_combiner_s
+{
+    uint8_t bit[EM4095_EM4100_MAX_VOTE * EM4095_EM4100_FRAME_BITS];               /**< last bits */
+    uint8_t confidence[EM4095_EM4100_MAX_VOTE * EM4095_EM4100_FRAME_BITS];        /**< last bit confidence */
+    uint64_t raw;                                                                 /**< last 64 bits, the newest bit is the lsb */
+    uint16_t head;                                                                /**< next bit index */
+    uint16_t count;                                                               /**< valid bits */
+    uint8_t max_frames;                                                           /**< max voted frames */
+    uint8_t used;                                                                 /**< frames used by the last id */
+} em4095_em4100_combiner_t;
+
+/**
+ * @brief     init the em4100 decoder
+ * @param[in] *handle pointer to an em4100 decoder structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      none
+ */
+uint8_t em4095_em4100_init(em4095_em4100_t *handle);
+
+/**
+ * @brief      push one bit to the em4100 decoder
+ * @param[in]  *handle pointer to an em4100 decoder structure
+ * @param[in]  bit pushed bit
+ * @param[out] *id pointer to an em4100 id structure
+ * @return     status code
+ *             - 0 frame decoded
+ *             - 1 no frame
+ *             - 2 handle or id is NULL
+ * @note       constant work per bit, both manchester polarities are checked
+ */
+uint8_t em4095_em4100_push_bit(em4095_em4100_t *handle, uint8_t bit, em4095_em4100_id_t *id);
+
+/**
+ * @brief      decode a raw em4100 frame
+ * @param[in]  raw raw frame, the first bit is the msb
+ * @param[out] *id pointer to an em4100 id structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 frame is invalid
+ *             - 2 id is NULL
+ * @note       none
+ */
+uint8_t em4095_em4100_decode(uint64_t raw, em4095_em4100_id_t *id);
+
+/**
+ * @brief      decode the level samples of a decode buffer
+ * @param[in]  *buf pointer to a decode buffer
+ * @param[in]  len buffer length
+ * @param[in]  samples_per_bit sampled levels per data bit
+ * @param[out] *id pointer to an em4100 id structure
+ * @param[out] *index pointer to a sample index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no frame
+ *             - 2 buf, id or index is NULL
+ *             - 4 samples_per_bit can't be 0
+ * @note       every bit phase is tried, *index is the sample which completes the first frame
+ */
+uint8_t em4095_em4100_decode_buffer(const em4095_decode_t *buf, uint16_t len, uint8_t samples_per_bit,
+                                    em4095_em4100_id_t *id, uint16_t *index);
+
+/**
+ * @brief     init the em4100 frame combiner
+ * @param[in] *handle pointer to an em4100 combiner structure
+ * @param[in] max_frames max voted frames
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 max_frames is invalid
+ * @note      2 <= max_frames <= EM4095_EM4100_MAX_VOTE
+ */
+uint8_t em4095_em4100_combiner_init(em4095_em4100_combiner_t *handle, uint8_t max_frames);
+
+/**
+ * @brief      push one bit to the em4100 frame combiner
+ * @param[in]  *handle pointer to an em4100 combiner structure
+ * @param[in]  bit pushed bit
+ * @param[in]  confidence bit confidence
+ * @param[out] *id pointer to an em4100 id structure
+ * @return     status code
+ *             - 0 frame decoded
+ *             - 1 no frame
+ *             - 2 handle or id is NULL
+ * @note       when the last 64 bits start with a header and end with a stop bit but fail the parity
+ *             check, the frames before it are aligned 64 bits apart and voted bit by bit weighted by
+ *             the bit confidence, one more frame at a time until the voted frame passes the check.
+ *             handle->used is the number of frames used by the decoded id
+ */
+uint8_t em4095_em4100_combiner_push_bit(em4095_em4100_combiner_t *handle, uint8_t bit, uint8_t confidence,
+                                        em4095_em4100_id_t *id);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,492 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_format.c
+ * @brief     driver em4095 format source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#include "driver_em4095_format.h"
+
+/**
+ * @brief em4100 format definition
+ */
+static const em4095_format_t gs_format_em4100 =
+{
+    "em4100", EM4095_SLICER_CODING_MANCHESTER, 64, 9, 0x1FF, 1,
+    3,
+    {
+        {EM4095_FORMAT_CHECK_FIXED, 63, 1, 1, 0},                        /* stop bit */
+        {EM4095_FORMAT_CHECK_PARITY_GROUPS, 9, 50, 5, 0},                /* even row parity */
+        {EM4095_FORMAT_CHECK_PARITY_COLUMNS, 9, 54, 5, 0},               /* even column parity */
+    },
+    2,
+    {
+        {"version", 9, 8, 4, 1},                                         /* version or customer id */
+        {"id", 19, 32, 4, 1},                                            /* card id */
+    },
+};
+
+/**
+ * @brief viking format definition
+ */
+static const em4095_format_t gs_format_viking =
+{
+    "viking", EM4095_SLICER_CODING_MANCHESTER, 64, 24, 0xF20000, 1,
+    1,
+    {
+        {EM4095_FORMAT_CHECK_XOR_WORDS, 0, 64, 8, 0xA8},                 /* xor of all bytes */
+    },
+    1,
+    {
+        {"id", 24, 32, 0, 0},                                            /* card id */
+    },
+};
+
+/**
+ * @brief built in format table definition
+ */
+static const em4095_format_t *const gs_format_builtin[] =
+{
+    &gs_format_em4100,
+    &gs_format_viking,
+};
+
+/**
+ * @brief     get a bit mask
+ * @param[in] n bit number
+ * @return    mask of the n lsbs
+ * @note      0 < n <= 64
+ */
+static uint64_t a_format_mask(uint8_t n)
+{
+    return (n >= 64) ? 0xFFFFFFFFFFFFFFFFULL : ((1ULL << n) - 1);        /* make the mask */
+}
+
+/**
+ * @brief     get the parity of a word
+ * @param[in] v checked word
+ * @return    1 for an odd number of ones
+ * @note      none
+ */
+static uint8_t a_format_parity(uint64_t v)
+{
+    v ^= v >> 32;                      /* fold 32 */
+    v ^= v >> 16;                      /* fold 16 */
+    v ^= v >> 8;                       /* fold 8 */
+    v ^= v >> 4;                       /* fold 4 */
+    v ^= v >> 2;                       /* fold 2 */
+    v ^= v >> 1;                       /* fold 1 */
+
+    return (uint8_t)(v & 0x01);        /* return the parity */
+}
+
+/**
+ * @brief     get some frame bits from the window
+ * @param[in] *engine pointer to a format engine structure
+ * @param[in] len frame bits
+ * @param[in] pos first frame bit
+ * @param[in] n bit number, 0 < n <= 64
+ * @param[in] inv inverted flag
+ * @return    bits, the first bit is the msb
+ * @note      the frame ends at the newest bit
+ */
+static uint64_t a_format_get(const em4095_format_engine_t *engine, uint8_t len, uint8_t pos, uint8_t n, uint8_t inv)
+{
+    uint8_t k;
+    uint64_t v;
+
+    k = (uint8_t)(len - pos - n);                                              /* lsb distance from the newest bit */
+    if (k >= 64)                                                               /* only in the older word */
+    {
+        v = engine->window[0] >> (k - 64);                                     /* get the bits */
+    }
+    else if (k == 0)                                                           /* only in the newer word */
+    {
+        v = engine->window[1];                                                 /* get the bits */
+    }
+    else                                                                       /* both words */
+    {
+        v = (engine->window[1] >> k) | (engine->window[0] << (64 - k));        /* get the bits */
+    }
+    if (inv != 0)                                                              /* inverted */
+    {
+        v = ~v;                                                                /* invert */
+    }
+
+    return v & a_format_mask(n);                                               /* return the bits */
+}
+
+/**
+ * @brief     run one check
+ * @param[in] *engine pointer to a format engine structure
+ * @param[in] *format pointer to a format structure
+ * @param[in] *check pointer to a check structure
+ * @param[in] inv inverted flag
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_format_check(const em4095_format_engine_t *engine, const em4095_format_t *format,
+                              const em4095_format_check_t *check, uint8_t inv)
+{
+    uint8_t c;
+    uint8_t p;
+    uint8_t last;
+    uint16_t pos;
+    uint16_t end;
+    uint64_t acc;
+
+    end = (uint16_t)(check->start + check->length);                                                    /* end of the range */
+    switch (check->type)
+    {
+        case EM4095_FORMAT_CHECK_FIXED :
+        {
+            return (a_format_get(engine, format->bits, check->start, check->length, inv) ==
+                    check->value) ? 0 : 1;                                                             /* compare the bits */
+        }
+        case EM4095_FORMAT_CHECK_PARITY_GROUPS :
+        {
+            for (pos = check->start; pos < end; pos += check->width)                                   /* every group */
+            {
+                if (a_format_parity(a_format_get(engine, format->bits, (uint8_t)pos,
+                                                 check->width, inv)) != check->value)                  /* check the parity */
+                {
+                    return 1;                                                                          /* check failed */
+                }
+            }
+
+            return 0;                                                                                  /* success return 0 */
+        }
+        case EM4095_FORMAT_CHECK_PARITY_COLUMNS :
+        {
+            last = (uint8_t)(check->length % check->width);                                            /* last row bits */
+            last = (last == 0) ? check->width : last;                                                  /* a full last row */
+            for (c = 0; c < last; c++)                                                                 /* every covered column */
+            {
+                p = 0;                                                                                 /* init 0 */
+                for (pos = (uint16_t)(check->start + c); pos < end; pos += check->width)               /* every row */
+                {
+                    p ^= (uint8_t)a_format_get(engine, format->bits, (uint8_t)pos, 1, inv);            /* xor the bit */
+                }
+                if (p != check->value)                                                                 /* check the parity */
+                {
+                    return 1;                                                                          /* check failed */
+                }
+            }
+
+            return 0;                                                                                  /* success return 0 */
+        }
+        case EM4095_FORMAT_CHECK_XOR_WORDS :
+        case EM4095_FORMAT_CHECK_SUM_WORDS :
+        {
+            acc = 0;                                                                                   /* init 0 */
+            for (pos = check->start; pos < end; pos += check->width)                                   /* every word */
+            {
+                if (check->type == EM4095_FORMAT_CHECK_XOR_WORDS)                                      /* xor */
+                {
+                    acc ^= a_format_get(engine, format->bits, (uint8_t)pos, check->width, inv);        /* xor the word */
+                }
+                else                                                                                   /* sum */
+                {
+                    acc += a_format_get(engine, format->bits, (uint8_t)pos, check->width, inv);        /* add the word */
+                }
+            }
+
+            return ((acc & a_format_mask(check->width)) == check->value) ? 0 : 1;                      /* compare the result */
+        }
+        default :
+        {
+            return 0;                                                                                  /* no check */
+        }
+    }
+}
+
+/**
+ * @brief     check a format descriptor
+ * @param[in] *format pointer to a format structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 format is invalid
+ * @note      none
+ */
+static uint8_t a_format_valid(const em4095_format_t *format)
+{
+    uint8_t i;
+    uint16_t span;
+    const em4095_format_check_t *check;
+    const em4095_format_field_t *field;
+
+    if ((format->bits == 0) || (format->bits > EM4095_FORMAT_MAX_BITS))                          /* check the bits */
+    {
+        return 1;                                                                                /* return error */
+    }
+    if ((format->preamble_bits == 0) || (format->preamble_bits > 64) ||
+        (format->preamble_bits > format->bits))                                                  /* check the preamble */
+    {
+        return 1;                                                                                /* return error */
+    }
+    if ((format->checks > EM4095_FORMAT_MAX_CHECKS) ||
+        (format->fields > EM4095_FORMAT_MAX_FIELDS))                                             /* check the number */
+    {
+        return 1;                                                                                /* return error */
+    }
+    for (i = 0; i < format->checks; i++)                                                         /* every check */
+    {
+        check = &format->check[i];                                                               /* get the check */
+        if ((check->length == 0) || (check->width == 0) ||
+            ((uint16_t)(check->start + check->length) > format->bits))                           /* check the range */
+        {
+            return 1;                                                                            /* return error */
+        }
+        if ((check->type == EM4095_FORMAT_CHECK_FIXED) && (check->length > 8))                   /* fixed value is 8 bits */
+        {
+            return 1;                                                                            /* return error */
+        }
+        if (((check->type == EM4095_FORMAT_CHECK_PARITY_GROUPS) ||
+             (check->type == EM4095_FORMAT_CHECK_XOR_WORDS) ||
+             (check->type == EM4095_FORMAT_CHECK_SUM_WORDS)) &&
+            ((check->length % check->width) != 0))                                               /* whole groups */
+        {
+            return 1;                                                                            /* return error */
+        }
+        if (((check->type == EM4095_FORMAT_CHECK_XOR_WORDS) ||
+             (check->type == EM4095_FORMAT_CHECK_SUM_WORDS)) && (check->width > 8))              /* value is 8 bits */
+        {
+            return 1;                                                                            /* return error */
+        }
+        if ((check->type == EM4095_FORMAT_CHECK_PARITY_GROUPS) && (check->width > 64))           /* group in a word */
+        {
+            return 1;                                                                            /* return error */
+        }
+    }
+    for (i = 0; i < format->fields; i++)                                                         /* every field */
+    {
+        field = &format->field[i];                                                               /* get the field */
+        if ((field->length == 0) || (field->length > 64))                                        /* check the length */
+        {
+            return 1;                                                                            /* return error */
+        }
+        span = field->length;                                                                    /* data bits */
+        if (field->group != 0)                                                                   /* skipped bits */
+        {
+            span = (uint16_t)(span + ((field->length - 1) / field->group) * field->skip);        /* add the skips */
+        }
+        if ((uint16_t)(field->start + span) > format->bits)                                      /* check the range */
+        {
+            return 1;                                                                            /* return error */
+        }
+    }
+
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief      get the built in format table
+ * @param[out] **table pointer to a format table buffer
+ * @param[out] *count pointer to a format number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 table or count is NULL
+ * @note       em4100 and viking
+ */
+uint8_t em4095_format_get_builtin(const em4095_format_t *const **table, uint8_t *count)
+{
+    if ((table == NULL) || (count == NULL))                                              /* check the pointers */
+    {
+        return 2;                                                                        /* return error */
+    }
+
+    *table = gs_format_builtin;                                                          /* set the table */
+    *count = (uint8_t)(sizeof(gs_format_builtin) / sizeof(gs_format_builtin[0]));        /* set the count */
+
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     init the format engine
+ * @param[in] *engine pointer to a format engine structure
+ * @param[in] *table pointer to a format table
+ * @param[in] count format number
+ * @param[in] coding slicer coding of the bit stream
+ * @return    status code
+ *            - 0 success
+ *            - 2 engine or table is NULL
+ *            - 4 a format is invalid
+ * @note      every format is checked once here, the formats of another coding are skipped by the
+ *            engine, run one engine per slicer to cover both codings
+ */
+uint8_t em4095_format_init(em4095_format_engine_t *engine, const em4095_format_t *const *table, uint8_t count,
+                           em4095_slicer_coding_t coding)
+{
+    uint8_t i;
+
+    if ((engine == NULL) || (table == NULL))                              /* check the pointers */
+    {
+        return 2;                                                         /* return error */
+    }
+
+    for (i = 0; i < count; i++)                                           /* every format */
+    {
+        if ((table[i] == NULL) || (a_format_valid(table[i]) != 0))        /* check the format */
+        {
+            return 4;                                                     /* return error */
+        }
+    }
+    engine->table = table;                                                /* set the table */
+    engine->count = count;                                                /* set the count */
+    engine->coding = (uint8_t)coding;                                     /* set the coding */
+
+    return em4095_format_reset(engine);                                   /* reset the window */
+}
+
+/**
+ * @brief     reset the format engine
+ * @param[in] *engine pointer to a format engine structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 engine is NULL
+ * @note      call it when the bit stream restarts
+ */
+uint8_t em4095_format_reset(em4095_format_engine_t *engine)
+{
+    if (engine == NULL)           /* check engine */
+    {
+        return 2;                 /* return error */
+    }
+
+    engine->window[0] = 0;        /* init 0 */
+    engine->window[1] = 0;        /* init 0 */
+    engine->bits = 0;             /* init 0 */
+
+    return 0;                     /* success return 0 */
+}
+
+/**
+ * @brief      push one bit to the format engine
+ * @param[in]  *engine pointer to a format engine structure
+ * @param[in]  bit pushed bit
+ * @param[out] *result pointer to a format result structure
+ * @return     status code
+ *             - 0 frame decoded
+ *             - 1 no frame
+ *             - 2 engine or result is NULL
+ * @note       the first matched format of the table wins
+ */
+uint8_t em4095_format_push_bit(em4095_format_engine_t *engine, uint8_t bit, em4095_format_result_t *result)
+{
+    uint8_t i;
+    uint8_t j;
+    uint8_t k;
+    uint8_t inv;
+    uint8_t pos;
+    uint8_t n;
+    uint64_t pre;
+    uint64_t v;
+    const em4095_format_t *f;
+    const em4095_format_field_t *field;
+
+    if ((engine == NULL) || (result == NULL))                                                           /* check the pointers */
+    {
+        return 2;                                                                                       /* return error */
+    }
+
+    engine->window[0] = (engine->window[0] << 1) | (engine->window[1] >> 63);                           /* shift the older word */
+    engine->window[1] = (engine->window[1] << 1) | (uint64_t)(bit & 0x01);                              /* shift in */
+    if (engine->bits < EM4095_FORMAT_MAX_BITS)                                                          /* check the bits */
+    {
+        engine->bits++;                                                                                 /* bits++ */
+    }
+    for (i = 0; i < engine->count; i++)                                                                 /* every format */
+    {
+        f = engine->table[i];                                                                           /* get the format */
+        if ((f->coding != engine->coding) || (engine->bits < f->bits))                                  /* skip it */
+        {
+            continue;                                                                                   /* next format */
+        }
+        pre = a_format_get(engine, f->bits, 0, f->preamble_bits, 0);                                    /* get the preamble */
+        if (pre == f->preamble)                                                                         /* preamble matched */
+        {
+            inv = 0;                                                                                    /* not inverted */
+        }
+        else if ((f->inverted != 0) && ((pre ^ a_format_mask(f->preamble_bits)) == f->preamble))        /* inverted preamble */
+        {
+            inv = 1;                                                                                    /* inverted */
+        }
+        else
+        {
+            continue;                                                                                   /* next format */
+        }
+        for (j = 0; j < f->checks; j++)                                                                 /* every check */
+        {
+            if (a_format_check(engine, f, &f->check[j], inv) != 0)                                      /* run the check */
+            {
+                break;                                                                                  /* failed */
+            }
+        }
+        if (j != f->checks)                                                                             /* a check failed */
+        {
+            continue;                                                                                   /* next format */
+        }
+        for (j = 0; j < f->fields; j++)                                                                 /* every field */
+        {
+            field = &f->field[j];                                                                       /* get the field */
+            if (field->group == 0)                                                                      /* contiguous */
+            {
+                result->field[j] = a_format_get(engine, f->bits, field->start,
+                                                field->length, inv);                                    /* get the field */
+            }
+            else                                                                                        /* skipped bits */
+            {
+                v = 0;                                                                                  /* init 0 */
+                pos = field->start;                                                                     /* first bit */
+                for (k = 0; k < field->length; k = (uint8_t)(k + n))                                    /* every group */
+                {
+                    n = (uint8_t)(field->length - k);                                                   /* left bits */
+                    n = (n > field->group) ? field->group : n;                                          /* group bits */
+                    v = (v << n) | a_format_get(engine, f->bits, pos, n, inv);                          /* append the group */
+                    pos = (uint8_t)(pos + n + field->skip);                                             /* next group */
+                }
+                result->field[j] = v;                                                                   /* set the field */
+            }
+        }
+        result->format = f;                                                                             /* set the format */
+        result->inverted = inv;                                                                         /* set the polarity */
+        result->raw[0] = engine->window[0];                                                             /* set the older bits */
+        result->raw[1] = engine->window[1];                                                             /* set the newer bits */
+
+        return 0;                                                                                       /* frame decoded */
+    }
+
+    return 1;                                                                                           /* no frame */
+}
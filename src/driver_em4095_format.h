@@ -0,0 +1,205 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_format.h
+ * @brief     driver em4095 format header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#ifndef DRIVER_EM4095_FORMAT_H
+#define DRIVER_EM4095_FORMAT_H
+
+#include "driver_em4095_slicer.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup em4095_format_driver em4095 format driver function
+ * @brief    em4095 format driver modules
+ * @ingroup  em4095_driver
+ * @details  a fixed pattern lf format is a preamble, a fixed frame length, some checks and some fields,
+ *           so it is described by a const table entry instead of a hand written state machine. the
+ *           engine keeps the last 128 sliced bits and tests every registered format at each bit,
+ *           a format is only checked further when its preamble matches, so one pass over the bit
+ *           stream covers the whole table. bit 0 of a frame is the first received bit.
+ * @{
+ */
+
+/**
+ * @brief em4095 format definition
+ */
+#define EM4095_FORMAT_MAX_BITS          128        /**< max frame bits */
+#ifndef EM4095_FORMAT_MAX_CHECKS
+    #define EM4095_FORMAT_MAX_CHECKS    4          /**< max checks of a format */
+#endif
+#ifndef EM4095_FORMAT_MAX_FIELDS
+    #define EM4095_FORMAT_MAX_FIELDS    4          /**< max fields of a format */
+#endif
+
+/**
+ * @brief em4095 format check enumeration definition
+ */
+typedef enum
+{
+    EM4095_FORMAT_CHECK_NONE           = 0x00,        /**< no check */
+    EM4095_FORMAT_CHECK_FIXED          = 0x01,        /**< the bits equal the value */
+    EM4095_FORMAT_CHECK_PARITY_GROUPS  = 0x02,        /**< every group of width bits has the value parity */
+    EM4095_FORMAT_CHECK_PARITY_COLUMNS = 0x03,        /**< every column of the width bits rows has the value parity */
+    EM4095_FORMAT_CHECK_XOR_WORDS      = 0x04,        /**< xor of the width bits words equals the value */
+    EM4095_FORMAT_CHECK_SUM_WORDS      = 0x05,        /**< sum of the width bits words equals the value */
+} em4095_format_check_type_t;
+
+/**
+ * @brief em4095 format check structure definition
+ */
+typedef struct em4095_format_check_s
+{
+    uint8_t type;              /**< check type */
+    uint8_t start;             /**< first bit */
+    uint8_t length;            /**< bit length */
+    uint8_t width;             /**< group, row or word width */
+    uint8_t value;             /**< expected value or parity, 0 is even */
+} em4095_format_check_t;
+
+/**
+ * @brief em4095 format field structure definition
+ */
+typedef struct em4095_format_field_s
+{
+    const char *name;          /**< field name */
+    uint8_t start;             /**< first bit */
+    uint8_t length;            /**< data bits, no more than 64 */
+    uint8_t group;             /**< data bits between two skips, 0 means no skip */
+    uint8_t skip;              /**< bits skipped after each group */
+} em4095_format_field_t;
+
+/**
+ * @brief em4095 format structure definition
+ */
+typedef struct em4095_format_s
+{
+    const char *name;                                            /**< format name */
+    uint8_t coding;                                              /**< slicer coding */
+    uint8_t bits;                                                /**< frame bits */
+    uint8_t preamble_bits;                                       /**< preamble bits, no more than 64 */
+    uint64_t preamble;                                           /**< preamble, the first bit is the msb */
+    uint8_t inverted;                                            /**< also match the inverted bits */
+    uint8_t checks;                                              /**< check number */
+    em4095_format_check_t check[EM4095_FORMAT_MAX_CHECKS];       /**< checks */
+    uint8_t fields;                                              /**< field number */
+    em4095_format_field_t field[EM4095_FORMAT_MAX_FIELDS];       /**< fields */
+} em4095_format_t;
+
+/**
+ * @brief em4095 format result structure definition
+ */
+typedef struct em4095_format_result_s
+{
+    const em4095_format_t *format;                /**< matched format */
+    uint8_t inverted;                             /**< matched the inverted bits */
+    uint64_t field[EM4095_FORMAT_MAX_FIELDS];     /**< field values */
+    uint64_t raw[2];                              /**< last 128 bits, the newest bit is the lsb of raw[1] */
+} em4095_format_result_t;
+
+/**
+ * @brief em4095 format engine structure definition
+ */
+typedef struct em4095_format_engine_s
+{
+    const em4095_format_t *const *table;        /**< format table */
+    uint8_t count;                              /**< format number */
+    uint8_t coding;                             /**< slicer coding of the bit stream */
+    uint64_t window[2];                         /**< last 128 bits, the newest bit is the lsb of window[1] */
+    uint8_t bits;                               /**< valid bits */
+} em4095_format_engine_t;
+
+/**
+ * @brief      get the built in format table
+ * @param[out] **table pointer to a format table buffer
+ * @param[out] *count pointer to a format number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 table or count is NULL
+ * @note       em4100 and viking
+ */
+uint8_t em4095_format_get_builtin(const em4095_format_t *const **table, uint8_t *count);
+
+/**
+ * @brief     init the format engine
+ * @param[in] *engine pointer to a format engine structure
+ * @param[in] *table pointer to a format table
+ * @param[in] count format number
+ * @param[in] coding slicer coding of the bit stream
+ * @return    status code
+ *            - 0 success
+ *            - 2 engine or table is NULL
+ *            - 4 a format is invalid
+ * @note      every format is checked once here, the formats of another coding are skipped by the
+ *            engine, run one engine per slicer to cover both codings
+ */
+uint8_t em4095_format_init(em4095_format_engine_t *engine, const em4095_format_t *const *table, uint8_t count,
+                           em4095_slicer_coding_t coding);
+
+/**
+ * @brief     reset the format engine
+ * @param[in] *engine pointer to a format engine structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 engine is NULL
+ * @note      call it when the bit stream restarts
+ */
+uint8_t em4095_format_reset(em4095_format_engine_t *engine);
+
+/**
+ * @brief      push one bit to the format engine
+ * @param[in]  *engine pointer to a format engine structure
+ * @param[in]  bit pushed bit
+ * @param[out] *result pointer to a format result structure
+ * @return     status code
+ *             - 0 frame decoded
+ *             - 1 no frame
+ *             - 2 engine or result is NULL
+ * @note       the first matched format of the table wins
+ */
+uint8_t em4095_format_push_bit(em4095_format_engine_t *engine, uint8_t bit, em4095_format_result_t *result);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,350 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_host.c
+ * @brief     driver em4095 host source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#include "driver_em4095_host.h"
+
+/**
+ * @brief     calculate the host crc16
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    crc16
+ * @note      polynomial 0x1021 with the initial value 0xFFFF
+ */
+uint16_t em4095_host_crc16(const uint8_t *buf, uint16_t len)
+{
+    uint16_t crc;
+    uint16_t i;
+    uint8_t j;
+
+    crc = 0xFFFF;                                                                                        /* init value */
+    for (i = 0; i < len; i++)                                                                            /* every byte */
+    {
+        crc = (uint16_t)(crc ^ ((uint16_t)buf[i] << 8));                                                 /* add the byte */
+        for (j = 0; j < 8; j++)                                                                          /* every bit */
+        {
+            crc = ((crc & 0x8000) != 0) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);        /* shift one bit */
+        }
+    }
+
+    return crc;                                                                                          /* return the crc */
+}
+
+/**
+ * @brief     write the header and the crc16 around a payload in place
+ * @param[in] *buf pointer to a frame buffer with the payload behind the header
+ * @param[in] seq sequence number
+ * @param[in] code code with the response flag
+ * @param[in] len payload length
+ * @return    frame length
+ * @note      none
+ */
+static uint16_t a_host_seal(uint8_t *buf, uint8_t seq, uint8_t code, uint16_t len)
+{
+    uint16_t crc;
+
+    buf[0] = EM4095_HOST_SOF;                                           /* set the sof */
+    buf[1] = seq;                                                       /* set the sequence number */
+    buf[2] = code;                                                      /* set the code */
+    buf[3] = (uint8_t)(len & 0xFF);                                     /* length low byte */
+    buf[4] = (uint8_t)(len >> 8);                                       /* length high byte */
+    crc = em4095_host_crc16(&buf[1], (uint16_t)(len + 4));              /* crc from the sequence number */
+    buf[EM4095_HOST_HEADER_LEN + len] = (uint8_t)(crc & 0xFF);          /* crc low byte */
+    buf[EM4095_HOST_HEADER_LEN + len + 1] = (uint8_t)(crc >> 8);        /* crc high byte */
+
+    return (uint16_t)(len + EM4095_HOST_OVERHEAD);                      /* return the frame length */
+}
+
+/**
+ * @brief      build a frame
+ * @param[in]  seq sequence number
+ * @param[in]  code code with the response flag
+ * @param[in]  *data pointer to a payload buffer
+ * @param[in]  len payload length
+ * @param[out] *buf pointer to a frame buffer
+ * @param[in]  size frame buffer size
+ * @param[out] *out pointer to a frame length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is too small
+ *             - 2 buf or out is NULL
+ *             - 4 len is over EM4095_HOST_MAX_PAYLOAD
+ * @note       none
+ */
+uint8_t em4095_host_build(uint8_t seq, uint8_t code, const uint8_t *data, uint16_t len,
+                          uint8_t *buf, uint16_t size, uint16_t *out)
+{
+    if ((buf == NULL) || (out == NULL) || ((data == NULL) && (len != 0)))        /* check the pointers */
+    {
+        return 2;                                                                /* return error */
+    }
+    if (len > EM4095_HOST_MAX_PAYLOAD)                                           /* check the length */
+    {
+        return 4;                                                                /* return error */
+    }
+    if ((uint32_t)len + EM4095_HOST_OVERHEAD > size)                             /* check the size */
+    {
+        return 1;                                                                /* return too small */
+    }
+
+    if (len != 0)
+    {
+        memmove(&buf[EM4095_HOST_HEADER_LEN], data, len);                        /* payload behind the header */
+    }
+    *out = a_host_seal(buf, seq, code, len);                                     /* header and crc */
+
+    return 0;                                                                    /* success return 0 */
+}
+
+/**
+ * @brief      parse a frame in place
+ * @param[in]  *buf pointer to a receive buffer
+ * @param[in]  len received length
+ * @param[out] *frame pointer to a frame structure
+ * @param[out] *used pointer to a used length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 frame is incomplete
+ *             - 2 buf, frame or used is NULL
+ *             - 4 frame is invalid
+ * @note       used is the length to drop from the buffer front, after a success or an invalid
+ *             frame it covers the frame or the bytes skipped to the next sof, an incomplete
+ *             frame keeps its bytes and only drops the garbage before the sof
+ */
+uint8_t em4095_host_parse(const uint8_t *buf, uint16_t len, em4095_host_frame_t *frame, uint16_t *used)
+{
+    uint16_t start;
+    uint16_t plen;
+    uint16_t total;
+    uint16_t crc;
+    const uint8_t *p;
+
+    if ((buf == NULL) || (frame == NULL) || (used == NULL))                     /* check the pointers */
+    {
+        return 2;                                                               /* return error */
+    }
+
+    start = 0;                                                                  /* init 0 */
+    while ((start < len) && (buf[start] != EM4095_HOST_SOF))                    /* find the sof */
+    {
+        start++;                                                                /* skip the garbage */
+    }
+    if (len - start < EM4095_HOST_HEADER_LEN)                                   /* no full header yet */
+    {
+        *used = start;
+
+        return 1;                                                               /* return incomplete */
+    }
+    p = &buf[start];                                                            /* frame start */
+    plen = (uint16_t)(p[3] | ((uint16_t)p[4] << 8));                            /* payload length */
+    if (plen > EM4095_HOST_MAX_PAYLOAD)                                         /* check the length */
+    {
+        *used = (uint16_t)(start + 1);
+
+        return 4;                                                               /* return error */
+    }
+    total = (uint16_t)(plen + EM4095_HOST_OVERHEAD);                            /* frame length */
+    if (len - start < total)                                                    /* wait the rest */
+    {
+        *used = start;
+
+        return 1;                                                               /* return incomplete */
+    }
+    crc = em4095_host_crc16(&p[1], (uint16_t)(plen + 4));                       /* crc from the sequence number */
+    if (crc != (uint16_t)(p[total - 2] | ((uint16_t)p[total - 1] << 8)))        /* check the crc */
+    {
+        *used = (uint16_t)(start + 1);
+
+        return 4;                                                               /* return error */
+    }
+
+    frame->seq = p[1];                                                          /* set the sequence number */
+    frame->code = p[2];                                                         /* set the code */
+    frame->data = &p[EM4095_HOST_HEADER_LEN];                                   /* payload in place */
+    frame->len = plen;                                                          /* set the payload length */
+    frame->crc = crc;                                                           /* set the crc */
+    *used = (uint16_t)(start + total);                                          /* drop the frame */
+
+    return 0;                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     init the host protocol
+ * @param[in] *host pointer to a host structure
+ * @param[in] *command pointer to a command callback
+ * @return    status code
+ *            - 0 success
+ *            - 2 host or command is NULL
+ * @note      the callback runs read, write, capture and config, it writes the response data behind
+ *            the status byte to out and returns an em4095_host_status_t
+ */
+uint8_t em4095_host_init(em4095_host_t *host,
+                         uint8_t (*command)(uint8_t code, const uint8_t *data, uint16_t len,
+                                            uint8_t *out, uint16_t size, uint16_t *out_len))
+{
+    if ((host == NULL) || (command == NULL))                     /* check the pointers */
+    {
+        return 2;                                                /* return error */
+    }
+
+    memset(&host->stats, 0, sizeof(em4095_host_stats_t));        /* clear the counters */
+    host->command = command;                                     /* set the callback */
+    host->last_valid = 0;                                        /* no last response */
+    host->last_len = 0;                                          /* init 0 */
+
+    return 0;                                                    /* success return 0 */
+}
+
+/**
+ * @brief      put a 32 bits little endian word
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  value word
+ * @note       none
+ */
+static void a_host_put32(uint8_t *buf, uint32_t value)
+{
+    buf[0] = (uint8_t)(value & 0xFF);                /* byte 0 */
+    buf[1] = (uint8_t)((value >> 8) & 0xFF);         /* byte 1 */
+    buf[2] = (uint8_t)((value >> 16) & 0xFF);        /* byte 2 */
+    buf[3] = (uint8_t)((value >> 24) & 0xFF);        /* byte 3 */
+}
+
+/**
+ * @brief      handle a request frame
+ * @param[in]  *host pointer to a host structure
+ * @param[in]  *frame pointer to a parsed frame
+ * @param[out] **response pointer to a response pointer
+ * @param[out] *len pointer to a response length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 frame is a response
+ *             - 2 host, frame, response or len is NULL
+ * @note       the response points into the host and stays valid until the next request
+ */
+uint8_t em4095_host_handle(em4095_host_t *host, const em4095_host_frame_t *frame, const uint8_t **response, uint16_t *len)
+{
+    uint8_t status;
+    uint8_t *out;
+    uint16_t size;
+    uint16_t out_len;
+    uint16_t n;
+
+    if ((host == NULL) || (frame == NULL) || (response == NULL) || (len == NULL))                     /* check the pointers */
+    {
+        return 2;                                                                                     /* return error */
+    }
+    if ((frame->code & EM4095_HOST_RESPONSE_FLAG) != 0)                                               /* check the direction */
+    {
+        return 1;                                                                                     /* not a request */
+    }
+
+    if ((host->last_valid != 0) && (frame->seq == host->last_seq) &&
+        (frame->code == host->last_code) && (frame->crc == host->last_crc))                           /* repeated request */
+    {
+        host->stats.repeats++;                                                                        /* count the repeat */
+        *response = host->last;                                                                       /* last response */
+        *len = host->last_len;                                                                        /* last length */
+
+        return 0;                                                                                     /* success return 0 */
+    }
+
+    host->stats.frames++;                                                                             /* count the request */
+    out = &host->last[EM4095_HOST_HEADER_LEN + 1];                                                    /* data behind the status */
+    size = EM4095_HOST_MAX_PAYLOAD - 1;                                                               /* data room */
+    out_len = 0;                                                                                      /* no data */
+    switch (frame->code)
+    {
+        case EM4095_HOST_CODE_PING :
+        {
+            out[0] = EM4095_HOST_VERSION;                                                             /* protocol version */
+            out[1] = (uint8_t)(EM4095_HOST_MAX_PAYLOAD & 0xFF);                                       /* max payload low byte */
+            out[2] = (uint8_t)(EM4095_HOST_MAX_PAYLOAD >> 8);                                         /* max payload high byte */
+            n = (frame->len > size - 3) ? (uint16_t)(size - 3) : frame->len;                          /* echo length */
+            memcpy(&out[3], frame->data, n);                                                          /* echo the data */
+            out_len = (uint16_t)(n + 3);                                                              /* set the length */
+            status = EM4095_HOST_STATUS_OK;                                                           /* success */
+
+            break;
+        }
+        case EM4095_HOST_CODE_STATS :
+        {
+            a_host_put32(&out[0], host->stats.frames);                                                /* frames */
+            a_host_put32(&out[4], host->stats.errors);                                                /* errors */
+            a_host_put32(&out[8], host->stats.repeats);                                               /* repeats */
+            a_host_put32(&out[12], host->stats.unknown);                                              /* unknown */
+            a_host_put32(&out[16], host->stats.failed);                                               /* failed */
+            out_len = 20;                                                                             /* 5 words */
+            status = EM4095_HOST_STATUS_OK;                                                           /* success */
+
+            break;
+        }
+        default :
+        {
+            status = host->command(frame->code, frame->data, frame->len, out, size, &out_len);        /* run the command */
+            if (out_len > size)                                                                       /* check the length */
+            {
+                out_len = 0;                                                                          /* drop the data */
+                status = EM4095_HOST_STATUS_FAILED;                                                   /* failed */
+            }
+            if (status == EM4095_HOST_STATUS_UNKNOWN)                                                 /* check the status */
+            {
+                host->stats.unknown++;                                                                /* count the unknown */
+            }
+            else if (status != EM4095_HOST_STATUS_OK)                                                 /* check the status */
+            {
+                host->stats.failed++;                                                                 /* count the failure */
+            }
+            else
+            {
+                /* success */
+            }
+
+            break;
+        }
+    }
+
+    out[-1] = status;                                                                                 /* set the status */
+    host->last_len = a_host_seal(host->last, frame->seq, (uint8_t)(frame->code | EM4095_HOST_RESPONSE_FLAG),
+                                 (uint16_t)(out_len + 1));                                            /* header and crc */
+    host->last_seq = frame->seq;                                                                      /* save the sequence number */
+    host->last_code = frame->code;                                                                    /* save the code */
+    host->last_crc = frame->crc;                                                                      /* save the crc */
+    host->last_valid = 1;                                                                             /* last response is valid */
+    *response = host->last;                                                                           /* set the response */
+    *len = host->last_len;                                                                            /* set the length */
+
+    return 0;                                                                                         /* success return 0 */
+}
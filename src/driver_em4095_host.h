@@ -0,0 +1,239 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_host.h
+ * @brief     driver em4095 host header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#ifndef DRIVER_EM4095_HOST_H
+#define DRIVER_EM4095_HOST_H
+
+#include "driver_em4095.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup em4095_host_driver em4095 host driver function
+ * @brief    em4095 host driver modules
+ * @ingroup  em4095_driver
+ * @details  a binary request and response protocol for a host test rig. a frame is sof, sequence
+ *           number, code, a 16 bits little endian payload length, the payload and a crc16 of the
+ *           sequence number to the payload end. a response has the code of its request with the
+ *           response flag, its payload starts with a status byte and it carries the sequence
+ *           number of the request. requests are handled in the order they arrive, so a host may
+ *           pipeline many of them and match the responses by the sequence number. a request
+ *           repeated with the same sequence number, code and crc gets the last response again
+ *           without running twice. the parser works in place like the osdp one.
+ *           - ping: any data, echoed behind the protocol version and the max payload.
+ *           - read: 16 bits read length, the response is the read data.
+ *           - write: the data to write.
+ *           - capture: 16 bits read length, the response is a capture frame block.
+ *           - stats: no data, the response is the em4095_host_stats_t words in order.
+ *           - config: a key byte and a 32 bits value to set, or the key only to get,
+ *             the response is the 32 bits value.
+ * @{
+ */
+
+/**
+ * @brief em4095 host definition
+ */
+#define EM4095_HOST_SOF                  0xA5        /**< start of frame */
+#define EM4095_HOST_VERSION              0x01        /**< protocol version */
+#define EM4095_HOST_RESPONSE_FLAG        0x80        /**< code flag of a response */
+#define EM4095_HOST_HEADER_LEN           5           /**< sof, sequence number, code and length */
+#define EM4095_HOST_OVERHEAD             7           /**< header and crc16 */
+#ifndef EM4095_HOST_MAX_PAYLOAD
+    #define EM4095_HOST_MAX_PAYLOAD      2048        /**< max payload length */
+#endif
+
+/**
+ * @brief em4095 host code enumeration definition
+ */
+typedef enum
+{
+    EM4095_HOST_CODE_PING    = 0x01,        /**< link test */
+    EM4095_HOST_CODE_READ    = 0x02,        /**< read data */
+    EM4095_HOST_CODE_WRITE   = 0x03,        /**< write data */
+    EM4095_HOST_CODE_CAPTURE = 0x04,        /**< read a capture frame */
+    EM4095_HOST_CODE_STATS   = 0x05,        /**< protocol counters */
+    EM4095_HOST_CODE_CONFIG  = 0x06,        /**< get or set a config */
+} em4095_host_code_t;
+
+/**
+ * @brief em4095 host status enumeration definition
+ */
+typedef enum
+{
+    EM4095_HOST_STATUS_OK      = 0x00,        /**< success */
+    EM4095_HOST_STATUS_FAILED  = 0x01,        /**< command failed */
+    EM4095_HOST_STATUS_LENGTH  = 0x02,        /**< invalid payload length */
+    EM4095_HOST_STATUS_UNKNOWN = 0x03,        /**< unknown code or config key */
+    EM4095_HOST_STATUS_PARAM   = 0x04,        /**< invalid param */
+} em4095_host_status_t;
+
+/**
+ * @brief em4095 host config key enumeration definition
+ */
+typedef enum
+{
+    EM4095_HOST_CONFIG_DIV        = 0x01,        /**< irq clock div */
+    EM4095_HOST_CONFIG_OVERSAMPLE = 0x02,        /**< oversample times */
+    EM4095_HOST_CONFIG_GLITCH     = 0x03,        /**< glitch filter width */
+    EM4095_HOST_CONFIG_GAP        = 0x04,        /**< read gap periods */
+    EM4095_HOST_CONFIG_PLL        = 0x05,        /**< sampling phase loop shift */
+} em4095_host_config_t;
+
+/**
+ * @brief em4095 host frame structure definition
+ */
+typedef struct em4095_host_frame_s
+{
+    uint8_t seq;                /**< sequence number */
+    uint8_t code;               /**< code with the response flag */
+    const uint8_t *data;        /**< payload in the receive buffer */
+    uint16_t len;               /**< payload length */
+    uint16_t crc;               /**< frame crc16 */
+} em4095_host_frame_t;
+
+/**
+ * @brief em4095 host stats structure definition
+ */
+typedef struct em4095_host_stats_s
+{
+    uint32_t frames;            /**< handled requests */
+    uint32_t errors;            /**< dropped bytes and bad frames */
+    uint32_t repeats;           /**< repeated requests */
+    uint32_t unknown;           /**< unknown codes */
+    uint32_t failed;            /**< failed commands */
+} em4095_host_stats_t;
+
+/**
+ * @brief em4095 host structure definition
+ */
+typedef struct em4095_host_s
+{
+    uint8_t (*command)(uint8_t code, const uint8_t *data, uint16_t len,
+                       uint8_t *out, uint16_t size, uint16_t *out_len);        /**< command callback */
+    em4095_host_stats_t stats;                                                  /**< counters */
+    uint8_t last_valid;                                                         /**< last response is valid */
+    uint8_t last_seq;                                                           /**< sequence number of the last request */
+    uint8_t last_code;                                                          /**< code of the last request */
+    uint16_t last_crc;                                                          /**< crc16 of the last request */
+    uint8_t last[EM4095_HOST_MAX_PAYLOAD + EM4095_HOST_OVERHEAD];               /**< last response */
+    uint16_t last_len;                                                          /**< last response length */
+} em4095_host_t;
+
+/**
+ * @brief     calculate the host crc16
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    crc16
+ * @note      polynomial 0x1021 with the initial value 0xFFFF
+ */
+uint16_t em4095_host_crc16(const uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      build a frame
+ * @param[in]  seq sequence number
+ * @param[in]  code code with the response flag
+ * @param[in]  *data pointer to a payload buffer
+ * @param[in]  len payload length
+ * @param[out] *buf pointer to a frame buffer
+ * @param[in]  size frame buffer size
+ * @param[out] *out pointer to a frame length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is too small
+ *             - 2 buf or out is NULL
+ *             - 4 len is over EM4095_HOST_MAX_PAYLOAD
+ * @note       none
+ */
+uint8_t em4095_host_build(uint8_t seq, uint8_t code, const uint8_t *data, uint16_t len,
+                          uint8_t *buf, uint16_t size, uint16_t *out);
+
+/**
+ * @brief      parse a frame in place
+ * @param[in]  *buf pointer to a receive buffer
+ * @param[in]  len received length
+ * @param[out] *frame pointer to a frame structure
+ * @param[out] *used pointer to a used length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 frame is incomplete
+ *             - 2 buf, frame or used is NULL
+ *             - 4 frame is invalid
+ * @note       used is the length to drop from the buffer front, after a success or an invalid
+ *             frame it covers the frame or the bytes skipped to the next sof, an incomplete
+ *             frame keeps its bytes and only drops the garbage before the sof
+ */
+uint8_t em4095_host_parse(const uint8_t *buf, uint16_t len, em4095_host_frame_t *frame, uint16_t *used);
+
+/**
+ * @brief     init the host protocol
+ * @param[in] *host pointer to a host structure
+ * @param[in] *command pointer to a command callback
+ * @return    status code
+ *            - 0 success
+ *            - 2 host or command is NULL
+ * @note      the callback runs read, write, capture and config, it writes the response data behind
+ *            the status byte to out and returns an em4095_host_status_t
+ */
+uint8_t em4095_host_init(em4095_host_t *host,
+                         uint8_t (*command)(uint8_t code, const uint8_t *data, uint16_t len,
+                                            uint8_t *out, uint16_t size, uint16_t *out_len));
+
+/**
+ * @brief      handle a request frame
+ * @param[in]  *host pointer to a host structure
+ * @param[in]  *frame pointer to a parsed frame
+ * @param[out] **response pointer to a response pointer
+ * @param[out] *len pointer to a response length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 frame is a response
+ *             - 2 host, frame, response or len is NULL
+ * @note       the response points into the host and stays valid until the next request
+ */
+uint8_t em4095_host_handle(em4095_host_t *host, const em4095_host_frame_t *frame, const uint8_t **response, uint16_t *len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,806 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_log.c
+ * @brief     driver em4095 log source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#include "driver_em4095_log.h"
+#if defined(__ICCARM__)
+#include <intrinsics.h>
+#endif
+
+/**
+ * @brief log header definition
+ */
+#define LOG_COMMIT        ((em4095_log_word_t)1 << 31)        /**< record is complete */
+#define LOG_MASK          (EM4095_LOG_WORDS - 1)              /**< ring index mask */
+
+/**
+ * @brief log argument kind enumeration definition
+ */
+typedef enum
+{
+    LOG_KIND_END     = 0x00,                                                                                    /**< unknown conversion, stop */
+    LOG_KIND_NONE    = 0x01,                                                                                    /**< no argument */
+    LOG_KIND_INT     = 0x02,                                                                                    /**< int */
+    LOG_KIND_LONG    = 0x03,                                                                                    /**< long */
+    LOG_KIND_LLONG   = 0x04,                                                                                    /**< long long */
+    LOG_KIND_SIZE    = 0x05,                                                                                    /**< size_t */
+    LOG_KIND_DOUBLE  = 0x06,                                                                                    /**< double */
+    LOG_KIND_STRING  = 0x07,                                                                                    /**< string */
+    LOG_KIND_POINTER = 0x08,                                                                                    /**< pointer */
+} log_kind_t;
+
+/**
+ * @brief log conversion structure definition
+ */
+typedef struct log_spec_s
+{
+    uint8_t len;                                                                                                /**< chars after the percent sign */
+    uint8_t star;                                                                                               /**< '*' width and precision number */
+    log_kind_t kind;                                                                                            /**< argument kind */
+} log_spec_t;
+
+static volatile em4095_log_word_t gs_log_ring[EM4095_LOG_WORDS];                                                /**< log ring */
+static volatile uint32_t gs_log_head;                                                                           /**< reserved words */
+static volatile uint32_t gs_log_tail;                                                                           /**< read words */
+static volatile uint32_t gs_log_dropped;                                                                        /**< dropped records */
+
+/**
+ * @brief     compare and swap
+ * @param[in] *ptr pointer to a value
+ * @param[in] old expected value
+ * @param[in] value new value
+ * @return    1 if swapped, 0 if the value changed
+ * @note      none
+ */
+static uint8_t a_log_cas(volatile uint32_t *ptr, uint32_t old, uint32_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __atomic_compare_exchange_n(ptr, &old, value, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED) ? 1 : 0;        /* ldrex and strex on arm */
+#elif defined(__ICCARM__)
+    if (__LDREX((unsigned long *)ptr) != old)                                                                   /* check the value */
+    {
+        __CLREX();                                                                                              /* clear the monitor */
+
+        return 0;                                                                                               /* return changed */
+    }
+
+    return (__STREX(value, (unsigned long *)ptr) == 0) ? 1 : 0;                                                 /* store exclusive */
+#else
+    #error "em4095 log needs a compare and swap"
+#endif
+}
+
+/**
+ * @brief full memory barrier
+ * @note  none
+ */
+static void a_log_fence(void)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);        /* dmb on arm */
+#elif defined(__ICCARM__)
+    __DMB();                                        /* dmb */
+#endif
+}
+
+/**
+ * @brief      parse a conversion
+ * @param[in]  *fmt pointer to the text after the percent sign
+ * @param[out] *spec pointer to a conversion structure
+ * @note       none
+ */
+static void a_log_spec(const char *fmt, log_spec_t *spec)
+{
+    const char *p;
+    uint8_t size;
+
+    p = fmt;                                                                               /* set the start */
+    spec->star = 0;                                                                        /* no star */
+    while ((*p != '\0') && (strchr("-+ #0", *p) != NULL))                                  /* flags */
+    {
+        p++;                                                                               /* next char */
+    }
+    while (((*p >= '0') && (*p <= '9')) || (*p == '.') || (*p == '*'))                     /* width and precision */
+    {
+        if (*p == '*')                                                                     /* check the star */
+        {
+            spec->star++;                                                                  /* one more int */
+        }
+        p++;                                                                               /* next char */
+    }
+    size = 0;                                                                              /* int */
+    while ((*p == 'h') || (*p == 'l') || (*p == 'z') || (*p == 't') || (*p == 'j'))        /* length */
+    {
+        if (*p == 'l')                                                                     /* check l */
+        {
+            size++;                                                                        /* long or long long */
+        }
+        else if (*p != 'h')                                                                /* check z, t and j */
+        {
+            size = (*p == 'j') ? 2 : 3;                                                    /* intmax_t or size_t */
+        }
+        else
+        {
+            /* char and short are promoted to int */
+        }
+        p++;                                                                               /* next char */
+    }
+    spec->len = (uint8_t)(p - fmt + 1);                                                    /* with the conversion */
+    switch (*p)
+    {
+        case 'd' :
+        case 'i' :
+        case 'u' :
+        case 'x' :
+        case 'X' :
+        case 'o' :
+        {
+            spec->kind = (size == 0) ? LOG_KIND_INT :
+                         (size == 1) ? LOG_KIND_LONG :
+                         (size == 2) ? LOG_KIND_LLONG : LOG_KIND_SIZE;                     /* integer */
+
+            break;
+        }
+        case 'c' :
+        {
+            spec->kind = LOG_KIND_INT;                                                     /* promoted char */
+
+            break;
+        }
+        case 'f' :
+        case 'F' :
+        case 'e' :
+        case 'E' :
+        case 'g' :
+        case 'G' :
+        case 'a' :
+        case 'A' :
+        {
+            spec->kind = LOG_KIND_DOUBLE;                                                  /* promoted float */
+
+            break;
+        }
+        case 's' :
+        {
+            spec->kind = LOG_KIND_STRING;                                                  /* string */
+
+            break;
+        }
+        case 'p' :
+        {
+            spec->kind = LOG_KIND_POINTER;                                                 /* pointer */
+
+            break;
+        }
+        case '%' :
+        {
+            spec->kind = LOG_KIND_NONE;                                                    /* percent sign */
+
+            break;
+        }
+        default :
+        {
+            spec->kind = LOG_KIND_END;                                                     /* %n, long double or broken */
+
+            break;
+        }
+    }
+}
+
+/**
+ * @brief         pack a value
+ * @param[out]    *argv pointer to the argument words
+ * @param[in,out] *argc pointer to the used words
+ * @param[in]     *value pointer to a value
+ * @param[in]     size value size
+ * @return        1 if the value doesn't fit, else 0
+ * @note          none
+ */
+static uint8_t a_log_put(em4095_log_word_t *argv, uint8_t *argc, const void *value, size_t size)
+{
+    uint8_t words;
+
+    words = (uint8_t)((size + sizeof(em4095_log_word_t) - 1) / sizeof(em4095_log_word_t));        /* words of the value */
+    if ((*argc + words) > EM4095_LOG_MAX_ARGS)                                                    /* check the room */
+    {
+        return 1;                                                                                 /* return full */
+    }
+    memcpy(&argv[*argc], value, size);                                                            /* copy the value */
+    *argc = (uint8_t)(*argc + words);                                                             /* add the words */
+
+    return 0;                                                                                     /* success return 0 */
+}
+
+/**
+ * @brief         unpack a value
+ * @param[in]     *record pointer to a record structure
+ * @param[in,out] *argi pointer to the read words
+ * @param[out]    *value pointer to a value
+ * @param[in]     size value size
+ * @return        1 if the record is short, else 0
+ * @note          none
+ */
+static uint8_t a_log_get(const em4095_log_record_t *record, uint8_t *argi, void *value, size_t size)
+{
+    uint8_t words;
+
+    words = (uint8_t)((size + sizeof(em4095_log_word_t) - 1) / sizeof(em4095_log_word_t));        /* words of the value */
+    if ((*argi + words) > record->argc)                                                           /* check the words */
+    {
+        return 1;                                                                                 /* return short */
+    }
+    memcpy(value, &record->argv[*argi], size);                                                    /* copy the value */
+    *argi = (uint8_t)(*argi + words);                                                             /* skip the words */
+
+    return 0;                                                                                     /* success return 0 */
+}
+
+/**
+ * @brief     push a record
+ * @param[in] level message level
+ * @param[in] packed 1 for a packed record
+ * @param[in] *fmt pointer to a format
+ * @param[in] argc argument words
+ * @param[in] *argv pointer to the argument words
+ * @return    status code
+ *            - 0 success
+ *            - 1 ring is full
+ * @note      none
+ */
+static uint8_t a_log_push(uint8_t level, uint8_t packed, const char *fmt, uint8_t argc, const em4095_log_word_t *argv)
+{
+    uint32_t head;
+    uint32_t dropped;
+    uint32_t n;
+    uint32_t i;
+
+    n = (uint32_t)argc + 2;                                                         /* header, format and arguments */
+    do
+    {
+        head = gs_log_head;                                                         /* get the head */
+        if ((uint32_t)(head + n - gs_log_tail) > EM4095_LOG_WORDS)                  /* check the room */
+        {
+            do
+            {
+                dropped = gs_log_dropped;                                           /* get the dropped */
+            } while (a_log_cas(&gs_log_dropped, dropped, dropped + 1) == 0);        /* count the record */
+
+            return 1;                                                               /* return full */
+        }
+    } while (a_log_cas(&gs_log_head, head, head + n) == 0);                         /* reserve the words */
+    gs_log_ring[(head + 1) & LOG_MASK] = (em4095_log_word_t)fmt;                    /* set the format */
+    for (i = 0; i < argc; i++)                                                      /* every argument */
+    {
+        gs_log_ring[(head + 2 + i) & LOG_MASK] = argv[i];                           /* set the argument */
+    }
+    a_log_fence();                                                                  /* payload before the header */
+    gs_log_ring[head & LOG_MASK] = LOG_COMMIT | ((em4095_log_word_t)n << 16) |
+                                   ((em4095_log_word_t)packed << 8) | level;        /* commit the record */
+
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief     write a raw record
+ * @param[in] level message level
+ * @param[in] *fmt pointer to a format which outlives the record
+ * @param[in] argc argument words
+ * @param[in] *argv pointer to the argument words
+ * @return    status code
+ *            - 0 success
+ *            - 1 ring is full and the record is dropped
+ *            - 2 fmt is NULL
+ *            - 4 argc is over EM4095_LOG_MAX_ARGS
+ * @note      lock free, it may run in any context
+ */
+uint8_t em4095_log_write(uint8_t level, const char *fmt, uint8_t argc, const em4095_log_word_t *argv)
+{
+    if ((fmt == NULL) || ((argv == NULL) && (argc != 0)))        /* check the pointers */
+    {
+        return 2;                                                /* return error */
+    }
+    if (argc > EM4095_LOG_MAX_ARGS)                              /* check the argc */
+    {
+        return 4;                                                /* return error */
+    }
+
+    return a_log_push(level, 0, fmt, argc, argv);                /* push the record */
+}
+
+/**
+ * @brief     write a packed record
+ * @param[in] level message level
+ * @param[in] *fmt pointer to a format which outlives the record
+ * @param[in] args argument list
+ * @return    status code
+ *            - 0 success
+ *            - 1 ring is full and the record is dropped
+ *            - 2 fmt is NULL
+ * @note      lock free, it may run in any context, the arguments which don't fit in
+ *            EM4095_LOG_MAX_ARGS words are dropped and a string is cut to fit
+ */
+uint8_t em4095_log_vwrite(uint8_t level, const char *fmt, va_list args)
+{
+    em4095_log_word_t argv[EM4095_LOG_MAX_ARGS];
+    log_spec_t spec;
+    const char *p;
+    const char *s;
+    uint8_t argc;
+    uint8_t full;
+    uint8_t i;
+
+    if (fmt == NULL)                                                                                /* check the fmt */
+    {
+        return 2;                                                                                   /* return error */
+    }
+
+    argc = 0;                                                                                       /* no argument */
+    full = 0;                                                                                       /* room left */
+    p = fmt;                                                                                        /* set the format */
+    while ((full == 0) && ((p = strchr(p, '%')) != NULL))                                           /* every conversion */
+    {
+        a_log_spec(p + 1, &spec);                                                                   /* parse the conversion */
+        p += spec.len + 1;                                                                          /* skip the conversion */
+        for (i = 0; (i < spec.star) && (full == 0); i++)                                            /* width and precision */
+        {
+            int star = va_arg(args, int);
+
+            full = a_log_put(argv, &argc, &star, sizeof(star));                                     /* pack the int */
+        }
+        if (full != 0)                                                                              /* check the room */
+        {
+            break;                                                                                  /* break */
+        }
+        switch (spec.kind)
+        {
+            case LOG_KIND_INT :
+            {
+                int v = va_arg(args, int);
+
+                full = a_log_put(argv, &argc, &v, sizeof(v));                                       /* pack the int */
+
+                break;
+            }
+            case LOG_KIND_LONG :
+            {
+                long v = va_arg(args, long);
+
+                full = a_log_put(argv, &argc, &v, sizeof(v));                                       /* pack the long */
+
+                break;
+            }
+            case LOG_KIND_LLONG :
+            {
+                long long v = va_arg(args, long long);
+
+                full = a_log_put(argv, &argc, &v, sizeof(v));                                       /* pack the long long */
+
+                break;
+            }
+            case LOG_KIND_SIZE :
+            {
+                size_t v = va_arg(args, size_t);
+
+                full = a_log_put(argv, &argc, &v, sizeof(v));                                       /* pack the size */
+
+                break;
+            }
+            case LOG_KIND_DOUBLE :
+            {
+                double v = va_arg(args, double);
+
+                full = a_log_put(argv, &argc, &v, sizeof(v));                                       /* pack the double */
+
+                break;
+            }
+            case LOG_KIND_POINTER :
+            {
+                void *v = va_arg(args, void *);
+
+                full = a_log_put(argv, &argc, &v, sizeof(v));                                       /* pack the pointer */
+
+                break;
+            }
+            case LOG_KIND_STRING :
+            {
+                size_t room;
+                size_t len;
+
+                s = va_arg(args, const char *);                                                     /* get the string */
+                if (argc >= EM4095_LOG_MAX_ARGS)                                                    /* check the room */
+                {
+                    full = 1;                                                                       /* no room */
+
+                    break;
+                }
+                room = (size_t)(EM4095_LOG_MAX_ARGS - argc - 1) * sizeof(em4095_log_word_t);        /* bytes left */
+                len = (s == NULL) ? 0 : strlen(s);                                                  /* string length */
+                len = (len > room) ? room : len;                                                    /* cut the string */
+                argv[argc] = (em4095_log_word_t)len;                                                /* set the length */
+                argc++;                                                                             /* length word */
+                if (len != 0)                                                                       /* check the length */
+                {
+                    full = a_log_put(argv, &argc, s, len);                                          /* pack the chars */
+                }
+
+                break;
+            }
+            case LOG_KIND_NONE :
+            {
+                break;
+            }
+            default :
+            {
+                full = 1;                                                                           /* stop */
+
+                break;
+            }
+        }
+    }
+
+    return a_log_push(level, 1, fmt, argc, argv);                                                   /* push the record */
+}
+
+/**
+ * @brief      read the oldest record
+ * @param[out] *record pointer to a record structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 no record
+ *             - 2 record is NULL
+ * @note       only one context may read
+ */
+uint8_t em4095_log_read(em4095_log_record_t *record)
+{
+    em4095_log_word_t header;
+    uint32_t tail;
+    uint32_t n;
+    uint32_t i;
+
+    if (record == NULL)                                                    /* check the record */
+    {
+        return 2;                                                          /* return error */
+    }
+
+    tail = gs_log_tail;                                                    /* get the tail */
+    if (tail == gs_log_head)                                               /* check the ring */
+    {
+        return 1;                                                          /* return empty */
+    }
+    header = gs_log_ring[tail & LOG_MASK];                                 /* get the header */
+    if ((header & LOG_COMMIT) == 0)                                        /* check the commit */
+    {
+        return 1;                                                          /* still being written */
+    }
+    a_log_fence();                                                         /* header before the payload */
+    n = (uint32_t)((header >> 16) & 0xFF);                                 /* record words */
+    record->level = (uint8_t)(header & 0xFF);                              /* set the level */
+    record->packed = (uint8_t)((header >> 8) & 0xFF);                      /* set the packed */
+    record->argc = (uint8_t)(n - 2);                                       /* set the argc */
+    record->fmt = (const char *)gs_log_ring[(tail + 1) & LOG_MASK];        /* set the format */
+    for (i = 0; i < n - 2; i++)                                            /* every argument */
+    {
+        record->argv[i] = gs_log_ring[(tail + 2 + i) & LOG_MASK];          /* copy the argument */
+    }
+    for (i = 0; i < n; i++)                                                /* every word */
+    {
+        gs_log_ring[(tail + i) & LOG_MASK] = 0;                            /* clear the word */
+    }
+    a_log_fence();                                                         /* clear before the release */
+    gs_log_tail = tail + n;                                                /* release the words */
+
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief      format a record
+ * @param[in]  *record pointer to a record structure
+ * @param[out] *buf pointer to a text buffer
+ * @param[in]  len buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 1 text is cut
+ *             - 2 record or buf is NULL
+ * @note       the conversions of the format take the argument words in order
+ */
+uint8_t em4095_log_format(const em4095_log_record_t *record, char *buf, uint16_t len)
+{
+    log_spec_t spec;
+    char conv[32];
+    const char *p;
+    uint16_t pos;
+    uint16_t c;
+    uint8_t argi;
+    uint8_t stop;
+    uint8_t cut;
+    uint8_t i;
+    int res;
+
+    if ((record == NULL) || (buf == NULL) || (len == 0))                                                  /* check the pointers */
+    {
+        return 2;                                                                                         /* return error */
+    }
+
+    pos = 0;                                                                                              /* init 0 */
+    argi = 0;                                                                                             /* first word */
+    stop = 0;                                                                                             /* conversions on */
+    cut = 0;                                                                                              /* not cut */
+    p = record->fmt;                                                                                      /* set the format */
+    while ((*p != '\0') && (pos < len - 1))                                                               /* every char */
+    {
+        if ((*p != '%') || (stop != 0))                                                                   /* check the text */
+        {
+            buf[pos++] = *p++;                                                                            /* copy the char */
+
+            continue;                                                                                     /* next */
+        }
+        a_log_spec(p + 1, &spec);                                                                         /* parse the conversion */
+        if ((spec.kind == LOG_KIND_END) || ((size_t)spec.len + 12 * spec.star + 2 > sizeof(conv)))        /* check the conversion */
+        {
+            stop = 1;                                                                                     /* copy the rest */
+
+            continue;                                                                                     /* next */
+        }
+        c = 0;                                                                                            /* init 0 */
+        conv[c++] = '%';                                                                                  /* percent sign */
+        for (i = 1; i <= spec.len; i++)                                                                   /* every spec char */
+        {
+            if (p[i] == '*')                                                                              /* check the star */
+            {
+                int star;
+
+                if (a_log_get(record, &argi, &star, sizeof(star)) != 0)                                   /* get the int */
+                {
+                    stop = 1;                                                                             /* short record */
+
+                    break;
+                }
+                c = (uint16_t)(c + snprintf(&conv[c], sizeof(conv) - c, "%d", star));                     /* put the number */
+            }
+            else
+            {
+                conv[c++] = p[i];                                                                         /* copy the char */
+            }
+        }
+        if (stop != 0)                                                                                    /* check the stop */
+        {
+            continue;                                                                                     /* copy the rest */
+        }
+        conv[c] = '\0';                                                                                   /* end the conversion */
+        res = 0;                                                                                          /* init 0 */
+        if (record->packed == 0)                                                                          /* raw words */
+        {
+            em4095_log_word_t w;
+
+            if ((spec.kind != LOG_KIND_NONE) && (a_log_get(record, &argi, &w, sizeof(w)) != 0))           /* get the word */
+            {
+                stop = 1;                                                                                 /* short record */
+
+                continue;                                                                                 /* copy the rest */
+            }
+            switch (spec.kind)
+            {
+                case LOG_KIND_INT :
+                {
+                    res = snprintf(&buf[pos], len - pos, conv, (int)w);                                   /* int */
+
+                    break;
+                }
+                case LOG_KIND_LONG :
+                {
+                    res = snprintf(&buf[pos], len - pos, conv, (long)w);                                  /* long */
+
+                    break;
+                }
+                case LOG_KIND_LLONG :
+                {
+                    res = snprintf(&buf[pos], len - pos, conv, (long long)w);                             /* long long */
+
+                    break;
+                }
+                case LOG_KIND_SIZE :
+                {
+                    res = snprintf(&buf[pos], len - pos, conv, (size_t)w);                                /* size */
+
+                    break;
+                }
+                case LOG_KIND_DOUBLE :
+                {
+                    res = snprintf(&buf[pos], len - pos, conv, (double)(intptr_t)w);                      /* integer as double */
+
+                    break;
+                }
+                case LOG_KIND_STRING :
+                {
+                    res = snprintf(&buf[pos], len - pos, conv,
+                                   (w == 0) ? "(null)" : (const char *)w);                                /* string */
+
+                    break;
+                }
+                case LOG_KIND_POINTER :
+                {
+                    res = snprintf(&buf[pos], len - pos, conv, (void *)w);                                /* pointer */
+
+                    break;
+                }
+                default :
+                {
+                    res = snprintf(&buf[pos], len - pos, "%%");                                           /* percent sign */
+
+                    break;
+                }
+            }
+        }
+        else
+        {
+            switch (spec.kind)
+            {
+                case LOG_KIND_INT :
+                {
+                    int v;
+
+                    stop = a_log_get(record, &argi, &v, sizeof(v));                                       /* get the int */
+                    res = (stop != 0) ? 0 : snprintf(&buf[pos], len - pos, conv, v);                      /* int */
+
+                    break;
+                }
+                case LOG_KIND_LONG :
+                {
+                    long v;
+
+                    stop = a_log_get(record, &argi, &v, sizeof(v));                                       /* get the long */
+                    res = (stop != 0) ? 0 : snprintf(&buf[pos], len - pos, conv, v);                      /* long */
+
+                    break;
+                }
+                case LOG_KIND_LLONG :
+                {
+                    long long v;
+
+                    stop = a_log_get(record, &argi, &v, sizeof(v));                                       /* get the long long */
+                    res = (stop != 0) ? 0 : snprintf(&buf[pos], len - pos, conv, v);                      /* long long */
+
+                    break;
+                }
+                case LOG_KIND_SIZE :
+                {
+                    size_t v;
+
+                    stop = a_log_get(record, &argi, &v, sizeof(v));                                       /* get the size */
+                    res = (stop != 0) ? 0 : snprintf(&buf[pos], len - pos, conv, v);                      /* size */
+
+                    break;
+                }
+                case LOG_KIND_DOUBLE :
+                {
+                    double v;
+
+                    stop = a_log_get(record, &argi, &v, sizeof(v));                                       /* get the double */
+                    res = (stop != 0) ? 0 : snprintf(&buf[pos], len - pos, conv, v);                      /* double */
+
+                    break;
+                }
+                case LOG_KIND_POINTER :
+                {
+                    void *v;
+
+                    stop = a_log_get(record, &argi, &v, sizeof(v));                                       /* get the pointer */
+                    res = (stop != 0) ? 0 : snprintf(&buf[pos], len - pos, conv, v);                      /* pointer */
+
+                    break;
+                }
+                case LOG_KIND_STRING :
+                {
+                    char s[EM4095_LOG_MAX_ARGS * sizeof(em4095_log_word_t) + 1];
+                    em4095_log_word_t n;
+
+                    stop = a_log_get(record, &argi, &n, sizeof(n));                                       /* get the length */
+                    if ((stop == 0) && (n >= sizeof(s)))                                                  /* check the length */
+                    {
+                        stop = 1;                                                                         /* broken record */
+                    }
+                    if ((stop == 0) && (n != 0))                                                          /* check the length */
+                    {
+                        stop = a_log_get(record, &argi, s, (size_t)n);                                    /* get the chars */
+                    }
+                    if (stop == 0)                                                                        /* check the stop */
+                    {
+                        s[n] = '\0';                                                                      /* end the string */
+                        res = snprintf(&buf[pos], len - pos, conv, s);                                    /* string */
+                    }
+
+                    break;
+                }
+                default :
+                {
+                    res = snprintf(&buf[pos], len - pos, "%%");                                           /* percent sign */
+
+                    break;
+                }
+            }
+            if (stop != 0)                                                                                /* check the stop */
+            {
+                continue;                                                                                 /* copy the rest */
+            }
+        }
+        if (res < 0)                                                                                      /* check the result */
+        {
+            res = 0;                                                                                      /* nothing written */
+        }
+        if ((uint32_t)pos + (uint32_t)res > (uint32_t)(len - 1))                                          /* check the room */
+        {
+            cut = 1;                                                                                      /* text is cut */
+            pos = (uint16_t)(len - 1);                                                                    /* buffer is full */
+        }
+        else
+        {
+            pos = (uint16_t)(pos + res);                                                                  /* add the text */
+        }
+        p += spec.len + 1;                                                                                /* skip the conversion */
+    }
+    buf[pos] = '\0';                                                                                      /* end the text */
+
+    if ((cut != 0) || (*p != '\0'))                                                                       /* check the cut */
+    {
+        return 1;                                                                                         /* return cut */
+    }
+
+    return 0;                                                                                             /* success return 0 */
+}
+
+/**
+ * @brief  get the free words
+ * @return free word number
+ * @note   a record takes its argument words and 2 more
+ */
+uint32_t em4095_log_get_free(void)
+{
+    uint32_t tail;
+
+    tail = gs_log_tail;                                              /* read the tail before the head */
+
+    return EM4095_LOG_WORDS - (uint32_t)(gs_log_head - tail);        /* return the free words */
+}
+
+/**
+ * @brief  get the dropped records
+ * @return dropped record number
+ * @note   none
+ */
+uint32_t em4095_log_get_dropped(void)
+{
+    return gs_log_dropped;        /* return the dropped */
+}
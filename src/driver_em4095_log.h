@@ -0,0 +1,227 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_log.h
+ * @brief     driver em4095 log header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#ifndef DRIVER_EM4095_LOG_H
+#define DRIVER_EM4095_LOG_H
+
+#include "driver_em4095.h"
+#include <stdarg.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup em4095_log_driver em4095 log driver function
+ * @brief    em4095 log driver modules
+ * @ingroup  em4095_driver
+ * @details  a deferred binary log. a log call stores the format pointer and the raw arguments in a
+ *           lock free ring of words and returns, the formatting runs later in a background context
+ *           which reads the records back. any context may write, a compare and swap on the write
+ *           index reserves the record and the header word is stored last, so a reader never sees a
+ *           half written record. only one context may read. the EM4095_LOG_ERROR to
+ *           EM4095_LOG_DEBUG macros count their arguments at compile time and a message above
+ *           EM4095_LOG_LEVEL compiles to nothing.
+ *           - packed: em4095_log_vwrite walks the format, 64 bits and floating point arguments
+ *             take as many words as they need and a string is copied into the record, so the
+ *             arguments may be temporaries.
+ *           - raw: the macros store every argument as one word, they take integer and pointer
+ *             arguments only and a string argument must outlive the record.
+ * @{
+ */
+
+/**
+ * @brief em4095 log level definition
+ */
+#define EM4095_LOG_LEVEL_NONE         0        /**< no message */
+#define EM4095_LOG_LEVEL_ERROR        1        /**< error message */
+#define EM4095_LOG_LEVEL_WARN         2        /**< warning message */
+#define EM4095_LOG_LEVEL_INFO         3        /**< information message */
+#define EM4095_LOG_LEVEL_DEBUG        4        /**< debug message */
+
+/**
+ * @brief em4095 log definition
+ */
+#ifndef EM4095_LOG_LEVEL
+    #define EM4095_LOG_LEVEL          EM4095_LOG_LEVEL_INFO        /**< max compiled level */
+#endif
+#ifndef EM4095_LOG_WORDS
+    #define EM4095_LOG_WORDS          1024                         /**< ring words, must be a power of 2 */
+#endif
+#define EM4095_LOG_MAX_ARGS           16                           /**< max argument words of a record */
+
+/**
+ * @brief em4095 log word definition
+ */
+typedef uintptr_t em4095_log_word_t;
+
+/**
+ * @brief em4095 log record structure definition
+ */
+typedef struct em4095_log_record_s
+{
+    uint8_t level;                                       /**< message level */
+    uint8_t packed;                                      /**< 1 if written by em4095_log_vwrite */
+    uint8_t argc;                                        /**< argument words */
+    const char *fmt;                                     /**< format */
+    em4095_log_word_t argv[EM4095_LOG_MAX_ARGS];         /**< argument words */
+} em4095_log_record_t;
+
+/**
+ * @brief em4095 log argument counting definition
+ */
+#define EM4095_LOG_W(X)                                   ((em4095_log_word_t)(X))
+#define EM4095_LOG_CAT_(A, B)                             A##B
+#define EM4095_LOG_CAT(A, B)                              EM4095_LOG_CAT_(A, B)
+#define EM4095_LOG_NARG_(A1, A2, A3, A4, A5, A6, A7, N, ...) N
+#define EM4095_LOG_NARG(...)                              EM4095_LOG_NARG_(__VA_ARGS__, 7, 6, 5, 4, 3, 2, 1, 0)
+#define EM4095_LOG_1(L, F)                                em4095_log_write(L, F, 0, NULL)
+#define EM4095_LOG_2(L, F, A)                             em4095_log_write(L, F, 1, (const em4095_log_word_t[]){EM4095_LOG_W(A)})
+#define EM4095_LOG_3(L, F, A, B)                          em4095_log_write(L, F, 2, (const em4095_log_word_t[]){EM4095_LOG_W(A), EM4095_LOG_W(B)})
+#define EM4095_LOG_4(L, F, A, B, C)                       em4095_log_write(L, F, 3, (const em4095_log_word_t[]){EM4095_LOG_W(A), EM4095_LOG_W(B), \
+                                                                                                                 EM4095_LOG_W(C)})
+#define EM4095_LOG_5(L, F, A, B, C, D)                    em4095_log_write(L, F, 4, (const em4095_log_word_t[]){EM4095_LOG_W(A), EM4095_LOG_W(B), \
+                                                                                                                 EM4095_LOG_W(C), EM4095_LOG_W(D)})
+#define EM4095_LOG_6(L, F, A, B, C, D, E)                 em4095_log_write(L, F, 5, (const em4095_log_word_t[]){EM4095_LOG_W(A), EM4095_LOG_W(B), \
+                                                                                                                 EM4095_LOG_W(C), EM4095_LOG_W(D), \
+                                                                                                                 EM4095_LOG_W(E)})
+#define EM4095_LOG_7(L, F, A, B, C, D, E, G)              em4095_log_write(L, F, 6, (const em4095_log_word_t[]){EM4095_LOG_W(A), EM4095_LOG_W(B), \
+                                                                                                                 EM4095_LOG_W(C), EM4095_LOG_W(D), \
+                                                                                                                 EM4095_LOG_W(E), EM4095_LOG_W(G)})
+#define EM4095_LOG_WRITE(L, ...)                          EM4095_LOG_CAT(EM4095_LOG_, EM4095_LOG_NARG(__VA_ARGS__))(L, __VA_ARGS__)
+
+/**
+ * @brief em4095 log level macro definition
+ * @note  a format and up to 6 integer or pointer arguments
+ */
+#if (EM4095_LOG_LEVEL >= EM4095_LOG_LEVEL_ERROR)
+    #define EM4095_LOG_ERROR(...)        (void)EM4095_LOG_WRITE(EM4095_LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+    #define EM4095_LOG_ERROR(...)        ((void)0)
+#endif
+#if (EM4095_LOG_LEVEL >= EM4095_LOG_LEVEL_WARN)
+    #define EM4095_LOG_WARN(...)         (void)EM4095_LOG_WRITE(EM4095_LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+    #define EM4095_LOG_WARN(...)         ((void)0)
+#endif
+#if (EM4095_LOG_LEVEL >= EM4095_LOG_LEVEL_INFO)
+    #define EM4095_LOG_INFO(...)         (void)EM4095_LOG_WRITE(EM4095_LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+    #define EM4095_LOG_INFO(...)         ((void)0)
+#endif
+#if (EM4095_LOG_LEVEL >= EM4095_LOG_LEVEL_DEBUG)
+    #define EM4095_LOG_DEBUG(...)        (void)EM4095_LOG_WRITE(EM4095_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+    #define EM4095_LOG_DEBUG(...)        ((void)0)
+#endif
+
+/**
+ * @brief     write a raw record
+ * @param[in] level message level
+ * @param[in] *fmt pointer to a format which outlives the record
+ * @param[in] argc argument words
+ * @param[in] *argv pointer to the argument words
+ * @return    status code
+ *            - 0 success
+ *            - 1 ring is full and the record is dropped
+ *            - 2 fmt is NULL
+ *            - 4 argc is over EM4095_LOG_MAX_ARGS
+ * @note      lock free, it may run in any context
+ */
+uint8_t em4095_log_write(uint8_t level, const char *fmt, uint8_t argc, const em4095_log_word_t *argv);
+
+/**
+ * @brief     write a packed record
+ * @param[in] level message level
+ * @param[in] *fmt pointer to a format which outlives the record
+ * @param[in] args argument list
+ * @return    status code
+ *            - 0 success
+ *            - 1 ring is full and the record is dropped
+ *            - 2 fmt is NULL
+ * @note      lock free, it may run in any context, the arguments which don't fit in
+ *            EM4095_LOG_MAX_ARGS words are dropped and a string is cut to fit
+ */
+uint8_t em4095_log_vwrite(uint8_t level, const char *fmt, va_list args);
+
+/**
+ * @brief      read the oldest record
+ * @param[out] *record pointer to a record structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 no record
+ *             - 2 record is NULL
+ * @note       only one context may read
+ */
+uint8_t em4095_log_read(em4095_log_record_t *record);
+
+/**
+ * @brief      format a record
+ * @param[in]  *record pointer to a record structure
+ * @param[out] *buf pointer to a text buffer
+ * @param[in]  len buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 1 text is cut
+ *             - 2 record or buf is NULL
+ * @note       the conversions of the format take the argument words in order
+ */
+uint8_t em4095_log_format(const em4095_log_record_t *record, char *buf, uint16_t len);
+
+/**
+ * @brief  get the free words
+ * @return free word number
+ * @note   a record takes its argument words and 2 more
+ */
+uint32_t em4095_log_get_free(void);
+
+/**
+ * @brief  get the dropped records
+ * @return dropped record number
+ * @note   none
+ */
+uint32_t em4095_log_get_dropped(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,1210 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_osdp.c
+ * @brief     driver em4095 osdp source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#include "driver_em4095_osdp.h"
+
+/**
+ * @brief osdp control definition
+ */
+#define OSDP_CTRL_SQN        0x03        /**< sequence number mask */
+#define OSDP_CTRL_CRC        0x04        /**< crc16 instead of the checksum */
+#define OSDP_CTRL_SCB        0x08        /**< security block present */
+#define OSDP_HEADER_LEN      5           /**< som, address, length and control */
+
+/**
+ * @brief osdp crc16 nibble table definition
+ */
+static const uint16_t gs_osdp_crc_table[16] =
+{
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+};
+
+/**
+ * @brief osdp capability table definition
+ */
+static const uint8_t gs_osdp_cap[] =
+{
+    4, 3, 0,                                                               /* card data format, raw and formatted */
+    8, 1, 0,                                                               /* check character, crc16 */
+    9, 0, 0,                                                               /* communication security, set by the pd */
+    10, EM4095_OSDP_MAX_PACKET & 0xFF, EM4095_OSDP_MAX_PACKET >> 8,        /* receive buffer size */
+    11, EM4095_OSDP_MAX_PACKET & 0xFF, EM4095_OSDP_MAX_PACKET >> 8,        /* largest combined message size */
+};
+
+/**
+ * @brief osdp default secure channel base key definition
+ */
+static const uint8_t gs_osdp_scbk_d[EM4095_AES_KEY] =
+{
+    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0x3E, 0x3F,
+};
+
+/**
+ * @brief     calculate the osdp crc16
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    crc16
+ * @note      polynomial 0x1021 with the initial value 0x1D0F
+ */
+uint16_t em4095_osdp_crc16(const uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+    uint16_t crc;
+
+    crc = 0x1D0F;                                                                                      /* initial value */
+    for (i = 0; i < len; i++)                                                                          /* every byte */
+    {
+        crc = (uint16_t)((crc << 4) ^ gs_osdp_crc_table[((crc >> 12) ^ (buf[i] >> 4)) & 0x0F]);        /* high nibble */
+        crc = (uint16_t)((crc << 4) ^ gs_osdp_crc_table[((crc >> 12) ^ buf[i]) & 0x0F]);               /* low nibble */
+    }
+
+    return crc;                                                                                        /* return the crc */
+}
+
+/**
+ * @brief     calculate the osdp checksum
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    checksum
+ * @note      the two's complement of the byte sum
+ */
+static uint8_t a_osdp_checksum(const uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+    uint8_t sum;
+
+    sum = 0;                                  /* init 0 */
+    for (i = 0; i < len; i++)                 /* every byte */
+    {
+        sum = (uint8_t)(sum + buf[i]);        /* add the byte */
+    }
+
+    return (uint8_t)(0x100 - sum);            /* return the checksum */
+}
+
+/**
+ * @brief      frame a packet without its check
+ * @param[in]  address address with the reply flag
+ * @param[in]  sqn sequence number
+ * @param[in]  crc 1 for crc16, 0 for the checksum
+ * @param[in]  *sec pointer to a security block, NULL without a block
+ * @param[in]  code command or reply code
+ * @param[in]  *data pointer to a data buffer
+ * @param[in]  len data length
+ * @param[in]  mac mac bytes to reserve after the data
+ * @param[out] *buf pointer to a packet buffer
+ * @param[in]  size packet buffer size
+ * @param[out] *out pointer to a packet length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is too small
+ * @note       none
+ */
+static uint8_t a_osdp_frame(uint8_t address, uint8_t sqn, uint8_t crc, const uint8_t *sec, uint8_t code,
+                            const uint8_t *data, uint16_t len, uint16_t mac, uint8_t *buf, uint16_t size, uint16_t *out)
+{
+    uint16_t i;
+    uint16_t head;
+    uint16_t total;
+
+    head = (uint16_t)(OSDP_HEADER_LEN + ((sec != NULL) ? sec[0] : 0));        /* header and block */
+    total = (uint16_t)(head + 1 + len + mac + ((crc != 0) ? 2 : 1));          /* packet length */
+    if (total > size)                                                         /* check the size */
+    {
+        return 1;                                                             /* return error */
+    }
+
+    buf[0] = EM4095_OSDP_SOM;                                                 /* set the som */
+    buf[1] = address;                                                         /* set the address */
+    buf[2] = (uint8_t)(total & 0xFF);                                         /* set the length lsb */
+    buf[3] = (uint8_t)(total >> 8);                                           /* set the length msb */
+    buf[4] = (uint8_t)((sqn & OSDP_CTRL_SQN) | ((crc != 0) ? OSDP_CTRL_CRC : 0) |
+                       ((sec != NULL) ? OSDP_CTRL_SCB : 0));                  /* set the control */
+    for (i = OSDP_HEADER_LEN; i < head; i++)                                  /* copy the block */
+    {
+        buf[i] = sec[i - OSDP_HEADER_LEN];                                    /* set the block */
+    }
+    buf[head] = code;                                                         /* set the code */
+    for (i = 0; i < len; i++)                                                 /* copy the data */
+    {
+        buf[head + 1 + i] = data[i];                                          /* set the data */
+    }
+    *out = total;                                                             /* set the length */
+
+    return 0;                                                                 /* success return 0 */
+}
+
+/**
+ * @brief      seal a framed packet with its check
+ * @param[out] *buf pointer to a packet buffer
+ * @param[in]  total packet length
+ * @param[in]  crc 1 for crc16, 0 for the checksum
+ * @note       none
+ */
+static void a_osdp_seal(uint8_t *buf, uint16_t total, uint8_t crc)
+{
+    uint16_t c;
+
+    if (crc != 0)                                                            /* crc16 */
+    {
+        c = em4095_osdp_crc16(buf, (uint16_t)(total - 2));                   /* get the crc */
+        buf[total - 2] = (uint8_t)(c & 0xFF);                                /* set the crc lsb */
+        buf[total - 1] = (uint8_t)(c >> 8);                                  /* set the crc msb */
+    }
+    else
+    {
+        buf[total - 1] = a_osdp_checksum(buf, (uint16_t)(total - 1));        /* set the checksum */
+    }
+}
+
+/**
+ * @brief      build a packet
+ * @param[in]  address address with the reply flag
+ * @param[in]  sqn sequence number
+ * @param[in]  crc 1 for crc16, 0 for the checksum
+ * @param[in]  code command or reply code
+ * @param[in]  *data pointer to a data buffer
+ * @param[in]  len data length
+ * @param[out] *buf pointer to a packet buffer
+ * @param[in]  size packet buffer size
+ * @param[out] *out pointer to a packet length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is too small
+ *             - 2 buf or out is NULL
+ * @note       none
+ */
+uint8_t em4095_osdp_build(uint8_t address, uint8_t sqn, uint8_t crc, uint8_t code, const uint8_t *data,
+                          uint16_t len, uint8_t *buf, uint16_t size, uint16_t *out)
+{
+    if ((buf == NULL) || (out == NULL) || ((data == NULL) && (len != 0)))                      /* check the pointers */
+    {
+        return 2;                                                                              /* return error */
+    }
+    if (a_osdp_frame(address, sqn, crc, NULL, code, data, len, 0, buf, size, out) != 0)        /* frame the packet */
+    {
+        return 1;                                                                              /* return error */
+    }
+    a_osdp_seal(buf, *out, crc);                                                               /* set the check */
+
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      build a packet with a security block
+ * @param[in]  address address with the reply flag
+ * @param[in]  sqn sequence number
+ * @param[in]  *sec pointer to a security block, length, type and data
+ * @param[in]  code command or reply code
+ * @param[in]  *data pointer to a data buffer
+ * @param[in]  len data length
+ * @param[out] *buf pointer to a packet buffer
+ * @param[in]  size packet buffer size
+ * @param[out] *out pointer to a packet length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is too small
+ *             - 2 sec, buf or out is NULL
+ *             - 4 security block is invalid
+ * @note       the handshake packets of the secure channel, always with the crc16
+ */
+uint8_t em4095_osdp_build_block(uint8_t address, uint8_t sqn, const uint8_t *sec, uint8_t code, const uint8_t *data,
+                                uint16_t len, uint8_t *buf, uint16_t size, uint16_t *out)
+{
+    if ((sec == NULL) || (buf == NULL) || (out == NULL) || ((data == NULL) && (len != 0)))        /* check the pointers */
+    {
+        return 2;                                                                                 /* return error */
+    }
+    if (sec[0] < 2)                                                                               /* check the block length */
+    {
+        return 4;                                                                                 /* return error */
+    }
+    if (a_osdp_frame(address, sqn, 1, sec, code, data, len, 0, buf, size, out) != 0)              /* frame the packet */
+    {
+        return 1;                                                                                 /* return error */
+    }
+    a_osdp_seal(buf, *out, 1);                                                                    /* set the crc */
+
+    return 0;                                                                                     /* success return 0 */
+}
+
+/**
+ * @brief      parse a packet in place
+ * @param[in]  *buf pointer to a receive buffer
+ * @param[in]  len received length
+ * @param[out] *packet pointer to a packet structure
+ * @param[out] *used pointer to a used length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 packet is incomplete
+ *             - 2 buf, packet or used is NULL
+ *             - 4 packet is invalid
+ * @note       used is the length to drop from the buffer front, after a success or an invalid
+ *             packet it covers the packet or the bytes skipped to the next som, an incomplete
+ *             packet keeps its bytes and only drops the garbage before the som
+ */
+uint8_t em4095_osdp_parse(const uint8_t *buf, uint16_t len, em4095_osdp_packet_t *packet, uint16_t *used)
+{
+    uint16_t start;
+    uint16_t total;
+    uint16_t head;
+    uint16_t tail;
+    const uint8_t *p;
+
+    if ((buf == NULL) || (packet == NULL) || (used == NULL))                  /* check the pointers */
+    {
+        return 2;                                                             /* return error */
+    }
+
+    start = 0;                                                                /* init 0 */
+    while ((start < len) && (buf[start] != EM4095_OSDP_SOM))                  /* find the som */
+    {
+        start++;                                                              /* skip the garbage */
+    }
+    if (len - start < OSDP_HEADER_LEN)                                        /* no full header yet */
+    {
+        *used = start;                                                        /* drop the garbage */
+
+        return 1;                                                             /* return incomplete */
+    }
+    p = &buf[start];                                                          /* packet start */
+    total = (uint16_t)(p[2] | ((uint16_t)p[3] << 8));                         /* packet length */
+    tail = ((p[4] & OSDP_CTRL_CRC) != 0) ? 2 : 1;                             /* check length */
+    head = OSDP_HEADER_LEN;                                                   /* header length */
+    if ((p[4] & OSDP_CTRL_SCB) != 0)                                          /* security block */
+    {
+        if (len - start < OSDP_HEADER_LEN + 1)                                /* no block length yet */
+        {
+            *used = start;                                                    /* drop the garbage */
+
+            return 1;                                                         /* return incomplete */
+        }
+        if (p[5] < 2)                                                         /* check the block length */
+        {
+            *used = (uint16_t)(start + 1);                                    /* resync after the som */
+
+            return 4;                                                         /* return error */
+        }
+        head = (uint16_t)(head + p[5]);                                       /* skip the block */
+    }
+    if ((total > EM4095_OSDP_MAX_PACKET) || (total < head + 1 + tail))        /* check the length */
+    {
+        *used = (uint16_t)(start + 1);                                        /* resync after the som */
+
+        return 4;                                                             /* return error */
+    }
+    if (len - start < total)                                                  /* wait the rest */
+    {
+        *used = start;                                                        /* drop the garbage */
+
+        return 1;                                                             /* return incomplete */
+    }
+    if (tail == 2)                                                            /* crc16 */
+    {
+        if (em4095_osdp_crc16(p, (uint16_t)(total - 2)) !=
+            (uint16_t)(p[total - 2] | ((uint16_t)p[total - 1] << 8)))         /* check the crc */
+        {
+            *used = (uint16_t)(start + 1);                                    /* resync after the som */
+
+            return 4;                                                         /* return error */
+        }
+    }
+    else
+    {
+        if (a_osdp_checksum(p, (uint16_t)(total - 1)) != p[total - 1])        /* check the checksum */
+        {
+            *used = (uint16_t)(start + 1);                                    /* resync after the som */
+
+            return 4;                                                         /* return error */
+        }
+    }
+
+    packet->address = p[1];                                                   /* set the address */
+    packet->sqn = p[4] & OSDP_CTRL_SQN;                                       /* set the sequence number */
+    packet->crc = (tail == 2) ? 1 : 0;                                        /* set the check type */
+    packet->scb = ((p[4] & OSDP_CTRL_SCB) != 0) ? 1 : 0;                      /* set the security flag */
+    packet->code = p[head];                                                   /* set the code */
+    packet->data = &p[head + 1];                                              /* data in place */
+    packet->len = (uint16_t)(total - head - 1 - tail);                        /* set the data length */
+    packet->som = p;                                                          /* packet in place */
+    packet->sec = (packet->scb != 0) ? &p[OSDP_HEADER_LEN] : NULL;            /* block in place */
+    *used = (uint16_t)(start + total);                                        /* drop the packet */
+
+    return 0;                                                                 /* success return 0 */
+}
+
+/**
+ * @brief      derive a session key
+ * @param[in]  *scbk pointer to a base key
+ * @param[in]  type key type byte
+ * @param[in]  *rnd_a pointer to the panel random
+ * @param[out] *key pointer to a 16 bytes key buffer
+ * @note       aes of 01, type and the first 6 random bytes under the base key
+ */
+static void a_osdp_sc_derive(const uint8_t *scbk, uint8_t type, const uint8_t *rnd_a, uint8_t *key)
+{
+    uint8_t i;
+    em4095_aes_t aes;
+
+    key[0] = 0x01;                                /* set the prefix */
+    key[1] = type;                                /* set the key type */
+    for (i = 0; i < 6; i++)                       /* copy the random */
+    {
+        key[2 + i] = rnd_a[i];                    /* set the random */
+    }
+    for (i = 8; i < EM4095_AES_BLOCK; i++)        /* pad the block */
+    {
+        key[i] = 0;                               /* set 0 */
+    }
+    (void)em4095_aes_init(&aes, scbk);            /* expand the base key */
+    (void)em4095_aes_encrypt(&aes, key);          /* encrypt the block */
+}
+
+/**
+ * @brief      encrypt two randoms into a cryptogram
+ * @param[in]  *key pointer to a key
+ * @param[in]  *first pointer to the first random
+ * @param[in]  *second pointer to the second random
+ * @param[out] *out pointer to a 16 bytes cryptogram buffer
+ * @note       none
+ */
+static void a_osdp_sc_cryptogram(const uint8_t *key, const uint8_t *first, const uint8_t *second, uint8_t *out)
+{
+    uint8_t i;
+    em4095_aes_t aes;
+
+    for (i = 0; i < EM4095_OSDP_RND_LEN; i++)            /* copy the randoms */
+    {
+        out[i] = first[i];                               /* set the first random */
+        out[EM4095_OSDP_RND_LEN + i] = second[i];        /* set the second random */
+    }
+    (void)em4095_aes_init(&aes, key);                    /* expand the key */
+    (void)em4095_aes_encrypt(&aes, out);                 /* encrypt the block */
+}
+
+/**
+ * @brief      calculate the mac of a packet
+ * @param[in]  *sc pointer to a secure channel structure
+ * @param[in]  *buf pointer to a packet buffer
+ * @param[in]  len length before the mac
+ * @param[in]  *chain pointer to the last mac of the peer
+ * @param[out] *mac pointer to a 16 bytes mac buffer
+ * @note       cbc over the packet padded with 0x80, s-mac1 for the leading blocks and s-mac2 for
+ *             the last one
+ */
+static void a_osdp_sc_mac(const em4095_osdp_sc_t *sc, const uint8_t *buf, uint16_t len, const uint8_t *chain, uint8_t *mac)
+{
+    uint16_t i;
+    uint16_t pos;
+    uint8_t j;
+    uint8_t first;
+    em4095_aes_t aes;
+
+    for (j = 0; j < EM4095_AES_BLOCK; j++)                   /* every byte */
+    {
+        mac[j] = chain[j];                                   /* chain from the peer */
+    }
+    first = 1;                                               /* leading key first */
+    for (pos = 0; pos < len; pos += EM4095_AES_BLOCK)        /* every block */
+    {
+        for (j = 0; j < EM4095_AES_BLOCK; j++)               /* every byte */
+        {
+            i = (uint16_t)(pos + j);                         /* byte index */
+            if (i < len)                                     /* packet byte */
+            {
+                mac[j] ^= buf[i];                            /* chain the byte */
+            }
+            else if (i == len)                               /* end of the packet */
+            {
+                mac[j] ^= 0x80;                              /* chain the pad marker */
+            }
+            else
+            {
+                /* zero pad */
+            }
+        }
+        if (pos + EM4095_AES_BLOCK >= len)                   /* last block */
+        {
+            (void)em4095_aes_init(&aes, sc->s_mac2);         /* expand s-mac2 */
+        }
+        else if (first != 0)                                 /* first leading block */
+        {
+            (void)em4095_aes_init(&aes, sc->s_mac1);         /* expand s-mac1 */
+            first = 0;                                       /* keep it */
+        }
+        else
+        {
+            /* s-mac1 is expanded */
+        }
+        (void)em4095_aes_encrypt(&aes, mac);                 /* encrypt the block */
+    }
+}
+
+/**
+ * @brief     init a secure channel
+ * @param[in] *sc pointer to a secure channel structure
+ * @param[in] *scbk pointer to a 16 bytes base key, NULL for the default key scbk-d
+ * @return    status code
+ *            - 0 success
+ *            - 2 sc is NULL
+ * @note      the default key is for the install mode only
+ */
+uint8_t em4095_osdp_sc_init(em4095_osdp_sc_t *sc, const uint8_t *scbk)
+{
+    uint8_t i;
+
+    if (sc == NULL)                                                        /* check the pointer */
+    {
+        return 2;                                                          /* return error */
+    }
+
+    sc->state = EM4095_OSDP_SC_NONE;                                       /* no session */
+    sc->key = (scbk != NULL) ? 1 : 0;                                      /* set the key selector */
+    for (i = 0; i < EM4095_AES_KEY; i++)                                   /* copy the key */
+    {
+        sc->scbk[i] = (scbk != NULL) ? scbk[i] : gs_osdp_scbk_d[i];        /* set the base key */
+        sc->c_mac[i] = 0;                                                  /* init 0 */
+        sc->r_mac[i] = 0;                                                  /* init 0 */
+    }
+
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief      start a session
+ * @param[in]  *sc pointer to a secure channel structure
+ * @param[in]  *rnd_a pointer to the 8 bytes panel random
+ * @param[in]  *rnd_b pointer to the 8 bytes pd random
+ * @param[out] *client pointer to a 16 bytes client cryptogram buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 sc, rnd_a, rnd_b or client is NULL
+ * @note       derives s-enc, s-mac1 and s-mac2 from the base key and rnd_a, the session waits
+ *             for the server cryptogram
+ */
+uint8_t em4095_osdp_sc_session(em4095_osdp_sc_t *sc, const uint8_t *rnd_a, const uint8_t *rnd_b, uint8_t *client)
+{
+    uint8_t i;
+
+    if ((sc == NULL) || (rnd_a == NULL) || (rnd_b == NULL) || (client == NULL))        /* check the pointers */
+    {
+        return 2;                                                                      /* return error */
+    }
+
+    for (i = 0; i < EM4095_OSDP_RND_LEN; i++)                                          /* copy the randoms */
+    {
+        sc->rnd_a[i] = rnd_a[i];                                                       /* set the panel random */
+        sc->rnd_b[i] = rnd_b[i];                                                       /* set the pd random */
+    }
+    a_osdp_sc_derive(sc->scbk, 0x82, sc->rnd_a, sc->s_enc);                            /* derive s-enc */
+    a_osdp_sc_derive(sc->scbk, 0x01, sc->rnd_a, sc->s_mac1);                           /* derive s-mac1 */
+    a_osdp_sc_derive(sc->scbk, 0x02, sc->rnd_a, sc->s_mac2);                           /* derive s-mac2 */
+    a_osdp_sc_cryptogram(sc->s_enc, sc->rnd_a, sc->rnd_b, client);                     /* client cryptogram */
+    sc->state = EM4095_OSDP_SC_CHALLENGED;                                             /* wait the server cryptogram */
+
+    return 0;                                                                          /* success return 0 */
+}
+
+/**
+ * @brief      run a session
+ * @param[in]  *sc pointer to a secure channel structure
+ * @param[out] *server pointer to a 16 bytes server cryptogram buffer
+ * @param[out] *rmac_i pointer to a 16 bytes initial reply mac buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no session is started
+ *             - 2 sc, server or rmac_i is NULL
+ * @note       the initial reply mac seeds the mac chain, the caller checks the cryptogram of the
+ *             peer and sets the state back to none when it is wrong
+ */
+uint8_t em4095_osdp_sc_server(em4095_osdp_sc_t *sc, uint8_t *server, uint8_t *rmac_i)
+{
+    uint8_t i;
+    em4095_aes_t aes;
+
+    if ((sc == NULL) || (server == NULL) || (rmac_i == NULL))             /* check the pointers */
+    {
+        return 2;                                                         /* return error */
+    }
+    if (sc->state == EM4095_OSDP_SC_NONE)                                 /* no session */
+    {
+        return 1;                                                         /* return error */
+    }
+
+    a_osdp_sc_cryptogram(sc->s_enc, sc->rnd_b, sc->rnd_a, server);        /* server cryptogram */
+    for (i = 0; i < EM4095_AES_BLOCK; i++)                                /* copy the cryptogram */
+    {
+        rmac_i[i] = server[i];                                            /* set the block */
+    }
+    (void)em4095_aes_init(&aes, sc->s_mac1);                              /* expand s-mac1 */
+    (void)em4095_aes_encrypt(&aes, rmac_i);                               /* encrypt with s-mac1 */
+    (void)em4095_aes_init(&aes, sc->s_mac2);                              /* expand s-mac2 */
+    (void)em4095_aes_encrypt(&aes, rmac_i);                               /* encrypt with s-mac2 */
+    for (i = 0; i < EM4095_AES_BLOCK; i++)                                /* seed the chain */
+    {
+        sc->r_mac[i] = rmac_i[i];                                         /* set the reply mac */
+    }
+    sc->state = EM4095_OSDP_SC_ACTIVE;                                    /* session is running */
+
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief      build a packet in the session
+ * @param[in]  *sc pointer to a secure channel structure
+ * @param[in]  address address with the reply flag
+ * @param[in]  sqn sequence number
+ * @param[in]  code command or reply code
+ * @param[in]  *data pointer to a data buffer
+ * @param[in]  len data length
+ * @param[out] *buf pointer to a packet buffer
+ * @param[in]  size packet buffer size
+ * @param[out] *out pointer to a packet length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is too small or no session is running
+ *             - 2 sc, buf or out is NULL
+ * @note       data is padded and encrypted with s-enc, the mac chains from the last mac of the
+ *             peer and the first 4 bytes go before the crc16
+ */
+uint8_t em4095_osdp_sc_build(em4095_osdp_sc_t *sc, uint8_t address, uint8_t sqn, uint8_t code, const uint8_t *data,
+                             uint16_t len, uint8_t *buf, uint16_t size, uint16_t *out)
+{
+    uint16_t i;
+    uint16_t n;
+    uint8_t reply;
+    uint8_t sec[2];
+    uint8_t iv[EM4095_AES_BLOCK];
+    const uint8_t *chain;
+    uint8_t *mac;
+    em4095_aes_t aes;
+
+    if ((sc == NULL) || (buf == NULL) || (out == NULL) || ((data == NULL) && (len != 0)))        /* check the pointers */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (sc->state != EM4095_OSDP_SC_ACTIVE)                                                      /* no session */
+    {
+        return 1;                                                                                /* return error */
+    }
+    n = (len != 0) ? (uint16_t)((len / EM4095_AES_BLOCK + 1) * EM4095_AES_BLOCK) : 0;            /* padded length */
+    if (n > sizeof(sc->buf))                                                                     /* check the length */
+    {
+        return 1;                                                                                /* return error */
+    }
+
+    reply = ((address & EM4095_OSDP_REPLY_FLAG) != 0) ? 1 : 0;                                   /* reply or command */
+    chain = (reply != 0) ? sc->c_mac : sc->r_mac;                                                /* last mac of the peer */
+    mac = (reply != 0) ? sc->r_mac : sc->c_mac;                                                  /* own mac */
+    if (n != 0)                                                                                  /* encrypt the data */
+    {
+        for (i = 0; i < n; i++)                                                                  /* pad the data */
+        {
+            sc->buf[i] = (i < len) ? data[i] : ((i == len) ? 0x80 : 0x00);                       /* set the byte */
+        }
+        for (i = 0; i < EM4095_AES_BLOCK; i++)                                                   /* make the iv */
+        {
+            iv[i] = (uint8_t)(~chain[i]);                                                        /* complement of the mac */
+        }
+        (void)em4095_aes_init(&aes, sc->s_enc);                                                  /* expand s-enc */
+        (void)em4095_aes_cbc_encrypt(&aes, iv, sc->buf, n);                                      /* encrypt the data */
+    }
+    sec[0] = 2;                                                                                  /* block length */
+    if (reply != 0)                                                                              /* reply */
+    {
+        sec[1] = (n != 0) ? EM4095_OSDP_SCS_18 : EM4095_OSDP_SCS_16;                             /* set the type */
+    }
+    else
+    {
+        sec[1] = (n != 0) ? EM4095_OSDP_SCS_17 : EM4095_OSDP_SCS_15;                             /* set the type */
+    }
+    if (a_osdp_frame(address, sqn, 1, sec, code, sc->buf, n, EM4095_OSDP_MAC_LEN,
+                     buf, size, out) != 0)                                                       /* frame the packet */
+    {
+        return 1;                                                                                /* return error */
+    }
+    a_osdp_sc_mac(sc, buf, (uint16_t)(*out - 2 - EM4095_OSDP_MAC_LEN), chain, mac);              /* chain the mac */
+    for (i = 0; i < EM4095_OSDP_MAC_LEN; i++)                                                    /* copy the mac */
+    {
+        buf[*out - 2 - EM4095_OSDP_MAC_LEN + i] = mac[i];                                        /* set the mac */
+    }
+    a_osdp_seal(buf, *out, 1);                                                                   /* set the crc */
+
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief         check and decrypt a packet of the session
+ * @param[in]     *sc pointer to a secure channel structure
+ * @param[in,out] *packet pointer to a parsed packet
+ * @return        status code
+ *                - 0 success
+ *                - 1 mac is wrong or no session is running
+ *                - 2 sc or packet is NULL
+ *                - 4 packet is not a session packet
+ * @note          the packet data points into the clear buffer of the channel afterwards, a wrong
+ *                mac leaves the chain as it is
+ */
+uint8_t em4095_osdp_sc_unwrap(em4095_osdp_sc_t *sc, em4095_osdp_packet_t *packet)
+{
+    uint16_t i;
+    uint16_t n;
+    uint8_t reply;
+    uint8_t type;
+    uint8_t diff;
+    uint8_t mac[EM4095_AES_BLOCK];
+    uint8_t iv[EM4095_AES_BLOCK];
+    const uint8_t *chain;
+    uint8_t *own;
+    em4095_aes_t aes;
+
+    if ((sc == NULL) || (packet == NULL))                                                            /* check the pointers */
+    {
+        return 2;                                                                                    /* return error */
+    }
+    reply = ((packet->address & EM4095_OSDP_REPLY_FLAG) != 0) ? 1 : 0;                               /* reply or command */
+    if ((packet->sec == NULL) || (packet->som == NULL) || (packet->crc == 0) ||
+        (packet->sec[0] != 2) || (packet->len < EM4095_OSDP_MAC_LEN))                                /* check the packet */
+    {
+        return 4;                                                                                    /* return error */
+    }
+    type = packet->sec[1];                                                                           /* block type */
+    if (((reply != 0) && (type != EM4095_OSDP_SCS_16) && (type != EM4095_OSDP_SCS_18)) ||
+        ((reply == 0) && (type != EM4095_OSDP_SCS_15) && (type != EM4095_OSDP_SCS_17)))              /* check the type */
+    {
+        return 4;                                                                                    /* return error */
+    }
+    n = (uint16_t)(packet->len - EM4095_OSDP_MAC_LEN);                                               /* data length */
+    if ((type == EM4095_OSDP_SCS_17) || (type == EM4095_OSDP_SCS_18))                                /* encrypted data */
+    {
+        if ((n == 0) || ((n % EM4095_AES_BLOCK) != 0) || (n > sizeof(sc->buf)))                      /* check the blocks */
+        {
+            return 4;                                                                                /* return error */
+        }
+    }
+    if (sc->state != EM4095_OSDP_SC_ACTIVE)                                                          /* no session */
+    {
+        return 1;                                                                                    /* return error */
+    }
+
+    chain = (reply != 0) ? sc->c_mac : sc->r_mac;                                                    /* last mac of the peer */
+    own = (reply != 0) ? sc->r_mac : sc->c_mac;                                                      /* mac of the sender */
+    a_osdp_sc_mac(sc, packet->som, (uint16_t)((packet->data - packet->som) + n), chain, mac);        /* calculate the mac */
+    diff = 0;                                                                                        /* init 0 */
+    for (i = 0; i < EM4095_OSDP_MAC_LEN; i++)                                                        /* compare every byte */
+    {
+        diff |= (uint8_t)(mac[i] ^ packet->data[n + i]);                                             /* collect the difference */
+    }
+    if (diff != 0)                                                                                   /* wrong mac */
+    {
+        return 1;                                                                                    /* return error */
+    }
+    if ((type == EM4095_OSDP_SCS_17) || (type == EM4095_OSDP_SCS_18))                                /* encrypted data */
+    {
+        for (i = 0; i < EM4095_AES_BLOCK; i++)                                                       /* make the iv */
+        {
+            iv[i] = (uint8_t)(~chain[i]);                                                            /* complement of the mac */
+        }
+        for (i = 0; i < n; i++)                                                                      /* copy the data */
+        {
+            sc->buf[i] = packet->data[i];                                                            /* set the cipher */
+        }
+        (void)em4095_aes_init(&aes, sc->s_enc);                                                      /* expand s-enc */
+        (void)em4095_aes_cbc_decrypt(&aes, iv, sc->buf, n);                                          /* decrypt the data */
+        while ((n != 0) && (sc->buf[n - 1] == 0x00))                                                 /* strip the zero pad */
+        {
+            n--;                                                                                     /* n-- */
+        }
+        if ((n == 0) || (sc->buf[n - 1] != 0x80))                                                    /* check the pad marker */
+        {
+            return 4;                                                                                /* return error */
+        }
+        n--;                                                                                         /* strip the marker */
+        packet->data = sc->buf;                                                                      /* clear data */
+    }
+    packet->len = n;                                                                                 /* set the data length */
+    for (i = 0; i < EM4095_AES_BLOCK; i++)                                                           /* chain the mac */
+    {
+        own[i] = mac[i];                                                                             /* set the mac */
+    }
+
+    return 0;                                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     init the pd
+ * @param[in] *pd pointer to a pd structure
+ * @param[in] address pd address
+ * @param[in] reader reader number of the card reports
+ * @param[in] *id pointer to an id structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 pd or id is NULL
+ *            - 4 address is invalid
+ * @note      0 <= address < 0x7F
+ */
+uint8_t em4095_osdp_pd_init(em4095_osdp_pd_t *pd, uint8_t address, uint8_t reader, const em4095_osdp_id_t *id)
+{
+    if ((pd == NULL) || (id == NULL))                /* check the pointers */
+    {
+        return 2;                                    /* return error */
+    }
+    if (address >= EM4095_OSDP_BROADCAST)            /* check the address */
+    {
+        return 4;                                    /* return error */
+    }
+
+    pd->address = address;                           /* set the address */
+    pd->reader = reader;                             /* set the reader */
+    pd->id = *id;                                    /* set the id */
+    pd->head = 0;                                    /* init 0 */
+    pd->tail = 0;                                    /* init 0 */
+    pd->last_sqn = 0;                                /* init 0 */
+    pd->last_valid = 0;                              /* no reply */
+    pd->last_len = 0;                                /* init 0 */
+    (void)em4095_osdp_sc_init(&pd->sc, NULL);        /* default key */
+    pd->random = NULL;                               /* secure channel is off */
+    pd->secure = 0;                                  /* no session */
+    pd->packets = 0;                                 /* init 0 */
+    pd->errors = 0;                                  /* init 0 */
+
+    return 0;                                        /* success return 0 */
+}
+
+/**
+ * @brief     set the secure channel of the pd
+ * @param[in] *pd pointer to a pd structure
+ * @param[in] *scbk pointer to a 16 bytes base key, NULL for the default key scbk-d
+ * @param[in] *random pointer to a random function, NULL turns the secure channel off
+ * @return    status code
+ *            - 0 success
+ *            - 2 pd is NULL
+ * @note      random fills len bytes and returns 0 on success, the pd answers a challenge only
+ *            for its own key, a secure channel that is off naks every security block
+ */
+uint8_t em4095_osdp_pd_set_secure(em4095_osdp_pd_t *pd, const uint8_t *scbk, uint8_t (*random)(uint8_t *buf, uint16_t len))
+{
+    if (pd == NULL)                                  /* check the pointer */
+    {
+        return 2;                                    /* return error */
+    }
+
+    (void)em4095_osdp_sc_init(&pd->sc, scbk);        /* set the base key */
+    pd->random = random;                             /* set the random source */
+
+    return 0;                                        /* success return 0 */
+}
+
+/**
+ * @brief     queue a raw card read
+ * @param[in] *pd pointer to a pd structure
+ * @param[in] format raw format
+ * @param[in] *buf pointer to a bit buffer, the first bit is the msb of buf[0]
+ * @param[in] bits bit number
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ *            - 2 pd or buf is NULL
+ *            - 4 bits is invalid
+ * @note      single producer, the reply side is the consumer
+ */
+uint8_t em4095_osdp_pd_push_raw(em4095_osdp_pd_t *pd, em4095_osdp_raw_format_t format, const uint8_t *buf, uint16_t bits)
+{
+    uint8_t i;
+    em4095_osdp_card_t *card;
+
+    if ((pd == NULL) || (buf == NULL))                                   /* check the pointers */
+    {
+        return 2;                                                        /* return error */
+    }
+    if ((bits == 0) || (bits > EM4095_OSDP_MAX_CARD_BYTES * 8))          /* check the bits */
+    {
+        return 4;                                                        /* return error */
+    }
+    if ((uint8_t)(pd->tail - pd->head) >= EM4095_OSDP_CARD_DEPTH)        /* queue is full */
+    {
+        return 1;                                                        /* return error */
+    }
+
+    card = &pd->card[pd->tail & (EM4095_OSDP_CARD_DEPTH - 1)];           /* get the slot */
+    card->code = EM4095_OSDP_REPLY_RAW;                                  /* raw reply */
+    card->format = (uint8_t)format;                                      /* set the format */
+    card->bits = bits;                                                   /* set the bits */
+    for (i = 0; i < (bits + 7) / 8; i++)                                 /* copy the bits */
+    {
+        card->data[i] = buf[i];                                          /* set the data */
+    }
+    if ((bits % 8) != 0)                                                 /* partial last byte */
+    {
+        card->data[i - 1] &= (uint8_t)(0xFF << (8 - (bits % 8)));        /* clear the unused bits */
+    }
+    pd->tail++;                                                          /* publish the card */
+
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief     queue a formatted card read
+ * @param[in] *pd pointer to a pd structure
+ * @param[in] *text pointer to an ascii card number
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ *            - 2 pd or text is NULL
+ *            - 4 text is invalid
+ * @note      single producer, the reply side is the consumer
+ */
+uint8_t em4095_osdp_pd_push_fmt(em4095_osdp_pd_t *pd, const char *text)
+{
+    uint8_t n;
+    em4095_osdp_card_t *card;
+
+    if ((pd == NULL) || (text == NULL))                                  /* check the pointers */
+    {
+        return 2;                                                        /* return error */
+    }
+    n = 0;                                                               /* init 0 */
+    while ((n <= EM4095_OSDP_MAX_CARD_BYTES) && (text[n] != 0))          /* count the characters */
+    {
+        n++;                                                             /* n++ */
+    }
+    if ((n == 0) || (n > EM4095_OSDP_MAX_CARD_BYTES))                    /* check the length */
+    {
+        return 4;                                                        /* return error */
+    }
+    if ((uint8_t)(pd->tail - pd->head) >= EM4095_OSDP_CARD_DEPTH)        /* queue is full */
+    {
+        return 1;                                                        /* return error */
+    }
+
+    card = &pd->card[pd->tail & (EM4095_OSDP_CARD_DEPTH - 1)];           /* get the slot */
+    card->code = EM4095_OSDP_REPLY_FMT;                                  /* fmt reply */
+    card->format = 0;                                                    /* forward read */
+    card->bits = n;                                                      /* set the characters */
+    while (n != 0)                                                       /* copy the characters */
+    {
+        n--;                                                             /* n-- */
+        card->data[n] = (uint8_t)text[n];                                /* set the data */
+    }
+    pd->tail++;                                                          /* publish the card */
+
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief     build the pd reply
+ * @param[in] *pd pointer to a pd structure
+ * @param[in] *packet pointer to a parsed packet
+ * @param[in] code reply code
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @note      the reply is kept for a repeated sequence number
+ */
+static void a_osdp_reply(em4095_osdp_pd_t *pd, const em4095_osdp_packet_t *packet, uint8_t code,
+                         const uint8_t *data, uint16_t len)
+{
+    uint8_t res;
+
+    if (pd->secure != 0)                                                                               /* in the session */
+    {
+        res = em4095_osdp_sc_build(&pd->sc, (uint8_t)(pd->address | EM4095_OSDP_REPLY_FLAG), packet->sqn, code,
+                                   data, len, pd->last, EM4095_OSDP_MAX_PACKET, &pd->last_len);        /* build the secure reply */
+    }
+    else
+    {
+        res = em4095_osdp_build((uint8_t)(pd->address | EM4095_OSDP_REPLY_FLAG), packet->sqn, packet->crc, code,
+                                data, len, pd->last, EM4095_OSDP_MAX_PACKET, &pd->last_len);           /* build the reply */
+    }
+    if (res != 0)                                                                                      /* build failed */
+    {
+        pd->last_len = 0;                                                                              /* no reply */
+    }
+    pd->last_sqn = packet->sqn;                                                                        /* save the sequence number */
+    pd->last_valid = (pd->last_len != 0) ? 1 : 0;                                                      /* set the valid flag */
+}
+
+/**
+ * @brief     build a pd reply with a security block
+ * @param[in] *pd pointer to a pd structure
+ * @param[in] *packet pointer to a parsed packet
+ * @param[in] *sec pointer to a security block
+ * @param[in] code reply code
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @note      the handshake replies, kept for a repeated sequence number
+ */
+static void a_osdp_reply_block(em4095_osdp_pd_t *pd, const em4095_osdp_packet_t *packet, const uint8_t *sec,
+                               uint8_t code, const uint8_t *data, uint16_t len)
+{
+    if (em4095_osdp_build_block((uint8_t)(pd->address | EM4095_OSDP_REPLY_FLAG), packet->sqn, sec, code,
+                                data, len, pd->last, EM4095_OSDP_MAX_PACKET, &pd->last_len) != 0)        /* build the reply */
+    {
+        pd->last_len = 0;                                                                                /* no reply */
+    }
+    pd->last_sqn = packet->sqn;                                                                          /* save the sequence number */
+    pd->last_valid = (pd->last_len != 0) ? 1 : 0;                                                        /* set the valid flag */
+}
+
+/**
+ * @brief         handle a packet with a security block
+ * @param[in]     *pd pointer to a pd structure
+ * @param[in,out] *packet pointer to a parsed packet
+ * @return        status code
+ *                - 0 the command is unwrapped, answer it in the session
+ *                - 1 the reply is built
+ * @note          a challenge for another key, a wrong cryptogram or a wrong mac drops the session
+ *                and gets a nak
+ */
+static uint8_t a_osdp_pd_secure(em4095_osdp_pd_t *pd, em4095_osdp_packet_t *packet)
+{
+    uint8_t i;
+    uint8_t diff;
+    uint8_t sec[3];
+    uint8_t rnd_b[EM4095_OSDP_RND_LEN];
+    uint8_t rmac_i[EM4095_AES_BLOCK];
+    uint8_t buf[2 * EM4095_OSDP_RND_LEN + EM4095_AES_BLOCK];
+
+    if (pd->random == NULL)                                                                               /* secure channel is off */
+    {
+        /* nak below */
+    }
+    else if ((packet->code == EM4095_OSDP_CMD_CHLNG) && (packet->sec[0] == 3) &&
+             (packet->sec[1] == EM4095_OSDP_SCS_11) && (packet->sec[2] == pd->sc.key) &&
+             (packet->len == EM4095_OSDP_RND_LEN))                                                        /* challenge */
+    {
+        pd->sc.state = EM4095_OSDP_SC_NONE;                                                               /* a new session */
+        if (pd->random(rnd_b, EM4095_OSDP_RND_LEN) == 0)                                                  /* get the pd random */
+        {
+            (void)em4095_osdp_sc_session(&pd->sc, packet->data, rnd_b, &buf[16]);                         /* derive the keys */
+            buf[0] = pd->id.vendor[0];                                                                    /* set the client uid vendor */
+            buf[1] = pd->id.vendor[1];                                                                    /* set the client uid vendor */
+            buf[2] = pd->id.vendor[2];                                                                    /* set the client uid vendor */
+            buf[3] = pd->id.model;                                                                        /* set the client uid model */
+            buf[4] = (uint8_t)(pd->id.serial & 0xFF);                                                     /* set the client uid serial */
+            buf[5] = (uint8_t)((pd->id.serial >> 8) & 0xFF);                                              /* set the client uid serial */
+            buf[6] = (uint8_t)((pd->id.serial >> 16) & 0xFF);                                             /* set the client uid serial */
+            buf[7] = (uint8_t)((pd->id.serial >> 24) & 0xFF);                                             /* set the client uid serial */
+            for (i = 0; i < EM4095_OSDP_RND_LEN; i++)                                                     /* copy the random */
+            {
+                buf[8 + i] = rnd_b[i];                                                                    /* set the pd random */
+            }
+            sec[0] = 3;                                                                                   /* block length */
+            sec[1] = EM4095_OSDP_SCS_12;                                                                  /* client cryptogram */
+            sec[2] = pd->sc.key;                                                                          /* key selector */
+            a_osdp_reply_block(pd, packet, sec, EM4095_OSDP_REPLY_CCRYPT, buf, sizeof(buf));              /* ccrypt */
+
+            return 1;                                                                                     /* answered */
+        }
+    }
+    else if ((packet->code == EM4095_OSDP_CMD_SCRYPT) && (packet->sec[0] == 3) &&
+             (packet->sec[1] == EM4095_OSDP_SCS_13) && (packet->len == EM4095_AES_BLOCK) &&
+             (pd->sc.state == EM4095_OSDP_SC_CHALLENGED))                                                 /* server cryptogram */
+    {
+        (void)em4095_osdp_sc_server(&pd->sc, buf, rmac_i);                                                /* expected cryptogram */
+        diff = 0;                                                                                         /* init 0 */
+        for (i = 0; i < EM4095_AES_BLOCK; i++)                                                            /* compare every byte */
+        {
+            diff |= (uint8_t)(buf[i] ^ packet->data[i]);                                                  /* collect the difference */
+        }
+        if (diff == 0)                                                                                    /* panel knows the key */
+        {
+            sec[0] = 3;                                                                                   /* block length */
+            sec[1] = EM4095_OSDP_SCS_14;                                                                  /* initial reply mac */
+            sec[2] = 0x01;                                                                                /* cryptogram accepted */
+            a_osdp_reply_block(pd, packet, sec, EM4095_OSDP_REPLY_RMAC_I, rmac_i, sizeof(rmac_i));        /* rmac_i */
+
+            return 1;                                                                                     /* answered */
+        }
+    }
+    else if (em4095_osdp_sc_unwrap(&pd->sc, packet) == 0)                                                 /* session command */
+    {
+        pd->secure = 1;                                                                                   /* answer in the session */
+
+        return 0;                                                                                         /* dispatch it */
+    }
+    else
+    {
+        /* not a session packet */
+    }
+    pd->sc.state = EM4095_OSDP_SC_NONE;                                                                   /* drop the session */
+    buf[0] = EM4095_OSDP_NAK_SECURE;                                                                      /* condition not met */
+    a_osdp_reply(pd, packet, EM4095_OSDP_REPLY_NAK, buf, 1);                                              /* nak */
+
+    return 1;                                                                                             /* answered */
+}
+
+/**
+ * @brief      handle a command packet
+ * @param[in]  *pd pointer to a pd structure
+ * @param[in]  *packet pointer to a parsed packet
+ * @param[out] **reply pointer to a reply pointer
+ * @param[out] *len pointer to a reply length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 packet is not for the pd
+ *             - 2 pd, packet, reply or len is NULL
+ * @note       the reply points into the pd and stays valid until the next command
+ */
+uint8_t em4095_osdp_pd_handle(em4095_osdp_pd_t *pd, const em4095_osdp_packet_t *packet, const uint8_t **reply, uint16_t *len)
+{
+    uint8_t i;
+    uint8_t n;
+    uint8_t res;
+    uint8_t buf[4 + EM4095_OSDP_MAX_CARD_BYTES];
+    const em4095_osdp_card_t *card;
+    em4095_osdp_packet_t cmd;
+
+    if ((pd == NULL) || (packet == NULL) || (reply == NULL) || (len == NULL))                       /* check the pointers */
+    {
+        return 2;                                                                                   /* return error */
+    }
+    if (((packet->address & EM4095_OSDP_REPLY_FLAG) != 0) ||
+        ((packet->address != pd->address) && (packet->address != EM4095_OSDP_BROADCAST)))           /* not for the pd */
+    {
+        return 1;                                                                                   /* return error */
+    }
+
+    pd->packets++;                                                                                  /* packets++ */
+    if ((packet->sqn != 0) && (pd->last_valid != 0) && (packet->sqn == pd->last_sqn))               /* a retry */
+    {
+        *reply = pd->last;                                                                          /* send the last reply */
+        *len = pd->last_len;                                                                        /* set the length */
+
+        return 0;                                                                                   /* success return 0 */
+    }
+
+    pd->secure = 0;                                                                                 /* plain reply */
+    res = 0;                                                                                        /* init 0 */
+    if (packet->scb != 0)                                                                           /* secure channel */
+    {
+        cmd = *packet;                                                                              /* copy the packet */
+        res = a_osdp_pd_secure(pd, &cmd);                                                           /* handshake or unwrap */
+        packet = &cmd;                                                                              /* clear command */
+    }
+    else
+    {
+        pd->sc.state = EM4095_OSDP_SC_NONE;                                                         /* a plain command ends the session */
+    }
+    if (res != 0)                                                                                   /* answered by the secure channel */
+    {
+        /* reply is built */
+    }
+    else if (packet->code == EM4095_OSDP_CMD_POLL)                                                  /* poll */
+    {
+        if (pd->head != pd->tail)                                                                   /* a card is queued */
+        {
+            card = &pd->card[pd->head & (EM4095_OSDP_CARD_DEPTH - 1)];                              /* get the card */
+            buf[0] = pd->reader;                                                                    /* set the reader */
+            buf[1] = card->format;                                                                  /* set the format or direction */
+            if (card->code == EM4095_OSDP_REPLY_RAW)                                                /* raw */
+            {
+                buf[2] = (uint8_t)(card->bits & 0xFF);                                              /* set the bits lsb */
+                buf[3] = (uint8_t)(card->bits >> 8);                                                /* set the bits msb */
+                n = (uint8_t)((card->bits + 7) / 8);                                                /* data bytes */
+                for (i = 0; i < n; i++)                                                             /* copy the bits */
+                {
+                    buf[4 + i] = card->data[i];                                                     /* set the data */
+                }
+                n = (uint8_t)(n + 4);                                                               /* reply length */
+            }
+            else
+            {
+                buf[2] = (uint8_t)card->bits;                                                       /* set the characters */
+                n = (uint8_t)card->bits;                                                            /* data bytes */
+                for (i = 0; i < n; i++)                                                             /* copy the characters */
+                {
+                    buf[3 + i] = card->data[i];                                                     /* set the data */
+                }
+                n = (uint8_t)(n + 3);                                                               /* reply length */
+            }
+            a_osdp_reply(pd, packet, card->code, buf, n);                                           /* card reply */
+            pd->head++;                                                                             /* free the card */
+        }
+        else
+        {
+            a_osdp_reply(pd, packet, EM4095_OSDP_REPLY_ACK, NULL, 0);                               /* ack */
+        }
+    }
+    else if (packet->code == EM4095_OSDP_CMD_ID)                                                    /* id */
+    {
+        buf[0] = pd->id.vendor[0];                                                                  /* set the vendor */
+        buf[1] = pd->id.vendor[1];                                                                  /* set the vendor */
+        buf[2] = pd->id.vendor[2];                                                                  /* set the vendor */
+        buf[3] = pd->id.model;                                                                      /* set the model */
+        buf[4] = pd->id.version;                                                                    /* set the version */
+        buf[5] = (uint8_t)(pd->id.serial & 0xFF);                                                   /* set the serial */
+        buf[6] = (uint8_t)((pd->id.serial >> 8) & 0xFF);                                            /* set the serial */
+        buf[7] = (uint8_t)((pd->id.serial >> 16) & 0xFF);                                           /* set the serial */
+        buf[8] = (uint8_t)((pd->id.serial >> 24) & 0xFF);                                           /* set the serial */
+        buf[9] = pd->id.firmware[0];                                                                /* set the firmware major */
+        buf[10] = pd->id.firmware[1];                                                               /* set the firmware minor */
+        buf[11] = pd->id.firmware[2];                                                               /* set the firmware build */
+        a_osdp_reply(pd, packet, EM4095_OSDP_REPLY_PDID, buf, 12);                                  /* id report */
+    }
+    else if (packet->code == EM4095_OSDP_CMD_CAP)                                                   /* capabilities */
+    {
+        for (i = 0; i < sizeof(gs_osdp_cap); i++)                                                   /* copy the capabilities */
+        {
+            buf[i] = gs_osdp_cap[i];                                                                /* set the capability */
+        }
+        buf[7] = (pd->random != NULL) ? 1 : 0;                                                      /* aes-128 */
+        buf[8] = (pd->random != NULL) ? 1 : 0;                                                      /* default key */
+        a_osdp_reply(pd, packet, EM4095_OSDP_REPLY_PDCAP, buf, sizeof(gs_osdp_cap));                /* capabilities report */
+    }
+    else if (packet->code == EM4095_OSDP_CMD_LSTAT)                                                 /* local status */
+    {
+        buf[0] = 0;                                                                                 /* no tamper */
+        buf[1] = 0;                                                                                 /* power is normal */
+        a_osdp_reply(pd, packet, EM4095_OSDP_REPLY_LSTATR, buf, 2);                                 /* local status report */
+    }
+    else
+    {
+        buf[0] = EM4095_OSDP_NAK_UNKNOWN;                                                           /* unknown command */
+        a_osdp_reply(pd, packet, EM4095_OSDP_REPLY_NAK, buf, 1);                                    /* nak */
+    }
+    if (pd->last_valid == 0)                                                                        /* build failed */
+    {
+        pd->errors++;                                                                               /* errors++ */
+
+        return 1;                                                                                   /* return error */
+    }
+    *reply = pd->last;                                                                              /* set the reply */
+    *len = pd->last_len;                                                                            /* set the length */
+
+    return 0;                                                                                       /* success return 0 */
+}
@@ -0,0 +1,450 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_osdp.h
+ * @brief     driver em4095 osdp header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#ifndef DRIVER_EM4095_OSDP_H
+#define DRIVER_EM4095_OSDP_H
+
+#include "driver_em4095_aes.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup em4095_osdp_driver em4095 osdp driver function
+ * @brief    em4095 osdp driver modules
+ * @ingroup  em4095_driver
+ * @details  an osdp peripheral device, the reader side of the open supervised device protocol. a
+ *           packet is som, address, a 16 bits little endian length of the whole packet, control,
+ *           the command or reply code, its data and a crc16 or an 8 bits checksum. the parser works
+ *           in place, a parsed packet points into the receive buffer and nothing is copied. the pd
+ *           answers poll, id, cap and lstat, a queued card read is the reply of the next poll as
+ *           osdp_RAW or osdp_FMT, and a poll repeated with the same sequence number gets the last
+ *           reply again so a lost reply never drops a card. the secure channel runs the osdp_CHLNG,
+ *           osdp_CCRYPT, osdp_SCRYPT and osdp_RMAC_I handshake, derives the aes-128 session keys from
+ *           the base key and the two randoms, then every packet carries a 4 bytes chained mac and its
+ *           data is encrypted in cbc mode. the same session code serves the pd and a host panel.
+ * @{
+ */
+
+/**
+ * @brief em4095 osdp definition
+ */
+#define EM4095_OSDP_SOM                  0x53        /**< start of message */
+#define EM4095_OSDP_BROADCAST            0x7F        /**< broadcast address */
+#define EM4095_OSDP_REPLY_FLAG           0x80        /**< address flag of a reply */
+#define EM4095_OSDP_MAX_PACKET           128         /**< max packet length */
+#define EM4095_OSDP_MAX_CARD_BYTES       16          /**< max card data bytes */
+#define EM4095_OSDP_MAC_LEN              4           /**< mac bytes of a secure packet */
+#define EM4095_OSDP_RND_LEN              8           /**< random bytes of the handshake */
+#ifndef EM4095_OSDP_CARD_DEPTH
+    #define EM4095_OSDP_CARD_DEPTH       4           /**< queued card reads, must be a power of 2 */
+#endif
+
+/**
+ * @brief em4095 osdp command enumeration definition
+ */
+typedef enum
+{
+    EM4095_OSDP_CMD_POLL   = 0x60,        /**< poll */
+    EM4095_OSDP_CMD_ID     = 0x61,        /**< id report request */
+    EM4095_OSDP_CMD_CAP    = 0x62,        /**< capabilities request */
+    EM4095_OSDP_CMD_LSTAT  = 0x64,        /**< local status request */
+    EM4095_OSDP_CMD_CHLNG  = 0x76,        /**< secure channel challenge */
+    EM4095_OSDP_CMD_SCRYPT = 0x77,        /**< server cryptogram */
+} em4095_osdp_cmd_t;
+
+/**
+ * @brief em4095 osdp reply enumeration definition
+ */
+typedef enum
+{
+    EM4095_OSDP_REPLY_ACK    = 0x40,        /**< ack */
+    EM4095_OSDP_REPLY_NAK    = 0x41,        /**< nak */
+    EM4095_OSDP_REPLY_PDID   = 0x45,        /**< id report */
+    EM4095_OSDP_REPLY_PDCAP  = 0x46,        /**< capabilities report */
+    EM4095_OSDP_REPLY_LSTATR = 0x48,        /**< local status report */
+    EM4095_OSDP_REPLY_RAW    = 0x50,        /**< raw card data */
+    EM4095_OSDP_REPLY_FMT    = 0x51,        /**< formatted card data */
+    EM4095_OSDP_REPLY_CCRYPT = 0x76,        /**< client cryptogram */
+    EM4095_OSDP_REPLY_RMAC_I = 0x78,        /**< initial reply mac */
+} em4095_osdp_reply_t;
+
+/**
+ * @brief em4095 osdp nak enumeration definition
+ */
+typedef enum
+{
+    EM4095_OSDP_NAK_CHECK    = 0x01,        /**< bad checksum or crc */
+    EM4095_OSDP_NAK_LENGTH   = 0x02,        /**< invalid command length */
+    EM4095_OSDP_NAK_UNKNOWN  = 0x03,        /**< unknown command code */
+    EM4095_OSDP_NAK_SEQUENCE = 0x04,        /**< unexpected sequence number */
+    EM4095_OSDP_NAK_SECURE   = 0x05,        /**< security block or condition not met */
+} em4095_osdp_nak_t;
+
+/**
+ * @brief em4095 osdp security block type enumeration definition
+ */
+typedef enum
+{
+    EM4095_OSDP_SCS_11 = 0x11,        /**< challenge, osdp_CHLNG */
+    EM4095_OSDP_SCS_12 = 0x12,        /**< client cryptogram, osdp_CCRYPT */
+    EM4095_OSDP_SCS_13 = 0x13,        /**< server cryptogram, osdp_SCRYPT */
+    EM4095_OSDP_SCS_14 = 0x14,        /**< initial reply mac, osdp_RMAC_I */
+    EM4095_OSDP_SCS_15 = 0x15,        /**< command with a mac */
+    EM4095_OSDP_SCS_16 = 0x16,        /**< reply with a mac */
+    EM4095_OSDP_SCS_17 = 0x17,        /**< command with a mac and encrypted data */
+    EM4095_OSDP_SCS_18 = 0x18,        /**< reply with a mac and encrypted data */
+} em4095_osdp_scs_t;
+
+/**
+ * @brief em4095 osdp secure channel state enumeration definition
+ */
+typedef enum
+{
+    EM4095_OSDP_SC_NONE       = 0x00,        /**< no session */
+    EM4095_OSDP_SC_CHALLENGED = 0x01,        /**< session keys derived, cryptogram pending */
+    EM4095_OSDP_SC_ACTIVE     = 0x02,        /**< session is running */
+} em4095_osdp_sc_state_t;
+
+/**
+ * @brief em4095 osdp raw format enumeration definition
+ */
+typedef enum
+{
+    EM4095_OSDP_RAW_FORMAT_RAW     = 0x00,        /**< unspecified raw bits */
+    EM4095_OSDP_RAW_FORMAT_WIEGAND = 0x01,        /**< wiegand bits with the parities */
+} em4095_osdp_raw_format_t;
+
+/**
+ * @brief em4095 osdp packet structure definition
+ */
+typedef struct em4095_osdp_packet_s
+{
+    uint8_t address;            /**< address with the reply flag */
+    uint8_t sqn;                /**< sequence number */
+    uint8_t crc;                /**< 1 for crc16, 0 for the checksum */
+    uint8_t scb;                /**< 1 if a security block is present */
+    uint8_t code;               /**< command or reply code */
+    const uint8_t *data;        /**< data in the receive buffer */
+    uint16_t len;               /**< data length */
+    const uint8_t *som;         /**< packet start in the receive buffer */
+    const uint8_t *sec;         /**< security block length, type and data, NULL without a block */
+} em4095_osdp_packet_t;
+
+/**
+ * @brief em4095 osdp secure channel structure definition
+ */
+typedef struct em4095_osdp_sc_s
+{
+    uint8_t state;                               /**< session state */
+    uint8_t key;                                 /**< 0 for the default key scbk-d, 1 for scbk */
+    uint8_t scbk[EM4095_AES_KEY];                /**< secure channel base key */
+    uint8_t s_enc[EM4095_AES_KEY];               /**< session encryption key */
+    uint8_t s_mac1[EM4095_AES_KEY];              /**< session mac key of the leading blocks */
+    uint8_t s_mac2[EM4095_AES_KEY];              /**< session mac key of the last block */
+    uint8_t rnd_a[EM4095_OSDP_RND_LEN];          /**< panel random */
+    uint8_t rnd_b[EM4095_OSDP_RND_LEN];          /**< pd random */
+    uint8_t c_mac[EM4095_AES_BLOCK];             /**< mac of the last command */
+    uint8_t r_mac[EM4095_AES_BLOCK];             /**< mac of the last reply */
+    uint8_t buf[EM4095_OSDP_MAX_PACKET];         /**< clear data of the last secure packet */
+} em4095_osdp_sc_t;
+
+/**
+ * @brief em4095 osdp id structure definition
+ */
+typedef struct em4095_osdp_id_s
+{
+    uint8_t vendor[3];          /**< ieee oui vendor code */
+    uint8_t model;              /**< model number */
+    uint8_t version;            /**< model version */
+    uint32_t serial;            /**< serial number */
+    uint8_t firmware[3];        /**< firmware major, minor and build */
+} em4095_osdp_id_t;
+
+/**
+ * @brief em4095 osdp card structure definition
+ */
+typedef struct em4095_osdp_card_s
+{
+    uint8_t code;                                     /**< raw or fmt reply */
+    uint8_t format;                                   /**< raw format or fmt read direction */
+    uint16_t bits;                                    /**< raw bits or fmt characters */
+    uint8_t data[EM4095_OSDP_MAX_CARD_BYTES];         /**< msb first bits or characters */
+} em4095_osdp_card_t;
+
+/**
+ * @brief em4095 osdp pd structure definition
+ */
+typedef struct em4095_osdp_pd_s
+{
+    uint8_t address;                                          /**< pd address */
+    uint8_t reader;                                           /**< reader number of the card reports */
+    em4095_osdp_id_t id;                                      /**< id report */
+    em4095_osdp_card_t card[EM4095_OSDP_CARD_DEPTH];          /**< card queue */
+    volatile uint8_t head;                                    /**< card queue read index */
+    volatile uint8_t tail;                                    /**< card queue write index */
+    uint8_t last_sqn;                                         /**< sequence number of the last reply */
+    uint8_t last_valid;                                       /**< last reply is valid */
+    uint8_t last[EM4095_OSDP_MAX_PACKET];                     /**< last reply */
+    uint16_t last_len;                                        /**< last reply length */
+    em4095_osdp_sc_t sc;                                      /**< secure channel */
+    uint8_t (*random)(uint8_t *buf, uint16_t len);            /**< random source, NULL without the secure channel */
+    uint8_t secure;                                           /**< the command came in the session */
+    uint32_t packets;                                         /**< handled packets */
+    uint32_t errors;                                          /**< dropped bytes and bad packets */
+} em4095_osdp_pd_t;
+
+/**
+ * @brief     calculate the osdp crc16
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    crc16
+ * @note      polynomial 0x1021 with the initial value 0x1D0F
+ */
+uint16_t em4095_osdp_crc16(const uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      build a packet
+ * @param[in]  address address with the reply flag
+ * @param[in]  sqn sequence number
+ * @param[in]  crc 1 for crc16, 0 for the checksum
+ * @param[in]  code command or reply code
+ * @param[in]  *data pointer to a data buffer
+ * @param[in]  len data length
+ * @param[out] *buf pointer to a packet buffer
+ * @param[in]  size packet buffer size
+ * @param[out] *out pointer to a packet length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is too small
+ *             - 2 buf or out is NULL
+ * @note       none
+ */
+uint8_t em4095_osdp_build(uint8_t address, uint8_t sqn, uint8_t crc, uint8_t code, const uint8_t *data,
+                          uint16_t len, uint8_t *buf, uint16_t size, uint16_t *out);
+
+/**
+ * @brief      build a packet with a security block
+ * @param[in]  address address with the reply flag
+ * @param[in]  sqn sequence number
+ * @param[in]  *sec pointer to a security block, length, type and data
+ * @param[in]  code command or reply code
+ * @param[in]  *data pointer to a data buffer
+ * @param[in]  len data length
+ * @param[out] *buf pointer to a packet buffer
+ * @param[in]  size packet buffer size
+ * @param[out] *out pointer to a packet length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is too small
+ *             - 2 sec, buf or out is NULL
+ *             - 4 security block is invalid
+ * @note       the handshake packets of the secure channel, always with the crc16
+ */
+uint8_t em4095_osdp_build_block(uint8_t address, uint8_t sqn, const uint8_t *sec, uint8_t code, const uint8_t *data,
+                                uint16_t len, uint8_t *buf, uint16_t size, uint16_t *out);
+
+/**
+ * @brief      parse a packet in place
+ * @param[in]  *buf pointer to a receive buffer
+ * @param[in]  len received length
+ * @param[out] *packet pointer to a packet structure
+ * @param[out] *used pointer to a used length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 packet is incomplete
+ *             - 2 buf, packet or used is NULL
+ *             - 4 packet is invalid
+ * @note       used is the length to drop from the buffer front, after a success or an invalid
+ *             packet it covers the packet or the bytes skipped to the next som, an incomplete
+ *             packet keeps its bytes and only drops the garbage before the som
+ */
+uint8_t em4095_osdp_parse(const uint8_t *buf, uint16_t len, em4095_osdp_packet_t *packet, uint16_t *used);
+
+/**
+ * @brief     init a secure channel
+ * @param[in] *sc pointer to a secure channel structure
+ * @param[in] *scbk pointer to a 16 bytes base key, NULL for the default key scbk-d
+ * @return    status code
+ *            - 0 success
+ *            - 2 sc is NULL
+ * @note      the default key is for the install mode only
+ */
+uint8_t em4095_osdp_sc_init(em4095_osdp_sc_t *sc, const uint8_t *scbk);
+
+/**
+ * @brief      start a session
+ * @param[in]  *sc pointer to a secure channel structure
+ * @param[in]  *rnd_a pointer to the 8 bytes panel random
+ * @param[in]  *rnd_b pointer to the 8 bytes pd random
+ * @param[out] *client pointer to a 16 bytes client cryptogram buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 sc, rnd_a, rnd_b or client is NULL
+ * @note       derives s-enc, s-mac1 and s-mac2 from the base key and rnd_a, the session waits
+ *             for the server cryptogram
+ */
+uint8_t em4095_osdp_sc_session(em4095_osdp_sc_t *sc, const uint8_t *rnd_a, const uint8_t *rnd_b, uint8_t *client);
+
+/**
+ * @brief      run a session
+ * @param[in]  *sc pointer to a secure channel structure
+ * @param[out] *server pointer to a 16 bytes server cryptogram buffer
+ * @param[out] *rmac_i pointer to a 16 bytes initial reply mac buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no session is started
+ *             - 2 sc, server or rmac_i is NULL
+ * @note       the initial reply mac seeds the mac chain, the caller checks the cryptogram of the
+ *             peer and inits the channel again when it is wrong
+ */
+uint8_t em4095_osdp_sc_server(em4095_osdp_sc_t *sc, uint8_t *server, uint8_t *rmac_i);
+
+/**
+ * @brief      build a packet in the session
+ * @param[in]  *sc pointer to a secure channel structure
+ * @param[in]  address address with the reply flag
+ * @param[in]  sqn sequence number
+ * @param[in]  code command or reply code
+ * @param[in]  *data pointer to a data buffer
+ * @param[in]  len data length
+ * @param[out] *buf pointer to a packet buffer
+ * @param[in]  size packet buffer size
+ * @param[out] *out pointer to a packet length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is too small or no session is running
+ *             - 2 sc, buf or out is NULL
+ * @note       data is padded and encrypted with s-enc, the mac chains from the last mac of the
+ *             peer and the first 4 bytes go before the crc16
+ */
+uint8_t em4095_osdp_sc_build(em4095_osdp_sc_t *sc, uint8_t address, uint8_t sqn, uint8_t code, const uint8_t *data,
+                             uint16_t len, uint8_t *buf, uint16_t size, uint16_t *out);
+
+/**
+ * @brief         check and decrypt a packet of the session
+ * @param[in]     *sc pointer to a secure channel structure
+ * @param[in,out] *packet pointer to a parsed packet
+ * @return        status code
+ *                - 0 success
+ *                - 1 mac is wrong or no session is running
+ *                - 2 sc or packet is NULL
+ *                - 4 packet is not a session packet
+ * @note          the packet data points into the clear buffer of the channel afterwards, a wrong
+ *                mac leaves the chain as it is
+ */
+uint8_t em4095_osdp_sc_unwrap(em4095_osdp_sc_t *sc, em4095_osdp_packet_t *packet);
+
+/**
+ * @brief     init the pd
+ * @param[in] *pd pointer to a pd structure
+ * @param[in] address pd address
+ * @param[in] reader reader number of the card reports
+ * @param[in] *id pointer to an id structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 pd or id is NULL
+ *            - 4 address is invalid
+ * @note      0 <= address < 0x7F
+ */
+uint8_t em4095_osdp_pd_init(em4095_osdp_pd_t *pd, uint8_t address, uint8_t reader, const em4095_osdp_id_t *id);
+
+/**
+ * @brief     set the secure channel of the pd
+ * @param[in] *pd pointer to a pd structure
+ * @param[in] *scbk pointer to a 16 bytes base key, NULL for the default key scbk-d
+ * @param[in] *random pointer to a random function, NULL turns the secure channel off
+ * @return    status code
+ *            - 0 success
+ *            - 2 pd is NULL
+ * @note      random fills len bytes and returns 0 on success, the pd answers a challenge only
+ *            for its own key, a secure channel that is off naks every security block
+ */
+uint8_t em4095_osdp_pd_set_secure(em4095_osdp_pd_t *pd, const uint8_t *scbk, uint8_t (*random)(uint8_t *buf, uint16_t len));
+
+/**
+ * @brief     queue a raw card read
+ * @param[in] *pd pointer to a pd structure
+ * @param[in] format raw format
+ * @param[in] *buf pointer to a bit buffer, the first bit is the msb of buf[0]
+ * @param[in] bits bit number
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ *            - 2 pd or buf is NULL
+ *            - 4 bits is invalid
+ * @note      single producer, the reply side is the consumer
+ */
+uint8_t em4095_osdp_pd_push_raw(em4095_osdp_pd_t *pd, em4095_osdp_raw_format_t format, const uint8_t *buf, uint16_t bits);
+
+/**
+ * @brief     queue a formatted card read
+ * @param[in] *pd pointer to a pd structure
+ * @param[in] *text pointer to an ascii card number
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ *            - 2 pd or text is NULL
+ *            - 4 text is invalid
+ * @note      single producer, the reply side is the consumer
+ */
+uint8_t em4095_osdp_pd_push_fmt(em4095_osdp_pd_t *pd, const char *text);
+
+/**
+ * @brief      handle a command packet
+ * @param[in]  *pd pointer to a pd structure
+ * @param[in]  *packet pointer to a parsed packet
+ * @param[out] **reply pointer to a reply pointer
+ * @param[out] *len pointer to a reply length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 packet is not for the pd
+ *             - 2 pd, packet, reply or len is NULL
+ * @note       the reply points into the pd and stays valid until the next command
+ */
+uint8_t em4095_osdp_pd_handle(em4095_osdp_pd_t *pd, const em4095_osdp_packet_t *packet, const uint8_t **reply, uint16_t *len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,322 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_slicer.c
+ * @brief     driver em4095 slicer source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_em4095_slicer.h"
+
+/**
+ * @brief slicer definition
+ */
+#define SLICER_EMA_SHIFT        3        /**< period average weight 1/8 */
+
+/**
+ * @brief     slicer get the bit confidence
+ * @param[in] err_q4 distance to the nearest period in 1/16 us
+ * @param[in] half_q4 half bit period in 1/16 us
+ * @return    confidence
+ * @note      none
+ */
+static uint8_t a_slicer_confidence(uint32_t err_q4, uint32_t half_q4)
+{
+    uint32_t loss;
+
+    loss = (uint32_t)(((uint64_t)err_q4 * 510) / half_q4);           /* half a period is 255 */
+    if (loss > 255)                                                  /* check the range */
+    {
+        loss = 255;                                                  /* set max */
+    }
+
+    return (uint8_t)(255 - loss);                                    /* return the confidence */
+}
+
+/**
+ * @brief     init the slicer
+ * @param[in] *handle pointer to a slicer structure
+ * @param[in] coding bit coding
+ * @param[in] half_us nominal half bit period in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 half_us is invalid
+ * @note      rf/64 at 125KHz is 256us
+ */
+uint8_t em4095_slicer_init(em4095_slicer_t *handle, em4095_slicer_coding_t coding, uint32_t half_us)
+{
+    if (handle == NULL)                                    /* check handle */
+    {
+        return 2;                                          /* return error */
+    }
+    if ((half_us == 0) || (half_us > 0x0FFFFFFF))          /* check half_us */
+    {
+        return 4;                                          /* return error */
+    }
+
+    handle->coding = (uint8_t)coding;                      /* set coding */
+    handle->nominal_q4 = half_us << 4;                     /* set nominal period */
+    handle->errors = 0;                                    /* init 0 */
+
+    return em4095_slicer_reset(handle);                    /* reset the lock */
+}
+
+/**
+ * @brief     reset the bit clock lock
+ * @param[in] *handle pointer to a slicer structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      the tracked period goes back to the nominal one
+ */
+uint8_t em4095_slicer_reset(em4095_slicer_t *handle)
+{
+    if (handle == NULL)                           /* check handle */
+    {
+        return 2;                                 /* return error */
+    }
+
+    handle->sync = 0;                             /* not sync */
+    handle->phase = 0;                            /* init 0 */
+    handle->level = 0;                            /* init 0 */
+    handle->started = 0;                          /* no run */
+    handle->run_us = 0;                           /* init 0 */
+    handle->half_q4 = handle->nominal_q4;         /* nominal period */
+
+    return 0;                                     /* success return 0 */
+}
+
+/**
+ * @brief      push one run to the slicer
+ * @param[in]  *handle pointer to a slicer structure
+ * @param[in]  level level of the run
+ * @param[in]  duration_us run duration in us
+ * @param[out] *bit pointer to a bit buffer of EM4095_SLICER_MAX_BITS
+ * @param[out] *count pointer to an emitted bit number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run is out of range, the lock is lost
+ *             - 2 handle, bit or count is NULL
+ * @note       constant work per run
+ */
+uint8_t em4095_slicer_push_run(em4095_slicer_t *handle, uint8_t level, uint32_t duration_us,
+                               em4095_slicer_bit_t *bit, uint8_t *count)
+{
+    uint8_t h;
+    uint8_t halves;
+    uint8_t confidence;
+    uint8_t next;
+    uint32_t d_q4;
+    uint32_t err_q4;
+
+    if ((handle == NULL) || (bit == NULL) || (count == NULL))                       /* check the params */
+    {
+        return 2;                                                                   /* return error */
+    }
+
+    *count = 0;                                                                     /* no bit */
+    d_q4 = (duration_us > 0x0FFFFFFF) ? 0xFFFFFFFFU : (duration_us << 4);           /* to 1/16 us */
+    if ((d_q4 < (handle->half_q4 >> 1)) ||
+        (d_q4 > handle->half_q4 * EM4095_SLICER_MAX_HALVES +
+         (handle->half_q4 >> 1)))                                                   /* out of the run range */
+    {
+        handle->errors++;                                                           /* errors++ */
+        handle->sync = 0;                                                           /* lost the lock */
+        handle->phase = 0;                                                          /* init 0 */
+        handle->half_q4 = handle->nominal_q4;                                       /* back to nominal */
+
+        return 1;                                                                   /* return error */
+    }
+    halves = (uint8_t)((d_q4 + (handle->half_q4 >> 1)) / handle->half_q4);          /* round to half periods */
+    err_q4 = (d_q4 > handle->half_q4 * halves) ? (d_q4 - handle->half_q4 * halves) :
+             (handle->half_q4 * halves - d_q4);                                     /* distance */
+    if (halves == 1)                                                                /* short run */
+    {
+        confidence = a_slicer_confidence(err_q4, handle->half_q4);                  /* get the confidence */
+        handle->half_q4 = handle->half_q4 + (d_q4 >> SLICER_EMA_SHIFT) -
+                          (handle->half_q4 >> SLICER_EMA_SHIFT);                    /* track the period */
+    }
+    else if (halves == 2)                                                           /* long run */
+    {
+        confidence = a_slicer_confidence(err_q4 >> 1, handle->half_q4);             /* per half period */
+        handle->half_q4 = handle->half_q4 + (d_q4 >> (SLICER_EMA_SHIFT + 1)) -
+                          (handle->half_q4 >> SLICER_EMA_SHIFT);                    /* track the period */
+    }
+    else
+    {
+        handle->errors++;                                                           /* not a valid run */
+        confidence = 0;                                                             /* erased bits */
+        if (handle->sync == 0)                                                      /* not locked */
+        {
+            return 0;                                                               /* success return 0 */
+        }
+    }
+    next = (level != 0) ? 0 : 1;                                                    /* level after the edge */
+
+    if (handle->coding == EM4095_SLICER_CODING_MANCHESTER)                          /* manchester */
+    {
+        if ((halves == 2) && ((handle->sync == 0) || (handle->phase == 0)))         /* long run ends in the middle */
+        {
+            if (handle->sync != 0)                                                  /* at a boundary */
+            {
+                handle->errors++;                                                   /* a long run can't start there */
+                confidence = 0;                                                     /* phase is relocked */
+            }
+            handle->sync = 1;                                                       /* locked */
+            handle->phase = 1;                                                      /* in the middle */
+            bit[0].bit = next;                                                      /* set the bit */
+            bit[0].confidence = confidence;                                         /* set the confidence */
+            *count = 1;                                                             /* one bit */
+        }
+        else if (handle->sync != 0)                                                 /* locked */
+        {
+            for (h = 0; h < halves; h++)                                            /* every half period */
+            {
+                handle->phase ^= 1;                                                 /* next half */
+                if (handle->phase != 0)                                             /* in the middle */
+                {
+                    bit[*count].bit = (h == halves - 1) ? next : level;             /* the edge or the run level */
+                    bit[*count].confidence = confidence;                            /* set the confidence */
+                    (*count)++;                                                     /* count++ */
+                }
+            }
+        }
+        else
+        {
+            /* wait for a long run to lock */
+        }
+    }
+    else                                                                            /* biphase */
+    {
+        if ((halves == 2) && ((handle->sync == 0) || (handle->phase != 0)))         /* a whole one */
+        {
+            if (handle->sync != 0)                                                  /* after a single short run */
+            {
+                handle->errors++;                                                   /* a long run can't start there */
+                confidence = 0;                                                     /* phase is relocked */
+            }
+            handle->sync = 1;                                                       /* locked */
+            handle->phase = 0;                                                      /* at a boundary */
+            bit[0].bit = 1;                                                         /* set the bit */
+            bit[0].confidence = confidence;                                         /* set the confidence */
+            *count = 1;                                                             /* one bit */
+        }
+        else if (handle->sync != 0)                                                 /* locked */
+        {
+            for (h = 0; h < halves; h++)                                            /* every half period */
+            {
+                handle->phase ^= 1;                                                 /* next half */
+                if (handle->phase == 0)                                             /* at a boundary */
+                {
+                    bit[*count].bit = (h != 0) ? 1 : 0;                             /* no edge in the middle is one */
+                    bit[*count].confidence = confidence;                            /* set the confidence */
+                    (*count)++;                                                     /* count++ */
+                }
+            }
+        }
+        else
+        {
+            /* wait for a long run to lock */
+        }
+    }
+
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      push one level sample to the slicer
+ * @param[in]  *handle pointer to a slicer structure
+ * @param[in]  level sampled level
+ * @param[in]  diff_us time from the previous sample in us
+ * @param[out] *bit pointer to a bit buffer of EM4095_SLICER_MAX_BITS
+ * @param[out] *count pointer to an emitted bit number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run is out of range, the lock is lost
+ *             - 2 handle, bit or count is NULL
+ * @note       constant work per sample, a run ends at the first sample of the other level
+ */
+uint8_t em4095_slicer_push_sample(em4095_slicer_t *handle, uint8_t level, uint32_t diff_us,
+                                  em4095_slicer_bit_t *bit, uint8_t *count)
+{
+    uint8_t res;
+    uint32_t run;
+
+    if ((handle == NULL) || (bit == NULL) || (count == NULL))                /* check the params */
+    {
+        return 2;                                                            /* return error */
+    }
+
+    *count = 0;                                                              /* no bit */
+    level = (level != 0) ? 1 : 0;                                            /* to 0 or 1 */
+    if (handle->started == 0)                                                /* first sample */
+    {
+        handle->started = 1;                                                 /* run started */
+        handle->level = level;                                               /* save level */
+        handle->run_us = 0;                                                  /* init 0 */
+
+        return 0;                                                            /* success return 0 */
+    }
+    run = handle->run_us + diff_us;                                          /* add the time */
+    handle->run_us = (run < handle->run_us) ? 0xFFFFFFFFU : run;             /* saturate */
+    if (level == handle->level)                                              /* same run */
+    {
+        return 0;                                                            /* success return 0 */
+    }
+    run = handle->run_us;                                                    /* the run ends here */
+    res = em4095_slicer_push_run(handle, handle->level, run, bit, count);    /* push the run */
+    handle->level = level;                                                   /* new run */
+    handle->run_us = 0;                                                      /* init 0 */
+
+    return res;                                                              /* return the result */
+}
+
+/**
+ * @brief      get the tracked half bit period
+ * @param[in]  *handle pointer to a slicer structure
+ * @param[out] *half_us pointer to a half bit period buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or half_us is NULL
+ * @note       none
+ */
+uint8_t em4095_slicer_get_period(em4095_slicer_t *handle, uint32_t *half_us)
+{
+    if ((handle == NULL) || (half_us == NULL))        /* check the params */
+    {
+        return 2;                                     /* return error */
+    }
+
+    *half_us = (handle->half_q4 + 8) >> 4;            /* round to us */
+
+    return 0;                                         /* success return 0 */
+}
@@ -0,0 +1,174 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_slicer.h
+ * @brief     driver em4095 slicer header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_EM4095_SLICER_H
+#define DRIVER_EM4095_SLICER_H
+
+#include "driver_em4095.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup em4095_slicer_driver em4095 slicer driver function
+ * @brief    em4095 slicer driver modules
+ * @ingroup  em4095_driver
+ * @details  the slicer recovers the bit clock from the DEMOD_OUT runs one run at a time. every run is
+ *           classified as one or two half bit periods, the half bit period is tracked by an exponential
+ *           moving average and the bits are emitted as soon as they are known.
+ *           - manchester: an edge in the middle of every bit, the bit is the level after it.
+ *           - biphase: an edge at every bit boundary, a zero has one more edge in the middle.
+ *           a locked run longer than two half periods keeps the bit count, its bits are emitted with
+ *           confidence 0 so a frame combiner can outvote them.
+ * @{
+ */
+
+/**
+ * @brief em4095 slicer definition
+ */
+#define EM4095_SLICER_MAX_HALVES        6                                   /**< longest run in half periods */
+#define EM4095_SLICER_MAX_BITS          (EM4095_SLICER_MAX_HALVES / 2 + 1)  /**< max bits emitted by one run */
+
+/**
+ * @brief em4095 slicer coding enumeration definition
+ */
+typedef enum
+{
+    EM4095_SLICER_CODING_MANCHESTER = 0x00,        /**< manchester */
+    EM4095_SLICER_CODING_BIPHASE    = 0x01,        /**< biphase */
+} em4095_slicer_coding_t;
+
+/**
+ * @brief em4095 slicer bit structure definition
+ */
+typedef struct em4095_slicer_bit_s
+{
+    uint8_t bit;               /**< bit value */
+    uint8_t confidence;        /**< 255 is a run of the exact period, 0 is half a period away */
+} em4095_slicer_bit_t;
+
+/**
+ * @brief em4095 slicer structure definition
+ */
+typedef struct em4095_slicer_s
+{
+    uint8_t coding;            /**< coding */
+    uint8_t sync;              /**< bit clock is locked */
+    uint8_t phase;             /**< manchester in the middle or biphase after the first short run */
+    uint8_t level;             /**< level of the current run */
+    uint8_t started;           /**< a run is started */
+    uint32_t run_us;           /**< current run duration */
+    uint32_t half_q4;          /**< half bit period in 1/16 us */
+    uint32_t nominal_q4;       /**< nominal half bit period in 1/16 us */
+    uint32_t errors;           /**< runs out of the period range */
+} em4095_slicer_t;
+
+/**
+ * @brief     init the slicer
+ * @param[in] *handle pointer to a slicer structure
+ * @param[in] coding bit coding
+ * @param[in] half_us nominal half bit period in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 half_us is invalid
+ * @note      rf/64 at 125KHz is 256us
+ */
+uint8_t em4095_slicer_init(em4095_slicer_t *handle, em4095_slicer_coding_t coding, uint32_t half_us);
+
+/**
+ * @brief     reset the bit clock lock
+ * @param[in] *handle pointer to a slicer structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      the tracked period goes back to the nominal one
+ */
+uint8_t em4095_slicer_reset(em4095_slicer_t *handle);
+
+/**
+ * @brief      push one run to the slicer
+ * @param[in]  *handle pointer to a slicer structure
+ * @param[in]  level level of the run
+ * @param[in]  duration_us run duration in us
+ * @param[out] *bit pointer to a bit buffer of EM4095_SLICER_MAX_BITS
+ * @param[out] *count pointer to an emitted bit number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run is out of range, the lock is lost
+ *             - 2 handle, bit or count is NULL
+ * @note       constant work per run
+ */
+uint8_t em4095_slicer_push_run(em4095_slicer_t *handle, uint8_t level, uint32_t duration_us,
+                               em4095_slicer_bit_t *bit, uint8_t *count);
+
+/**
+ * @brief      push one level sample to the slicer
+ * @param[in]  *handle pointer to a slicer structure
+ * @param[in]  level sampled level
+ * @param[in]  diff_us time from the previous sample in us
+ * @param[out] *bit pointer to a bit buffer of EM4095_SLICER_MAX_BITS
+ * @param[out] *count pointer to an emitted bit number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run is out of range, the lock is lost
+ *             - 2 handle, bit or count is NULL
+ * @note       constant work per sample, a run ends at the first sample of the other level
+ */
+uint8_t em4095_slicer_push_sample(em4095_slicer_t *handle, uint8_t level, uint32_t diff_us,
+                                  em4095_slicer_bit_t *bit, uint8_t *count);
+
+/**
+ * @brief      get the tracked half bit period
+ * @param[in]  *handle pointer to a slicer structure
+ * @param[out] *half_us pointer to a half bit period buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or half_us is NULL
+ * @note       none
+ */
+uint8_t em4095_slicer_get_period(em4095_slicer_t *handle, uint32_t *half_us);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,547 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_wiegand.c
+ * @brief     driver em4095 wiegand source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#include "driver_em4095_wiegand.h"
+
+/**
+ * @brief wiegand format table definition
+ */
+static const em4095_wiegand_format_t gs_wiegand_format[] =
+{
+    {
+        "h10301", 26, 2,
+        {
+            {0, 0, 0x0000000003FFE000ULL},         /* even parity of bits 1 - 12 */
+            {25, 1, 0x0000000000001FFFULL},        /* odd parity of bits 13 - 24 */
+        },
+        {1, 8},
+        {9, 16},
+    },
+    {
+        "h10306", 34, 2,
+        {
+            {0, 0, 0x00000003FFFE0000ULL},         /* even parity of bits 1 - 16 */
+            {33, 1, 0x000000000001FFFFULL},        /* odd parity of bits 17 - 32 */
+        },
+        {1, 16},
+        {17, 16},
+    },
+    {
+        "c1k35", 35, 3,
+        {
+            {1, 0, 0x00000003B6DB6DB6ULL},         /* even parity of bits 2 - 33 but every third bit */
+            {34, 1, 0x000000036DB6DB6DULL},        /* odd parity of bits 1 - 32 but every third bit */
+            {0, 1, 0x00000007FFFFFFFFULL},         /* odd parity of bits 1 - 34 */
+        },
+        {2, 12},
+        {14, 20},
+    },
+    {
+        "h10304", 37, 2,
+        {
+            {0, 0, 0x0000001FFFFC0000ULL},         /* even parity of bits 1 - 18 */
+            {36, 1, 0x000000000007FFFFULL},        /* odd parity of bits 18 - 35 */
+        },
+        {1, 16},
+        {17, 19},
+    },
+    {
+        "c1k48", 48, 3,
+        {
+            {1, 0, 0x000076DB6DB6DB6CULL},         /* even parity of bits 2 - 45 but every third bit */
+            {47, 1, 0x00006DB6DB6DB6D9ULL},        /* odd parity of bits 1 - 44 but every third bit */
+            {0, 1, 0x0000FFFFFFFFFFFFULL},         /* odd parity of bits 1 - 47 */
+        },
+        {2, 22},
+        {24, 23},
+    },
+};
+
+/**
+ * @brief     get the parity of a word
+ * @param[in] v checked word
+ * @return    1 for an odd number of ones
+ * @note      none
+ */
+static uint8_t a_wiegand_parity(uint64_t v)
+{
+    v ^= v >> 32;                                  /* fold 32 */
+    v ^= v >> 16;                                  /* fold 16 */
+    v ^= v >> 8;                                   /* fold 8 */
+    v ^= v >> 4;                                   /* fold 4 */
+    v ^= v >> 2;                                   /* fold 2 */
+    v ^= v >> 1;                                   /* fold 1 */
+
+    return (uint8_t)(v & 0x01);                    /* return the parity */
+}
+
+/**
+ * @brief     get a field of a payload
+ * @param[in] payload right aligned payload
+ * @param[in] bits payload bits
+ * @param[in] *field pointer to a field structure
+ * @return    field value
+ * @note      none
+ */
+static uint32_t a_wiegand_get(uint64_t payload, uint8_t bits, const em4095_wiegand_field_t *field)
+{
+    if (field->length == 0)                                  /* no field */
+    {
+        return 0;                                            /* return 0 */
+    }
+
+    return (uint32_t)((payload >> (bits - field->start - field->length)) &
+                      ((1ULL << field->length) - 1));        /* get the bits */
+}
+
+/**
+ * @brief      get the wiegand format table
+ * @param[out] **table pointer to a format table buffer
+ * @param[out] *count pointer to a format number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 table or count is NULL
+ * @note       h10301 26 bits, h10306 34 bits, corporate 1000 35 bits, h10304 37 bits and
+ *             corporate 1000 48 bits
+ */
+uint8_t em4095_wiegand_get_formats(const em4095_wiegand_format_t **table, uint8_t *count)
+{
+    if ((table == NULL) || (count == NULL))                                              /* check the pointers */
+    {
+        return 2;                                                                        /* return error */
+    }
+
+    *table = gs_wiegand_format;                                                          /* set the table */
+    *count = (uint8_t)(sizeof(gs_wiegand_format) / sizeof(gs_wiegand_format[0]));        /* set the count */
+
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief      parse a wiegand payload
+ * @param[in]  payload right aligned payload, the first bit is the msb
+ * @param[in]  bits payload bits
+ * @param[out] *card pointer to a card structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 no format matched
+ *             - 2 card is NULL
+ * @note       no allocation, it can run in the frame completion path
+ */
+uint8_t em4095_wiegand_parse(uint64_t payload, uint8_t bits, em4095_wiegand_card_t *card)
+{
+    uint8_t i;
+    uint8_t j;
+    const em4095_wiegand_format_t *f;
+
+    if (card == NULL)                                                                     /* check card */
+    {
+        return 2;                                                                         /* return error */
+    }
+
+    for (i = 0; i < sizeof(gs_wiegand_format) / sizeof(gs_wiegand_format[0]); i++)        /* every format */
+    {
+        f = &gs_wiegand_format[i];                                                        /* get the format */
+        if (f->bits != bits)                                                              /* check the length */
+        {
+            continue;                                                                     /* next format */
+        }
+        for (j = 0; j < f->parities; j++)                                                 /* every parity bit */
+        {
+            if (a_wiegand_parity(payload & f->parity[j].mask) != f->parity[j].odd)        /* check the parity */
+            {
+                break;                                                                    /* failed */
+            }
+        }
+        if (j != f->parities)                                                             /* a parity failed */
+        {
+            continue;                                                                     /* next format */
+        }
+        card->format = f;                                                                 /* set the format */
+        card->facility = a_wiegand_get(payload, bits, &f->facility);                      /* get the facility */
+        card->card = a_wiegand_get(payload, bits, &f->card);                              /* get the card */
+
+        return 0;                                                                         /* success return 0 */
+    }
+
+    return 1;                                                                             /* no format */
+}
+
+/**
+ * @brief      encode a wiegand payload
+ * @param[in]  *format pointer to a format structure
+ * @param[in]  facility facility code
+ * @param[in]  card card number
+ * @param[out] *payload pointer to a payload buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 format or payload is NULL
+ *             - 4 facility or card is too large
+ * @note       the payload has format->bits bits
+ */
+uint8_t em4095_wiegand_encode(const em4095_wiegand_format_t *format, uint32_t facility, uint32_t card,
+                              uint64_t *payload)
+{
+    uint8_t j;
+    uint64_t v;
+    uint64_t bit;
+
+    if ((format == NULL) || (payload == NULL))                                                               /* check the pointers */
+    {
+        return 2;                                                                                            /* return error */
+    }
+    if (((uint64_t)facility >> format->facility.length) != 0)                                                /* check the facility */
+    {
+        return 4;                                                                                            /* return error */
+    }
+    if (((uint64_t)card >> format->card.length) != 0)                                                        /* check the card */
+    {
+        return 4;                                                                                            /* return error */
+    }
+
+    v = 0;                                                                                                   /* init 0 */
+    if (format->facility.length != 0)                                                                        /* has a facility */
+    {
+        v |= (uint64_t)facility << (format->bits - format->facility.start - format->facility.length);        /* set the facility */
+    }
+    v |= (uint64_t)card << (format->bits - format->card.start - format->card.length);                        /* set the card */
+    for (j = 0; j < format->parities; j++)                                                                   /* in the computing order */
+    {
+        bit = 1ULL << (format->bits - 1 - format->parity[j].position);                                       /* parity bit */
+        if ((a_wiegand_parity(v & format->parity[j].mask & ~bit) ^ format->parity[j].odd) != 0)              /* set it */
+        {
+            v |= bit;                                                                                        /* set 1 */
+        }
+    }
+    *payload = v;                                                                                            /* set the payload */
+
+    return 0;                                                                                                /* success return 0 */
+}
+
+/**
+ * @brief     append bits to a frame buffer
+ * @param[in] *buf pointer to a frame buffer
+ * @param[in] pos first bit position
+ * @param[in] v appended bits, the first bit is the lsb
+ * @param[in] n bit number
+ * @note      aba characters are sent lsb first
+ */
+static void a_wiegand_append_lsb(uint8_t *buf, uint16_t pos, uint8_t v, uint8_t n)
+{
+    uint8_t i;
+
+    for (i = 0; i < n; i++)                                                  /* every bit */
+    {
+        if (((v >> i) & 0x01) != 0)                                          /* a one */
+        {
+            buf[(pos + i) / 8] |= (uint8_t)(0x80 >> ((pos + i) % 8));        /* set the bit */
+        }
+    }
+}
+
+/**
+ * @brief      encode an aba track 2 frame
+ * @param[in]  *digits pointer to a decimal digit string
+ * @param[out] *buf pointer to a frame buffer
+ * @param[in]  len buffer length
+ * @param[out] *bits pointer to a frame bits buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is too small
+ *             - 2 digits, buf or bits is NULL
+ *             - 4 digits is invalid
+ * @note       10 leading zeros, the start sentinel, the digits, the end sentinel, the lrc and 10
+ *             trailing zeros, every character is 4 bits lsb first and an odd parity bit
+ */
+uint8_t em4095_wiegand_aba_encode(const char *digits, uint8_t *buf, uint16_t len, uint8_t *bits)
+{
+    uint16_t i;
+    uint16_t n;
+    uint16_t total;
+    uint16_t pos;
+    uint8_t c;
+    uint8_t lrc;
+
+    if ((digits == NULL) || (buf == NULL) || (bits == NULL))                                       /* check the pointers */
+    {
+        return 2;                                                                                  /* return error */
+    }
+
+    n = 0;                                                                                         /* init 0 */
+    while (digits[n] != 0)                                                                         /* count the digits */
+    {
+        if ((digits[n] < '0') || (digits[n] > '9'))                                                /* check the digit */
+        {
+            return 4;                                                                              /* return error */
+        }
+        n++;                                                                                       /* n++ */
+    }
+    if (n == 0)                                                                                    /* no digit */
+    {
+        return 4;                                                                                  /* return error */
+    }
+    total = (uint16_t)(10 + (n + 3) * 5 + 10);                                                     /* frame bits */
+    if (total > EM4095_WIEGAND_TX_MAX_BITS)                                                        /* too many digits */
+    {
+        return 4;                                                                                  /* return error */
+    }
+    if (len * 8 < total)                                                                           /* check the buffer */
+    {
+        return 1;                                                                                  /* return error */
+    }
+
+    for (i = 0; i < (total + 7) / 8; i++)                                                          /* clear the buffer */
+    {
+        buf[i] = 0;                                                                                /* set 0 */
+    }
+    pos = 10;                                                                                      /* after the leading zeros */
+    lrc = 0;                                                                                       /* init 0 */
+    for (i = 0; i < n + 2; i++)                                                                    /* sentinels and digits */
+    {
+        c = (i == 0) ? 0x0B : ((i == n + 1) ? 0x0F : (uint8_t)(digits[i - 1] - '0'));              /* get the character */
+        lrc ^= c;                                                                                  /* update the lrc */
+        a_wiegand_append_lsb(buf, pos, (uint8_t)(c | ((a_wiegand_parity(c) ^ 1) << 4)), 5);        /* append it */
+        pos += 5;                                                                                  /* next character */
+    }
+    a_wiegand_append_lsb(buf, pos, (uint8_t)(lrc | ((a_wiegand_parity(lrc) ^ 1) << 4)), 5);        /* append the lrc */
+    *bits = (uint8_t)total;                                                                        /* set the bits */
+
+    return 0;                                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     init the transmitter
+ * @param[in] *tx pointer to a tx structure
+ * @param[in] slots_per_bit slots of one bit
+ * @param[in] gap_slots idle slots after a frame
+ * @return    status code
+ *            - 0 success
+ *            - 2 tx is NULL
+ *            - 4 slots_per_bit or gap_slots is invalid
+ * @note      3 <= slots_per_bit, 1 <= gap_slots, with 50us slots a 2ms bit interval is 40 slots
+ */
+uint8_t em4095_wiegand_tx_init(em4095_wiegand_tx_t *tx, uint16_t slots_per_bit, uint16_t gap_slots)
+{
+    if (tx == NULL)                                    /* check tx */
+    {
+        return 2;                                      /* return error */
+    }
+    if ((slots_per_bit < 3) || (gap_slots < 1))        /* check the slots */
+    {
+        return 4;                                      /* return error */
+    }
+
+    tx->head = 0;                                      /* init 0 */
+    tx->tail = 0;                                      /* init 0 */
+    tx->slots_per_bit = slots_per_bit;                 /* set the bit slots */
+    tx->gap_slots = gap_slots;                         /* set the gap slots */
+    tx->active = 0;                                    /* idle */
+    tx->bit = 0;                                       /* init 0 */
+    tx->slot = 0;                                      /* init 0 */
+    tx->sent = 0;                                      /* init 0 */
+
+    return 0;                                          /* success return 0 */
+}
+
+/**
+ * @brief     queue a frame
+ * @param[in] *tx pointer to a tx structure
+ * @param[in] mode tx mode
+ * @param[in] *buf pointer to a frame buffer, the first bit is the msb of buf[0]
+ * @param[in] bits frame bits
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ *            - 2 tx or buf is NULL
+ *            - 4 bits is invalid
+ * @note      one pushing side and one slot side may run at once without a lock
+ */
+uint8_t em4095_wiegand_tx_push(em4095_wiegand_tx_t *tx, em4095_wiegand_tx_mode_t mode, const uint8_t *buf, uint8_t bits)
+{
+    uint8_t i;
+    em4095_wiegand_tx_frame_t *f;
+
+    if ((tx == NULL) || (buf == NULL))                                    /* check the pointers */
+    {
+        return 2;                                                         /* return error */
+    }
+    if ((bits == 0) || (bits > EM4095_WIEGAND_TX_MAX_BITS))               /* check the bits */
+    {
+        return 4;                                                         /* return error */
+    }
+    if ((uint8_t)(tx->tail - tx->head) >= EM4095_WIEGAND_TX_DEPTH)        /* check the queue */
+    {
+        return 1;                                                         /* return error */
+    }
+
+    f = &tx->frame[tx->tail & (EM4095_WIEGAND_TX_DEPTH - 1)];             /* get the free frame */
+    for (i = 0; i < (bits + 7) / 8; i++)                                  /* copy the bits */
+    {
+        f->buf[i] = buf[i];                                               /* copy */
+    }
+    f->bits = bits;                                                       /* set the bits */
+    f->mode = (uint8_t)mode;                                              /* set the mode */
+    tx->tail++;                                                           /* publish it */
+
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief     queue a wiegand payload
+ * @param[in] *tx pointer to a tx structure
+ * @param[in] payload right aligned payload, the first bit is the msb
+ * @param[in] bits payload bits
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ *            - 2 tx is NULL
+ *            - 4 bits is invalid
+ * @note      none
+ */
+uint8_t em4095_wiegand_tx_push_payload(em4095_wiegand_tx_t *tx, uint64_t payload, uint8_t bits)
+{
+    uint8_t i;
+    uint8_t buf[8];
+
+    if ((bits == 0) || (bits > EM4095_WIEGAND_MAX_BITS))                                 /* check the bits */
+    {
+        return 4;                                                                        /* return error */
+    }
+
+    payload <<= (64 - bits);                                                             /* left align */
+    for (i = 0; i < 8; i++)                                                              /* every byte */
+    {
+        buf[i] = (uint8_t)(payload >> (56 - i * 8));                                     /* msb first */
+    }
+
+    return em4095_wiegand_tx_push(tx, EM4095_WIEGAND_TX_MODE_WIEGAND, buf, bits);        /* queue it */
+}
+
+/**
+ * @brief      get the line actions of the next slot
+ * @param[in]  *tx pointer to a tx structure
+ * @param[out] *lines pointer to a line action buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 idle
+ *             - 2 tx or lines is NULL
+ * @note       *lines is an or of em4095_wiegand_line_t, 0 keeps the lines, it runs in the slot irq
+ */
+uint8_t em4095_wiegand_tx_next(em4095_wiegand_tx_t *tx, uint8_t *lines)
+{
+    uint8_t b;
+    const em4095_wiegand_tx_frame_t *f;
+
+    if ((tx == NULL) || (lines == NULL))                                                              /* check the pointers */
+    {
+        return 2;                                                                                     /* return error */
+    }
+
+    *lines = 0;                                                                                       /* keep the lines */
+    if (tx->active == 0)                                                                              /* no frame */
+    {
+        if (tx->head == tx->tail)                                                                     /* queue is empty */
+        {
+            return 1;                                                                                 /* idle */
+        }
+        tx->active = 1;                                                                               /* start the frame */
+        tx->bit = 0;                                                                                  /* first bit */
+        tx->slot = 0;                                                                                 /* first slot */
+    }
+
+    f = &tx->frame[tx->head & (EM4095_WIEGAND_TX_DEPTH - 1)];                                         /* get the frame */
+    if (tx->bit < f->bits)                                                                            /* a bit */
+    {
+        b = (uint8_t)((f->buf[tx->bit / 8] >> (7 - (tx->bit % 8))) & 0x01);                           /* get the bit */
+        if (f->mode == EM4095_WIEGAND_TX_MODE_WIEGAND)                                                /* wiegand */
+        {
+            if (tx->slot == 0)                                                                        /* pulse start */
+            {
+                *lines = (b != 0) ? EM4095_WIEGAND_LINE_D1_LOW : EM4095_WIEGAND_LINE_D0_LOW;          /* pull the line */
+            }
+            else if (tx->slot == 1)                                                                   /* pulse end */
+            {
+                *lines = (b != 0) ? EM4095_WIEGAND_LINE_D1_HIGH : EM4095_WIEGAND_LINE_D0_HIGH;        /* release the line */
+            }
+            else
+            {
+                /* bit interval */
+            }
+        }
+        else                                                                                          /* aba */
+        {
+            if (tx->slot == 0)                                                                        /* data setup */
+            {
+                *lines = (b != 0) ? EM4095_WIEGAND_LINE_D0_LOW : EM4095_WIEGAND_LINE_D0_HIGH;         /* set the data */
+            }
+            else if (tx->slot == 1)                                                                   /* clock start */
+            {
+                *lines = EM4095_WIEGAND_LINE_D1_LOW;                                                  /* pull the clock */
+            }
+            else if (tx->slot == 2)                                                                   /* clock end */
+            {
+                *lines = EM4095_WIEGAND_LINE_D1_HIGH;                                                 /* release the clock */
+            }
+            else
+            {
+                /* bit interval */
+            }
+        }
+        tx->slot++;                                                                                   /* slot++ */
+        if (tx->slot >= tx->slots_per_bit)                                                            /* bit done */
+        {
+            tx->slot = 0;                                                                             /* first slot */
+            tx->bit++;                                                                                /* next bit */
+        }
+    }
+    else                                                                                              /* the gap */
+    {
+        if (tx->slot == 0)                                                                            /* gap start */
+        {
+            *lines = EM4095_WIEGAND_LINE_D0_HIGH | EM4095_WIEGAND_LINE_D1_HIGH;                       /* release both lines */
+        }
+        tx->slot++;                                                                                   /* slot++ */
+        if (tx->slot >= tx->gap_slots)                                                                /* gap done */
+        {
+            tx->active = 0;                                                                           /* frame done */
+            tx->sent++;                                                                               /* sent++ */
+            tx->head++;                                                                               /* free the frame */
+        }
+    }
+
+    return 0;                                                                                         /* success return 0 */
+}
@@ -0,0 +1,281 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_wiegand.h
+ * @brief     driver em4095 wiegand header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#ifndef DRIVER_EM4095_WIEGAND_H
+#define DRIVER_EM4095_WIEGAND_H
+
+#include "driver_em4095.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup em4095_wiegand_driver em4095 wiegand driver function
+ * @brief    em4095 wiegand driver modules
+ * @ingroup  em4095_driver
+ * @details  a wiegand payload is kept right aligned in a 64 bits word, the first bit is the msb. every
+ *           parity bit has a precomputed mask of the bits it covers including itself, so a check is
+ *           one and and one parity fold. the format is detected from the payload length and the
+ *           parity validity, formats of the same length and parity can't be told apart and the
+ *           first one of the table wins.
+ *           the transmitter turns queued frames into line actions one time slot at a time, a board
+ *           timer or dma calls em4095_wiegand_tx_next at every slot and applies the actions to the
+ *           d0 and d1 lines, so the frame is clocked out in the background.
+ *           - wiegand: a bit is a one slot low pulse on d0 for 0 or on d1 for 1.
+ *           - aba clock and data: d0 is the data line and d1 the clock line, both active low, the
+ *             data is set one slot before the clock pulse.
+ * @{
+ */
+
+/**
+ * @brief em4095 wiegand definition
+ */
+#define EM4095_WIEGAND_MAX_BITS          64        /**< max payload bits */
+#define EM4095_WIEGAND_MAX_PARITIES      3         /**< max parity bits of a format */
+#define EM4095_WIEGAND_TX_MAX_BITS       128       /**< max transmitted frame bits */
+#ifndef EM4095_WIEGAND_TX_DEPTH
+    #define EM4095_WIEGAND_TX_DEPTH      4         /**< queued frames, must be a power of 2 */
+#endif
+
+/**
+ * @brief em4095 wiegand tx mode enumeration definition
+ */
+typedef enum
+{
+    EM4095_WIEGAND_TX_MODE_WIEGAND = 0x00,        /**< wiegand d0 and d1 */
+    EM4095_WIEGAND_TX_MODE_ABA     = 0x01,        /**< aba clock and data */
+} em4095_wiegand_tx_mode_t;
+
+/**
+ * @brief em4095 wiegand line action enumeration definition
+ */
+typedef enum
+{
+    EM4095_WIEGAND_LINE_D0_LOW  = 0x01,        /**< pull d0 or data low */
+    EM4095_WIEGAND_LINE_D0_HIGH = 0x02,        /**< release d0 or data */
+    EM4095_WIEGAND_LINE_D1_LOW  = 0x04,        /**< pull d1 or clock low */
+    EM4095_WIEGAND_LINE_D1_HIGH = 0x08,        /**< release d1 or clock */
+} em4095_wiegand_line_t;
+
+/**
+ * @brief em4095 wiegand parity structure definition
+ */
+typedef struct em4095_wiegand_parity_s
+{
+    uint8_t position;        /**< parity bit position, 0 is the first bit */
+    uint8_t odd;             /**< 1 odd parity, 0 even parity */
+    uint64_t mask;           /**< covered bits including the parity bit */
+} em4095_wiegand_parity_t;
+
+/**
+ * @brief em4095 wiegand field structure definition
+ */
+typedef struct em4095_wiegand_field_s
+{
+    uint8_t start;           /**< first bit */
+    uint8_t length;          /**< bit length, 0 means no field */
+} em4095_wiegand_field_t;
+
+/**
+ * @brief em4095 wiegand format structure definition
+ */
+typedef struct em4095_wiegand_format_s
+{
+    const char *name;                                                /**< format name */
+    uint8_t bits;                                                    /**< payload bits */
+    uint8_t parities;                                                /**< parity bit number */
+    em4095_wiegand_parity_t parity[EM4095_WIEGAND_MAX_PARITIES];     /**< parity bits in the computing order */
+    em4095_wiegand_field_t facility;                                 /**< facility code */
+    em4095_wiegand_field_t card;                                     /**< card number */
+} em4095_wiegand_format_t;
+
+/**
+ * @brief em4095 wiegand card structure definition
+ */
+typedef struct em4095_wiegand_card_s
+{
+    const em4095_wiegand_format_t *format;        /**< detected format */
+    uint32_t facility;                            /**< facility code */
+    uint32_t card;                                /**< card number */
+} em4095_wiegand_card_t;
+
+/**
+ * @brief em4095 wiegand tx frame structure definition
+ */
+typedef struct em4095_wiegand_tx_frame_s
+{
+    uint8_t buf[EM4095_WIEGAND_TX_MAX_BITS / 8];        /**< frame bits, the first bit is the msb of buf[0] */
+    uint8_t bits;                                       /**< frame bits */
+    uint8_t mode;                                       /**< tx mode */
+} em4095_wiegand_tx_frame_t;
+
+/**
+ * @brief em4095 wiegand tx structure definition
+ */
+typedef struct em4095_wiegand_tx_s
+{
+    em4095_wiegand_tx_frame_t frame[EM4095_WIEGAND_TX_DEPTH];        /**< frame queue */
+    volatile uint8_t head;                                           /**< next sent frame, only moved by the slot side */
+    volatile uint8_t tail;                                           /**< next free frame, only moved by the push side */
+    uint16_t slots_per_bit;                                          /**< slots of one bit */
+    uint16_t gap_slots;                                              /**< idle slots after a frame */
+    uint8_t active;                                                  /**< a frame is being sent */
+    uint8_t bit;                                                     /**< current bit */
+    uint16_t slot;                                                   /**< current slot of the bit or the gap */
+    uint32_t sent;                                                   /**< sent frames */
+} em4095_wiegand_tx_t;
+
+/**
+ * @brief      get the wiegand format table
+ * @param[out] **table pointer to a format table buffer
+ * @param[out] *count pointer to a format number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 table or count is NULL
+ * @note       h10301 26 bits, h10306 34 bits, corporate 1000 35 bits, h10304 37 bits and
+ *             corporate 1000 48 bits
+ */
+uint8_t em4095_wiegand_get_formats(const em4095_wiegand_format_t **table, uint8_t *count);
+
+/**
+ * @brief      parse a wiegand payload
+ * @param[in]  payload right aligned payload, the first bit is the msb
+ * @param[in]  bits payload bits
+ * @param[out] *card pointer to a card structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 no format matched
+ *             - 2 card is NULL
+ * @note       no allocation, it can run in the frame completion path
+ */
+uint8_t em4095_wiegand_parse(uint64_t payload, uint8_t bits, em4095_wiegand_card_t *card);
+
+/**
+ * @brief      encode a wiegand payload
+ * @param[in]  *format pointer to a format structure
+ * @param[in]  facility facility code
+ * @param[in]  card card number
+ * @param[out] *payload pointer to a payload buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 format or payload is NULL
+ *             - 4 facility or card is too large
+ * @note       the payload has format->bits bits
+ */
+uint8_t em4095_wiegand_encode(const em4095_wiegand_format_t *format, uint32_t facility, uint32_t card,
+                              uint64_t *payload);
+
+/**
+ * @brief      encode an aba track 2 frame
+ * @param[in]  *digits pointer to a decimal digit string
+ * @param[out] *buf pointer to a frame buffer
+ * @param[in]  len buffer length
+ * @param[out] *bits pointer to a frame bits buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is too small
+ *             - 2 digits, buf or bits is NULL
+ *             - 4 digits is invalid
+ * @note       10 leading zeros, the start sentinel, the digits, the end sentinel, the lrc and 10
+ *             trailing zeros, every character is 4 bits lsb first and an odd parity bit
+ */
+uint8_t em4095_wiegand_aba_encode(const char *digits, uint8_t *buf, uint16_t len, uint8_t *bits);
+
+/**
+ * @brief     init the transmitter
+ * @param[in] *tx pointer to a tx structure
+ * @param[in] slots_per_bit slots of one bit
+ * @param[in] gap_slots idle slots after a frame
+ * @return    status code
+ *            - 0 success
+ *            - 2 tx is NULL
+ *            - 4 slots_per_bit or gap_slots is invalid
+ * @note      3 <= slots_per_bit, 1 <= gap_slots, with 50us slots a 2ms bit interval is 40 slots
+ */
+uint8_t em4095_wiegand_tx_init(em4095_wiegand_tx_t *tx, uint16_t slots_per_bit, uint16_t gap_slots);
+
+/**
+ * @brief     queue a frame
+ * @param[in] *tx pointer to a tx structure
+ * @param[in] mode tx mode
+ * @param[in] *buf pointer to a frame buffer, the first bit is the msb of buf[0]
+ * @param[in] bits frame bits
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ *            - 2 tx or buf is NULL
+ *            - 4 bits is invalid
+ * @note      one pushing side and one slot side may run at once without a lock
+ */
+uint8_t em4095_wiegand_tx_push(em4095_wiegand_tx_t *tx, em4095_wiegand_tx_mode_t mode, const uint8_t *buf, uint8_t bits);
+
+/**
+ * @brief     queue a wiegand payload
+ * @param[in] *tx pointer to a tx structure
+ * @param[in] payload right aligned payload, the first bit is the msb
+ * @param[in] bits payload bits
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ *            - 2 tx is NULL
+ *            - 4 bits is invalid
+ * @note      none
+ */
+uint8_t em4095_wiegand_tx_push_payload(em4095_wiegand_tx_t *tx, uint64_t payload, uint8_t bits);
+
+/**
+ * @brief      get the line actions of the next slot
+ * @param[in]  *tx pointer to a tx structure
+ * @param[out] *lines pointer to a line action buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 idle
+ *             - 2 tx or lines is NULL
+ * @note       *lines is an or of em4095_wiegand_line_t, 0 keeps the lines, it runs in the slot irq
+ */
+uint8_t em4095_wiegand_tx_next(em4095_wiegand_tx_t *tx, uint8_t *lines);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
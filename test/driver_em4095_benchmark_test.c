@@ -0,0 +1,344 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_em4095_benchmark_test.c
+ * @brief     driver em4095 benchmark test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#include "driver_em4095_benchmark_test.h"
+#include "driver_em4095_em4100.h"
+
+/**
+ * @brief benchmark test definition
+ */
+#define BENCHMARK_TEST_DIV            32         /**< two samples per rf/64 bit */
+#define BENCHMARK_TEST_LENGTH         256        /**< a full frame at any phase */
+#define BENCHMARK_TEST_TIMEOUT_US     1000000    /**< 1s read timeout */
+#define BENCHMARK_TEST_CALIBRATE_US   100000     /**< 100ms idle loop calibration */
+#define BENCHMARK_TEST_BINS           1000       /**< 1ms time to id bins */
+
+static em4095_handle_t gs_handle;                                /**< em4095 handle */
+static volatile uint8_t gs_flag;                                 /**< flag */
+static em4095_decode_t *volatile gs_buf;                         /**< done read buffer */
+static volatile uint16_t gs_len;                                 /**< done read length */
+static uint16_t gs_bin[BENCHMARK_TEST_BINS];                     /**< time to id histogram */
+
+/**
+ * @brief  benchmark test irq
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   none
+ */
+uint8_t em4095_benchmark_test_irq_handler(void)
+{
+    if (em4095_irq_handler(&gs_handle) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     interface receive callback
+ * @param[in] *ctx pointer to the interface context
+ * @param[in] mode running mode
+ * @param[in] *buf pointer to a decode buffer
+ * @param[in] len data length
+ * @note      the buffer is kept until the next read, so it is decoded out of the irq
+ */
+static void a_receive_callback(void *ctx, em4095_mode_t mode, em4095_decode_t *buf, uint16_t len)
+{
+    (void)ctx;
+
+    if (mode == EM4095_MODE_READ)
+    {
+        gs_buf = buf;
+        gs_len = len;
+        gs_flag = 1;
+    }
+}
+
+/**
+ * @brief     get the elapsed time
+ * @param[in] *start pointer to a start time
+ * @return    elapsed us
+ * @note      a timestamp read error counts as no time
+ */
+static uint32_t a_elapsed_us(const em4095_time_t *start)
+{
+    em4095_time_t t;
+    
+    if (em4095_interface_timestamp_read(&t) != 0)
+    {
+        return 0;
+    }
+    
+    return (uint32_t)((t.s - start->s) * 1000000 + t.us) - start->us;
+}
+
+/**
+ * @brief      spin the idle loop
+ * @param[in]  us max spin time
+ * @param[in]  *flag pointer to a stop flag
+ * @param[out] *count pointer to an idle loop counter
+ * @return     elapsed us
+ * @note       the calibration and the benchmark run the same loop
+ */
+static uint32_t a_idle(uint32_t us, volatile uint8_t *flag, uint32_t *count)
+{
+    uint32_t elapsed;
+    em4095_time_t start;
+    
+    elapsed = 0;
+    if (em4095_interface_timestamp_read(&start) != 0)
+    {
+        return 0;
+    }
+    while ((*flag == 0) && (elapsed < us))
+    {
+        (*count)++;
+        elapsed = a_elapsed_us(&start);
+    }
+    
+    return elapsed;
+}
+
+/**
+ * @brief     benchmark test
+ * @param[in] ms test duration in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      back to back 256 samples reads at div 32 decoded as em4100 frames,
+ *            the cpu load is measured with an idle loop counter
+ */
+uint8_t em4095_benchmark_test(uint32_t ms)
+{
+    uint8_t res;
+    volatile uint8_t never;
+    uint16_t index;
+    uint32_t i;
+    uint32_t us;
+    uint32_t begin;
+    uint32_t total;
+    uint32_t frames;
+    uint32_t decoded;
+    uint32_t idle;
+    uint32_t calibrate;
+    uint32_t calibrate_us;
+    uint32_t p99;
+    uint64_t sum;
+    float load;
+    em4095_time_t start;
+    em4095_em4100_id_t id;
+    em4095_em4100_id_t last;
+    em4095_info_t info;
+    
+    /* link interface function */
+    DRIVER_EM4095_LINK_INIT(&gs_handle, em4095_handle_t);
+    DRIVER_EM4095_LINK_SHD_GPIO_INIT(&gs_handle, em4095_interface_shd_gpio_init);
+    DRIVER_EM4095_LINK_SHD_GPIO_DEINIT(&gs_handle, em4095_interface_shd_gpio_deinit);
+    DRIVER_EM4095_LINK_SHD_GPIO_WRITE(&gs_handle, em4095_interface_shd_gpio_write);
+    DRIVER_EM4095_LINK_MOD_GPIO_INIT(&gs_handle, em4095_interface_mod_gpio_init);
+    DRIVER_EM4095_LINK_MOD_GPIO_DEINIT(&gs_handle, em4095_interface_mod_gpio_deinit);
+    DRIVER_EM4095_LINK_MOD_GPIO_WRITE(&gs_handle, em4095_interface_mod_gpio_write);
+    DRIVER_EM4095_LINK_DEMOD_GPIO_INIT(&gs_handle, em4095_interface_demod_gpio_init);
+    DRIVER_EM4095_LINK_DEMOD_GPIO_DEINIT(&gs_handle, em4095_interface_demod_gpio_deinit);
+    DRIVER_EM4095_LINK_DEMOD_GPIO_READ(&gs_handle, em4095_interface_demod_gpio_read);
+    DRIVER_EM4095_LINK_TIMESTAMP_READ(&gs_handle, em4095_interface_timestamp_read);
+    DRIVER_EM4095_LINK_DELAY_MS(&gs_handle, em4095_interface_delay_ms);
+    DRIVER_EM4095_LINK_DEBUG_PRINT(&gs_handle, em4095_interface_debug_print);
+    DRIVER_EM4095_LINK_RECEIVE_CALLBACK(&gs_handle, a_receive_callback);
+    
+    /* get information */
+    res = em4095_info(&info);
+    if (res != 0)
+    {
+        em4095_interface_debug_print("em4095: get info failed.\n");
+    
+        return 1;
+    }
+    else
+    {
+        /* print chip info */
+        em4095_interface_debug_print("em4095: chip is %s.\n", info.chip_name);
+        em4095_interface_debug_print("em4095: manufacturer is %s.\n", info.manufacturer_name);
+        em4095_interface_debug_print("em4095: interface is %s.\n", info.interface);
+        em4095_interface_debug_print("em4095: driver version is %d.%d.\n", info.driver_version / 1000, (info.driver_version % 1000) / 100);
+        em4095_interface_debug_print("em4095: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
+        em4095_interface_debug_print("em4095: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
+        em4095_interface_debug_print("em4095: max current is %0.2fmA.\n", info.max_current_ma);
+        em4095_interface_debug_print("em4095: max temperature is %0.1fC.\n", info.temperature_max);
+        em4095_interface_debug_print("em4095: min temperature is %0.1fC.\n", info.temperature_min);
+    }
+    
+    /* init */
+    res = em4095_init(&gs_handle);
+    if (res != 0)
+    {
+        em4095_interface_debug_print("em4095: init failed.\n");
+    
+        return 1;
+    }
+    
+    /* start benchmark test */
+    em4095_interface_debug_print("em4095: start benchmark test.\n");
+    
+    /* set div */
+    res = em4095_set_div(&gs_handle, BENCHMARK_TEST_DIV);
+    if (res != 0)
+    {
+        em4095_interface_debug_print("em4095: set div failed.\n");
+        (void)em4095_deinit(&gs_handle);
+    
+        return 1;
+    }
+    
+    /* calibrate the idle loop with the carrier off */
+    never = 0;
+    calibrate = 0;
+    calibrate_us = a_idle(BENCHMARK_TEST_CALIBRATE_US, &never, &calibrate);
+    if ((calibrate == 0) || (calibrate_us == 0))
+    {
+        em4095_interface_debug_print("em4095: calibrate failed.\n");
+        (void)em4095_deinit(&gs_handle);
+    
+        return 1;
+    }
+    
+    /* run */
+    for (i = 0; i < BENCHMARK_TEST_BINS; i++)
+    {
+        gs_bin[i] = 0;
+    }
+    frames = 0;
+    decoded = 0;
+    idle = 0;
+    sum = 0;
+    if (em4095_interface_timestamp_read(&start) != 0)
+    {
+        em4095_interface_debug_print("em4095: timestamp read failed.\n");
+        (void)em4095_deinit(&gs_handle);
+    
+        return 1;
+    }
+    total = 0;
+    while (total < ms * 1000)
+    {
+        /* init 0 */
+        gs_flag = 0;
+    
+        /* read and power on, the tag powers up every read */
+        begin = a_elapsed_us(&start);
+        res = em4095_read(&gs_handle, BENCHMARK_TEST_LENGTH);
+        if (res != 0)
+        {
+            em4095_interface_debug_print("em4095: read failed.\n");
+            (void)em4095_deinit(&gs_handle);
+    
+            return 1;
+        }
+        res = em4095_power_on(&gs_handle);
+        if (res != 0)
+        {
+            em4095_interface_debug_print("em4095: power on failed.\n");
+            (void)em4095_deinit(&gs_handle);
+    
+            return 1;
+        }
+    
+        /* idle until the read is done */
+        (void)a_idle(BENCHMARK_TEST_TIMEOUT_US, &gs_flag, &idle);
+        if (gs_flag == 0)
+        {
+            em4095_interface_debug_print("em4095: read timeout.\n");
+            (void)em4095_deinit(&gs_handle);
+    
+            return 1;
+        }
+        frames++;
+    
+        /* decode, the time to id includes the decoding */
+        if (em4095_em4100_decode_buffer(gs_buf, gs_len, 2, &id, &index) == 0)
+        {
+            us = a_elapsed_us(&start) - begin;
+            last = id;
+            decoded++;
+            sum += us;
+            gs_bin[(us / 1000 < BENCHMARK_TEST_BINS) ? (us / 1000) : (BENCHMARK_TEST_BINS - 1)]++;
+        }
+        total = a_elapsed_us(&start);
+    }
+    (void)em4095_deinit(&gs_handle);
+    
+    /* p99 */
+    p99 = 0;
+    if (decoded != 0)
+    {
+        us = 0;
+        for (i = 0; i < BENCHMARK_TEST_BINS; i++)
+        {
+            us += gs_bin[i];
+            if ((uint64_t)us * 100 >= (uint64_t)decoded * 99)
+            {
+                p99 = i + 1;
+    
+                break;
+            }
+        }
+    }
+    
+    /* the load is the idle time the reads took */
+    load = 100.0f - 100.0f * ((float)idle / (float)calibrate) * ((float)calibrate_us / (float)total);
+    load = (load < 0.0f) ? 0.0f : load;
+    
+    /* output */
+    em4095_interface_debug_print("em4095: %d frames in %dms, %0.2f frames/s.\n",
+                                 frames, total / 1000, (float)frames * 1000000.0f / (float)total);
+    em4095_interface_debug_print("em4095: decoded %d frames, %0.2f%%.\n",
+                                 decoded, (frames != 0) ? (float)decoded * 100.0f / (float)frames : 0.0f);
+    if (decoded != 0)
+    {
+        em4095_interface_debug_print("em4095: last id is %02X%08X.\n", last.version, last.id);
+        em4095_interface_debug_print("em4095: mean time to id is %0.2fms, p99 is below %dms.\n",
+                                     (float)sum / (float)decoded / 1000.0f, p99);
+    }
+    em4095_interface_debug_print("em4095: cpu load is %0.2f%%.\n", load);
+    
+    /* finish benchmark test */
+    em4095_interface_debug_print("em4095: finish benchmark test.\n");
+    
+    return 0;
+}
@@ -59,15 +59,18 @@ uint8_t em4095_read_write_test_irq_handler(void)
 
 /**
  * @brief     interface receive callback
+ * @param[in] *ctx pointer to the interface context
  * @param[in] mode running mode
  * @param[in] *buf pointer to a decode buffer
  * @param[in] len data length
  * @note      none
  */
-static void a_receive_callback(em4095_mode_t mode, em4095_decode_t *buf, uint16_t len)
+static void a_receive_callback(void *ctx, em4095_mode_t mode, em4095_decode_t *buf, uint16_t len)
 {
     uint16_t i;
     
+    (void)ctx;
+    
     switch (mode)
     {
         case EM4095_MODE_READ :